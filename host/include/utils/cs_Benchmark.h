@@ -0,0 +1,50 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+/**
+ * Time a function.
+ *
+ * @param[in] numCalls       Number of times to call the function.
+ * @param[in] function       Function that gets the call number, and returns a value that is added to the checksum,
+ *                           so that the work can't be optimized away.
+ * @param[in,out] checksum   Sum to add the returned values to.
+ * @return                   The average time per call in ns.
+ */
+template <class Function>
+double getBenchmarkNs(int numCalls, Function function, int64_t& checksum) {
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < numCalls; ++i) {
+		checksum += function(i);
+	}
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	return static_cast<double>(ns) / numCalls;
+}
+
+/**
+ * Time a function, and print the average time per call.
+ *
+ * The time depends on the host and its load, so it is only printed: tests should not fail on it.
+ *
+ * @param[in] name           Name to print with the time.
+ * @param[in] numCalls       Number of times to call the function.
+ * @param[in] function       Function that gets the call number, and returns a value that is added to the checksum,
+ *                           so that the work can't be optimized away.
+ * @return                   The sum of the returned values.
+ */
+template <class Function>
+int64_t printBenchmark(const char* name, int numCalls, Function function) {
+	int64_t checksum = 0;
+	double ns        = getBenchmarkNs(numCalls, function, checksum);
+	std::cout << name << ": " << ns << " ns per call" << std::endl;
+	return checksum;
+}
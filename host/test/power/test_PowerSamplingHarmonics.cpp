@@ -0,0 +1,137 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <drivers/cs_ADC.h>
+#include <drivers/cs_RTC.h>
+#include <processing/cs_PowerSampling.h>
+#include <storage/cs_State.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Runs a load with known harmonics through PowerSampling, and checks the published power quality.
+ *
+ * The harmonics are calculated from the unfiltered samples, so they should match the synthesized amplitudes, even
+ * where the median filter flattens the peaks of the current.
+ */
+
+#define NUM_SAMPLES CS_ADC_NUM_SAMPLES_PER_CHANNEL
+#define BUFFER_DURATION_MS (CS_ADC_SAMPLE_INTERVAL_US * NUM_SAMPLES / 1000)
+
+// Channels, as configured by PowerSampling.
+#define VOLTAGE_CHANNEL_IDX 0
+#define CURRENT_CHANNEL_IDX 1
+
+// Number of buffers it takes for the zero values to settle, and the power quality to be published a few times.
+#define NUM_BUFFERS 1200
+
+// Amplitudes of the odd harmonics 1, 3, 5, 7, in sample units. The current is that of a rectifier, with sharp peaks.
+const double VOLTAGE_AMPLITUDES[POWER_QUALITY_NUM_HARMONICS] = {1626, 80, 30, 10};
+const double CURRENT_AMPLITUDES[POWER_QUALITY_NUM_HARMONICS] = {300, 240, 170, 100};
+
+// Phase of the current fundamental, relative to the voltage.
+#define CURRENT_PHASE -0.3
+
+// The measured harmonics may differ this much from the synthesized ones, relative to the fundamental.
+#define MAX_HARMONIC_ERROR 0.01
+
+double getSample(const double amplitudes[POWER_QUALITY_NUM_HARMONICS], double angle) {
+	double value = 0;
+	for (int h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+		value += amplitudes[h] * std::sin((2 * h + 1) * angle);
+	}
+	return value;
+}
+
+/**
+ * Fill the next buffer, and let PowerSampling handle it, like the SAADC fills them in turn.
+ */
+void handleBuffer(uint32_t bufferCount) {
+	ADC& adc             = ADC::getInstance();
+	AdcBuffer& adcBuffer = AdcBuffer::getInstance();
+
+	RTC::offsetMs(BUFFER_DURATION_MS);
+	adc_buffer_id_t bufIndex = bufferCount % adcBuffer.getBufferCount();
+	for (adc_sample_value_id_t i = 0; i < NUM_SAMPLES; ++i) {
+		double angle               = 2 * M_PI * i / NUM_SAMPLES;
+		adc_sample_value_t voltage = getSample(VOLTAGE_AMPLITUDES, angle) + (rand() % 5) - 2;
+		adc_sample_value_t current = 10 + getSample(CURRENT_AMPLITUDES, angle + CURRENT_PHASE) + (rand() % 5) - 2;
+		adcBuffer.setValue(bufIndex, VOLTAGE_CHANNEL_IDX, i, voltage);
+		adcBuffer.setValue(bufIndex, CURRENT_CHANNEL_IDX, i, current);
+	}
+	adc.markBufferFilled(bufIndex);
+	adc._handleAdcDone(bufIndex);
+}
+
+bool checkHarmonics(
+		const char* name,
+		const int32_t measured[POWER_QUALITY_NUM_HARMONICS],
+		const double amplitudes[POWER_QUALITY_NUM_HARMONICS],
+		float multiplier) {
+	for (int h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+		// Published in mA or mV RMS.
+		double expected = amplitudes[h] * std::fabs(multiplier) / std::sqrt(2.0) * 1000;
+		double maxError = amplitudes[0] * std::fabs(multiplier) / std::sqrt(2.0) * 1000 * MAX_HARMONIC_ERROR;
+		std::cout << name << " harmonic " << 2 * h + 1 << ": " << measured[h] << " expected " << expected << std::endl;
+		if (std::fabs(measured[h] - expected) > maxError) {
+			std::cout << name << " harmonic " << 2 * h + 1 << " is off" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+	storage.init();
+	state.init(&board);
+
+	// The power zero calibration waits for ticks, which aren't dispatched here.
+	TYPIFY(CONFIG_POWER_ZERO) powerZero = 0;
+	state.set(CS_TYPE::CONFIG_POWER_ZERO, &powerZero, sizeof(powerZero));
+
+	PowerSampling& powerSampling = PowerSampling::getInstance();
+	powerSampling.init(&board);
+	powerSampling.startSampling();
+
+	for (uint32_t i = 0; i < NUM_BUFFERS; ++i) {
+		handleBuffer(i);
+	}
+
+	TYPIFY(CONFIG_VOLTAGE_MULTIPLIER) voltageMultiplier;
+	TYPIFY(CONFIG_CURRENT_MULTIPLIER) currentMultiplier;
+	TYPIFY(STATE_POWER_QUALITY) powerQuality;
+	state.get(CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER, &voltageMultiplier, sizeof(voltageMultiplier));
+	state.get(CS_TYPE::CONFIG_CURRENT_MULTIPLIER, &currentMultiplier, sizeof(currentMultiplier));
+	state.get(CS_TYPE::STATE_POWER_QUALITY, &powerQuality, sizeof(powerQuality));
+
+	if (!checkHarmonics("Voltage", powerQuality.voltageHarmonicsRmsMilliVolt, VOLTAGE_AMPLITUDES, voltageMultiplier)) {
+		return 1;
+	}
+	if (!checkHarmonics("Current", powerQuality.currentHarmonicsRmsMA, CURRENT_AMPLITUDES, currentMultiplier)) {
+		return 1;
+	}
+
+	// The phase shift of the fundamentals.
+	int16_t expectedDisplacementPowerFactor = std::round(std::cos(CURRENT_PHASE) * 1000);
+	std::cout << "Displacement power factor: " << powerQuality.displacementPowerFactor << " expected "
+			  << expectedDisplacementPowerFactor << std::endl;
+	if (std::abs(powerQuality.displacementPowerFactor - expectedDisplacementPowerFactor) > 10) {
+		std::cout << "Displacement power factor is off" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,424 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <drivers/cs_ADC.h>
+#include <drivers/cs_RTC.h>
+#include <events/cs_EventDispatcher.h>
+#include <events/cs_EventListener.h>
+#include <processing/cs_PowerSampling.h>
+#include <protocol/cs_UartProtocol.h>
+#include <storage/cs_State.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/**
+ * Replays power measurement captures through PowerSampling: zero calibration, median filter, power calculation,
+ * softfuse and switchcraft. Reports the CPU time per buffer, the softfuse decisions, and the switchcraft detections.
+ *
+ * Usage: test_PowerSamplingReplay [capture [switch state [voltage multiplier current multiplier]]]
+ *
+ * The capture is the raw UART output of a crownstone with the current and voltage logs enabled (see
+ * CMD_ENABLE_LOG_CURRENT and CMD_ENABLE_LOG_VOLTAGE). Current and voltage messages with the same timestamp are
+ * combined into a buffer, all other messages are skipped. Since the logs contain the samples after the median filter,
+ * the samples are filtered twice during the replay.
+ *
+ * The switch state is not in the capture, and defaults to relay on. The multipliers default to those of the host
+ * board, they should be set to those of the crownstone that made the capture.
+ *
+ * Without arguments, a synthesized capture is replayed and the results are checked.
+ */
+
+#define NUM_SAMPLES CS_ADC_NUM_SAMPLES_PER_CHANNEL
+#define BUFFER_DURATION_MS (CS_ADC_SAMPLE_INTERVAL_US * NUM_SAMPLES / 1000)
+
+// Channels, as configured by PowerSampling.
+#define VOLTAGE_CHANNEL_IDX 0
+#define CURRENT_CHANNEL_IDX 1
+
+// Current amplitudes of the synthesized capture, 0.5A and 1.5A with the current multiplier of the host board.
+#define SYNTHESIZED_LOW_CURRENT 177
+#define SYNTHESIZED_HIGH_CURRENT 530
+
+struct uart_message_t {
+	uint16_t type;
+	std::vector<uint8_t> payload;
+};
+
+/**
+ * Current and voltage samples of one buffer, as logged.
+ */
+struct replay_buffer_t {
+	uint32_t timestamp;
+	adc_sample_value_t voltage[NUM_SAMPLES];
+	adc_sample_value_t current[NUM_SAMPLES];
+};
+
+struct replay_detection_t {
+	uint32_t bufferIndex;
+	CS_TYPE type;
+};
+
+/**
+ * Parse the plain UART messages with a valid CRC from a byte stream.
+ */
+std::vector<uart_message_t> parseUartStream(const std::vector<uint8_t>& stream) {
+	std::vector<uart_message_t> messages;
+	size_t i = 0;
+	while (i < stream.size()) {
+		if (stream[i++] != UART_START_BYTE) {
+			continue;
+		}
+
+		// Everything up to the next start byte belongs to this message.
+		std::vector<uint8_t> frame;
+		bool escaped = false;
+		while (i < stream.size() && stream[i] != UART_START_BYTE) {
+			uint8_t val = stream[i++];
+			if (escaped) {
+				UartProtocol::unEscape(val);
+				frame.push_back(val);
+				escaped = false;
+			}
+			else if (val == UART_ESCAPE_BYTE) {
+				escaped = true;
+			}
+			else {
+				frame.push_back(val);
+			}
+		}
+
+		uart_msg_size_header_t sizeHeader;
+		if (frame.size() < sizeof(sizeHeader)) {
+			continue;
+		}
+		memcpy(&sizeHeader, frame.data(), sizeof(sizeHeader));
+		const uint8_t* data = frame.data() + sizeof(sizeHeader);
+		uint16_t size       = sizeHeader.size;
+		if (frame.size() - sizeof(sizeHeader) != size
+			|| size < sizeof(uart_msg_wrapper_header_t) + sizeof(uart_msg_header_t) + sizeof(uart_msg_tail_t)) {
+			continue;
+		}
+
+		uart_msg_tail_t tail;
+		memcpy(&tail, data + size - sizeof(tail), sizeof(tail));
+		if (UartProtocol::crc16(data, size - sizeof(tail)) != tail.crc) {
+			continue;
+		}
+
+		uart_msg_wrapper_header_t wrapperHeader;
+		memcpy(&wrapperHeader, data, sizeof(wrapperHeader));
+		if (wrapperHeader.protocolMajor != UART_PROTOCOL_MAJOR
+			|| wrapperHeader.type != static_cast<uint8_t>(UartMsgType::UART_MSG)) {
+			continue;
+		}
+
+		uart_msg_header_t msgHeader;
+		memcpy(&msgHeader, data + sizeof(wrapperHeader), sizeof(msgHeader));
+		const uint8_t* payload = data + sizeof(wrapperHeader) + sizeof(msgHeader);
+		uint16_t payloadSize   = size - sizeof(wrapperHeader) - sizeof(msgHeader) - sizeof(tail);
+		messages.push_back({msgHeader.type, std::vector<uint8_t>(payload, payload + payloadSize)});
+	}
+	return messages;
+}
+
+/**
+ * Combine current and voltage log messages with the same timestamp into buffers.
+ *
+ * The current is logged before the voltage.
+ */
+std::vector<replay_buffer_t> getBuffers(const std::vector<uart_message_t>& messages) {
+	std::vector<replay_buffer_t> buffers;
+	bool hasCurrent = false;
+	uart_msg_current_t currentMsg;
+	uart_msg_voltage_t voltageMsg;
+	for (auto& message : messages) {
+		switch (message.type) {
+			case UART_OPCODE_TX_POWER_LOG_CURRENT: {
+				if (message.payload.size() != sizeof(currentMsg)) {
+					break;
+				}
+				memcpy(&currentMsg, message.payload.data(), sizeof(currentMsg));
+				hasCurrent = true;
+				break;
+			}
+			case UART_OPCODE_TX_POWER_LOG_VOLTAGE: {
+				if (message.payload.size() != sizeof(voltageMsg)) {
+					break;
+				}
+				memcpy(&voltageMsg, message.payload.data(), sizeof(voltageMsg));
+				if (!hasCurrent || currentMsg.timestamp != voltageMsg.timestamp) {
+					break;
+				}
+				replay_buffer_t buffer;
+				buffer.timestamp = voltageMsg.timestamp;
+				memcpy(buffer.voltage, voltageMsg.samples, sizeof(buffer.voltage));
+				memcpy(buffer.current, currentMsg.samples, sizeof(buffer.current));
+				buffers.push_back(buffer);
+				hasCurrent = false;
+				break;
+			}
+			default: break;
+		}
+	}
+	return buffers;
+}
+
+/**
+ * Escape and append bytes to a stream, like UartHandler::writeBytes().
+ */
+void appendEscaped(std::vector<uint8_t>& stream, const void* data, size_t size) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		uint8_t val = bytes[i];
+		if (val == UART_START_BYTE || val == UART_ESCAPE_BYTE) {
+			stream.push_back(UART_ESCAPE_BYTE);
+			UartProtocol::escape(val);
+		}
+		stream.push_back(val);
+	}
+}
+
+/**
+ * Append a plain UART message to a stream, like UartHandler::writeMsg().
+ */
+void appendUartMsg(std::vector<uint8_t>& stream, uint16_t type, const void* payload, uint16_t payloadSize) {
+	std::vector<uint8_t> data;
+	uart_msg_wrapper_header_t wrapperHeader;
+	uart_msg_header_t msgHeader;
+	msgHeader.type = type;
+	data.insert(data.end(), (uint8_t*)&wrapperHeader, (uint8_t*)&wrapperHeader + sizeof(wrapperHeader));
+	data.insert(data.end(), (uint8_t*)&msgHeader, (uint8_t*)&msgHeader + sizeof(msgHeader));
+	data.insert(data.end(), (uint8_t*)payload, (uint8_t*)payload + payloadSize);
+
+	uart_msg_size_header_t sizeHeader;
+	uart_msg_tail_t tail;
+	sizeHeader.size = data.size() + sizeof(tail);
+	tail.crc        = UartProtocol::crc16(data.data(), data.size());
+
+	stream.push_back(UART_START_BYTE);
+	appendEscaped(stream, &sizeHeader, sizeof(sizeHeader));
+	appendEscaped(stream, data.data(), data.size());
+	appendEscaped(stream, &tail, sizeof(tail));
+}
+
+/**
+ * Synthesize a capture: 230V, with a current of 0.5A that steps up to 1.5A halfway, with the multipliers of the host
+ * board. Other messages and corrupted messages are mixed in, to check the parser.
+ */
+std::vector<uint8_t> synthesizeCapture(uint32_t numBuffers) {
+	std::vector<uint8_t> stream;
+	uint32_t timestamp = 0;
+	for (uint32_t buf = 0; buf < numBuffers; ++buf) {
+		double currentAmplitude = (buf < numBuffers / 2) ? SYNTHESIZED_LOW_CURRENT : SYNTHESIZED_HIGH_CURRENT;
+		uart_msg_current_t currentMsg;
+		uart_msg_voltage_t voltageMsg;
+		currentMsg.timestamp = timestamp;
+		voltageMsg.timestamp = timestamp;
+		for (int i = 0; i < NUM_SAMPLES; ++i) {
+			double angle          = 2 * M_PI * i / NUM_SAMPLES;
+			voltageMsg.samples[i] = 1626 * std::sin(angle) + (rand() % 5) - 2;
+			currentMsg.samples[i] = 10 + currentAmplitude * std::sin(angle - 0.1) + (rand() % 5) - 2;
+		}
+		appendUartMsg(stream, UART_OPCODE_TX_POWER_LOG_CURRENT, &currentMsg, sizeof(currentMsg));
+		appendUartMsg(stream, UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT, &currentMsg, sizeof(currentMsg));
+		size_t voltageMsgStart = stream.size();
+		appendUartMsg(stream, UART_OPCODE_TX_POWER_LOG_VOLTAGE, &voltageMsg, sizeof(voltageMsg));
+		if (buf % 50 == 7) {
+			// Corrupt a sample, this buffer should be dropped.
+			stream[voltageMsgStart + 100] ^= 0x01;
+		}
+		timestamp += RTC::msToTicks(BUFFER_DURATION_MS);
+	}
+	return stream;
+}
+
+/**
+ * Keeps up the softfuse and switchcraft events, and on which buffer they happened.
+ */
+class ReplayListener : public EventListener {
+public:
+	uint32_t bufferIndex = 0;
+	std::vector<replay_detection_t> softfuses;
+	std::vector<replay_detection_t> switchcrafts;
+
+	void handleEvent(event_t& event) {
+		switch (event.type) {
+			case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD:
+			case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER:
+			case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED: softfuses.push_back({bufferIndex, event.type}); break;
+			case CS_TYPE::CMD_SWITCH_TOGGLE:
+				if (event.source.source.id == CS_CMD_SOURCE_SWITCHCRAFT) {
+					switchcrafts.push_back({bufferIndex, event.type});
+				}
+				break;
+			default: break;
+		}
+	}
+};
+
+const char* getSoftfuseName(CS_TYPE type) {
+	switch (type) {
+		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD: return "overcurrent";
+		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER: return "dimmer overcurrent";
+		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED: return "dimmer on failure";
+		default: return "unknown";
+	}
+}
+
+/**
+ * Feed the buffers to PowerSampling via the ADC, like the SAADC fills them in turn.
+ *
+ * @return CPU time per buffer in ns.
+ */
+std::vector<int64_t> replay(const std::vector<replay_buffer_t>& buffers, ReplayListener& listener) {
+	ADC& adc             = ADC::getInstance();
+	AdcBuffer& adcBuffer = AdcBuffer::getInstance();
+	std::vector<int64_t> cpuTimeNs;
+	for (uint32_t i = 0; i < buffers.size(); ++i) {
+		// Let the RTC follow the capture, so that time based decisions are the same as on the crownstone.
+		if (i > 0) {
+			RTC::offsetMs(RTC::ticksToMs(RTC::difference(buffers[i].timestamp, buffers[i - 1].timestamp)));
+		}
+
+		adc_buffer_id_t bufIndex = i % adcBuffer.getBufferCount();
+		for (adc_sample_value_id_t j = 0; j < NUM_SAMPLES; ++j) {
+			adcBuffer.setValue(bufIndex, VOLTAGE_CHANNEL_IDX, j, buffers[i].voltage[j]);
+			adcBuffer.setValue(bufIndex, CURRENT_CHANNEL_IDX, j, buffers[i].current[j]);
+		}
+		adc.markBufferFilled(bufIndex);
+		listener.bufferIndex = i;
+
+		auto start           = std::chrono::steady_clock::now();
+		adc._handleAdcDone(bufIndex);
+		auto duration = std::chrono::steady_clock::now() - start;
+		cpuTimeNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+	}
+	return cpuTimeNs;
+}
+
+void printReport(std::vector<int64_t> cpuTimeNs, const ReplayListener& listener) {
+	for (auto& softfuse : listener.softfuses) {
+		std::cout << "softfuse: buffer=" << softfuse.bufferIndex << " (" << softfuse.bufferIndex * BUFFER_DURATION_MS
+				  << " ms) " << getSoftfuseName(softfuse.type) << std::endl;
+	}
+	for (auto& switchcraft : listener.switchcrafts) {
+		std::cout << "switchcraft: buffer=" << switchcraft.bufferIndex << " ("
+				  << switchcraft.bufferIndex * BUFFER_DURATION_MS << " ms)" << std::endl;
+	}
+	if (cpuTimeNs.empty()) {
+		return;
+	}
+	std::sort(cpuTimeNs.begin(), cpuTimeNs.end());
+	int64_t sum = 0;
+	for (auto ns : cpuTimeNs) {
+		sum += ns;
+	}
+	std::cout << "buffers=" << cpuTimeNs.size() << " cpu time per buffer: avg=" << sum / (int64_t)cpuTimeNs.size()
+			  << " median=" << cpuTimeNs[cpuTimeNs.size() / 2] << " p99=" << cpuTimeNs[cpuTimeNs.size() * 99 / 100]
+			  << " max=" << cpuTimeNs.back() << " ns" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	srand(1);
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+	storage.init();
+	state.init(&board);
+
+	TYPIFY(STATE_SWITCH_STATE) switchState;
+	switchState.asInt = 0;
+	if (argc > 1) {
+		switchState.state.relay = 1;
+	}
+	else {
+		// The synthesized current should trigger the dimmer softfuse.
+		switchState.state.dimmer = CS_SWITCH_CMD_VAL_FULLY_ON;
+	}
+	if (argc > 2) {
+		switchState.asInt = atoi(argv[2]);
+	}
+	state.set(CS_TYPE::STATE_SWITCH_STATE, &switchState, sizeof(switchState));
+
+	if (argc > 4) {
+		TYPIFY(CONFIG_VOLTAGE_MULTIPLIER) voltageMultiplier = atof(argv[3]);
+		TYPIFY(CONFIG_CURRENT_MULTIPLIER) currentMultiplier = atof(argv[4]);
+		state.set(CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER, &voltageMultiplier, sizeof(voltageMultiplier));
+		state.set(CS_TYPE::CONFIG_CURRENT_MULTIPLIER, &currentMultiplier, sizeof(currentMultiplier));
+	}
+
+	TYPIFY(CONFIG_SWITCHCRAFT_ENABLED) switchcraftEnabled = true;
+	state.set(CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED, &switchcraftEnabled, sizeof(switchcraftEnabled));
+
+	ReplayListener listener;
+	listener.listen();
+
+	PowerSampling& powerSampling = PowerSampling::getInstance();
+	powerSampling.init(&board);
+	powerSampling.startSampling();
+
+	const uint32_t numSynthesizedBuffers = 600;
+	std::vector<uint8_t> stream;
+	if (argc > 1) {
+		std::ifstream file(argv[1], std::ios::binary);
+		if (!file) {
+			std::cout << "Failed to open " << argv[1] << std::endl;
+			return 1;
+		}
+		stream.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	else {
+		stream = synthesizeCapture(numSynthesizedBuffers);
+	}
+
+	std::vector<replay_buffer_t> buffers = getBuffers(parseUartStream(stream));
+	std::vector<int64_t> cpuTimeNs       = replay(buffers, listener);
+	printReport(cpuTimeNs, listener);
+
+	if (argc > 1) {
+		return 0;
+	}
+
+	// Only the corrupted buffers should be dropped.
+	if (buffers.size() != numSynthesizedBuffers - numSynthesizedBuffers / 50) {
+		std::cout << "Parsed " << buffers.size() << " buffers" << std::endl;
+		return 1;
+	}
+	// The dimmer softfuse should trigger once, shortly after the current stepped up.
+	uint32_t stepIndex = 0;
+	while (stepIndex < buffers.size()
+		   && *std::max_element(buffers[stepIndex].current, buffers[stepIndex].current + NUM_SAMPLES)
+					  < SYNTHESIZED_HIGH_CURRENT / 2) {
+		++stepIndex;
+	}
+	uint32_t maxDelay = CURRENT_THRESHOLD_DIMMER_CONSECUTIVE + POWER_SAMPLING_RMS_WINDOW_SIZE + 5;
+	if (listener.softfuses.size() != 1
+		|| listener.softfuses[0].type != CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER
+		|| listener.softfuses[0].bufferIndex < stepIndex + CURRENT_THRESHOLD_DIMMER_CONSECUTIVE
+		|| listener.softfuses[0].bufferIndex > stepIndex + maxDelay) {
+		std::cout << "Expected a single dimmer softfuse shortly after buffer " << stepIndex << std::endl;
+		return 1;
+	}
+	// A clean sine should not be mistaken for a switch.
+	if (!listener.switchcrafts.empty()) {
+		std::cout << "Unexpected switchcraft detection" << std::endl;
+		return 1;
+	}
+	return 0;
+}
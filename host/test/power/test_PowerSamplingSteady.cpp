@@ -0,0 +1,196 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <drivers/cs_ADC.h>
+#include <drivers/cs_RTC.h>
+#include <events/cs_EventListener.h>
+#include <processing/cs_PowerSampling.h>
+#include <storage/cs_State.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Runs a synthesized load through PowerSampling, with the steady mode enabled.
+ *
+ * Checks that buffers are skipped once the load is steady, that processing resumes at a current spike that only the
+ * ADC limit guard notices, and at a step in the current. Checks that the dimmer softfuse still triggers in time after
+ * the step. Reports the CPU time per buffer, and the CPU time saved.
+ */
+
+#define NUM_SAMPLES CS_ADC_NUM_SAMPLES_PER_CHANNEL
+#define BUFFER_DURATION_MS (CS_ADC_SAMPLE_INTERVAL_US * NUM_SAMPLES / 1000)
+
+// Channels, as configured by PowerSampling.
+#define VOLTAGE_CHANNEL_IDX 0
+#define CURRENT_CHANNEL_IDX 1
+
+// Current amplitudes, 0.5A and 1.5A with the current multiplier of the host board.
+#define LOW_CURRENT 177
+#define HIGH_CURRENT 530
+
+// A single sample spike, that hardly changes the RMS current, but is above the dimmer softfuse threshold peak.
+#define SPIKE_CURRENT 600
+
+// Number of buffers it takes for the zero values and power averages to settle.
+#define NUM_SETTLE_BUFFERS 1200
+
+/**
+ * Keeps up on which buffers the dimmer softfuse triggered.
+ */
+class SoftfuseListener : public EventListener {
+public:
+	uint32_t bufferIndex = 0;
+	std::vector<uint32_t> softfuses;
+
+	void handleEvent(event_t& event) {
+		if (event.type == CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER) {
+			softfuses.push_back(bufferIndex);
+		}
+	}
+};
+
+struct steady_test_t {
+	uint32_t bufferIndex = 0;
+	SoftfuseListener listener;
+	std::vector<int64_t> processedCpuTimeNs;
+	std::vector<int64_t> skippedCpuTimeNs;
+};
+
+/**
+ * Fill the next buffer with a sine, and let PowerSampling handle it, like the SAADC fills them in turn.
+ *
+ * @return Whether PowerSampling skipped the buffer.
+ */
+bool handleBuffer(steady_test_t& test, double currentAmplitude, int spike = 0) {
+	ADC& adc                     = ADC::getInstance();
+	AdcBuffer& adcBuffer         = AdcBuffer::getInstance();
+	PowerSampling& powerSampling = PowerSampling::getInstance();
+
+	RTC::offsetMs(BUFFER_DURATION_MS);
+	adc_buffer_id_t bufIndex = test.bufferIndex % adcBuffer.getBufferCount();
+	for (adc_sample_value_id_t i = 0; i < NUM_SAMPLES; ++i) {
+		double angle               = 2 * M_PI * i / NUM_SAMPLES;
+		adc_sample_value_t voltage = 1626 * std::sin(angle) + (rand() % 5) - 2;
+		adc_sample_value_t current = 10 + currentAmplitude * std::sin(angle - 0.1) + (rand() % 5) - 2;
+		if (i == NUM_SAMPLES / 2) {
+			current += spike;
+		}
+		adcBuffer.setValue(bufIndex, VOLTAGE_CHANNEL_IDX, i, voltage);
+		adcBuffer.setValue(bufIndex, CURRENT_CHANNEL_IDX, i, current);
+	}
+	adc.markBufferFilled(bufIndex);
+	test.listener.bufferIndex = test.bufferIndex++;
+
+	uint32_t skippedBufCount = powerSampling.getSteadySkippedBufCount();
+	auto start               = std::chrono::steady_clock::now();
+	adc._handleAdcDone(bufIndex);
+	int64_t cpuTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+								.count();
+
+	bool skipped = powerSampling.getSteadySkippedBufCount() != skippedBufCount;
+	if (skipped) {
+		test.skippedCpuTimeNs.push_back(cpuTimeNs);
+	}
+	else {
+		test.processedCpuTimeNs.push_back(cpuTimeNs);
+	}
+	return skipped;
+}
+
+int64_t getMedian(std::vector<int64_t> values) {
+	if (values.empty()) {
+		return 0;
+	}
+	std::sort(values.begin(), values.end());
+	return values[values.size() / 2];
+}
+
+int main() {
+	srand(1);
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+	storage.init();
+	state.init(&board);
+
+	// The synthesized current should trigger the dimmer softfuse.
+	TYPIFY(STATE_SWITCH_STATE) switchState;
+	switchState.asInt        = 0;
+	switchState.state.dimmer = CS_SWITCH_CMD_VAL_FULLY_ON;
+	state.set(CS_TYPE::STATE_SWITCH_STATE, &switchState, sizeof(switchState));
+
+	// The power zero calibration waits for ticks, which aren't dispatched here.
+	TYPIFY(CONFIG_POWER_ZERO) powerZero = 0;
+	state.set(CS_TYPE::CONFIG_POWER_ZERO, &powerZero, sizeof(powerZero));
+
+	// Switchcraft needs every buffer, so steady mode is not allowed with switchcraft enabled.
+	TYPIFY(CONFIG_SWITCHCRAFT_ENABLED) switchcraftEnabled = false;
+	state.set(CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED, &switchcraftEnabled, sizeof(switchcraftEnabled));
+
+	steady_test_t test;
+	test.listener.listen();
+
+	PowerSampling& powerSampling = PowerSampling::getInstance();
+	powerSampling.init(&board);
+	powerSampling.startSampling();
+	powerSampling.enableSteadyMode(true);
+
+	for (uint32_t i = 0; i < NUM_SETTLE_BUFFERS; ++i) {
+		handleBuffer(test, LOW_CURRENT);
+	}
+	if (!handleBuffer(test, LOW_CURRENT)) {
+		std::cout << "Steady load not detected" << std::endl;
+		return 1;
+	}
+
+	if (handleBuffer(test, LOW_CURRENT, SPIKE_CURRENT)) {
+		std::cout << "Buffer with current spike skipped" << std::endl;
+		return 1;
+	}
+
+	// Processing should only resume for as long as it takes to detect a steady load again.
+	for (uint32_t i = 0; i < POWER_SAMPLING_STEADY_BUFFERS; ++i) {
+		handleBuffer(test, LOW_CURRENT);
+	}
+	if (!handleBuffer(test, LOW_CURRENT)) {
+		std::cout << "Steady load not detected after spike" << std::endl;
+		return 1;
+	}
+
+	// After the step, no buffers should be skipped, as the current is above the softfuse threshold.
+	uint32_t stepIndex = test.bufferIndex;
+	for (uint32_t i = 0; i < 2 * CURRENT_THRESHOLD_DIMMER_CONSECUTIVE; ++i) {
+		if (handleBuffer(test, HIGH_CURRENT)) {
+			std::cout << "Buffer skipped after current step" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "skipped=" << powerSampling.getSteadySkippedBufCount() << " of " << test.bufferIndex
+			  << " buffers, saved=" << powerSampling.getSteadySavedMs() << " ms, cpu time per buffer: processed="
+			  << getMedian(test.processedCpuTimeNs) << " skipped=" << getMedian(test.skippedCpuTimeNs) << " ns"
+			  << std::endl;
+
+	// The dimmer softfuse should trigger once, as fast as without skipping buffers.
+	uint32_t minDelay                = CURRENT_THRESHOLD_DIMMER_CONSECUTIVE;
+	uint32_t maxDelay                = CURRENT_THRESHOLD_DIMMER_CONSECUTIVE + POWER_SAMPLING_RMS_WINDOW_SIZE + 5;
+	std::vector<uint32_t>& softfuses = test.listener.softfuses;
+	if (softfuses.size() != 1 || softfuses[0] < stepIndex + minDelay || softfuses[0] > stepIndex + maxDelay) {
+		std::cout << "Expected a single dimmer softfuse shortly after buffer " << stepIndex << std::endl;
+		return 1;
+	}
+	return 0;
+}
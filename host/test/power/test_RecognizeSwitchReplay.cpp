@@ -0,0 +1,350 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <processing/cs_PowerKernel.h>
+#include <processing/cs_RecognizeSwitch.h>
+#include <structs/buffer/cs_AdcBuffer.h>
+#include <structs/buffer/cs_CircularBuffer.h>
+#include <utils/cs_Benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/**
+ * Replays synthesized switch events through RecognizeSwitch::detect(), and checks that each set of buffers gives the
+ * same True, Almost, or False outcome as the float calculation RecognizeSwitch used before the squared difference
+ * kernel. Also checks the sums of powerKernelSquaredDiffSum(), with and without a limit, against the float sums.
+ * Then prints the time of both detections. On the host, the DSP instructions of the kernel are emulated, so these times
+ * don't tell how the detections compare on a Cortex-M4.
+ *
+ * The sets are: clean sines, switch events that distort part of one or both center buffers, load changes that last
+ * until the last buffer, and any of those with clipped samples of 2047, which are ignored.
+ */
+
+#define NUM_SAMPLES CS_ADC_NUM_SAMPLES_PER_CHANNEL
+#define VOLTAGE_CHANNEL_IDX 0
+#define NUM_SETS 200000
+#define NUM_ROUNDS 20000
+
+// The compared buffers, followed by the unfiltered buffer, as PowerSampling queues them.
+#define NUM_COMPARED_BUFFERS 4
+#define NUM_QUEUED_BUFFERS (NUM_COMPARED_BUFFERS + 1)
+
+// Thresholds RecognizeSwitch uses without configuration.
+#define THRESHOLD_DIFFERENT SWITCHCRAFT_THRESHOLD
+#define THRESHOLD_SIMILAR SWITCHCRAFT_THRESHOLD
+#define THRESHOLD_RATIO 100.0
+
+enum class Outcome { True, Almost, False };
+
+/**
+ * Voltage samples of the compared buffers.
+ */
+struct switch_set_t {
+	adc_sample_value_t voltage[NUM_COMPARED_BUFFERS][NUM_SAMPLES];
+};
+
+struct outcome_counts_t {
+	uint32_t counts[3] = {0, 0, 0};
+};
+
+const char* getOutcomeName(Outcome outcome) {
+	switch (outcome) {
+		case Outcome::True: return "True";
+		case Outcome::Almost: return "Almost";
+		case Outcome::False: return "False";
+	}
+	return "unknown";
+}
+
+/**
+ * Synthesize a set of buffers: a sine with noise, with a switch event or load change in some of them.
+ */
+void synthesizeSet(switch_set_t& set) {
+	double amplitude  = 1500 + rand() % 200;
+	double noise      = rand() % 20;
+	double phase      = (rand() % 628) / 100.0;
+	int type          = rand() % 4;
+	int eventStart    = rand() % NUM_SAMPLES;
+	int eventLength   = 1 + rand() % (NUM_SAMPLES / 2);
+	double eventScale = (rand() % 1000) / 1000.0;
+	bool clipped      = rand() % 8 == 0;
+
+	for (int buf = 0; buf < NUM_COMPARED_BUFFERS; ++buf) {
+		bool distorted = false;
+		switch (type) {
+			// Clean sine.
+			case 0: break;
+			// Switch event in the first center buffer.
+			case 1: distorted = (buf == 1); break;
+			// Switch event in both center buffers.
+			case 2: distorted = (buf == 1 || buf == 2); break;
+			// Load change that lasts.
+			case 3: distorted = (buf >= 2); break;
+		}
+		for (int i = 0; i < NUM_SAMPLES; ++i) {
+			double value = amplitude * std::sin(2 * M_PI * i / NUM_SAMPLES + phase);
+			if (distorted && i >= eventStart && i < eventStart + eventLength) {
+				value *= eventScale;
+			}
+			value += noise * ((rand() % 201) - 100) / 100.0;
+			if (clipped && value > 1600) {
+				value = 2047;
+			}
+			set.voltage[buf][i] = std::lround(value);
+		}
+	}
+}
+
+/**
+ * The float calcDiff() of RecognizeSwitch before the squared difference kernel, on a single pair of buffers.
+ */
+float calcDiffFloat(
+		const adc_sample_value_t* values1, const adc_sample_value_t* values2, int startIndex, int numSamples) {
+	float diffSum = 0;
+	for (int i = startIndex; i < startIndex + numSamples; ++i) {
+		float diff = (float)values1[i] - (float)values2[i];
+		diffSum += diff * diff;
+	}
+	return diffSum;
+}
+
+bool ignoreSample(adc_sample_value_t value0, adc_sample_value_t value1, adc_sample_value_t value2) {
+	return value0 == 2047 || value1 == 2047 || value2 == 2047;
+}
+
+/**
+ * The float detect() of RecognizeSwitch before the squared difference kernel, for a single center buffer.
+ */
+Outcome detectFloat(const switch_set_t& set, int center) {
+	const adc_sample_value_t* first = set.voltage[0];
+	const adc_sample_value_t* mid   = set.voltage[center];
+	const adc_sample_value_t* last  = set.voltage[NUM_COMPARED_BUFFERS - 1];
+	int checkLength                 = NUM_SAMPLES / 2;
+	int shift                       = checkLength / 2;
+	float lowerTheshold             = 0.1 * THRESHOLD_DIFFERENT;
+	bool foundAlmost                = false;
+
+	for (int startInd = 0; startInd < NUM_SAMPLES - shift; startInd += shift) {
+		float diffSumCenterFirst = 0;
+		float diffSumCenterLast  = 0;
+		float diffSumFirstLast   = 0;
+		for (int i = startInd; i < startInd + checkLength; ++i) {
+			if (ignoreSample(first[i], mid[i], last[i])) {
+				continue;
+			}
+			float valueFirst  = first[i];
+			float valueCenter = mid[i];
+			float valueLast   = last[i];
+			diffSumCenterFirst += (valueFirst - valueCenter) * (valueFirst - valueCenter);
+			diffSumCenterLast += (valueCenter - valueLast) * (valueCenter - valueLast);
+			diffSumFirstLast += (valueFirst - valueLast) * (valueFirst - valueLast);
+		}
+
+		if (diffSumCenterFirst > THRESHOLD_DIFFERENT && diffSumCenterLast > THRESHOLD_DIFFERENT) {
+			float minDiffSum = diffSumCenterFirst < diffSumCenterLast ? diffSumCenterFirst : diffSumCenterLast;
+			if (diffSumFirstLast < THRESHOLD_SIMILAR || minDiffSum / diffSumFirstLast > THRESHOLD_RATIO) {
+				return Outcome::True;
+			}
+		}
+		if (diffSumCenterFirst > lowerTheshold && diffSumCenterLast > lowerTheshold
+			&& diffSumFirstLast < THRESHOLD_SIMILAR) {
+			foundAlmost = true;
+		}
+	}
+	return foundAlmost ? Outcome::Almost : Outcome::False;
+}
+
+/**
+ * The float outcome over all center buffers, like RecognizeSwitch::detect().
+ */
+Outcome detectFloat(const switch_set_t& set) {
+	Outcome found = Outcome::False;
+	for (int center = 1; center < NUM_COMPARED_BUFFERS - 1; ++center) {
+		Outcome outcome = detectFloat(set, center);
+		if (outcome == Outcome::True) {
+			return outcome;
+		}
+		if (outcome == Outcome::Almost) {
+			found = outcome;
+		}
+	}
+	return found;
+}
+
+/**
+ * Put a set in the ADC buffers, in the order of the queue.
+ */
+void loadSet(const switch_set_t& set, CircularBuffer<adc_buffer_id_t>& bufQueue) {
+	AdcBuffer& adcBuffer = AdcBuffer::getInstance();
+	for (int buf = 0; buf < NUM_QUEUED_BUFFERS; ++buf) {
+		adc_buffer_id_t bufIndex = bufQueue[buf];
+		for (adc_sample_value_id_t i = 0; i < NUM_SAMPLES; ++i) {
+			// The unfiltered buffer is not compared, give it the samples of the last buffer.
+			adc_sample_value_t value = set.voltage[buf < NUM_COMPARED_BUFFERS ? buf : NUM_COMPARED_BUFFERS - 1][i];
+			adcBuffer.setValue(bufIndex, VOLTAGE_CHANNEL_IDX, i, value);
+		}
+	}
+}
+
+/**
+ * Whether the last almost detection holds the samples of this set.
+ */
+bool isLastAlmostDetection(RecognizeSwitch& recognizeSwitch, const switch_set_t& set) {
+	uint8_t data[sizeof(cs_power_samples_header_t) + NUM_SAMPLES * sizeof(adc_sample_value_t)];
+	for (uint8_t buf = 0; buf < NUM_COMPARED_BUFFERS; ++buf) {
+		cs_result_t result(cs_data_t(data, sizeof(data)));
+		recognizeSwitch.getLastDetection(POWER_SAMPLES_TYPE_SWITCHCRAFT_NON_TRIGGERED, buf, result);
+		if (result.returnCode != ERR_SUCCESS
+			|| memcmp(data + sizeof(cs_power_samples_header_t), set.voltage[buf], sizeof(set.voltage[buf])) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Get the outcome of RecognizeSwitch for a loaded set.
+ */
+Outcome detect(RecognizeSwitch& recognizeSwitch, CircularBuffer<adc_buffer_id_t>& bufQueue, const switch_set_t& set) {
+	// Don't skip detections after a found switch.
+	recognizeSwitch.skip(0);
+	if (recognizeSwitch.detect(bufQueue, VOLTAGE_CHANNEL_IDX)) {
+		return Outcome::True;
+	}
+	if (isLastAlmostDetection(recognizeSwitch, set)) {
+		return Outcome::Almost;
+	}
+	return Outcome::False;
+}
+
+/**
+ * Check the squared difference kernel against the float sums of the windows RecognizeSwitch compares.
+ *
+ * The float sums are only exact up to 2^24, so above that they are compared with a relative margin. With a limit,
+ * the kernel should give the exact sum below the limit, and otherwise stop at or above it.
+ */
+bool checkSquaredDiffSums(const switch_set_t& set) {
+	const int checkLength = NUM_SAMPLES / 2;
+	const int shift       = checkLength / 2;
+	for (int buf1 = 0; buf1 < NUM_COMPARED_BUFFERS; ++buf1) {
+		for (int buf2 = buf1 + 1; buf2 < NUM_COMPARED_BUFFERS; ++buf2) {
+			for (int start = 0; start < NUM_SAMPLES - shift; start += shift) {
+				const adc_sample_value_t* values1 = set.voltage[buf1];
+				const adc_sample_value_t* values2 = set.voltage[buf2];
+				float reference                   = calcDiffFloat(values1, values2, start, checkLength);
+				uint32_t sum = powerKernelSquaredDiffSum(values1 + start, values2 + start, checkLength, UINT32_MAX);
+				if (std::fabs(sum - (double)reference) > reference * 1e-5) {
+					std::cout << "Squared diff sum " << sum << " differs from float sum " << reference << std::endl;
+					return false;
+				}
+
+				uint32_t limit        = rand() % (2 * sum + 1);
+				uint32_t limitedSum   = powerKernelSquaredDiffSum(values1 + start, values2 + start, checkLength, limit);
+				bool stoppedCorrectly = limitedSum >= limit && sum >= limit && limitedSum <= sum;
+				if (limitedSum < limit ? limitedSum != sum : !stoppedCorrectly) {
+					std::cout << "Squared diff sum " << limitedSum << " wrong with limit " << limit << ": sum=" << sum
+							  << std::endl;
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool testReplay(RecognizeSwitch& recognizeSwitch, CircularBuffer<adc_buffer_id_t>& bufQueue) {
+	outcome_counts_t outcomes;
+	switch_set_t set;
+	for (int setIndex = 0; setIndex < NUM_SETS; ++setIndex) {
+		synthesizeSet(set);
+		if (!checkSquaredDiffSums(set)) {
+			std::cout << "set=" << setIndex << std::endl;
+			return false;
+		}
+
+		loadSet(set, bufQueue);
+		Outcome expected = detectFloat(set);
+		Outcome outcome  = detect(recognizeSwitch, bufQueue, set);
+		if (outcome != expected) {
+			std::cout << "Detected " << getOutcomeName(outcome) << " instead of " << getOutcomeName(expected)
+					  << ": set=" << setIndex << std::endl;
+			return false;
+		}
+		outcomes.counts[static_cast<int>(outcome)]++;
+	}
+
+	std::cout << "sets=" << NUM_SETS;
+	for (Outcome outcome : {Outcome::True, Outcome::Almost, Outcome::False}) {
+		std::cout << " " << getOutcomeName(outcome) << "=" << outcomes.counts[static_cast<int>(outcome)];
+	}
+	std::cout << std::endl;
+
+	// The synthesized sets should cover all outcomes.
+	for (uint32_t count : outcomes.counts) {
+		if (count == 0) {
+			std::cout << "Not all outcomes were replayed" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool hasClippedSamples(const switch_set_t& set) {
+	const adc_sample_value_t* samples = &set.voltage[0][0];
+	const adc_sample_value_t* end     = samples + NUM_COMPARED_BUFFERS * NUM_SAMPLES;
+	return std::find(samples, end, 2047) != end;
+}
+
+void benchmark(RecognizeSwitch& recognizeSwitch, CircularBuffer<adc_buffer_id_t>& bufQueue) {
+	switch_set_t set;
+	for (Outcome outcome : {Outcome::True, Outcome::Almost, Outcome::False}) {
+		// Find a set without clipped samples with this outcome.
+		do {
+			synthesizeSet(set);
+		} while (detectFloat(set) != outcome || hasClippedSamples(set));
+		loadSet(set, bufQueue);
+
+		std::string name = getOutcomeName(outcome);
+		printBenchmark(("Float detect " + name).c_str(), NUM_ROUNDS, [&](int round) {
+			return static_cast<int>(detectFloat(set));
+		});
+		printBenchmark(("RecognizeSwitch detect " + name).c_str(), NUM_ROUNDS, [&](int round) {
+			recognizeSwitch.skip(0);
+			return recognizeSwitch.detect(bufQueue, VOLTAGE_CHANNEL_IDX) ? 1 : 0;
+		});
+	}
+}
+
+int main() {
+	srand(1);
+	AdcBuffer& adcBuffer = AdcBuffer::getInstance();
+	if (adcBuffer.init() != ERR_SUCCESS) {
+		return 1;
+	}
+	CircularBuffer<adc_buffer_id_t> bufQueue(NUM_QUEUED_BUFFERS);
+	bufQueue.init();
+	for (adc_buffer_id_t i = 0; i < NUM_QUEUED_BUFFERS; ++i) {
+		adcBuffer.getBuffer(i)->valid = true;
+		bufQueue.push(i);
+	}
+
+	RecognizeSwitch& recognizeSwitch = RecognizeSwitch::getInstance();
+	recognizeSwitch.init();
+	recognizeSwitch.start();
+
+	if (!testReplay(recognizeSwitch, bufQueue)) {
+		return 1;
+	}
+	benchmark(recognizeSwitch, bufQueue);
+	return 0;
+}
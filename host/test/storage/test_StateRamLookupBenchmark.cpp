@@ -0,0 +1,145 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <events/cs_EventDispatcher.h>
+#include <storage/cs_State.h>
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * Measures the latency of get and set of state values in RAM, as the number of stored entries grows.
+ *
+ * The entries are spread over types with multiple ids, like asset filters and behaviours would be.
+ */
+
+#define NUM_ROUNDS 20
+
+const CS_TYPE multipleIdTypes[] = {
+		CS_TYPE::CONFIG_IBEACON_MAJOR,
+		CS_TYPE::CONFIG_IBEACON_MINOR,
+};
+const int numMultipleIdTypes = sizeof(multipleIdTypes) / sizeof(multipleIdTypes[0]);
+
+const int entryCounts[] = {4, 16, 64, 256, 512};
+
+cs_state_data_t getEntry(int index, uint16_t* value) {
+	CS_TYPE type     = multipleIdTypes[index % numMultipleIdTypes];
+	cs_state_id_t id = index / numMultipleIdTypes;
+	return cs_state_data_t(type, id, reinterpret_cast<uint8_t*>(value), sizeof(*value));
+}
+
+/**
+ * Set values of entries [startIndex, endIndex), and check if they can be retrieved.
+ */
+bool setEntries(State& state, int startIndex, int endIndex, uint16_t offset) {
+	for (int i = startIndex; i < endIndex; ++i) {
+		uint16_t value        = i + offset;
+		cs_state_data_t data  = getEntry(i, &value);
+		cs_ret_code_t retCode = state.set(data, PersistenceMode::RAM);
+		if (retCode != ERR_SUCCESS && retCode != ERR_SUCCESS_NO_CHANGE) {
+			std::cout << "Failed to set entry " << i << ": retCode=" << retCode << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool checkEntries(State& state, int entryCount, uint16_t offset) {
+	for (int i = 0; i < entryCount; ++i) {
+		uint16_t value       = 0;
+		cs_state_data_t data = getEntry(i, &value);
+		if (state.get(data, PersistenceMode::RAM) != ERR_SUCCESS || value != static_cast<uint16_t>(i + offset)) {
+			std::cout << "Entry " << i << " has value " << value << ", expected " << i + offset << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @return Average time per get in nanoseconds.
+ */
+double benchmarkGet(State& state, int entryCount) {
+	uint16_t value = 0;
+	auto start     = std::chrono::high_resolution_clock::now();
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		for (int i = 0; i < entryCount; ++i) {
+			cs_state_data_t data = getEntry(i, &value);
+			state.get(data, PersistenceMode::RAM);
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	return static_cast<double>(ns) / (NUM_ROUNDS * entryCount);
+}
+
+/**
+ * @return Average time per set in nanoseconds.
+ */
+double benchmarkSet(State& state, int entryCount) {
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		setEntries(state, 0, entryCount, round);
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	return static_cast<double>(ns) / (NUM_ROUNDS * entryCount);
+}
+
+int main() {
+	EventDispatcher::getInstance();
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+
+	storage.init();
+	state.init(&board);
+
+	std::cout << "entries    get (ns)    set (ns)" << std::endl;
+	int entryCount = 0;
+	for (int newEntryCount : entryCounts) {
+		if (!setEntries(state, entryCount, newEntryCount, 0)) {
+			return 1;
+		}
+		entryCount = newEntryCount;
+
+		double getNs = benchmarkGet(state, entryCount);
+		double setNs = benchmarkSet(state, entryCount);
+		std::cout << entryCount << "    " << getNs << "    " << setNs << std::endl;
+
+		if (!checkEntries(state, entryCount, NUM_ROUNDS - 1)) {
+			return 1;
+		}
+	}
+
+	// Remove every other entry, the remaining entries should still be found.
+	for (int i = 0; i < entryCount; i += 2) {
+		uint16_t value       = 0;
+		cs_state_data_t data = getEntry(i, &value);
+		state.remove(data.type, data.id);
+	}
+	for (int i = 1; i < entryCount; i += 2) {
+		uint16_t value       = 0;
+		cs_state_data_t data = getEntry(i, &value);
+		if (state.get(data, PersistenceMode::RAM) != ERR_SUCCESS
+			|| value != static_cast<uint16_t>(i + NUM_ROUNDS - 1)) {
+			std::cout << "Entry " << i << " not found after removing other entries" << std::endl;
+			return 1;
+		}
+	}
+
+	// Removed entries are reused.
+	if (!setEntries(state, 0, entryCount, 0) || !checkEntries(state, entryCount, 0)) {
+		return 1;
+	}
+	return 0;
+}
@@ -55,5 +55,20 @@ int main() {
 		return 1;
 	}
 
+	// Typed get should return the value that was set, and the reference should follow updates.
+	TYPIFY(CONFIG_SPHERE_ID) sphereId = 42;
+	state.set(CS_TYPE::CONFIG_SPHERE_ID, &sphereId, sizeof(sphereId));
+	if (state.get<CS_TYPE::CONFIG_SPHERE_ID>() != sphereId) {
+		LOGw("typed get didn't return same value");
+		return 1;
+	}
+	const TYPIFY(CONFIG_SPHERE_ID)& sphereIdRef = state.getRef<CS_TYPE::CONFIG_SPHERE_ID>();
+	sphereId                                    = 43;
+	state.set(CS_TYPE::CONFIG_SPHERE_ID, &sphereId, sizeof(sphereId));
+	if (sphereIdRef != sphereId) {
+		LOGw("typed reference didn't follow set");
+		return 1;
+	}
+
 	return 0;
 }
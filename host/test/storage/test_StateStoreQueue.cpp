@@ -0,0 +1,133 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <events/cs_EventDispatcher.h>
+#include <storage/cs_State.h>
+
+#include <cstdlib>
+#include <vector>
+
+void tick(int numTicks) {
+	TYPIFY(EVT_TICK) tickCount = 0;
+	for (int i = 0; i < numTicks; ++i) {
+		event_t tickEvent(CS_TYPE::EVT_TICK, &tickCount, sizeof(tickCount));
+		EventDispatcher::getInstance().dispatch(tickEvent);
+	}
+}
+
+/**
+ * Check that items come out in order of deadline, and that items are found by type and id.
+ */
+bool testQueueOrder() {
+	StateStoreQueue queue;
+	cs_state_store_queue_t item;
+	item.operation    = CS_STATE_QUEUE_OP_WRITE;
+	item.type         = CS_TYPE::STATE_BEHAVIOUR_RULE;
+	item.init_counter = 0;
+	item.execute      = true;
+
+	srand(1);
+	for (int i = 0; i < STATE_STORE_QUEUE_SIZE; ++i) {
+		item.id       = i;
+		item.deadline = rand() % 1000;
+		if (queue.add(item) != ERR_SUCCESS) {
+			LOGw("Failed to add item %i", i);
+			return false;
+		}
+	}
+	if (queue.add(item) != ERR_NO_SPACE) {
+		LOGw("Queue should be full");
+		return false;
+	}
+
+	// A remove operation of the same type and id is the same item.
+	cs_state_store_queue_t* found = queue.find(CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE, item.type, 3);
+	if (found == nullptr || found->id != 3) {
+		LOGw("Item not found");
+		return false;
+	}
+	queue.setDeadline(found, 100000);
+	if (queue.find(CS_STATE_QUEUE_OP_GC, item.type, 3) != nullptr) {
+		LOGw("Found item with other operation");
+		return false;
+	}
+
+	uint32_t lastDeadline = 0;
+	while (!queue.empty()) {
+		cs_state_store_queue_t* front = queue.front();
+		if (static_cast<int32_t>(front->deadline - lastDeadline) < 0) {
+			LOGw("Wrong order: %u after %u", front->deadline, lastDeadline);
+			return false;
+		}
+		lastDeadline = front->deadline;
+		queue.remove(front);
+	}
+	if (lastDeadline != 100000) {
+		LOGw("Item with moved deadline should be last");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Flood the queue of state with throttled writes.
+ */
+bool testThrottledFlood(State& state) {
+	CS_TYPE type = CS_TYPE::STATE_BEHAVIOUR_RULE;
+	std::vector<uint8_t> value(TypeSize(type), 0);
+	uint32_t periodSeconds = 1;
+
+	for (int round = 0; round < 10; ++round) {
+		for (int id = 0; id < STATE_STORE_QUEUE_SIZE; ++id) {
+			value[0] = round;
+			cs_state_data_t data(type, id, value.data(), value.size());
+			cs_ret_code_t retCode = state.setThrottled(data, periodSeconds);
+			if (retCode != ERR_SUCCESS && retCode != ERR_SUCCESS_NO_CHANGE) {
+				LOGw("setThrottled failed round=%i id=%i retCode=%u", round, id, retCode);
+				return false;
+			}
+		}
+	}
+
+	// All ids are queued, so a new id doesn't fit.
+	cs_state_data_t data(type, STATE_STORE_QUEUE_SIZE, value.data(), value.size());
+	if (state.setThrottled(data, periodSeconds) != ERR_NO_SPACE) {
+		LOGw("Queue should be full");
+		return false;
+	}
+
+	// After two periods, all items should be executed and removed.
+	tick(2 * (periodSeconds * 1000 / TICK_INTERVAL_MS + 2));
+	value[0] = 0xFF;
+	if (state.setThrottled(data, periodSeconds) != ERR_SUCCESS) {
+		LOGw("Queue should be empty");
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+
+	storage.init();
+	state.init(&board);
+	state.startWritesToFlash();
+
+	if (!testQueueOrder()) {
+		return 1;
+	}
+	if (!testThrottledFlood(state)) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <storage/cs_StateValuePool.h>
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+int main() {
+	StateValuePool pool;
+
+	cout << "Check that padding is set to 0xFF." << endl;
+	uint8_t* value = pool.allocate(5);
+	assert(value != nullptr);
+	assert(value[5] == 0xFF && value[6] == 0xFF && value[7] == 0xFF);
+	assert(pool.getStats().usedBytes == 5);
+	pool.free(value, 5);
+	assert(pool.getStats().usedBytes == 0);
+
+	cout << "Check that small values share a slab." << endl;
+	vector<uint8_t*> values;
+	values.push_back(pool.allocate(4));
+	*values.back()              = 0;
+	uint32_t numHeapAllocations = pool.getStats().numHeapAllocations;
+	for (int i = 1; i < 8; ++i) {
+		values.push_back(pool.allocate(4));
+		*values.back() = i;
+	}
+	assert(pool.getStats().numHeapAllocations == numHeapAllocations);
+	for (int i = 0; i < 8; ++i) {
+		assert(*values[i] == i);
+	}
+	assert(pool.getStats().usedBytes == 8 * 4);
+	assert(pool.getStats().peakUsedBytes == 8 * 4);
+
+	cout << "Check that freed slots are reused." << endl;
+	uint8_t* freed = values[3];
+	pool.free(freed, 4);
+	values[3] = pool.allocate(4);
+	assert(values[3] == freed);
+	assert(pool.getStats().numHeapAllocations == numHeapAllocations);
+
+	cout << "Check that large values are allocated on the heap." << endl;
+	uint32_t reservedBytes = pool.getStats().reservedBytes;
+	uint8_t* large         = pool.allocate(130);
+	assert(large != nullptr);
+	assert(pool.getStats().reservedBytes == reservedBytes + 132);
+	pool.free(large, 130);
+	assert(pool.getStats().reservedBytes == reservedBytes);
+
+	cout << "Check that empty slabs are freed, except for the last one." << endl;
+	for (int i = 0; i < 100; ++i) {
+		values.push_back(pool.allocate(4));
+	}
+	assert(pool.getStats().reservedBytes > reservedBytes);
+	for (auto ptr : values) {
+		pool.free(ptr, 4);
+	}
+	assert(pool.getStats().usedBytes == 0);
+	assert(pool.getStats().reservedBytes == reservedBytes);
+	assert(pool.getStats().peakUsedBytes == 108 * 4);
+
+	cout << "Done." << endl;
+	return 0;
+}
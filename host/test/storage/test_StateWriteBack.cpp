@@ -0,0 +1,87 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <events/cs_EventDispatcher.h>
+#include <storage/cs_State.h>
+
+void tick(int numTicks) {
+	TYPIFY(EVT_TICK) tickCount = 0;
+	for (int i = 0; i < numTicks; ++i) {
+		event_t tickEvent(CS_TYPE::EVT_TICK, &tickCount, sizeof(tickCount));
+		EventDispatcher::getInstance().dispatch(tickEvent);
+	}
+}
+
+bool isInFlash(Storage& storage, CS_TYPE type) {
+	cs_state_id_t id;
+	return storage.findFirst(type, id) == ERR_SUCCESS;
+}
+
+int main() {
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+
+	storage.init();
+	state.init(&board);
+	state.startWritesToFlash();
+
+	// Set the same value many times, it should only be written once.
+	TYPIFY(CONFIG_BOOT_DELAY) bootDelay = 0;
+	for (int i = 0; i < 50; ++i) {
+		bootDelay = 100 + i;
+		cs_state_data_t data(CS_TYPE::CONFIG_BOOT_DELAY, reinterpret_cast<uint8_t*>(&bootDelay), sizeof(bootDelay));
+		if (state.setWriteBack(data) != ERR_SUCCESS) {
+			LOGw("setWriteBack failed");
+			return 1;
+		}
+		tick(1);
+	}
+
+	if (isInFlash(storage, CS_TYPE::CONFIG_BOOT_DELAY)) {
+		LOGw("Value should not be written before the write-back delay");
+		return 1;
+	}
+
+	tick(STATE_WRITE_BACK_DELAY_MS / TICK_INTERVAL_MS + 1);
+
+	if (!isInFlash(storage, CS_TYPE::CONFIG_BOOT_DELAY)) {
+		LOGw("Value should be written after the write-back delay");
+		return 1;
+	}
+
+	TYPIFY(CONFIG_BOOT_DELAY) storedBootDelay = 0;
+	state.get(CS_TYPE::CONFIG_BOOT_DELAY, &storedBootDelay, sizeof(storedBootDelay));
+	if (storedBootDelay != bootDelay) {
+		LOGw("Expected %u, got %u", bootDelay, storedBootDelay);
+		return 1;
+	}
+
+	const cs_state_write_back_stats_t& stats = state.getWriteBackStats();
+	if (stats.numWrites != 1 || stats.numCoalesced != 49) {
+		LOGw("Wrong stats: writes=%u coalesced=%u", stats.numWrites, stats.numCoalesced);
+		return 1;
+	}
+
+	// A brownout should write dirty values immediately.
+	TYPIFY(CONFIG_MAX_CHIP_TEMP) maxChipTemp = 70;
+	cs_state_data_t data(CS_TYPE::CONFIG_MAX_CHIP_TEMP, reinterpret_cast<uint8_t*>(&maxChipTemp), sizeof(maxChipTemp));
+	state.setWriteBack(data);
+	event_t brownoutEvent(CS_TYPE::EVT_BROWNOUT_IMPENDING);
+	EventDispatcher::getInstance().dispatch(brownoutEvent);
+
+	if (!isInFlash(storage, CS_TYPE::CONFIG_MAX_CHIP_TEMP)) {
+		LOGw("Value should be written on brownout");
+		return 1;
+	}
+
+	return 0;
+}
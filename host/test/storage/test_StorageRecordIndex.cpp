@@ -0,0 +1,145 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <logging/cs_Logger.h>
+#include <storage/cs_StorageRecordIndex.h>
+
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+/**
+ * Checks the index of flash records that Storage uses when built with BUILD_FLASH_RECORD_INDEX, against a map of
+ * record key and file id to record id.
+ */
+
+#define NUM_RECORD_KEYS 20
+#define NUM_FILE_IDS 10
+#define NUM_RECORDS 300
+#define NUM_OPERATIONS 5000
+
+typedef std::map<std::pair<uint16_t, uint16_t>, uint32_t> reference_index_t;
+
+fds_record_desc_t getRecordDesc(uint32_t recordId) {
+	fds_record_desc_t recordDesc = {};
+	recordDesc.record_id         = recordId;
+	return recordDesc;
+}
+
+/**
+ * Record keys and file ids start at 1, 0 is not used by Storage. Also look up one more, that is never indexed.
+ */
+bool checkIndex(StorageRecordIndex& index, const reference_index_t& reference) {
+	if (index.size() != reference.size()) {
+		LOGw("Size %u instead of %u", index.size(), reference.size());
+		return false;
+	}
+	for (uint16_t recordKey = 1; recordKey <= NUM_RECORD_KEYS + 1; ++recordKey) {
+		for (uint16_t fileId = 1; fileId <= NUM_FILE_IDS + 1; ++fileId) {
+			auto iter                              = reference.find({recordKey, fileId});
+			cs_storage_record_index_entry_t* entry = index.find(recordKey, fileId);
+			if (iter == reference.end() ? entry != nullptr
+										: (entry == nullptr || entry->recordDesc.record_id != iter->second)) {
+				LOGw("Wrong entry for key=%u file=%u", recordKey, fileId);
+				return false;
+			}
+		}
+
+		// The search should go over the files of the record key, in order.
+		index.initSearch();
+		auto iter = reference.lower_bound({recordKey, 0});
+		for (cs_storage_record_index_entry_t* entry = index.findNext(recordKey); entry != nullptr;
+			 entry                                  = index.findNext(recordKey)) {
+			if (iter == reference.end() || iter->first.first != recordKey || entry->recordKey != recordKey
+				|| entry->fileId != iter->first.second) {
+				LOGw("Wrong search result for key=%u", recordKey);
+				return false;
+			}
+			++iter;
+		}
+		if (iter != reference.end() && iter->first.first == recordKey) {
+			LOGw("Search for key=%u stopped early", recordKey);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Build the index like Storage does at init: records in flash order, with duplicates of which the last is valid.
+ */
+bool testBuild(StorageRecordIndex& index, reference_index_t& reference) {
+	uint16_t numDuplicates = 0;
+	index.clear();
+	reference.clear();
+	for (uint32_t recordId = 1; recordId <= NUM_RECORDS; ++recordId) {
+		uint16_t recordKey = 1 + rand() % NUM_RECORD_KEYS;
+		uint16_t fileId    = 1 + rand() % NUM_FILE_IDS;
+		if (reference.count({recordKey, fileId})) {
+			numDuplicates++;
+		}
+		index.append(recordKey, fileId, getRecordDesc(recordId));
+		reference[{recordKey, fileId}] = recordId;
+	}
+	if (index.sort() != numDuplicates) {
+		LOGw("Wrong number of duplicates removed");
+		return false;
+	}
+	return checkIndex(index, reference);
+}
+
+/**
+ * Apply the changes of the FDS events: written records, removed records, and removed files.
+ */
+bool testUpdates(StorageRecordIndex& index, reference_index_t& reference) {
+	uint32_t recordId = NUM_RECORDS + 1;
+	for (int i = 0; i < NUM_OPERATIONS; ++i) {
+		uint16_t recordKey = 1 + rand() % NUM_RECORD_KEYS;
+		uint16_t fileId    = 1 + rand() % NUM_FILE_IDS;
+		switch (rand() % 10) {
+			case 0: {
+				index.removeFile(fileId);
+				for (auto iter = reference.begin(); iter != reference.end();) {
+					iter = (iter->first.second == fileId) ? reference.erase(iter) : std::next(iter);
+				}
+				break;
+			}
+			case 1:
+			case 2:
+			case 3:
+			case 4: {
+				index.remove(recordKey, fileId);
+				reference.erase({recordKey, fileId});
+				break;
+			}
+			default: {
+				index.add(recordKey, fileId, getRecordDesc(recordId));
+				reference[{recordKey, fileId}] = recordId;
+				recordId++;
+				break;
+			}
+		}
+		if (!checkIndex(index, reference)) {
+			LOGw("After operation %i", i);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	StorageRecordIndex index;
+	reference_index_t reference;
+	if (!testBuild(index, reference)) {
+		return 1;
+	}
+	if (!testUpdates(index, reference)) {
+		return 1;
+	}
+	return 0;
+}
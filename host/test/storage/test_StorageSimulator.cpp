@@ -0,0 +1,294 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <behaviour/cs_BehaviourStore.h>
+#include <boards/cs_HostBoardFullyFeatured.h>
+#include <drivers/cs_FdsSimulator.h>
+#include <events/cs_EventDispatcher.h>
+#include <events/cs_EventListener.h>
+#include <storage/cs_State.h>
+
+#include <iostream>
+#include <vector>
+
+/**
+ * Benchmarks State on top of the FDS simulator, so that writes take time, record keys are busy, the FDS queue fills
+ * up, and garbage collection is needed. Time is virtual, so the results are deterministic.
+ */
+
+#define NUM_IDS 16
+#define NUM_ROUNDS 8
+#define MAX_TICKS 10000
+
+class FactoryResetListener : public EventListener {
+public:
+	bool _done = false;
+
+	void handleEvent(event_t& event) override {
+		if (event.type == CS_TYPE::EVT_STATE_FACTORY_RESET_DONE) {
+			_done = true;
+		}
+	}
+};
+
+/**
+ * Lets a tick interval pass: both State and the simulator get to do their work.
+ */
+void tick() {
+	TYPIFY(EVT_TICK) tickCount = 0;
+	event_t tickEvent(CS_TYPE::EVT_TICK, &tickCount, sizeof(tickCount));
+	EventDispatcher::getInstance().dispatch(tickEvent);
+	FdsSimulator::getInstance().advance(TICK_INTERVAL_MS);
+}
+
+/**
+ * Check whether the value with given id has been stored in flash.
+ */
+bool isStored(CS_TYPE type, cs_state_id_t id, uint8_t expectedValue) {
+	std::vector<uint8_t> value(TypeSize(type), 0);
+	cs_state_data_t data(type, id, value.data(), value.size());
+	if (Storage::getInstance().read(data) != ERR_SUCCESS) {
+		return false;
+	}
+	return value[0] == expectedValue;
+}
+
+/**
+ * Tick until all values are stored in flash.
+ *
+ * @return Number of ticks it took, or -1 on timeout.
+ */
+int tickUntilStored(CS_TYPE type, uint8_t expectedValue) {
+	for (int ticks = 0; ticks < MAX_TICKS; ++ticks) {
+		bool allStored = !Storage::getInstance().isBusy();
+		for (cs_state_id_t id = 0; allStored && id < NUM_IDS; ++id) {
+			allStored = isStored(type, id, expectedValue);
+		}
+		if (allStored) {
+			return ticks;
+		}
+		tick();
+	}
+	return -1;
+}
+
+void printStats(const char* name, int ticks) {
+	FdsSimulator& simulator         = FdsSimulator::getInstance();
+	const cs_storage_stats_t& stats = Storage::getInstance().getStats();
+	std::cout << name << ": ticks=" << ticks << " virtualTimeMs=" << simulator.getTimeMs()
+			  << " writes=" << stats.numWrites << " removes=" << stats.numRemoves
+			  << " garbageCollections=" << stats.numGarbageCollections
+			  << " garbageCollectionTotalMs=" << stats.garbageCollectionTotalMs
+			  << " pageErases=" << simulator.getNumPageErases()
+			  << " wordsWritten=" << simulator.getNumWordsWritten() << std::endl;
+}
+
+/**
+ * Set many values at once, multiple rounds, so that record keys are busy, and garbage has to be collected.
+ *
+ * Each round is stored before the next one starts, else the writes of a value would be coalesced, and no garbage
+ * would be left behind.
+ */
+bool testWriteBurst(State& state) {
+	CS_TYPE type = CS_TYPE::STATE_BEHAVIOUR_RULE;
+	std::vector<uint8_t> value(TypeSize(type), 0);
+	int ticks    = 0;
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		for (cs_state_id_t id = 0; id < NUM_IDS; ++id) {
+			value[0] = round;
+			cs_state_data_t data(type, id, value.data(), value.size());
+			if (state.set(data) != ERR_SUCCESS) {
+				std::cout << "set failed round=" << round << " id=" << (int)id << std::endl;
+				return false;
+			}
+		}
+		int roundTicks = tickUntilStored(type, round);
+		if (roundTicks < 0) {
+			std::cout << "Write burst not stored round=" << round << std::endl;
+			return false;
+		}
+		ticks += roundTicks;
+	}
+	printStats("Write burst", ticks);
+	if (Storage::getInstance().getStats().numGarbageCollections == 0) {
+		std::cout << "Write burst should need garbage collection" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Tick until storage is no longer busy.
+ */
+void tickUntilNotBusy() {
+	for (int ticks = 0; ticks < MAX_TICKS && Storage::getInstance().isBusy(); ++ticks) {
+		tick();
+	}
+}
+
+/**
+ * Set many values throttled, only the last value of each id should be written.
+ *
+ * The first throttled set of a value writes it right away, which fails with ERR_BUSY while another value of the same
+ * type is being written. So the first round waits for each write to finish, and the period is long enough for the
+ * other rounds to be throttled.
+ */
+bool testThrottledWrites(State& state) {
+	CS_TYPE type = CS_TYPE::STATE_BEHAVIOUR_RULE;
+	std::vector<uint8_t> value(TypeSize(type), 0);
+	uint32_t numWritesBefore = Storage::getInstance().getStats().numWrites;
+	uint32_t periodSeconds   = 60;
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		for (cs_state_id_t id = 0; id < NUM_IDS; ++id) {
+			value[0] = 100 + round;
+			cs_state_data_t data(type, id, value.data(), value.size());
+			cs_ret_code_t retCode = state.setThrottled(data, periodSeconds);
+			if (retCode != ERR_SUCCESS && retCode != ERR_SUCCESS_NO_CHANGE) {
+				std::cout << "setThrottled failed round=" << round << " id=" << (int)id << std::endl;
+				return false;
+			}
+			if (round == 0) {
+				tickUntilNotBusy();
+			}
+		}
+		tick();
+	}
+	int ticks = tickUntilStored(type, 100 + NUM_ROUNDS - 1);
+	printStats("Throttled writes", ticks);
+	if (ticks < 0) {
+		std::cout << "Throttled writes not stored" << std::endl;
+		return false;
+	}
+	uint32_t numWrites = Storage::getInstance().getStats().numWrites - numWritesBefore;
+	if (numWrites > 2 * NUM_IDS) {
+		std::cout << "Too many writes for throttled values: " << numWrites << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool testFactoryReset() {
+	FactoryResetListener listener;
+	listener.listen();
+
+	event_t resetEvent(CS_TYPE::CMD_FACTORY_RESET);
+	resetEvent.dispatch();
+	int ticks = 0;
+	while (!listener._done && ticks < MAX_TICKS) {
+		tick();
+		ticks++;
+	}
+	printStats("Factory reset", ticks);
+	if (!listener._done) {
+		std::cout << "Factory reset not done" << std::endl;
+		return false;
+	}
+	for (cs_state_id_t id = 0; id < NUM_IDS; ++id) {
+		if (isStored(CS_TYPE::STATE_BEHAVIOUR_RULE, id, 100 + NUM_ROUNDS - 1)) {
+			std::cout << "Value not removed by factory reset id=" << (int)id << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Check whether the value with given id has been removed from flash.
+ */
+bool isRemoved(CS_TYPE type, cs_state_id_t id) {
+	std::vector<uint8_t> value(TypeSize(type), 0);
+	cs_state_data_t data(type, id, value.data(), value.size());
+	return Storage::getInstance().read(data) == ERR_NOT_FOUND;
+}
+
+/**
+ * Store a value for every behaviour, then remove them all at once, like clearing all behaviours does.
+ *
+ * All but the first removal find the record key busy, so they are queued: the queue should fit them all.
+ */
+bool testRemoveBurst(State& state) {
+	CS_TYPE type     = CS_TYPE::STATE_BEHAVIOUR_RULE;
+	int numIds       = BehaviourStore::MaxBehaviours;
+	std::vector<uint8_t> value(TypeSize(type), 0);
+	value[0] = 200;
+	for (cs_state_id_t id = 0; id < numIds; ++id) {
+		cs_state_data_t data(type, id, value.data(), value.size());
+		if (state.set(data) != ERR_SUCCESS) {
+			std::cout << "set failed id=" << (int)id << std::endl;
+			return false;
+		}
+	}
+	int ticks = 0;
+	for (cs_state_id_t id = 0; id < numIds; ++id) {
+		while (!isStored(type, id, value[0]) && ticks < MAX_TICKS) {
+			tick();
+			ticks++;
+		}
+	}
+	tickUntilNotBusy();
+	for (cs_state_id_t id = 0; id < numIds; ++id) {
+		if (!isStored(type, id, value[0])) {
+			std::cout << "Value not stored id=" << (int)id << std::endl;
+			return false;
+		}
+	}
+
+	for (cs_state_id_t id = 0; id < numIds; ++id) {
+		if (state.remove(type, id) != ERR_SUCCESS) {
+			std::cout << "remove failed id=" << (int)id << std::endl;
+			return false;
+		}
+	}
+	ticks = 0;
+	for (cs_state_id_t id = 0; id < numIds; ++id) {
+		while (!isRemoved(type, id) && ticks < MAX_TICKS) {
+			tick();
+			ticks++;
+		}
+	}
+	printStats("Remove burst", ticks);
+	for (cs_state_id_t id = 0; id < numIds; ++id) {
+		if (!isRemoved(type, id)) {
+			std::cout << "Value not removed id=" << (int)id << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	Storage& storage = Storage::getInstance();
+	State& state     = State::getInstance();
+
+	boards_config_t board;
+	init(&board);
+	asHostFullyFeatured(&board);
+
+	// Small pages, so that garbage collection is needed.
+	fds_simulator_config_t config;
+	config.numPages      = 3;
+	config.pageSizeWords = 256;
+	FdsSimulator::getInstance().enable(config);
+
+	storage.init();
+	state.init(&board);
+	state.startWritesToFlash();
+
+	if (!testWriteBurst(state)) {
+		return 1;
+	}
+	if (!testThrottledWrites(state)) {
+		return 1;
+	}
+	if (!testFactoryReset()) {
+		return 1;
+	}
+	if (!testRemoveBurst(state)) {
+		return 1;
+	}
+	return 0;
+}
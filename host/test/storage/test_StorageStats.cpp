@@ -0,0 +1,56 @@
+#include <storage/cs_StorageStats.h>
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+uint32_t getTypeWrites(StorageStats& stats, CS_TYPE type) {
+	for (auto& typeStats : stats.getStats().typeStats) {
+		if (typeStats.type == to_underlying_type(type)) {
+			return typeStats.numWrites;
+		}
+	}
+	return 0;
+}
+
+int main() {
+	StorageStats stats;
+
+	cout << "Check latency bins." << endl;
+	assert(StorageStats::getLatencyBin(0) == 0);
+	assert(StorageStats::getLatencyBin(1) == 1);
+	assert(StorageStats::getLatencyBin(3) == 2);
+	assert(StorageStats::getLatencyBin(4) == 3);
+	assert(StorageStats::getLatencyBin(0xFFFFFFFF) == STORAGE_STATS_LATENCY_BINS - 1);
+	stats.onOperationDone(5);
+	assert(stats.getStats().latencyHistogram[3] == 1);
+
+	cout << "Check writes and removes per type." << endl;
+	for (int i = 0; i < 100; ++i) {
+		stats.onWrite(CS_TYPE::STATE_BEHAVIOUR_RULE);
+	}
+	stats.onRemove(CS_TYPE::STATE_BEHAVIOUR_RULE);
+	assert(stats.getStats().numWrites == 100);
+	assert(stats.getStats().numRemoves == 1);
+	assert(getTypeWrites(stats, CS_TYPE::STATE_BEHAVIOUR_RULE) == 100);
+
+	cout << "Check that the type with most writes stays in the table." << endl;
+	for (uint16_t type = 1; type < 100; ++type) {
+		if (type != to_underlying_type(CS_TYPE::STATE_BEHAVIOUR_RULE)) {
+			stats.onWrite(static_cast<CS_TYPE>(type));
+		}
+	}
+	assert(getTypeWrites(stats, CS_TYPE::STATE_BEHAVIOUR_RULE) == 100);
+
+	cout << "Check garbage collection." << endl;
+	stats.onGarbageCollectionDone(80, 1024);
+	stats.onGarbageCollectionDone(20, 512);
+	assert(stats.getStats().numGarbageCollections == 2);
+	assert(stats.getStats().garbageCollectionTotalMs == 100);
+	assert(stats.getStats().garbageCollectionMaxMs == 80);
+	assert(stats.getStats().garbageCollectionReclaimedBytes == 1536);
+
+	cout << "Done." << endl;
+	return 0;
+}
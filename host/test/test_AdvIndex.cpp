@@ -0,0 +1,184 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_Utils.h>
+#include <utils/cs_Benchmark.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Checks that lookups via the AD structure index give the same results as parsing the advertisement data, for random
+ * and malformed advertisements, and for ones that don't fit in the index.
+ */
+
+#define NUM_ADVERTISEMENTS 1000
+#define NUM_ROUNDS 200
+#define MAX_ADV_LEN 31
+
+// Number of asset filters that each look up a field.
+#define NUM_ASSET_FILTERS 4
+
+// Types looked up per scanned device: command adv (2x), background adv (2x), asset filters, microapp.
+const uint8_t lookupTypes[] = {
+		BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE,
+		BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE,
+		BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE,
+		BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+		BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+		BLE_GAP_AD_TYPE_SERVICE_DATA,
+		BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME,
+		BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+		BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME,
+		BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME,
+};
+const int numLookupTypes = sizeof(lookupTypes) / sizeof(lookupTypes[0]);
+
+struct advertisement_t {
+	uint8_t dataSize;
+	uint8_t data[MAX_ADV_LEN];
+};
+
+/**
+ * Make an advertisement of AD structures with random types and lengths.
+ * Some have many small structures, so that they don't fit in the index, and some are malformed.
+ */
+advertisement_t makeAdvertisement() {
+	advertisement_t adv = {};
+	uint8_t maxFieldLen = (rand() % 3 == 0) ? 2 : 10;
+	while (adv.dataSize < MAX_ADV_LEN - 1) {
+		uint8_t fieldLen = 1 + rand() % maxFieldLen;
+		if (rand() % 20 == 0) {
+			// Malformed: length 0, or longer than the remaining data.
+			fieldLen = (rand() % 2) ? 0 : MAX_ADV_LEN;
+		}
+		else if (adv.dataSize + 1 + fieldLen > MAX_ADV_LEN) {
+			break;
+		}
+		adv.data[adv.dataSize]     = fieldLen;
+		adv.data[adv.dataSize + 1] = (rand() % 2) ? lookupTypes[rand() % numLookupTypes] : rand() % 256;
+		for (uint8_t i = 2; i <= fieldLen && adv.dataSize + i < MAX_ADV_LEN; ++i) {
+			adv.data[adv.dataSize + i] = rand() % 256;
+		}
+		if (fieldLen == 0 || adv.dataSize + 1 + fieldLen > MAX_ADV_LEN) {
+			adv.dataSize = MAX_ADV_LEN;
+			break;
+		}
+		adv.dataSize += fieldLen + 1;
+	}
+	return adv;
+}
+
+scanned_device_t makeScannedDevice(advertisement_t& adv, const adv_index_t* advIndex) {
+	scanned_device_t device = {};
+	device.dataSize         = adv.dataSize;
+	device.data             = adv.data;
+	device.advIndex         = advIndex;
+	return device;
+}
+
+bool checkLookups(advertisement_t& adv) {
+	adv_index_t advIndex;
+	CsUtils::indexAdvTypes(adv.data, adv.dataSize, advIndex);
+	scanned_device_t device = makeScannedDevice(adv, &advIndex);
+	for (int type = 0; type < 256; ++type) {
+		cs_data_t expected;
+		cs_data_t result;
+		cs_ret_code_t expectedRetCode = CsUtils::findAdvType(type, adv.data, adv.dataSize, &expected);
+		cs_ret_code_t retCode         = CsUtils::findAdvType(type, device, &result);
+		if (retCode != expectedRetCode || result.data != expected.data || result.len != expected.len) {
+			std::cout << "Lookup of type " << type << " differs: retCode=" << retCode << " len=" << (int)result.len
+					  << " expected retCode=" << expectedRetCode << " len=" << (int)expected.len << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Do the lookups the scan handlers do, and return the total length of the found data.
+ */
+int64_t handleAdvertisement(advertisement_t& adv, bool indexed) {
+	adv_index_t advIndex;
+	if (indexed) {
+		CsUtils::indexAdvTypes(adv.data, adv.dataSize, advIndex);
+	}
+	scanned_device_t device = makeScannedDevice(adv, indexed ? &advIndex : nullptr);
+	int64_t foundLen        = 0;
+	for (int i = 0; i < numLookupTypes; ++i) {
+		cs_data_t result;
+		if (CsUtils::findAdvType(lookupTypes[i], device, &result) == ERR_SUCCESS) {
+			foundLen += result.len;
+		}
+	}
+	return foundLen;
+}
+
+/**
+ * Make an advertisement with a single AD structure of given length, followed by one of length 1.
+ */
+advertisement_t makeSingleFieldAdvertisement(uint8_t fieldLen, uint8_t dataSize) {
+	advertisement_t adv = {};
+	adv.data[0]         = fieldLen;
+	adv.data[1]         = BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME;
+	if (fieldLen + 3 < MAX_ADV_LEN) {
+		adv.data[fieldLen + 1] = 1;
+		adv.data[fieldLen + 2] = BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME;
+	}
+	adv.dataSize = dataSize;
+	return adv;
+}
+
+int main() {
+	srand(1);
+	std::vector<advertisement_t> advertisements;
+	for (int i = 0; i < NUM_ADVERTISEMENTS; ++i) {
+		advertisements.push_back(makeAdvertisement());
+		if (!checkLookups(advertisements.back())) {
+			return 1;
+		}
+	}
+
+	// An empty advertisement, and one that doesn't fit in the index.
+	advertisement_t adv = {};
+	if (!checkLookups(adv)) {
+		return 1;
+	}
+	for (uint8_t i = 0; i < MAX_ADV_LEN - 1; i += 2) {
+		adv.data[i]     = 1;
+		adv.data[i + 1] = i;
+	}
+	adv.dataSize = MAX_ADV_LEN - 1;
+	if (!checkLookups(adv)) {
+		return 1;
+	}
+
+	// A structure of length 0, one that ends exactly at the end of the data, one that is longer than the data, and
+	// one of which only the length byte fits.
+	for (auto fieldAdv : {makeSingleFieldAdvertisement(0, 10),
+						  makeSingleFieldAdvertisement(9, 10),
+						  makeSingleFieldAdvertisement(10, 10),
+						  makeSingleFieldAdvertisement(5, 1)}) {
+		if (!checkLookups(fieldAdv)) {
+			return 1;
+		}
+	}
+
+	int numCalls           = NUM_ROUNDS * NUM_ADVERTISEMENTS;
+	int64_t parsedFoundLen = printBenchmark("Parsed per lookup", numCalls, [&](int i) {
+		return handleAdvertisement(advertisements[i % NUM_ADVERTISEMENTS], false);
+	});
+	int64_t indexedFoundLen = printBenchmark("Indexed once", numCalls, [&](int i) {
+		return handleAdvertisement(advertisements[i % NUM_ADVERTISEMENTS], true);
+	});
+	if (parsedFoundLen != indexedFoundLen) {
+		std::cout << "Found " << indexedFoundLen << " bytes, expected " << parsedFoundLen << std::endl;
+		return 1;
+	}
+	return 0;
+}
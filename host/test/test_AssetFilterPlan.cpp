@@ -0,0 +1,342 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_AssetFilter.h>
+#include <util/cs_AssetFilterPlan.h>
+#include <util/cs_Utils.h>
+#include <utils/cs_Benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+/**
+ * Checks that the filter plan gives the same result as checking every filter on its own, for filters that share
+ * inputs, and for cuckoo filters with different hash versions on the same input.
+ */
+
+#define NUM_DEVICES 500
+#define NUM_ROUNDS 40
+#define ADV_LEN 20
+#define KEYS_PER_FILTER 10
+#define FILTER_BUFFER_SIZE 200
+
+#define AD_TYPE_NAME 0x09
+#define AD_TYPE_MANUFACTURER 0xFF
+
+struct test_device_t {
+	uint8_t address[MAC_ADDRESS_LEN];
+	uint8_t data[ADV_LEN];
+};
+
+/**
+ * Make a device with a name and manufacturer data, from a small set of values so that filters match now and then.
+ */
+test_device_t makeDevice() {
+	test_device_t device;
+	for (auto& byte : device.address) {
+		byte = rand() % 2;
+	}
+	device.data[0] = 7;
+	device.data[1] = AD_TYPE_NAME;
+	for (int i = 2; i < 8; ++i) {
+		device.data[i] = 'a' + rand() % 2;
+	}
+	device.data[8] = ADV_LEN - 9;
+	device.data[9] = AD_TYPE_MANUFACTURER;
+	for (int i = 10; i < ADV_LEN; ++i) {
+		device.data[i] = rand() % 2;
+	}
+	return device;
+}
+
+scanned_device_t toScannedDevice(test_device_t& device) {
+	scanned_device_t scannedDevice = {};
+	memcpy(scannedDevice.address, device.address, sizeof(device.address));
+	scannedDevice.dataSize = ADV_LEN;
+	scannedDevice.data     = device.data;
+	return scannedDevice;
+}
+
+/**
+ * Write the input description to the buffer, and return its size.
+ */
+size_t writeInput(uint8_t* buffer, AssetFilterInputType inputType) {
+	buffer[0] = static_cast<uint8_t>(inputType);
+	switch (inputType) {
+		case AssetFilterInputType::MacAddress: return 1;
+		case AssetFilterInputType::AdDataType: {
+			buffer[1] = AD_TYPE_NAME;
+			return 2;
+		}
+		case AssetFilterInputType::MaskedAdDataType: {
+			buffer[1]     = AD_TYPE_MANUFACTURER;
+			uint32_t mask = 0x3F;
+			memcpy(buffer + 2, &mask, sizeof(mask));
+			return 6;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Make a filter with the input of given type, that contains the inputs of the given devices.
+ */
+uint8_t* makeFilter(
+		AssetFilterType filterType,
+		AssetFilterInputType inputType,
+		bool exclude,
+		bool fnv1aHash,
+		std::vector<test_device_t> devices) {
+	uint8_t* buffer = new uint8_t[FILTER_BUFFER_SIZE]();
+	AssetFilter filter(buffer);
+	uint8_t* metadata = filter.filterdata()._data;
+	metadata[0]       = static_cast<uint8_t>(filterType);
+	metadata[1]       = (exclude ? 1 : 0) | (fnv1aHash ? 2 : 0);
+	size_t index      = 3 + writeInput(metadata + 3, inputType);
+	metadata[index]   = static_cast<uint8_t>(AssetFilterOutputFormat::None);
+
+	std::vector<std::vector<uint8_t>> keys;
+	for (auto& device : devices) {
+		scanned_device_t scannedDevice = toScannedDevice(device);
+		uint8_t keyBuffer[AssetFilter::MAX_INPUT_SIZE];
+		cs_const_data_t key;
+		AssetFilter::getInputData(scannedDevice, filter.filterdata().metadata().inputType(), keyBuffer, key);
+		keys.emplace_back(key.data, key.data + key.len);
+	}
+
+	if (filterType == AssetFilterType::CuckooFilter) {
+		CuckooFilter cuckoo = filter.filterdata().cuckooFilter();
+		cuckoo.init(16, 2);
+		for (auto& key : keys) {
+			cuckoo.add(key.data(), key.size());
+		}
+	}
+	else {
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+		uint8_t* exact = metadata + filter.filterdata().metadata().length();
+		exact[0]       = keys.size();
+		exact[1]       = keys[0].size();
+		for (size_t i = 0; i < keys.size(); ++i) {
+			memcpy(exact + 2 + i * keys[i].size(), keys[i].data(), keys[i].size());
+		}
+	}
+	return buffer;
+}
+
+/**
+ * Make a filter that contains the inputs of some random devices.
+ */
+uint8_t* makeRandomFilter(AssetFilterType filterType, AssetFilterInputType inputType, bool exclude, bool fnv1aHash) {
+	std::vector<test_device_t> devices;
+	for (int i = 0; i < KEYS_PER_FILTER; ++i) {
+		devices.push_back(makeDevice());
+	}
+	return makeFilter(filterType, inputType, exclude, fnv1aHash, devices);
+}
+
+/**
+ * Like AssetFiltering did before the filter plan: check every filter.
+ *
+ * @return Bitmask of the exclude filters that accept the device.
+ */
+uint8_t evaluateEachFilter(std::vector<uint8_t*>& filters, const scanned_device_t& device, uint8_t& acceptingFilters) {
+	uint8_t rejectingFilters = 0;
+	acceptingFilters         = 0;
+	for (uint8_t i = 0; i < filters.size(); ++i) {
+		AssetFilter filter(filters[i]);
+		if (filter.filterAcceptsScannedDevice(device)) {
+			if (filter.filterdata().metadata().flags()->flags.exclude) {
+				CsUtils::setBit(rejectingFilters, i);
+			}
+			else {
+				CsUtils::setBit(acceptingFilters, i);
+			}
+		}
+	}
+	return rejectingFilters;
+}
+
+/**
+ * Make a plan of the given filters.
+ */
+bool makePlan(AssetFilterPlan& plan, std::vector<uint8_t*>& filters) {
+	plan.clear();
+	for (auto filter : filters) {
+		if (!plan.add(AssetFilter(filter))) {
+			std::cout << "Failed to add filter" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Check that the plan gives the same result as checking every filter on its own.
+ *
+ * @param[out] rejected      Whether the device is rejected.
+ * @param[out] accepting     Bitmask of the filters that accept the device.
+ */
+bool checkDevice(
+		AssetFilterPlan& plan,
+		std::vector<uint8_t*>& filters,
+		test_device_t& testDevice,
+		bool& rejected,
+		uint8_t& accepting) {
+	scanned_device_t device = toScannedDevice(testDevice);
+	uint8_t expectedAccepting;
+	uint8_t expectedRejecting              = evaluateEachFilter(filters, device, expectedAccepting);
+	std::optional<uint8_t> rejectingFilter = plan.evaluate(device, accepting);
+	rejected                               = rejectingFilter.has_value();
+
+	// When rejected, the accepting filters are incomplete, and any of the rejecting filters may be reported.
+	bool expectedRejected = expectedRejecting != 0;
+	if (rejected != expectedRejected || (!rejected && accepting != expectedAccepting)
+		|| (rejected && !CsUtils::isBitSet(expectedRejecting, rejectingFilter.value()))) {
+		std::cout << "Device " << (int)testDevice.address[0] << ": rejected=" << rejected
+				  << " accepting=" << (int)accepting << " expected rejecting=" << (int)expectedRejecting
+				  << " accepting=" << (int)expectedAccepting << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Filters with random contents, that share inputs.
+ */
+bool testRandomFilters(AssetFilterPlan& plan) {
+	// 8 filters, with 3 distinct inputs, and both cuckoo filter hash versions.
+	std::vector<uint8_t*> filters = {
+			makeRandomFilter(AssetFilterType::CuckooFilter, AssetFilterInputType::MacAddress, false, false),
+			makeRandomFilter(AssetFilterType::CuckooFilter, AssetFilterInputType::MaskedAdDataType, false, false),
+			makeRandomFilter(AssetFilterType::ExactMatchFilter, AssetFilterInputType::MacAddress, true, false),
+			makeRandomFilter(AssetFilterType::CuckooFilter, AssetFilterInputType::MaskedAdDataType, false, true),
+			makeRandomFilter(AssetFilterType::ExactMatchFilter, AssetFilterInputType::AdDataType, false, false),
+			makeRandomFilter(AssetFilterType::CuckooFilter, AssetFilterInputType::MacAddress, false, true),
+			makeRandomFilter(AssetFilterType::CuckooFilter, AssetFilterInputType::AdDataType, false, false),
+			makeRandomFilter(AssetFilterType::CuckooFilter, AssetFilterInputType::MaskedAdDataType, false, false),
+	};
+	if (!makePlan(plan, filters)) {
+		return false;
+	}
+	if (plan.add(AssetFilter(filters[0])) || plan.getInputCount() != 3) {
+		std::cout << "Wrong number of filters or inputs: inputs=" << (int)plan.getInputCount() << std::endl;
+		return false;
+	}
+
+	std::vector<test_device_t> devices;
+	int numRejected  = 0;
+	int numAccepting = 0;
+	for (int i = 0; i < NUM_DEVICES; ++i) {
+		devices.push_back(makeDevice());
+		bool rejected;
+		uint8_t accepting;
+		if (!checkDevice(plan, filters, devices.back(), rejected, accepting)) {
+			return false;
+		}
+		numRejected += rejected;
+		numAccepting += (!rejected && accepting != 0);
+	}
+	if (numRejected == 0 || numAccepting == 0) {
+		std::cout << "Test devices don't cover rejection and acceptance" << std::endl;
+		return false;
+	}
+
+	int numCalls = NUM_ROUNDS * NUM_DEVICES;
+	printBenchmark("Each filter", numCalls, [&](int i) {
+		scanned_device_t device = toScannedDevice(devices[i % NUM_DEVICES]);
+		uint8_t accepting;
+		return evaluateEachFilter(filters, device, accepting);
+	});
+	printBenchmark("Filter plan", numCalls, [&](int i) {
+		scanned_device_t device = toScannedDevice(devices[i % NUM_DEVICES]);
+		uint8_t accepting;
+		return plan.evaluate(device, accepting).has_value();
+	});
+
+	for (auto filter : filters) {
+		delete[] filter;
+	}
+	return true;
+}
+
+/**
+ * Cuckoo filters with different hash versions on the same input, each has to be checked with the hash of its own
+ * version.
+ */
+bool testHashVersionMixing(AssetFilterPlan& plan) {
+	std::vector<test_device_t> devices;
+	for (uint8_t i = 0; i < 4; ++i) {
+		devices.push_back(makeDevice());
+		memset(devices.back().address, i + 1, MAC_ADDRESS_LEN);
+	}
+	test_device_t& deviceA = devices[0];
+	test_device_t& deviceB = devices[1];
+	test_device_t& deviceC = devices[2];
+	test_device_t& deviceD = devices[3];
+
+	AssetFilterInputType input    = AssetFilterInputType::MacAddress;
+	std::vector<uint8_t*> filters = {
+			makeFilter(AssetFilterType::CuckooFilter, input, false, false, {deviceA}),
+			makeFilter(AssetFilterType::CuckooFilter, input, false, true, {deviceA, deviceB}),
+			makeFilter(AssetFilterType::ExactMatchFilter, input, false, false, {deviceB}),
+			makeFilter(AssetFilterType::CuckooFilter, input, true, true, {deviceC}),
+			makeFilter(AssetFilterType::CuckooFilter, input, false, false, {deviceC}),
+	};
+	if (!makePlan(plan, filters)) {
+		return false;
+	}
+	if (plan.getInputCount() != 1) {
+		std::cout << "Filters should share one input: inputs=" << (int)plan.getInputCount() << std::endl;
+		return false;
+	}
+
+	struct expected_result_t {
+		test_device_t& device;
+		bool rejected;
+		uint8_t accepting;
+	};
+	expected_result_t expectedResults[] = {
+			{deviceA, false, 0b00011},
+			{deviceB, false, 0b00110},
+			{deviceC, true, 0},
+			{deviceD, false, 0},
+	};
+	for (auto& expected : expectedResults) {
+		bool rejected;
+		uint8_t accepting;
+		if (!checkDevice(plan, filters, expected.device, rejected, accepting)) {
+			return false;
+		}
+		if (rejected != expected.rejected || (!rejected && accepting != expected.accepting)) {
+			std::cout << "Device " << (int)expected.device.address[0] << ": rejected=" << rejected
+					  << " accepting=" << (int)accepting << " expected rejected=" << expected.rejected
+					  << " accepting=" << (int)expected.accepting << std::endl;
+			return false;
+		}
+	}
+
+	for (auto filter : filters) {
+		delete[] filter;
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	AssetFilterPlan plan;
+	if (!testRandomFilters(plan)) {
+		return 1;
+	}
+	if (!testHashVersionMixing(plan)) {
+		return 1;
+	}
+	return 0;
+}
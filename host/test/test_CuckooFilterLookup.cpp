@@ -0,0 +1,144 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_CuckooFilter.h>
+#include <utils/cs_Benchmark.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Checks the word compare of buckets against comparing nest by nest, for both hash versions, on filters of the sizes
+ * that fit in the asset filter store: empty, filled with MAC addresses, and after removing some of them. Also checks
+ * that looking up a key by its hash, like the asset filter plan does, gives the same result as looking up the key.
+ */
+
+#define NUM_LOOKUP_KEYS 2000
+#define NUM_ROUNDS 100
+#define KEY_LEN 6
+
+// Fraction of the nests that get filled.
+#define LOAD_FACTOR 0.9
+
+struct test_key_t {
+	uint8_t data[KEY_LEN];
+};
+
+test_key_t makeKey() {
+	test_key_t key;
+	for (auto& byte : key.data) {
+		byte = rand() % 256;
+	}
+	return key;
+}
+
+/**
+ * Look up the fingerprint of a key by comparing nest by nest, like the filter used to.
+ */
+bool containsReference(CuckooFilter& filter, cuckoo_filter_data_t* data, test_key_t& key) {
+	cuckoo_compressed_fingerprint_t fingerprint = filter.getCompressedFingerprint(key.data, KEY_LEN);
+	cuckoo_index_t bucketA                      = fingerprint.bucket;
+	cuckoo_index_t bucketB                      = (fingerprint.bucket ^ fingerprint.fingerprint) % filter.bucketCount();
+	for (auto bucket : {bucketA, bucketB}) {
+		for (int i = 0; i < data->nestsPerBucket; ++i) {
+			if (data->bucketArray[bucket * data->nestsPerBucket + i] == fingerprint.fingerprint) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * Check lookups of the given keys, and of as many random keys, against the reference.
+ *
+ * @return Number of given keys that were found.
+ */
+int checkLookups(CuckooFilter& filter, cuckoo_filter_data_t* data, std::vector<test_key_t>& keys) {
+	std::vector<test_key_t> lookupKeys = keys;
+	for (size_t i = 0; i < keys.size() || i < NUM_LOOKUP_KEYS / 2; ++i) {
+		lookupKeys.push_back(makeKey());
+	}
+	int numFound = 0;
+	for (size_t i = 0; i < lookupKeys.size(); ++i) {
+		test_key_t& key  = lookupKeys[i];
+		bool expected    = containsReference(filter, data, key);
+		bool found       = filter.contains(key.data, KEY_LEN);
+		bool foundByHash = filter.contains(CuckooFilter::hashKey(key.data, KEY_LEN, filter.hashVersion()));
+		if (found != expected || foundByHash != expected) {
+			std::cout << "Lookup differs from nest by nest compare: found=" << found << " foundByHash=" << foundByHash
+					  << " expected=" << expected << std::endl;
+			return -1;
+		}
+		numFound += (i < keys.size() && found);
+	}
+	return numFound;
+}
+
+bool testFilter(cuckoo_index_t bucketCount, cuckoo_index_t nestsPerBucket, CuckooFilterHashVersion hashVersion) {
+	std::vector<uint8_t> buffer(CuckooFilter::size(bucketCount, nestsPerBucket));
+	cuckoo_filter_data_t* data = reinterpret_cast<cuckoo_filter_data_t*>(buffer.data());
+	CuckooFilter filter(data, hashVersion);
+	filter.init(bucketCount, nestsPerBucket);
+
+	std::vector<test_key_t> keys;
+	if (checkLookups(filter, data, keys) < 0) {
+		return false;
+	}
+
+	int numKeys    = bucketCount * nestsPerBucket * LOAD_FACTOR;
+	bool addFailed = false;
+	for (int i = 0; i < numKeys; ++i) {
+		keys.push_back(makeKey());
+		if (!filter.add(keys.back().data, KEY_LEN)) {
+			// Filter is full, which can happen at high load factors: this key or one it kicked out became the victim.
+			keys.pop_back();
+			addFailed = true;
+			break;
+		}
+	}
+	int numFound = checkLookups(filter, data, keys);
+	if (numFound < 0 || numFound < (int)keys.size() - (addFailed ? 1 : 0)) {
+		std::cout << keys.size() - numFound << " added keys not found" << std::endl;
+		return false;
+	}
+
+	// Remove half of the keys.
+	std::vector<test_key_t> keptKeys;
+	for (size_t i = 0; i < keys.size(); ++i) {
+		if (i % 2) {
+			keptKeys.push_back(keys[i]);
+		}
+		else {
+			filter.remove(keys[i].data, KEY_LEN);
+		}
+	}
+	numFound = checkLookups(filter, data, keptKeys);
+	if (numFound < 0 || numFound < (int)keptKeys.size() - (addFailed ? 1 : 0)) {
+		std::cout << keptKeys.size() - numFound << " kept keys not found after removal" << std::endl;
+		return false;
+	}
+
+	std::cout << (int)bucketCount << "x" << (int)nestsPerBucket << " filter, hash version " << (int)hashVersion << ", ";
+	printBenchmark("lookup", NUM_ROUNDS * keys.size(), [&](int i) {
+		// Half of the added keys have been removed again.
+		return filter.contains(keys[i % keys.size()].data, KEY_LEN);
+	});
+	return true;
+}
+
+int main() {
+	srand(1);
+	for (auto hashVersion : {CuckooFilterHashVersion::Crc16Djb2, CuckooFilterHashVersion::Fnv1a}) {
+		if (!testFilter(16, 4, hashVersion) || !testFilter(64, 4, hashVersion) || !testFilter(128, 4, hashVersion)
+			|| !testFilter(64, 3, hashVersion) || !testFilter(32, 2, hashVersion)) {
+			return 1;
+		}
+	}
+	return 0;
+}
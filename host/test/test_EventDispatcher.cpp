@@ -20,6 +20,8 @@ public:
 
 	bool receivedEvent() { return _receivedEvent; }
 
+	void reset() { _receivedEvent = false; }
+
 	virtual ~TestListener() { LOGi("TestListener::~TestListener()"); }
 };
 
@@ -36,5 +38,29 @@ int main() {
 	assert(a.receivedEvent(), "test listener a didn't receive anything");
 	assert(b.receivedEvent(), "test listener b didn't receive anything");
 
+	// Subscribe b to a single type only.
+	b.listen({CS_TYPE::EVT_TICK});
+	a.reset();
+	b.reset();
+	evt.dispatch();
+	assert(a.receivedEvent(), "test listener a didn't receive anything");
+	assert(!b.receivedEvent(), "test listener b received an event it didn't subscribe to");
+
+	TYPIFY(EVT_TICK) tickCount = 0;
+	event_t tickEvt(CS_TYPE::EVT_TICK, &tickCount, sizeof(tickCount));
+	a.reset();
+	b.reset();
+	tickEvt.dispatch();
+	assert(a.receivedEvent(), "test listener a didn't receive the tick");
+	assert(b.receivedEvent(), "test listener b didn't receive the tick it subscribed to");
+
+	// Removing a listener should shift the subscriptions of the others along.
+	dispatcher.removeListener(&a);
+	a.reset();
+	b.reset();
+	tickEvt.dispatch();
+	assert(!a.receivedEvent(), "removed test listener a received the tick");
+	assert(b.receivedEvent(), "test listener b didn't receive the tick after removing a");
+
 	return 0;
 }
@@ -0,0 +1,115 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <events/cs_Event.h>
+#include <events/cs_EventDispatcher.h>
+#include <events/cs_EventListener.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/**
+ * Compares the cost of dispatching when all listeners receive every event, with the cost when listeners
+ * only subscribed to the types they handle.
+ */
+
+#define NUM_LISTENERS 40
+#define NUM_ROUNDS 20000
+#define SCANS_PER_TICK 10
+
+// Types handled by the listeners, cycled through so that only a few listeners handle the hot types.
+const CS_TYPE handledTypes[] = {
+		CS_TYPE::EVT_TICK,
+		CS_TYPE::EVT_DEVICE_SCANNED,
+		CS_TYPE::EVT_STORAGE_WRITE_DONE,
+		CS_TYPE::CMD_SWITCH_ON,
+		CS_TYPE::CMD_SWITCH_OFF,
+		CS_TYPE::EVT_BLE_CONNECT,
+		CS_TYPE::EVT_BLE_DISCONNECT,
+		CS_TYPE::EVT_RECV_MESH_MSG,
+		CS_TYPE::EVT_PRESENCE_MUTATION,
+		CS_TYPE::EVT_FILTERS_UPDATED,
+};
+const int numHandledTypes = sizeof(handledTypes) / sizeof(handledTypes[0]);
+
+class BenchmarkListener : public EventListener {
+public:
+	CS_TYPE _handledType;
+	uint32_t _handledCount = 0;
+
+	BenchmarkListener(CS_TYPE handledType) : _handledType(handledType) {}
+
+	void handleEvent(event_t& event) override {
+		if (event.type == _handledType) {
+			_handledCount++;
+		}
+	}
+};
+
+uint32_t totalHandled(std::vector<BenchmarkListener*>& listeners) {
+	uint32_t total = 0;
+	for (auto listener : listeners) {
+		total += listener->_handledCount;
+		listener->_handledCount = 0;
+	}
+	return total;
+}
+
+/**
+ * Dispatch ticks and scanned devices, and return the average time per dispatch in nanoseconds.
+ */
+double runBenchmark() {
+	TYPIFY(EVT_TICK) tickCount = 0;
+	TYPIFY(EVT_DEVICE_SCANNED) scannedDevice;
+	event_t tickEvent(CS_TYPE::EVT_TICK, &tickCount, sizeof(tickCount));
+	event_t scanEvent(CS_TYPE::EVT_DEVICE_SCANNED, &scannedDevice, sizeof(scannedDevice));
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		tickEvent.dispatch();
+		for (int i = 0; i < SCANS_PER_TICK; ++i) {
+			scanEvent.dispatch();
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	return static_cast<double>(ns) / (NUM_ROUNDS * (1 + SCANS_PER_TICK));
+}
+
+int main() {
+	std::vector<BenchmarkListener*> listeners;
+	for (int i = 0; i < NUM_LISTENERS; ++i) {
+		BenchmarkListener* listener = new BenchmarkListener(handledTypes[i % numHandledTypes]);
+		listener->listen();
+		listeners.push_back(listener);
+	}
+
+	double broadcastNs        = runBenchmark();
+	uint32_t broadcastHandled = totalHandled(listeners);
+
+	for (auto listener : listeners) {
+		listener->listen({listener->_handledType});
+	}
+
+	double subscribedNs        = runBenchmark();
+	uint32_t subscribedHandled = totalHandled(listeners);
+
+	std::cout << "Broadcast:  " << broadcastNs << " ns per dispatch" << std::endl;
+	std::cout << "Subscribed: " << subscribedNs << " ns per dispatch" << std::endl;
+
+	if (broadcastHandled != subscribedHandled) {
+		std::cout << "Handled " << subscribedHandled << " events, expected " << broadcastHandled << std::endl;
+		return 1;
+	}
+
+	for (auto listener : listeners) {
+		delete listener;
+	}
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_ExactMatchFilter.h>
+#include <utils/cs_Benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+/**
+ * Checks that lookups in the Eytzinger layout give the same results as the binary search in the sorted layout, for
+ * several item counts and sizes, including items smaller and larger than all items in the filter. Also checks that
+ * isValid() rejects a tree that is out of order.
+ */
+
+#define NUM_LOOKUP_KEYS 2000
+#define NUM_ROUNDS 100
+#define MAX_ITEM_SIZE 16
+
+typedef std::vector<uint8_t> item_t;
+
+/**
+ * Make an item. With a shared prefix, the items look like MAC addresses of a few vendors.
+ */
+item_t makeItem(uint8_t itemSize, bool sharedPrefix) {
+	item_t item(itemSize);
+	for (size_t i = 0; i < itemSize; ++i) {
+		item[i] = (sharedPrefix && i < 3) ? (rand() % 2) : rand() % 256;
+	}
+	return item;
+}
+
+std::vector<uint8_t> makeFilterBuffer(std::vector<item_t>& items, uint8_t itemSize) {
+	std::vector<uint8_t> buffer(ExactMatchFilter::size(items.size(), itemSize));
+	buffer[0] = items.size();
+	buffer[1] = itemSize;
+	for (size_t i = 0; i < items.size(); ++i) {
+		memcpy(buffer.data() + 2 + i * itemSize, items[i].data(), itemSize);
+	}
+	return buffer;
+}
+
+bool testLayout(uint8_t itemCount, uint8_t itemSize, bool sharedPrefix) {
+	std::vector<item_t> items;
+	for (int i = 0; i < itemCount; ++i) {
+		items.push_back(makeItem(itemSize, sharedPrefix));
+	}
+	std::sort(items.begin(), items.end());
+	items.erase(std::unique(items.begin(), items.end()), items.end());
+
+	std::vector<uint8_t> sortedBuffer    = makeFilterBuffer(items, itemSize);
+	std::vector<uint8_t> eytzingerBuffer = sortedBuffer;
+	ExactMatchFilter sortedFilter(reinterpret_cast<exact_match_filter_data_t*>(sortedBuffer.data()));
+	ExactMatchFilter eytzingerFilter(reinterpret_cast<exact_match_filter_data_t*>(eytzingerBuffer.data()));
+	if (eytzingerFilter.toEytzingerLayout() != ERR_SUCCESS || !eytzingerFilter.isValid()
+		|| eytzingerFilter.toEytzingerLayout() != ERR_WRONG_STATE) {
+		std::cout << "Failed to reorder to the Eytzinger layout" << std::endl;
+		return false;
+	}
+
+	// Half of the lookups are items in the filter, some others are of the wrong size, or outside the range of items.
+	std::vector<item_t> lookupItems = {item_t(itemSize, 0), item_t(itemSize, 0xFF)};
+	for (int i = 0; i < NUM_LOOKUP_KEYS; ++i) {
+		if (i % 2) {
+			lookupItems.push_back(items[rand() % items.size()]);
+		}
+		else {
+			lookupItems.push_back(makeItem((i % 50) ? itemSize : itemSize + 1, sharedPrefix));
+		}
+	}
+	for (auto& item : lookupItems) {
+		int index     = eytzingerFilter.find(item.data(), item.size());
+		bool expected = sortedFilter.contains(item.data(), item.size());
+		bool found    = index >= 0;
+		if (found != expected
+			|| (found && memcmp(eytzingerBuffer.data() + 2 + index * itemSize, item.data(), itemSize) != 0)) {
+			std::cout << "Lookup differs from the sorted layout, expected " << expected << std::endl;
+			return false;
+		}
+	}
+
+	std::cout << items.size() << " items of " << (int)itemSize << "B" << (sharedPrefix ? " with shared prefix" : "")
+			  << ":" << std::endl;
+	int numCalls        = NUM_ROUNDS * lookupItems.size();
+	int64_t sortedFound = printBenchmark("Sorted", numCalls, [&](int i) {
+		item_t& item = lookupItems[i % lookupItems.size()];
+		return sortedFilter.contains(item.data(), item.size());
+	});
+	int64_t eytzingerFound = printBenchmark("Eytzinger", numCalls, [&](int i) {
+		item_t& item = lookupItems[i % lookupItems.size()];
+		return eytzingerFilter.contains(item.data(), item.size());
+	});
+	if (sortedFound != eytzingerFound) {
+		std::cout << "Found " << eytzingerFound << ", expected " << sortedFound << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Items that are out of order in the Eytzinger layout, while every child is on the correct side of its parent.
+ */
+bool testInvalidLayout() {
+	std::vector<item_t> items;
+	for (uint8_t i = 1; i <= 7; ++i) {
+		items.push_back(item_t(1, i));
+	}
+	std::vector<uint8_t> buffer = makeFilterBuffer(items, 1);
+	ExactMatchFilter filter(reinterpret_cast<exact_match_filter_data_t*>(buffer.data()));
+	if (filter.toEytzingerLayout() != ERR_SUCCESS || !filter.isValid()) {
+		std::cout << "Failed to reorder to the Eytzinger layout" << std::endl;
+		return false;
+	}
+
+	// The tree is 4, 2, 6, 1, 3, 5, 7: swap 3 and 5.
+	std::swap(buffer[2 + 4], buffer[2 + 5]);
+	ExactMatchFilter invalidFilter(
+			reinterpret_cast<exact_match_filter_data_t*>(buffer.data()), ExactMatchFilterLayout::Eytzinger);
+	if (invalidFilter.isValid()) {
+		std::cout << "Items out of order should be invalid" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	if (!testInvalidLayout()) {
+		return 1;
+	}
+	for (uint8_t itemSize : {2, 3, 6, MAX_ITEM_SIZE}) {
+		for (uint8_t itemCount : {1, 2, 7, 16, 64, 255}) {
+			if (!testLayout(itemCount, itemSize, false) || (itemSize == 6 && !testLayout(itemCount, itemSize, true))) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
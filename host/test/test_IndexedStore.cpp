@@ -0,0 +1,318 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_IndexedStore.h>
+#include <util/cs_Store.h>
+#include <utils/cs_Benchmark.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+/**
+ * Checks IndexedStore on a full store, duplicate adds, removal from the middle of a probe sequence, and probe
+ * sequences that wrap around the end of the index. Then against a reference set under random adds and removes, and
+ * against Store with a workload like the AssetStore gets: mostly known ids, some new ones that replace a record.
+ */
+
+#define NUM_CHECK_OPERATIONS 20000
+#define NUM_OPERATIONS 200000
+
+struct test_record_t {
+	uint32_t recordId;
+	uint8_t counter = 0xFF;
+
+	void invalidate() { counter = 0xFF; }
+
+	bool isValid() { return counter != 0xFF; }
+
+	uint32_t id() { return recordId; }
+};
+
+template <unsigned int MaxItemCount>
+void removeRecord(Store<test_record_t, MaxItemCount>& store, test_record_t* record) {
+	record->invalidate();
+}
+
+template <unsigned int MaxItemCount>
+void removeRecord(IndexedStore<test_record_t, MaxItemCount>& store, test_record_t* record) {
+	store.remove(record);
+}
+
+/**
+ * Get the record with the given id, or add it, replacing a random record when the store is full.
+ */
+template <class StoreType>
+test_record_t* getOrCreate(StoreType& store, uint32_t id) {
+	test_record_t* record = store.getOrAdd(id);
+	if (record == nullptr) {
+		removeRecord(store, store.begin() + rand() % store.size());
+		record = store.getOrAdd(id);
+	}
+	record->recordId = id;
+	record->counter  = 0;
+	return record;
+}
+
+/**
+ * Add a record with given id.
+ */
+template <unsigned int MaxItemCount>
+test_record_t* add(IndexedStore<test_record_t, MaxItemCount>& store, uint32_t id) {
+	test_record_t* record = store.getOrAdd(id);
+	if (record != nullptr) {
+		record->recordId = id;
+		record->counter  = 0;
+	}
+	return record;
+}
+
+/**
+ * Check that exactly the given ids are in the store.
+ */
+template <unsigned int MaxItemCount>
+bool checkIds(IndexedStore<test_record_t, MaxItemCount>& store, std::set<uint32_t> ids, uint32_t idRange) {
+	for (uint32_t id = 0; id < idRange; ++id) {
+		test_record_t* record = store.get(id);
+		bool expected         = ids.count(id) != 0;
+		if ((record != nullptr) != expected || (record != nullptr && record->recordId != id)) {
+			std::cout << "Lookup of " << id << " differs, expected found=" << expected << std::endl;
+			return false;
+		}
+	}
+	if (store.count() != ids.size()) {
+		std::cout << "Count " << store.count() << ", expected " << ids.size() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * A store with a single record: it is full after one add, and the record is reused after removal.
+ */
+bool testSingleRecord() {
+	IndexedStore<test_record_t, 1> store;
+	store.clear();
+	uint32_t id      = 5;
+	uint32_t otherId = 6;
+	if (!checkIds(store, {}, 10) || store.full()) {
+		std::cout << "Empty store should not have records" << std::endl;
+		return false;
+	}
+	test_record_t* record = add(store, id);
+	if (record == nullptr || !store.full() || add(store, otherId) != nullptr || !checkIds(store, {id}, 10)) {
+		std::cout << "Store with one record should be full" << std::endl;
+		return false;
+	}
+	store.remove(record);
+	if (store.full() || !checkIds(store, {}, 10) || add(store, otherId) != record || store.size() != 1
+		|| !checkIds(store, {otherId}, 10)) {
+		std::cout << "Removed record should be reused" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Adding an id that is already in the store gives the same record.
+ */
+bool testDuplicates() {
+	IndexedStore<test_record_t, 8> store;
+	store.clear();
+	std::vector<test_record_t*> records;
+	for (uint32_t id = 0; id < 8; ++id) {
+		records.push_back(add(store, id));
+	}
+	for (uint32_t id = 0; id < 8; ++id) {
+		if (store.getOrAdd(id) != records[id] || store.get(id) != records[id]) {
+			std::cout << "Adding id " << id << " again gives another record" << std::endl;
+			return false;
+		}
+	}
+	if (!store.full() || store.size() != 8 || !checkIds(store, {0, 1, 2, 3, 4, 5, 6, 7}, 16)) {
+		std::cout << "Adding ids again should not change the store" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * The home position of an id in the index of a store with 8 records, like IndexedStore calculates it.
+ */
+uint16_t getHomePosition(uint32_t id) {
+	const uint16_t indexMask = 15;
+	uint16_t hash            = Djb2(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+	return (hash ^ (hash >> 8)) & indexMask;
+}
+
+/**
+ * Find ids with the given home position.
+ */
+std::vector<uint32_t> findIds(uint16_t homePosition, int count) {
+	std::vector<uint32_t> ids;
+	for (uint32_t id = 0; ids.size() < (size_t)count; ++id) {
+		if (getHomePosition(id) == homePosition) {
+			ids.push_back(id);
+		}
+	}
+	return ids;
+}
+
+/**
+ * Probe sequences that wrap around the end of the index, and removal from the start and the middle of them.
+ */
+bool testWraparound() {
+	IndexedStore<test_record_t, 8> store;
+	store.clear();
+
+	// 3 ids at the last position of the index, so they end up at positions 15, 0 and 1.
+	// Then ids at positions 0 and 1, they end up after those.
+	std::vector<uint32_t> lastIds = findIds(15, 3);
+	uint32_t firstId              = findIds(0, 1)[0];
+	uint32_t secondId             = findIds(1, 1)[0];
+	std::set<uint32_t> ids        = {lastIds[0], lastIds[1], lastIds[2], firstId, secondId};
+	for (auto id : {lastIds[0], lastIds[1], lastIds[2], firstId, secondId}) {
+		add(store, id);
+	}
+	uint32_t idRange = *ids.rbegin() + 1;
+	if (!checkIds(store, ids, idRange)) {
+		return false;
+	}
+
+	// Remove the one at the start, the others have to be shifted back over the end of the index.
+	store.remove(store.get(lastIds[0]));
+	ids.erase(lastIds[0]);
+	if (!checkIds(store, ids, idRange)) {
+		return false;
+	}
+
+	// Remove one in the middle.
+	store.remove(store.get(firstId));
+	ids.erase(firstId);
+	if (!checkIds(store, ids, idRange)) {
+		return false;
+	}
+
+	// Add them again, and remove the last one.
+	add(store, lastIds[0]);
+	add(store, firstId);
+	ids.insert(lastIds[0]);
+	ids.insert(firstId);
+	store.remove(store.get(secondId));
+	ids.erase(secondId);
+	if (!checkIds(store, ids, idRange) || store.size() != 5) {
+		std::cout << "Removed records should be reused: size=" << store.size() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+template <unsigned int MaxItemCount>
+bool checkIndexedStore() {
+	IndexedStore<test_record_t, MaxItemCount> store;
+	std::set<uint32_t> expected;
+	store.clear();
+
+	// Ids from a small range, so that the same ids get added and removed often.
+	uint32_t idRange = 2 * MaxItemCount;
+	for (int i = 0; i < NUM_CHECK_OPERATIONS; ++i) {
+		uint32_t id = rand() % idRange;
+		if (rand() % 2 && expected.size() < MaxItemCount) {
+			test_record_t* record = store.getOrAdd(id);
+			record->recordId      = id;
+			record->counter       = 0;
+			expected.insert(id);
+		}
+		else if (test_record_t* record = store.get(id)) {
+			store.remove(record);
+			expected.erase(id);
+		}
+
+		if (store.count() != expected.size() || store.full() != (expected.size() == MaxItemCount)) {
+			std::cout << "Count " << store.count() << ", expected " << expected.size() << std::endl;
+			return false;
+		}
+		for (int j = 0; j < 4; ++j) {
+			uint32_t lookupId     = rand() % idRange;
+			test_record_t* record = store.get(lookupId);
+			bool found            = expected.count(lookupId) != 0;
+			if ((record != nullptr) != found || (record != nullptr && record->recordId != lookupId)) {
+				std::cout << "Lookup of " << lookupId << " differs, expected found=" << found << std::endl;
+				return false;
+			}
+		}
+	}
+
+	uint16_t validCount = store.countIf([](auto& rec) { return rec.isValid(); });
+	if (validCount != expected.size() || store.size() > MaxItemCount) {
+		std::cout << "Iteration gives " << validCount << " valid records, expected " << expected.size() << std::endl;
+		return false;
+	}
+
+	store.clear();
+	if (store.count() != 0 || store.size() != 0 || store.get(*expected.begin()) != nullptr) {
+		std::cout << "Store not empty after clear" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Run the workload, and return the checksum.
+ */
+template <class StoreType, unsigned int MaxItemCount>
+int64_t runWorkload(const char* name) {
+	StoreType* store = new StoreType();
+	store->clear();
+
+	srand(1);
+	std::vector<uint32_t> ids;
+	for (unsigned int i = 0; i < MaxItemCount + MaxItemCount / 10; ++i) {
+		ids.push_back(rand());
+	}
+	for (unsigned int i = 0; i < MaxItemCount; ++i) {
+		getOrCreate(*store, ids[i]);
+	}
+
+	int64_t checksum = printBenchmark(name, NUM_OPERATIONS, [&](int i) {
+		uint32_t id = ids[rand() % ids.size()];
+		if (test_record_t* record = store->get(id)) {
+			return record->recordId % 256;
+		}
+		return getOrCreate(*store, id)->recordId % 256 + 1;
+	});
+	delete store;
+	return checksum;
+}
+
+template <unsigned int MaxItemCount>
+bool compareStores() {
+	if (!checkIndexedStore<MaxItemCount>()) {
+		return false;
+	}
+
+	std::cout << MaxItemCount << " records:" << std::endl;
+	int64_t storeChecksum   = runWorkload<Store<test_record_t, MaxItemCount>, MaxItemCount>("Store");
+	int64_t indexedChecksum = runWorkload<IndexedStore<test_record_t, MaxItemCount>, MaxItemCount>("IndexedStore");
+	if (storeChecksum != indexedChecksum) {
+		std::cout << "Checksum " << indexedChecksum << ", expected " << storeChecksum << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	if (!testSingleRecord() || !testDuplicates() || !testWraparound()) {
+		return 1;
+	}
+	if (!compareStores<50>() || !compareStores<200>() || !compareStores<1000>()) {
+		return 1;
+	}
+	return 0;
+}
@@ -44,6 +44,33 @@ int main() {
 	cout << "Set buffers" << endl;
 	for (int i = 0; i < NUM_BUFFERS; ++i) {
 		buffer.setBuffer(i, buf[i]);
+		// Like the ADC does once the SAADC filled the buffer.
+		buffer.deinterleave(i);
+	}
+
+	cout << "Check channel values, deinterleaved=" << AdcBuffer::isDeinterleaved() << endl;
+	for (int i = 0; i < NUM_BUFFERS; ++i) {
+		adc_channel_values_t voltage             = buffer.getChannel(i, 0);
+		adc_channel_values_t current             = buffer.getChannel(i, 1);
+		const adc_sample_value_t* currentValues = buffer.getChannelValues(i, 1);
+		for (int j = 0; j < 100; ++j) {
+			if (buffer.getValue(i, 0, j) != sin_table[j] || voltage[j] != sin_table[j]) {
+				cout << "Wrong voltage value: buf=" << i << " index=" << j << endl;
+				return EXIT_FAILURE;
+			}
+			if (buffer.getValue(i, 1, j) != 400 || current[j] != 400
+				|| currentValues[j * AdcBuffer::getChannelStride()] != 400) {
+				cout << "Wrong current value: buf=" << i << " index=" << j << endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	buffer.setValue(0, 1, 7, -5);
+	if (buffer.getValue(0, 1, 7) != -5 || buffer.getChannel(0, 1)[7] != -5
+		|| buffer.getValue(0, 0, 7) != sin_table[7]) {
+		cout << "Set value did not write the right sample" << endl;
+		return EXIT_FAILURE;
 	}
 
 	cout << "Create circular buffer" << endl;
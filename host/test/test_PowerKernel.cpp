@@ -0,0 +1,363 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <processing/cs_PowerKernel.h>
+#include <utils/cs_Benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Checks that the dual multiply accumulate kernel gives the same sums as the portable reference, for interleaved and
+ * planar buffers, and that the zero corrected sums match the per sample calculation PowerSampling used before. Also
+ * checks the squared difference kernel used by RecognizeSwitch, and that the harmonics match a floating point DFT.
+ * Then checks that the cost of the harmonics stays bounded, relative to the power kernel, and prints the time of the
+ * kernels.
+ */
+
+#define CHANNEL_LENGTH 100
+#define NUM_BUFFERS 1000
+#define NUM_ROUNDS 20000
+
+// Calculating the harmonics should cost at most this many times the power kernel. Per pair of samples, the power kernel
+// does 3 dual multiply accumulates, and the harmonics add 4 per harmonic, so on a Cortex-M4 it's about 6 times. The
+// margin is for the host. A regression like calculating the tables at runtime would cost orders of magnitude more.
+#define MAX_HARMONICS_COST_FACTOR 20
+
+// The kernels are timed in turns, and the fastest time of each is compared, so that the load of the host affects both.
+#define NUM_COST_BATCHES 5
+
+/**
+ * Fill a buffer with a voltage and current sine, 12 bit samples with some noise.
+ */
+void fillBuffer(std::vector<adc_sample_value_t>& buffer, int phase) {
+	for (int i = 0; i < CHANNEL_LENGTH; ++i) {
+		double angle      = 2 * M_PI * i / CHANNEL_LENGTH;
+		buffer[2 * i]     = 1800 * std::sin(angle) + (rand() % 201) - 100;
+		buffer[2 * i + 1] = (rand() % 2048) * std::sin(angle + phase * 0.1) + (rand() % 41) - 20;
+	}
+}
+
+/**
+ * Split interleaved samples into a plane per channel, like AdcBuffer does when built with BUILD_ADC_DEINTERLEAVED.
+ */
+std::vector<adc_sample_value_t> deinterleave(const std::vector<adc_sample_value_t>& buffer) {
+	size_t channelLength = buffer.size() / 2;
+	std::vector<adc_sample_value_t> planes(buffer.size());
+	for (size_t i = 0; i < channelLength; ++i) {
+		planes[i]                 = buffer[2 * i];
+		planes[channelLength + i] = buffer[2 * i + 1];
+	}
+	return planes;
+}
+
+bool isEqual(const power_kernel_sums_t& a, const power_kernel_sums_t& b) {
+	return a.numSamples == b.numSamples && a.sum[0] == b.sum[0] && a.sum[1] == b.sum[1]
+		   && a.squareSum[0] == b.squareSum[0] && a.squareSum[1] == b.squareSum[1] && a.productSum == b.productSum;
+}
+
+/**
+ * The calculation of PowerSampling::calculatePower() before the kernel.
+ */
+void calculatePerSample(
+		const std::vector<adc_sample_value_t>& buffer,
+		adc_sample_value_id_t numSamples,
+		int32_t zeroVoltage,
+		int32_t zeroCurrent,
+		int64_t& pSum,
+		int64_t& vSquareSum,
+		int64_t& cSquareSum) {
+	pSum       = 0;
+	cSquareSum = 0;
+	vSquareSum = 0;
+	for (adc_sample_value_id_t i = 0; i < numSamples; ++i) {
+		int64_t voltage = (int64_t)buffer[2 * i] * 1024 - zeroVoltage;
+		int64_t current = (int64_t)buffer[2 * i + 1] * 1024 - zeroCurrent;
+		vSquareSum += (voltage * voltage) / (1024 * 1024);
+		cSquareSum += (current * current) / (1024 * 1024);
+		pSum += (current * voltage) / (1024 * 1024);
+	}
+}
+
+/**
+ * The per sample calculation truncates each term, the kernel only truncates the sum: the difference is less than
+ * one per sample.
+ */
+bool isClose(int64_t perSample, int64_t kernel, adc_sample_value_id_t numSamples) {
+	return std::abs(perSample - kernel) <= numSamples;
+}
+
+bool testSums() {
+	std::vector<adc_sample_value_t> buffer(2 * CHANNEL_LENGTH);
+	for (int buf = 0; buf < NUM_BUFFERS; ++buf) {
+		fillBuffer(buffer, buf);
+		// Also test odd lengths.
+		adc_sample_value_id_t numSamples = CHANNEL_LENGTH - (buf % 2);
+
+		power_kernel_sums_t sums;
+		power_kernel_sums_t referenceSums;
+		powerKernelAccumulate(buffer.data(), numSamples, sums);
+		powerKernelAccumulateReference(buffer.data(), numSamples, referenceSums);
+		if (!isEqual(sums, referenceSums)) {
+			std::cout << "Kernel sums differ from reference: buf=" << buf << std::endl;
+			return false;
+		}
+
+		std::vector<adc_sample_value_t> planes = deinterleave(buffer);
+		power_kernel_sums_t planarSums;
+		powerKernelAccumulatePlanar(planes.data(), planes.data() + CHANNEL_LENGTH, numSamples, planarSums);
+		if (!isEqual(planarSums, referenceSums)) {
+			std::cout << "Planar kernel sums differ from reference: buf=" << buf << std::endl;
+			return false;
+		}
+
+		int32_t zeroVoltage = (rand() % 65536) - 32768;
+		int32_t zeroCurrent = (rand() % 65536) - 32768;
+		int64_t pSum, vSquareSum, cSquareSum;
+		calculatePerSample(buffer, numSamples, zeroVoltage, zeroCurrent, pSum, vSquareSum, cSquareSum);
+		if (!isClose(pSum, powerKernelCenteredProductSum(sums, 0, zeroVoltage, 1, zeroCurrent), numSamples)
+			|| !isClose(vSquareSum, powerKernelCenteredProductSum(sums, 0, zeroVoltage, 0, zeroVoltage), numSamples)
+			|| !isClose(cSquareSum, powerKernelCenteredProductSum(sums, 1, zeroCurrent, 1, zeroCurrent), numSamples)) {
+			std::cout << "Centered sums differ from per sample calculation: buf=" << buf << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Check the extremes of the sample range, where the products no longer fit in 32 bits when added.
+ */
+bool testExtremes() {
+	std::vector<adc_sample_value_t> buffer(2 * CHANNEL_LENGTH, -32768);
+	power_kernel_sums_t sums;
+	power_kernel_sums_t referenceSums;
+	powerKernelAccumulate(buffer.data(), CHANNEL_LENGTH, sums);
+	powerKernelAccumulateReference(buffer.data(), CHANNEL_LENGTH, referenceSums);
+	if (!isEqual(sums, referenceSums) || sums.productSum != (int64_t)CHANNEL_LENGTH * 32768 * 32768) {
+		std::cout << "Kernel sums wrong for extreme samples" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Check the squared difference kernel against the reference, with and without a limit.
+ * Below the limit the sums should be equal, otherwise the kernel may stop early, but only at or above the limit.
+ */
+bool testSquaredDiffSum() {
+	std::vector<adc_sample_value_t> samplesA(CHANNEL_LENGTH);
+	std::vector<adc_sample_value_t> samplesB(CHANNEL_LENGTH);
+	for (int buf = 0; buf < NUM_BUFFERS; ++buf) {
+		for (int i = 0; i < CHANNEL_LENGTH; ++i) {
+			samplesA[i] = (rand() % 4096) - 2048;
+			samplesB[i] = samplesA[i] + (rand() % (2 * (buf % 50) + 1)) - (buf % 50);
+		}
+		// Also test odd lengths and start indices.
+		adc_sample_value_id_t start      = buf % 3;
+		adc_sample_value_id_t numSamples = CHANNEL_LENGTH / 2 - (buf % 2);
+		uint32_t reference =
+				powerKernelSquaredDiffSumReference(samplesA.data() + start, samplesB.data() + start, numSamples);
+		uint32_t sum =
+				powerKernelSquaredDiffSum(samplesA.data() + start, samplesB.data() + start, numSamples, UINT32_MAX);
+		if (sum != reference) {
+			std::cout << "Squared diff sum differs from reference: buf=" << buf << std::endl;
+			return false;
+		}
+
+		uint32_t limit = rand() % (2 * reference + 1);
+		sum            = powerKernelSquaredDiffSum(samplesA.data() + start, samplesB.data() + start, numSamples, limit);
+		if (sum < limit ? sum != reference : (reference < limit || sum > reference)) {
+			std::cout << "Squared diff sum wrong with limit: buf=" << buf << std::endl;
+			return false;
+		}
+	}
+
+	// The largest sum that fits.
+	std::vector<adc_sample_value_t> minSamples(128, -2048);
+	std::vector<adc_sample_value_t> maxSamples(128, 2047);
+	if (powerKernelSquaredDiffSum(minSamples.data(), maxSamples.data(), 128, UINT32_MAX) != 128 * 4095 * 4095) {
+		std::cout << "Squared diff sum wrong for extreme samples" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Fill a buffer with odd harmonics of known amplitude and phase, on a zero offset, with some noise.
+ */
+void fillHarmonicsBuffer(std::vector<adc_sample_value_t>& buffer, double amplitudes[2][POWER_QUALITY_NUM_HARMONICS]) {
+	double phases[2][POWER_QUALITY_NUM_HARMONICS];
+	int zeroOffsets[2];
+	for (int channel = 0; channel < 2; ++channel) {
+		zeroOffsets[channel] = (rand() % 4096) - 2048;
+		for (int h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+			amplitudes[channel][h] = (rand() % 1000) / (h + 1.0);
+			phases[channel][h]     = (rand() % 628) / 100.0;
+		}
+	}
+	for (int i = 0; i < POWER_KERNEL_PERIOD_LENGTH; ++i) {
+		for (int channel = 0; channel < 2; ++channel) {
+			double value = zeroOffsets[channel] + (rand() % 11) - 5;
+			for (int h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+				double angle = 2 * M_PI * (2 * h + 1) * i / POWER_KERNEL_PERIOD_LENGTH;
+				value += amplitudes[channel][h] * std::cos(angle + phases[channel][h]);
+			}
+			buffer[2 * i + channel] = value;
+		}
+	}
+}
+
+/**
+ * Check the harmonics kernel against the reference, and the amplitudes against the ones the buffer was made with.
+ * The power sums should be the same as those of the power kernel.
+ */
+bool testHarmonics() {
+	std::vector<adc_sample_value_t> buffer(2 * POWER_KERNEL_PERIOD_LENGTH);
+	double amplitudes[2][POWER_QUALITY_NUM_HARMONICS];
+	for (int buf = 0; buf < NUM_BUFFERS; ++buf) {
+		fillHarmonicsBuffer(buffer, amplitudes);
+		power_kernel_sums_t sums;
+		power_kernel_sums_t referenceSums;
+		power_kernel_harmonic_sums_t harmonicSums;
+		power_kernel_harmonic_sums_t referenceHarmonicSums;
+		powerKernelAccumulateHarmonics(buffer.data(), sums, harmonicSums);
+		powerKernelAccumulateHarmonicsReference(buffer.data(), referenceSums, referenceHarmonicSums);
+		powerKernelAccumulate(buffer.data(), POWER_KERNEL_PERIOD_LENGTH, referenceSums);
+		if (!isEqual(sums, referenceSums)) {
+			std::cout << "Harmonics kernel sums differ from power kernel: buf=" << buf << std::endl;
+			return false;
+		}
+
+		std::vector<adc_sample_value_t> planes = deinterleave(buffer);
+		power_kernel_sums_t planarSums;
+		power_kernel_harmonic_sums_t planarHarmonicSums;
+		powerKernelAccumulateHarmonicsPlanar(
+				planes.data(), planes.data() + POWER_KERNEL_PERIOD_LENGTH, planarSums, planarHarmonicSums);
+		if (!isEqual(planarSums, referenceSums)) {
+			std::cout << "Planar harmonics kernel sums differ from power kernel: buf=" << buf << std::endl;
+			return false;
+		}
+
+		for (int channel = 0; channel < 2; ++channel) {
+			for (int h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+				const power_kernel_phasor_t& phasor    = harmonicSums.harmonics[channel][h];
+				const power_kernel_phasor_t& reference = referenceHarmonicSums.harmonics[channel][h];
+				const power_kernel_phasor_t& planar    = planarHarmonicSums.harmonics[channel][h];
+				if (phasor.cos != reference.cos || phasor.sin != reference.sin || planar.cos != reference.cos
+					|| planar.sin != reference.sin) {
+					std::cout << "Harmonics differ from reference: buf=" << buf << std::endl;
+					return false;
+				}
+
+				// Rounding of the samples and the tables, and the noise, give an error of a few units.
+				double amplitude = 2 * std::hypot((double)phasor.cos, (double)phasor.sin)
+								   / (32767.0 * POWER_KERNEL_PERIOD_LENGTH);
+				if (std::fabs(amplitude - amplitudes[channel][h]) > 3) {
+					std::cout << "Harmonic " << 2 * h + 1 << " amplitude " << amplitude << " instead of "
+							  << amplitudes[channel][h] << ": buf=" << buf << std::endl;
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Sum of the centered products, like PowerSampling calculates them.
+ */
+int64_t getCenteredProductSums(power_kernel_sums_t& sums, int zero) {
+	return powerKernelCenteredProductSum(sums, 0, zero, 1, zero) + powerKernelCenteredProductSum(sums, 0, zero, 0, zero)
+		   + powerKernelCenteredProductSum(sums, 1, zero, 1, zero);
+}
+
+bool testHarmonicsCost() {
+	std::vector<adc_sample_value_t> buffer(2 * POWER_KERNEL_PERIOD_LENGTH);
+	fillBuffer(buffer, 0);
+	auto kernel = [&](int round) {
+		power_kernel_sums_t sums;
+		powerKernelAccumulate(buffer.data(), POWER_KERNEL_PERIOD_LENGTH, sums);
+		return getCenteredProductSums(sums, round);
+	};
+	auto kernelWithHarmonics = [&](int round) {
+		power_kernel_sums_t sums;
+		power_kernel_harmonic_sums_t harmonicSums;
+		powerKernelAccumulateHarmonics(buffer.data(), sums, harmonicSums);
+		return getCenteredProductSums(sums, round) + harmonicSums.harmonics[1][POWER_QUALITY_NUM_HARMONICS - 1].sin;
+	};
+
+	int64_t checksum   = 0;
+	double kernelNs    = 0;
+	double harmonicsNs = 0;
+	for (int batch = 0; batch < NUM_COST_BATCHES; ++batch) {
+		double batchKernelNs    = getBenchmarkNs(NUM_ROUNDS / NUM_COST_BATCHES, kernel, checksum);
+		double batchHarmonicsNs = getBenchmarkNs(NUM_ROUNDS / NUM_COST_BATCHES, kernelWithHarmonics, checksum);
+		kernelNs                = (batch == 0) ? batchKernelNs : std::min(kernelNs, batchKernelNs);
+		harmonicsNs             = (batch == 0) ? batchHarmonicsNs : std::min(harmonicsNs, batchHarmonicsNs);
+	}
+	double costFactor = harmonicsNs / kernelNs;
+	std::cout << "Harmonics cost factor: " << costFactor << " (checksum " << checksum << ")" << std::endl;
+	if (costFactor > MAX_HARMONICS_COST_FACTOR) {
+		std::cout << "Harmonics cost more than " << MAX_HARMONICS_COST_FACTOR << " times the power kernel" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void benchmark() {
+	std::vector<adc_sample_value_t> buffer(2 * CHANNEL_LENGTH);
+	fillBuffer(buffer, 0);
+	std::vector<adc_sample_value_t> planes = deinterleave(buffer);
+
+	printBenchmark("Per sample", NUM_ROUNDS, [&](int round) {
+		int64_t pSum, vSquareSum, cSquareSum;
+		calculatePerSample(buffer, CHANNEL_LENGTH, round, round, pSum, vSquareSum, cSquareSum);
+		return pSum + vSquareSum + cSquareSum;
+	});
+	printBenchmark("Kernel", NUM_ROUNDS, [&](int round) {
+		power_kernel_sums_t sums;
+		powerKernelAccumulate(buffer.data(), CHANNEL_LENGTH, sums);
+		return getCenteredProductSums(sums, round);
+	});
+	printBenchmark("Planar kernel", NUM_ROUNDS, [&](int round) {
+		power_kernel_sums_t sums;
+		powerKernelAccumulatePlanar(planes.data(), planes.data() + CHANNEL_LENGTH, CHANNEL_LENGTH, sums);
+		return getCenteredProductSums(sums, round);
+	});
+	printBenchmark("Kernel with harmonics", NUM_ROUNDS, [&](int round) {
+		power_kernel_sums_t sums;
+		power_kernel_harmonic_sums_t harmonicSums;
+		powerKernelAccumulateHarmonics(buffer.data(), sums, harmonicSums);
+		return getCenteredProductSums(sums, round) + harmonicSums.harmonics[1][POWER_QUALITY_NUM_HARMONICS - 1].sin;
+	});
+}
+
+int main() {
+	srand(1);
+	if (!testSums()) {
+		return 1;
+	}
+	if (!testExtremes()) {
+		return 1;
+	}
+	if (!testSquaredDiffSum()) {
+		return 1;
+	}
+	if (!testHarmonics()) {
+		return 1;
+	}
+	if (!testHarmonicsCost()) {
+		return 1;
+	}
+	benchmark();
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <processing/cs_PowerKernel.h>
+#include <processing/cs_PowerQuality.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Runs synthesized periods of a load with a phase shift and a 3rd harmonic through the harmonics kernel and
+ * PowerQuality, the way PowerSampling does, and checks the power factors and harmonics against the analytic values.
+ */
+
+#define VOLTAGE_MULTIPLIER 0.2f
+#define CURRENT_MULTIPLIER 0.005f
+
+// Amplitudes in samples: 320 V, and 4 A fundamental with 1.5 A 3rd harmonic.
+#define VOLTAGE_AMPLITUDE 1600
+#define CURRENT_AMPLITUDE_1 800
+#define CURRENT_AMPLITUDE_3 300
+#define PHASE_SHIFT 0.5
+
+#define ZERO_VOLTAGE 1000
+#define ZERO_CURRENT -200
+
+/**
+ * Fill a buffer with one period, with some noise.
+ */
+void fillBuffer(std::vector<adc_sample_value_t>& buffer) {
+	for (int i = 0; i < POWER_KERNEL_PERIOD_LENGTH; ++i) {
+		double angle      = 2 * M_PI * i / POWER_KERNEL_PERIOD_LENGTH;
+		buffer[2 * i]     = ZERO_VOLTAGE + VOLTAGE_AMPLITUDE * std::sin(angle) + (rand() % 5) - 2;
+		buffer[2 * i + 1] = ZERO_CURRENT + CURRENT_AMPLITUDE_1 * std::sin(angle - PHASE_SHIFT)
+							+ CURRENT_AMPLITUDE_3 * std::sin(3 * angle) + (rand() % 5) - 2;
+	}
+}
+
+bool isClose(double value, double expected, double margin) {
+	if (std::fabs(value - expected) > margin) {
+		std::cout << value << " instead of " << expected << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	std::vector<adc_sample_value_t> buffer(2 * POWER_KERNEL_PERIOD_LENGTH);
+	PowerQuality powerQuality;
+	bool complete = false;
+	for (int period = 0; period < POWER_QUALITY_INTERVAL_PERIODS; ++period) {
+		if (complete) {
+			std::cout << "Interval complete too early" << std::endl;
+			return 1;
+		}
+		fillBuffer(buffer);
+		power_kernel_sums_t sums;
+		power_kernel_harmonic_sums_t harmonicSums;
+		powerKernelAccumulateHarmonics(buffer.data(), sums, harmonicSums);
+
+		// Like PowerSampling::calculateRms().
+		int32_t zeroVoltage    = ZERO_VOLTAGE * 1024;
+		int32_t zeroCurrent    = ZERO_CURRENT * 1024;
+		double pMean           = powerKernelCenteredProductSum(sums, 0, zeroVoltage, 1, zeroCurrent);
+		double cSquareMean     = powerKernelCenteredProductSum(sums, 1, zeroCurrent, 1, zeroCurrent);
+		double vSquareMean     = powerKernelCenteredProductSum(sums, 0, zeroVoltage, 0, zeroVoltage);
+		pMean /= POWER_KERNEL_PERIOD_LENGTH;
+		cSquareMean /= POWER_KERNEL_PERIOD_LENGTH;
+		vSquareMean /= POWER_KERNEL_PERIOD_LENGTH;
+		int32_t powerMilliWatt = pMean * CURRENT_MULTIPLIER * VOLTAGE_MULTIPLIER * 1000;
+		int32_t currentRmsMA   = std::sqrt(cSquareMean) * CURRENT_MULTIPLIER * 1000;
+		int32_t voltageRms     = std::sqrt(vSquareMean) * VOLTAGE_MULTIPLIER * 1000;
+
+		complete = powerQuality.add(
+				harmonicSums.harmonics[0], harmonicSums.harmonics[1], powerMilliWatt, currentRmsMA, voltageRms);
+	}
+	if (!complete) {
+		std::cout << "Interval not complete" << std::endl;
+		return 1;
+	}
+
+	cs_power_quality_t result;
+	powerQuality.calculate(VOLTAGE_MULTIPLIER, CURRENT_MULTIPLIER, result);
+
+	double currentRms1 = CURRENT_AMPLITUDE_1 * CURRENT_MULTIPLIER * 1000 / M_SQRT2;
+	double currentRms3 = CURRENT_AMPLITUDE_3 * CURRENT_MULTIPLIER * 1000 / M_SQRT2;
+	double voltageRms1 = VOLTAGE_AMPLITUDE * VOLTAGE_MULTIPLIER * 1000 / M_SQRT2;
+	double currentRms  = std::hypot(CURRENT_AMPLITUDE_1, CURRENT_AMPLITUDE_3) * CURRENT_MULTIPLIER * 1000 / M_SQRT2;
+	double powerFactor = std::cos(PHASE_SHIFT) * currentRms1 / currentRms;
+	std::cout << "PF=" << result.powerFactor << " DPF=" << result.displacementPowerFactor
+			  << " I1=" << result.currentHarmonicsRmsMA[0] << " I3=" << result.currentHarmonicsRmsMA[1]
+			  << " V1=" << result.voltageHarmonicsRmsMilliVolt[0] << std::endl;
+
+	// Margins of a few samples of noise and rounding.
+	if (!isClose(result.powerFactor, powerFactor * 1000, 5)
+		|| !isClose(result.displacementPowerFactor, std::cos(PHASE_SHIFT) * 1000, 5)
+		|| !isClose(result.currentHarmonicsRmsMA[0], currentRms1, 10)
+		|| !isClose(result.currentHarmonicsRmsMA[1], currentRms3, 10)
+		|| !isClose(result.currentHarmonicsRmsMA[2], 0, 10) || !isClose(result.currentHarmonicsRmsMA[3], 0, 10)
+		|| !isClose(result.voltageHarmonicsRmsMilliVolt[0], voltageRms1, 500)
+		|| !isClose(result.voltageHarmonicsRmsMilliVolt[1], 0, 500)) {
+		std::cout << "Power quality differs from the load" << std::endl;
+		return 1;
+	}
+
+	// A negative multiplier flips the phase of a channel.
+	for (int period = 0; period < POWER_QUALITY_INTERVAL_PERIODS; ++period) {
+		fillBuffer(buffer);
+		power_kernel_sums_t sums;
+		power_kernel_harmonic_sums_t harmonicSums;
+		powerKernelAccumulateHarmonics(buffer.data(), sums, harmonicSums);
+		powerQuality.add(harmonicSums.harmonics[0], harmonicSums.harmonics[1], 0, 0, 0);
+	}
+	powerQuality.calculate(VOLTAGE_MULTIPLIER, -CURRENT_MULTIPLIER, result);
+	if (!isClose(result.displacementPowerFactor, -std::cos(PHASE_SHIFT) * 1000, 5) || result.powerFactor != 0) {
+		std::cout << "Power quality wrong with negative current multiplier" << std::endl;
+		return 1;
+	}
+	return 0;
+}
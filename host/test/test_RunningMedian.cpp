@@ -0,0 +1,87 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_RunningMedian.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+/**
+ * Compares the running median with the median and average of a copy of the window, like PowerSampling used to
+ * calculate them.
+ */
+
+#define WINDOW_SIZE 9
+#define NUM_VALUES 10000
+
+bool testRandom(int32_t range) {
+	RunningMedian<int32_t, WINDOW_SIZE> runningMedian;
+	std::deque<int32_t> window;
+	for (int i = 0; i < NUM_VALUES; ++i) {
+		// Small ranges give many duplicates.
+		int32_t value = (rand() % range) - range / 2;
+		runningMedian.push(value);
+		window.push_back(value);
+		if (window.size() > WINDOW_SIZE) {
+			window.pop_front();
+		}
+
+		if (runningMedian.size() != window.size() || runningMedian.full() != (window.size() == WINDOW_SIZE)) {
+			std::cout << "Wrong size at i=" << i << std::endl;
+			return false;
+		}
+
+		std::vector<int32_t> copy(window.begin(), window.end());
+		int64_t sum = 0;
+		for (auto v : copy) {
+			sum += v;
+		}
+		std::nth_element(copy.begin(), copy.begin() + (copy.size() - 1) / 2, copy.end());
+		int32_t median = copy[(copy.size() - 1) / 2];
+		if (runningMedian.getMedian() != median) {
+			std::cout << "Wrong median at i=" << i << ": " << runningMedian.getMedian() << " != " << median
+					  << std::endl;
+			return false;
+		}
+		if (runningMedian.getAverage() != sum / (int64_t)copy.size()) {
+			std::cout << "Wrong average at i=" << i << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool testClear() {
+	RunningMedian<int32_t, WINDOW_SIZE> runningMedian;
+	for (int32_t i = 0; i < 2 * WINDOW_SIZE; ++i) {
+		runningMedian.push(i);
+	}
+	runningMedian.clear();
+	runningMedian.push(5);
+	if (runningMedian.size() != 1 || runningMedian.getMedian() != 5 || runningMedian.getAverage() != 5) {
+		std::cout << "Wrong values after clear" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	if (!testRandom(10)) {
+		return 1;
+	}
+	if (!testRandom(1000000)) {
+		return 1;
+	}
+	if (!testClear()) {
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <cfg/cs_Config.h>
+#include <processing/cs_MedianFilter.h>
+#include <third/SortMedian.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * Compares the sliding median filter with the block sorting median filter it replaced, on interleaved buffers like
+ * the ADC buffers, and benchmarks both.
+ */
+
+#define NUM_CHANNELS 2
+#define CHANNEL_LENGTH 100
+#define NUM_BUFFERS 200
+#define NUM_ROUNDS 2000
+
+/**
+ * Fill a buffer with a noisy sine on each channel, with some spikes.
+ */
+void fillBuffer(std::vector<adc_sample_value_t>& buffer, int offset) {
+	for (int i = 0; i < CHANNEL_LENGTH; ++i) {
+		for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+			int value = 1000 * std::sin(2 * M_PI * (offset + i) / CHANNEL_LENGTH + channel) + (rand() % 41) - 20;
+			if (rand() % 20 == 0) {
+				value = (rand() % 4096) - 2048;
+			}
+			buffer[i * NUM_CHANNELS + channel] = value;
+		}
+	}
+}
+
+/**
+ * Filter a channel like PowerSampling used to: pad, copy, and sort_median().
+ */
+void sortMedianChannel(
+		MedianFilter& params,
+		const std::vector<adc_sample_value_t>& input,
+		std::vector<adc_sample_value_t>& output,
+		int channel) {
+	PowerVector paddedSamples(CHANNEL_LENGTH + params.half * 2);
+	PowerVector outputSamples(CHANNEL_LENGTH);
+	unsigned j = 0;
+	for (unsigned i = 0; i < params.half; ++i, ++j) {
+		paddedSamples[j] = input[channel];
+	}
+	for (unsigned i = 0; i < CHANNEL_LENGTH; ++i, ++j) {
+		paddedSamples[j] = input[i * NUM_CHANNELS + channel];
+	}
+	for (unsigned i = 0; i < params.half; ++i, ++j) {
+		paddedSamples[j] = input[(CHANNEL_LENGTH - 1) * NUM_CHANNELS + channel];
+	}
+	sort_median(params, paddedSamples, outputSamples);
+	for (unsigned i = 0; i < CHANNEL_LENGTH; ++i) {
+		output[i * NUM_CHANNELS + channel] = outputSamples[i];
+	}
+}
+
+bool testHalfWindowSize(uint16_t halfWindowSize) {
+	uint16_t windowSize = 2 * halfWindowSize + 1;
+	MedianFilter params(halfWindowSize, (CHANNEL_LENGTH + 2 * halfWindowSize) / windowSize);
+	SlidingMedianFilter filter(halfWindowSize);
+
+	std::vector<adc_sample_value_t> input(CHANNEL_LENGTH * NUM_CHANNELS);
+	std::vector<adc_sample_value_t> expected(input.size());
+	std::vector<adc_sample_value_t> output(input.size());
+	for (int buf = 0; buf < NUM_BUFFERS; ++buf) {
+		fillBuffer(input, buf * 7);
+		for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+			sortMedianChannel(params, input, expected, channel);
+			filter.filter(input.data() + channel, output.data() + channel, NUM_CHANNELS, CHANNEL_LENGTH);
+		}
+		if (output != expected) {
+			std::cout << "Mismatch with sort_median: halfWindowSize=" << halfWindowSize << " buf=" << buf << std::endl;
+			return false;
+		}
+
+		// In place should give the same result.
+		for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+			filter.filter(input.data() + channel, input.data() + channel, NUM_CHANNELS, CHANNEL_LENGTH);
+		}
+		if (input != expected) {
+			std::cout << "Mismatch in place: halfWindowSize=" << halfWindowSize << " buf=" << buf << std::endl;
+			return false;
+		}
+	}
+
+	// Benchmark
+	fillBuffer(input, 0);
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+			sortMedianChannel(params, input, expected, channel);
+		}
+	}
+	auto sortMedianNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	start             = std::chrono::steady_clock::now();
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+			filter.filter(input.data() + channel, output.data() + channel, NUM_CHANNELS, CHANNEL_LENGTH);
+		}
+	}
+	auto slidingNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	std::cout << "halfWindowSize=" << halfWindowSize << " sort_median: " << sortMedianNs.count() / NUM_ROUNDS
+			  << " ns/buffer, sliding: " << slidingNs.count() / NUM_ROUNDS << " ns/buffer" << std::endl;
+	return true;
+}
+
+bool testEdges() {
+	SlidingMedianFilter filter(5);
+
+	// Fewer samples than half the window.
+	std::vector<adc_sample_value_t> samples = {3, -1, 7};
+	filter.filter(samples.data(), samples.data(), 1, samples.size());
+	std::vector<adc_sample_value_t> expected = {3, 3, 7};
+	if (samples != expected) {
+		std::cout << "Mismatch for short input" << std::endl;
+		return false;
+	}
+
+	adc_sample_value_t sample = 42;
+	filter.filter(&sample, &sample, 1, 1);
+	if (sample != 42) {
+		std::cout << "Mismatch for single sample" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main() {
+	srand(1);
+	if (!testHalfWindowSize(POWER_SAMPLING_CURVE_HALF_WINDOW_SIZE)) {
+		return 1;
+	}
+	if (!testHalfWindowSize(16)) {
+		return 1;
+	}
+	if (!testEdges()) {
+		return 1;
+	}
+	return 0;
+}
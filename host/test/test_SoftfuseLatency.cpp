@@ -0,0 +1,55 @@
+#include <drivers/cs_RTC.h>
+#include <processing/cs_SoftfuseLatency.h>
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+int main() {
+	SoftfuseLatency& latency = SoftfuseLatency::getInstance();
+
+	// 32 ticks, which is 976 us.
+	const uint32_t ticksPerMs = RTC_CLOCK_FREQ / 1000;
+
+	cout << "Check histogram bins." << endl;
+	assert(SoftfuseLatency::getHistogramBin(999) == 0);
+	assert(SoftfuseLatency::getHistogramBin(1000) == 1);
+	assert(SoftfuseLatency::getHistogramBin(3000) == 2);
+	assert(SoftfuseLatency::getHistogramBin(4000) == 3);
+	assert(SoftfuseLatency::getHistogramBin(0xFFFFFFFF) == SOFTFUSE_LATENCY_BINS - 1);
+
+	cout << "Check that every checked buffer is measured." << endl;
+	latency.onCheck(100, 100 + ticksPerMs);
+	latency.onCheck(200, 200 + 3 * ticksPerMs);
+	assert(latency.getStats().bufferToCheck.count == 2);
+	assert(latency.getStats().bufferToCheck.minUs == 976);
+	assert(latency.getStats().bufferToCheck.maxUs == 2929);
+	assert(latency.getStats().bufferToCheck.avgUs == (976 + 2929) / 2);
+
+	cout << "Check that switch offs without softfuse are ignored." << endl;
+	latency.onSwitchOff(300);
+	assert(latency.getStats().bufferToSwitchOff.count == 0);
+
+	cout << "Check a softfuse, with the RTC counter overflowing." << endl;
+	latency.onCheck(MAX_RTC_COUNTER_VAL - ticksPerMs, MAX_RTC_COUNTER_VAL);
+	latency.onDispatch(ticksPerMs);
+	latency.onSwitchOff(3 * ticksPerMs);
+	assert(latency.getStats().checkToDispatch.count == 1);
+	assert(latency.getStats().dispatchToSwitchOff.count == 1);
+	assert(latency.getStats().bufferToSwitchOff.count == 1);
+	assert(latency.getStats().dispatchToSwitchOff.minUs == 1953);
+	assert(latency.getStats().bufferToSwitchOff.minUs == 3936);
+	assert(latency.getStats().histogram[2] == 1);
+
+	cout << "Check that a dispatch is only measured until the next check." << endl;
+	latency.onCheck(400, 400);
+	latency.onDispatch(400);
+	latency.onCheck(500, 500);
+	latency.onSwitchOff(500);
+	assert(latency.getStats().checkToDispatch.count == 2);
+	assert(latency.getStats().bufferToSwitchOff.count == 1);
+
+	cout << "Done." << endl;
+	return 0;
+}
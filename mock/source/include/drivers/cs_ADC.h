@@ -0,0 +1,103 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <cfg/cs_Config.h>
+#include <structs/buffer/cs_AdcBuffer.h>
+
+typedef void (*adc_done_cb_t)(adc_buffer_id_t bufIndex);
+
+typedef void (*adc_zero_crossing_cb_t)();
+
+/**
+ * Host version of the ADC.
+ *
+ * There is no SAADC: buffers are filled by the test, which then calls _handleAdcDone(), just like the ADC interrupt
+ * handler would.
+ */
+class ADC {
+public:
+	static ADC& getInstance() {
+		static ADC instance;
+		return instance;
+	}
+
+	/**
+	 * Store the config, and allocate the buffers.
+	 */
+	cs_ret_code_t init(const adc_config_t& config);
+
+	void start();
+
+	void stop();
+
+	void setDoneCallback(adc_done_cb_t callback);
+
+	void setZeroCrossingCallback(adc_zero_crossing_cb_t callback);
+
+	void enableZeroCrossingInterrupt(adc_channel_id_t channel, int32_t zeroVal);
+
+	/**
+	 * Like the SAADC limit events: markBufferFilled() triggers the guard when a sample is outside the limits.
+	 */
+	cs_ret_code_t enableLimitGuard(adc_channel_id_t channel, int32_t lowLimit, int32_t highLimit);
+
+	void disableLimitGuard();
+
+	bool isLimitGuardTriggered();
+
+	cs_ret_code_t changeChannel(adc_channel_id_t channel, adc_channel_config_t& config);
+
+	/**
+	 * Get the config that is set for the samples of each buffer.
+	 */
+	const adc_channel_config_result_t& getChannelResultConfig(adc_channel_id_t channel);
+
+	/**
+	 * Set the buffer config, valid flag and sequence number like the ADC does after filling a buffer.
+	 *
+	 * Does not touch the samples.
+	 */
+	void markBufferFilled(adc_buffer_id_t bufIndex);
+
+	/**
+	 * Calls the done callback with the given buffer.
+	 */
+	void _handleAdcDone(adc_buffer_id_t bufIndex);
+
+private:
+	ADC() {}
+
+	ADC(ADC const&)            = delete;
+
+	void operator=(ADC const&) = delete;
+
+	adc_config_t _config;
+
+	adc_channel_config_result_t _channelResultConfigs[CS_ADC_NUM_CHANNELS];
+
+	adc_buffer_seq_nr_t _bufSeqNr                = 1;
+
+	bool _firstBuffer                            = true;
+
+	adc_done_cb_t _doneCallback                  = nullptr;
+
+	adc_zero_crossing_cb_t _zeroCrossingCallback = nullptr;
+
+	adc_channel_id_t _limitGuardChannel          = 0;
+
+	int32_t _limitGuardLow                       = 0;
+
+	int32_t _limitGuardHigh                      = 0;
+
+	bool _limitGuardEnabled                      = false;
+
+	bool _limitGuardTriggered                    = false;
+
+	void initChannel(adc_channel_id_t channel, const adc_channel_config_t& config);
+};
@@ -0,0 +1,198 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <ble/cs_Nordic.h>
+#include <components/libraries/fds/fds.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * Configuration of the FDS simulator.
+ *
+ * Defaults are taken from the FDS config and the nRF52832 datasheet.
+ */
+struct fds_simulator_config_t {
+	// Number of virtual pages, of which one is used as swap page for garbage collection.
+	uint16_t numPages            = FDS_VIRTUAL_PAGES;
+	uint16_t pageSizeWords       = FDS_VIRTUAL_PAGE_SIZE;
+	// Max number of queued operations.
+	uint16_t queueSize           = FDS_OP_QUEUE_SIZE;
+	// Time it takes to start an operation, like waiting for a flash timeslot of the softdevice.
+	uint32_t operationOverheadUs = 1000;
+	uint32_t wordWriteUs         = 41;
+	uint32_t pageEraseUs         = 85000;
+};
+
+/**
+ * An FDS operation, as queued in the simulator.
+ *
+ * data:           Copy of the data to write, padded to words.
+ * size:           Size of the data to write, without padding.
+ * page:           Page where space for the record is reserved.
+ * isUpdate:       Whether the write replaces a valid record with the same key and file.
+ * completionUs:   Virtual time at which the operation completes, set once it is at the front of the queue.
+ */
+struct fds_simulator_op_t {
+	fds_evt_id_t id;
+	uint16_t recordKey;
+	uint16_t fileId;
+	std::vector<uint8_t> data;
+	uint16_t size         = 0;
+	uint16_t page         = 0;
+	bool isUpdate         = false;
+	uint64_t completionUs = 0;
+};
+
+/**
+ * Called when an operation completed, after the virtual page layout has been updated.
+ */
+typedef void (*fds_simulator_callback_t)(const fds_simulator_op_t& op, const fds_evt_t& event);
+
+/**
+ * Timing model of Flash Data Storage, to be used by the host Storage mock.
+ *
+ * FDS queues operations, and performs them one by one, in between radio activity. This simulator keeps up a virtual
+ * page layout of records, and a queue of operations that complete after a time that depends on the number of words
+ * to write and pages to erase. Time only passes when advance() is called.
+ *
+ * Like FDS:
+ * - Space for a record is reserved when the write is queued, so a write fails with FDS_ERR_NO_SPACE_IN_FLASH when
+ *   there is no page with enough space, even if records have been deleted.
+ * - Deleted and updated records keep taking up space, until garbage collection.
+ * - Garbage collection copies the valid records of each page with deleted records to the swap page, and erases the
+ *   page. This takes time per page, during which no other operation can complete.
+ * - Operations fail with FDS_ERR_NO_SPACE_IN_QUEUES when the queue is full.
+ */
+class FdsSimulator {
+public:
+	static FdsSimulator& getInstance() {
+		static FdsSimulator instance;
+		return instance;
+	}
+
+	/**
+	 * Start simulating with given config: clears the page layout and queue, and resets the virtual time.
+	 */
+	void enable(const fds_simulator_config_t& config = fds_simulator_config_t());
+
+	void disable();
+
+	bool isEnabled() { return _enabled; }
+
+	void setCallback(fds_simulator_callback_t callback) { _callback = callback; }
+
+	/**
+	 * Queue a write of a record.
+	 *
+	 * @return NRF_SUCCESS, FDS_ERR_NO_SPACE_IN_QUEUES, or FDS_ERR_NO_SPACE_IN_FLASH.
+	 */
+	ret_code_t write(uint16_t recordKey, uint16_t fileId, const uint8_t* data, uint16_t size);
+
+	/**
+	 * Queue a delete of the records with given key and file.
+	 *
+	 * @return NRF_SUCCESS, or FDS_ERR_NO_SPACE_IN_QUEUES.
+	 */
+	ret_code_t remove(uint16_t recordKey, uint16_t fileId);
+
+	/**
+	 * Queue a delete of all records of a file.
+	 *
+	 * @return NRF_SUCCESS, or FDS_ERR_NO_SPACE_IN_QUEUES.
+	 */
+	ret_code_t removeFile(uint16_t fileId);
+
+	/**
+	 * Queue garbage collection.
+	 *
+	 * @return NRF_SUCCESS, or FDS_ERR_NO_SPACE_IN_QUEUES.
+	 */
+	ret_code_t garbageCollect();
+
+	/**
+	 * Let virtual time pass, completing all operations that are done by then.
+	 */
+	void advance(uint32_t ms);
+
+	uint32_t getTimeMs() { return _timeUs / 1000; }
+
+	bool isIdle() { return _queue.empty(); }
+
+	/**
+	 * Get the number of words taken up by deleted records, like fds_stat().
+	 */
+	uint32_t getFreeableWords();
+
+	uint32_t getNumPageErases() { return _numPageErases; }
+
+	uint32_t getNumWordsWritten() { return _numWordsWritten; }
+
+private:
+	FdsSimulator() = default;
+
+	enum fds_simulator_record_state_t : uint8_t {
+		FDS_SIMULATOR_RECORD_RESERVED,
+		FDS_SIMULATOR_RECORD_VALID,
+		FDS_SIMULATOR_RECORD_DELETED,
+	};
+
+	struct fds_simulator_record_t {
+		uint16_t recordKey;
+		uint16_t fileId;
+		uint16_t lengthWords;
+		fds_simulator_record_state_t state;
+	};
+
+	struct fds_simulator_page_t {
+		std::vector<fds_simulator_record_t> records;
+		uint16_t usedWords = 0;
+	};
+
+	bool _enabled = false;
+	fds_simulator_config_t _config;
+	fds_simulator_callback_t _callback = nullptr;
+	uint64_t _timeUs                   = 0;
+	uint32_t _numPageErases            = 0;
+	uint32_t _numWordsWritten          = 0;
+	uint32_t _lastRecordId             = 0;
+
+	/**
+	 * Data pages, the swap page is not part of the layout.
+	 */
+	std::vector<fds_simulator_page_t> _pages;
+
+	std::deque<fds_simulator_op_t> _queue;
+
+	ret_code_t enqueue(fds_simulator_op_t& op);
+
+	/**
+	 * Set the completion time of the operation at the front of the queue.
+	 */
+	void startFront();
+
+	uint32_t getDurationUs(const fds_simulator_op_t& op);
+
+	/**
+	 * Update the page layout for a completed operation, and fill the event.
+	 */
+	void apply(const fds_simulator_op_t& op, fds_evt_t& event);
+
+	/**
+	 * Mark all valid records with given key and file as deleted.
+	 *
+	 * @param[in] recordKey       Record key, or 0 to match all keys.
+	 */
+	void markDeleted(uint16_t recordKey, uint16_t fileId);
+
+	bool hasValidRecord(uint16_t recordKey, uint16_t fileId);
+
+	uint16_t getAvailableWords(const fds_simulator_page_t& page);
+};
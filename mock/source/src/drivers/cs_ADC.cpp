@@ -0,0 +1,124 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <drivers/cs_ADC.h>
+#include <drivers/cs_RTC.h>
+#include <events/cs_Event.h>
+#include <logging/cs_Logger.h>
+
+// The SAADC is configured for 12 bit samples.
+#define ADC_MOCK_BITS 12
+
+cs_ret_code_t ADC::init(const adc_config_t& config) {
+	_config = config;
+	LOGi("init: period=%uus", _config.samplingIntervalUs);
+	for (int i = 0; i < _config.channelCount; ++i) {
+		_channelResultConfigs[i].samplingIntervalUs = config.samplingIntervalUs;
+		initChannel(i, _config.channels[i]);
+	}
+	return AdcBuffer::getInstance().init();
+}
+
+void ADC::initChannel(adc_channel_id_t channel, const adc_channel_config_t& config) {
+	adc_channel_config_result_t& result = _channelResultConfigs[channel];
+	result.pin                          = config.pin;
+	result.referencePin                 = config.referencePin;
+	result.maxValueMilliVolt            = config.rangeMilliVolt;
+	if (config.referencePin == CS_ADC_REF_PIN_NOT_AVAILABLE) {
+		result.maxSampleValue    = (1 << ADC_MOCK_BITS) - 1;
+		result.minSampleValue    = 0;
+		result.minValueMilliVolt = 0;
+	}
+	else {
+		result.maxSampleValue    = (1 << (ADC_MOCK_BITS - 1)) - 1;
+		result.minSampleValue    = -1 * result.maxSampleValue;
+		result.minValueMilliVolt = -1 * result.maxValueMilliVolt;
+	}
+}
+
+void ADC::start() {
+	_firstBuffer = true;
+}
+
+void ADC::stop() {}
+
+void ADC::setDoneCallback(adc_done_cb_t callback) {
+	_doneCallback = callback;
+}
+
+void ADC::setZeroCrossingCallback(adc_zero_crossing_cb_t callback) {
+	_zeroCrossingCallback = callback;
+}
+
+void ADC::enableZeroCrossingInterrupt(
+		[[maybe_unused]] adc_channel_id_t channel, [[maybe_unused]] int32_t zeroVal) {}
+
+cs_ret_code_t ADC::enableLimitGuard(adc_channel_id_t channel, int32_t lowLimit, int32_t highLimit) {
+	if (channel >= _config.channelCount) {
+		return ERR_ADC_INVALID_CHANNEL;
+	}
+	_limitGuardChannel   = channel;
+	_limitGuardLow       = lowLimit;
+	_limitGuardHigh      = highLimit;
+	_limitGuardTriggered = false;
+	_limitGuardEnabled   = true;
+	return ERR_SUCCESS;
+}
+
+void ADC::disableLimitGuard() {
+	_limitGuardEnabled = false;
+}
+
+bool ADC::isLimitGuardTriggered() {
+	return _limitGuardTriggered;
+}
+
+cs_ret_code_t ADC::changeChannel(adc_channel_id_t channel, adc_channel_config_t& config) {
+	if (channel >= _config.channelCount) {
+		return ERR_ADC_INVALID_CHANNEL;
+	}
+	_config.channels[channel] = config;
+	initChannel(channel, config);
+	return ERR_SUCCESS;
+}
+
+const adc_channel_config_result_t& ADC::getChannelResultConfig(adc_channel_id_t channel) {
+	return _channelResultConfigs[channel];
+}
+
+void ADC::markBufferFilled(adc_buffer_id_t bufIndex) {
+	adc_buffer_t* buf = AdcBuffer::getInstance().getBuffer(bufIndex);
+	for (int i = 0; i < _config.channelCount; ++i) {
+		buf->config[i] = _channelResultConfigs[i];
+	}
+	buf->valid     = true;
+	buf->seqNr     = _bufSeqNr++;
+	buf->doneTicks = RTC::getCount();
+
+	if (_limitGuardEnabled) {
+		for (adc_sample_value_id_t i = 0; i < AdcBuffer::getChannelLength(); ++i) {
+			adc_sample_value_t value = AdcBuffer::getInstance().getValue(bufIndex, _limitGuardChannel, i);
+			if (value < _limitGuardLow || value > _limitGuardHigh) {
+				_limitGuardEnabled   = false;
+				_limitGuardTriggered = true;
+				break;
+			}
+		}
+	}
+}
+
+void ADC::_handleAdcDone(adc_buffer_id_t bufIndex) {
+	if (_doneCallback == nullptr) {
+		return;
+	}
+	if (_firstBuffer) {
+		event_t event(CS_TYPE::EVT_ADC_RESTARTED, NULL, 0);
+		event.dispatch();
+	}
+	_firstBuffer = false;
+	_doneCallback(bufIndex);
+}
@@ -0,0 +1,267 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <drivers/cs_FdsSimulator.h>
+
+#include <cstring>
+
+// Size in words of the tag at the start of each page.
+const uint16_t FDS_SIMULATOR_PAGE_TAG_WORDS      = 2;
+// Size in words of the header of each record.
+const uint16_t FDS_SIMULATOR_RECORD_HEADER_WORDS = 3;
+
+void FdsSimulator::enable(const fds_simulator_config_t& config) {
+	_config          = config;
+	_enabled         = true;
+	_timeUs          = 0;
+	_numPageErases   = 0;
+	_numWordsWritten = 0;
+	_queue.clear();
+	_pages.clear();
+	_pages.resize(_config.numPages - 1);
+}
+
+void FdsSimulator::disable() {
+	_enabled = false;
+	_queue.clear();
+	_pages.clear();
+}
+
+ret_code_t FdsSimulator::write(uint16_t recordKey, uint16_t fileId, const uint8_t* data, uint16_t size) {
+	if (_queue.size() >= _config.queueSize) {
+		return FDS_ERR_NO_SPACE_IN_QUEUES;
+	}
+	uint16_t dataWords   = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+	uint16_t lengthWords = FDS_SIMULATOR_RECORD_HEADER_WORDS + dataWords;
+	for (uint16_t i = 0; i < _pages.size(); ++i) {
+		if (getAvailableWords(_pages[i]) < lengthWords) {
+			continue;
+		}
+		_pages[i].records.push_back({recordKey, fileId, lengthWords, FDS_SIMULATOR_RECORD_RESERVED});
+		_pages[i].usedWords += lengthWords;
+
+		fds_simulator_op_t op;
+		op.id        = FDS_EVT_WRITE;
+		op.recordKey = recordKey;
+		op.fileId    = fileId;
+		op.data.assign(dataWords * sizeof(uint32_t), 0xFF);
+		if (size != 0) {
+			memcpy(op.data.data(), data, size);
+		}
+		op.size     = size;
+		op.page     = i;
+		op.isUpdate = hasValidRecord(recordKey, fileId);
+		return enqueue(op);
+	}
+	return FDS_ERR_NO_SPACE_IN_FLASH;
+}
+
+ret_code_t FdsSimulator::remove(uint16_t recordKey, uint16_t fileId) {
+	fds_simulator_op_t op;
+	op.id        = FDS_EVT_DEL_RECORD;
+	op.recordKey = recordKey;
+	op.fileId    = fileId;
+	return enqueue(op);
+}
+
+ret_code_t FdsSimulator::removeFile(uint16_t fileId) {
+	fds_simulator_op_t op;
+	op.id        = FDS_EVT_DEL_FILE;
+	op.recordKey = 0;
+	op.fileId    = fileId;
+	return enqueue(op);
+}
+
+ret_code_t FdsSimulator::garbageCollect() {
+	fds_simulator_op_t op;
+	op.id        = FDS_EVT_GC;
+	op.recordKey = 0;
+	op.fileId    = 0;
+	return enqueue(op);
+}
+
+/**
+ * The callback can queue new operations, so the next operation is started before calling it.
+ */
+void FdsSimulator::advance(uint32_t ms) {
+	uint64_t endUs = _timeUs + static_cast<uint64_t>(ms) * 1000;
+	while (!_queue.empty() && _queue.front().completionUs <= endUs) {
+		fds_simulator_op_t op = std::move(_queue.front());
+		_queue.pop_front();
+		_timeUs = op.completionUs;
+
+		fds_evt_t event = {};
+		apply(op, event);
+		if (!_queue.empty()) {
+			startFront();
+		}
+		if (_callback != nullptr) {
+			_callback(op, event);
+		}
+	}
+	_timeUs = endUs;
+}
+
+uint32_t FdsSimulator::getFreeableWords() {
+	uint32_t freeableWords = 0;
+	for (auto& page : _pages) {
+		for (auto& record : page.records) {
+			if (record.state == FDS_SIMULATOR_RECORD_DELETED) {
+				freeableWords += record.lengthWords;
+			}
+		}
+	}
+	return freeableWords;
+}
+
+ret_code_t FdsSimulator::enqueue(fds_simulator_op_t& op) {
+	if (_queue.size() >= _config.queueSize) {
+		return FDS_ERR_NO_SPACE_IN_QUEUES;
+	}
+	_queue.push_back(std::move(op));
+	if (_queue.size() == 1) {
+		startFront();
+	}
+	return NRF_SUCCESS;
+}
+
+void FdsSimulator::startFront() {
+	fds_simulator_op_t& op = _queue.front();
+	op.completionUs        = _timeUs + getDurationUs(op);
+}
+
+uint32_t FdsSimulator::getDurationUs(const fds_simulator_op_t& op) {
+	uint32_t durationUs = _config.operationOverheadUs;
+	switch (op.id) {
+		case FDS_EVT_WRITE: {
+			uint32_t words = FDS_SIMULATOR_RECORD_HEADER_WORDS + op.data.size() / sizeof(uint32_t);
+			if (op.isUpdate) {
+				// The old record is deleted afterwards.
+				words++;
+			}
+			durationUs += words * _config.wordWriteUs;
+			break;
+		}
+		case FDS_EVT_DEL_RECORD:
+		case FDS_EVT_DEL_FILE: {
+			// Deleting a record overwrites a word of its header.
+			for (auto& page : _pages) {
+				for (auto& record : page.records) {
+					if (record.state == FDS_SIMULATOR_RECORD_VALID && record.fileId == op.fileId
+						&& (op.recordKey == 0 || record.recordKey == op.recordKey)) {
+						durationUs += _config.wordWriteUs;
+					}
+				}
+			}
+			break;
+		}
+		case FDS_EVT_GC: {
+			for (auto& page : _pages) {
+				uint32_t keptWords = 0;
+				bool dirty         = false;
+				for (auto& record : page.records) {
+					if (record.state == FDS_SIMULATOR_RECORD_DELETED) {
+						dirty = true;
+					}
+					else {
+						keptWords += record.lengthWords;
+					}
+				}
+				if (dirty) {
+					durationUs += keptWords * _config.wordWriteUs + _config.pageEraseUs;
+				}
+			}
+			break;
+		}
+		default: break;
+	}
+	return durationUs;
+}
+
+void FdsSimulator::apply(const fds_simulator_op_t& op, fds_evt_t& event) {
+	event.id     = op.id;
+	event.result = NRF_SUCCESS;
+	switch (op.id) {
+		case FDS_EVT_WRITE: {
+			if (op.isUpdate) {
+				markDeleted(op.recordKey, op.fileId);
+				event.id = FDS_EVT_UPDATE;
+			}
+			for (auto& record : _pages[op.page].records) {
+				if (record.state == FDS_SIMULATOR_RECORD_RESERVED && record.recordKey == op.recordKey
+					&& record.fileId == op.fileId) {
+					record.state = FDS_SIMULATOR_RECORD_VALID;
+					_numWordsWritten += record.lengthWords;
+					break;
+				}
+			}
+			event.write.record_id         = ++_lastRecordId;
+			event.write.file_id           = op.fileId;
+			event.write.record_key        = op.recordKey;
+			event.write.is_record_updated = op.isUpdate;
+			break;
+		}
+		case FDS_EVT_DEL_RECORD:
+		case FDS_EVT_DEL_FILE: {
+			markDeleted(op.recordKey, op.fileId);
+			event.del.file_id    = op.fileId;
+			event.del.record_key = op.recordKey;
+			break;
+		}
+		case FDS_EVT_GC: {
+			for (auto& page : _pages) {
+				bool dirty = false;
+				for (auto& record : page.records) {
+					dirty |= (record.state == FDS_SIMULATOR_RECORD_DELETED);
+				}
+				if (!dirty) {
+					continue;
+				}
+				std::vector<fds_simulator_record_t> keptRecords;
+				page.usedWords = 0;
+				for (auto& record : page.records) {
+					if (record.state != FDS_SIMULATOR_RECORD_DELETED) {
+						keptRecords.push_back(record);
+						page.usedWords += record.lengthWords;
+						_numWordsWritten += record.lengthWords;
+					}
+				}
+				page.records = std::move(keptRecords);
+				_numPageErases++;
+			}
+			break;
+		}
+		default: break;
+	}
+}
+
+void FdsSimulator::markDeleted(uint16_t recordKey, uint16_t fileId) {
+	for (auto& page : _pages) {
+		for (auto& record : page.records) {
+			if (record.state == FDS_SIMULATOR_RECORD_VALID && record.fileId == fileId
+				&& (recordKey == 0 || record.recordKey == recordKey)) {
+				record.state = FDS_SIMULATOR_RECORD_DELETED;
+			}
+		}
+	}
+}
+
+bool FdsSimulator::hasValidRecord(uint16_t recordKey, uint16_t fileId) {
+	for (auto& page : _pages) {
+		for (auto& record : page.records) {
+			if (record.state == FDS_SIMULATOR_RECORD_VALID && record.recordKey == recordKey
+				&& record.fileId == fileId) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+uint16_t FdsSimulator::getAvailableWords(const fds_simulator_page_t& page) {
+	return _config.pageSizeWords - FDS_SIMULATOR_PAGE_TAG_WORDS - page.usedWords;
+}
@@ -6,6 +6,7 @@
  */
 
 #include <common/cs_Types.h>
+#include <drivers/cs_FdsSimulator.h>
 #include <drivers/cs_Storage.h>
 #include <events/cs_Event.h>
 #include <logging/cs_Logger.h>
@@ -15,6 +16,7 @@
 #define LOGStorageMockDebug LOGvv
 
 // this contains the data of the static storage instance.
+// The values are copies, owned by this mock, like the data in flash.
 std::vector<cs_state_data_t> _storage;
 
 
@@ -66,7 +68,7 @@ cs_ret_code_t _remove(Storage& s, P predicate){
 		return ERR_BUSY;
 	}
 
-	int eraseCount = eraseIf(_storage, predicate);
+	int eraseCount = eraseRecords(predicate);
 
 	if(eraseCount == 0) {
 		return ERR_NOT_FOUND;
@@ -81,10 +83,6 @@ cs_ret_code_t _remove(Storage& s, P predicate){
  */
 template<class I>
 cs_ret_code_t _read(Storage& s, cs_state_data_t& data, I foundIter) {
-	if(s.isBusy()) {
-		return ERR_BUSY;
-	}
-
 	if (foundIter == NOT_FOUND()) {
 		return ERR_NOT_FOUND;
 	}
@@ -93,7 +91,7 @@ cs_ret_code_t _read(Storage& s, cs_state_data_t& data, I foundIter) {
 		return ERR_WRONG_PAYLOAD_LENGTH;
 	}
 
-	data.value = foundIter->value;
+	memcpy(data.value, foundIter->value, data.size);
 	return ERR_SUCCESS;
 }
 
@@ -172,37 +170,150 @@ int eraseIf(C& container, const Pred& pred) {
 	return removedCount;
 }
 
+/**
+ * Erase records from storage, and free their values.
+ *
+ * @return: number of erased records.
+ */
+template<class Pred>
+int eraseRecords(const Pred& pred) {
+	for (auto& rec : _storage) {
+		if (pred(rec)) {
+			delete[] rec.value;
+		}
+	}
+	return eraseIf(_storage, pred);
+}
+
+/**
+ * Replace the record with same type and id by a copy of given data.
+ */
+void storeRecord(CS_TYPE type, cs_state_id_t id, const uint8_t* value, size16_t size) {
+	int removeCount = eraseRecords(matchIdType(id, type));
+	if(removeCount) {
+		LOGd("removed %u old entrie(s)", removeCount);
+	}
+
+	cs_state_data_t rec(type, id, new uint8_t[size], size);
+	if (size != 0) {
+		memcpy(rec.value, value, size);
+	}
+	LOGStorageMockDebug("Storage::write pushing back data.");
+	_storage.push_back(rec);
+}
+
+// --- FDS simulator
+
+/**
+ * Apply the completed operation to the storage, then handle the event like FDS events are handled.
+ */
+void onSimulatedOperationDone(const fds_simulator_op_t& op, const fds_evt_t& event) {
+	cs_state_id_t id = op.fileId - FILE_CONFIGURATION;
+	switch (op.id) {
+		case FDS_EVT_WRITE: {
+			storeRecord(toCsType(op.recordKey), id, op.data.data(), op.size);
+			break;
+		}
+		case FDS_EVT_DEL_RECORD: {
+			eraseRecords(matchIdType(id, toCsType(op.recordKey)));
+			break;
+		}
+		case FDS_EVT_DEL_FILE: {
+			eraseRecords(matchId(id));
+			break;
+		}
+		default: break;
+	}
+	Storage::getInstance().handleFileStorageEvent(&event);
+}
+
 // ------------- implemented -------------
 
 cs_ret_code_t Storage::init() {
 	LOGi("Mock Storage::init()");
+	FdsSimulator::getInstance().setCallback(onSimulatedOperationDone);
 	_initialized = true;
 	return ERR_SUCCESS;
 }
 
+/**
+ * Without the FDS simulator, operations complete immediately, so storage is never busy.
+ */
 bool Storage::isBusy() {
+	if (!FdsSimulator::getInstance().isEnabled()) {
+		return false;
+	}
+	return _collectingGarbage || _removingFile || _performingFactoryReset || !_busyRecordKeys.empty();
+}
+
+bool Storage::isBusy(uint16_t recordKey) {
+	if (!FdsSimulator::getInstance().isEnabled()) {
+		return false;
+	}
+	if (_collectingGarbage || _removingFile || _performingFactoryReset) {
+		return true;
+	}
+	for (auto& busyRecord : _busyRecordKeys) {
+		if (busyRecord.recordKey == recordKey) {
+			return true;
+		}
+	}
 	return false;
 }
 
+/**
+ * The start count is the virtual time of the FDS simulator in ms, instead of the RTC count.
+ */
+void Storage::setBusy(uint16_t recordKey) {
+	_busyRecordKeys.push_back({recordKey, FdsSimulator::getInstance().getTimeMs()});
+}
+
+void Storage::clearBusy(uint16_t recordKey) {
+	for (auto it = _busyRecordKeys.begin(); it != _busyRecordKeys.end(); it++) {
+		if (it->recordKey == recordKey) {
+			_stats.onOperationDone(FdsSimulator::getInstance().getTimeMs() - it->startCount);
+			_busyRecordKeys.erase(it);
+			return;
+		}
+	}
+}
+
 cs_ret_code_t Storage::write(const cs_state_data_t& data) {
 	if (!_initialized) {
 		LOGe(STR_ERR_NOT_INITIALIZED);
 		return ERR_NOT_INITIALIZED;
 	}
 
-	int removeCount = eraseIf(_storage, equalTo(data));
-	if(removeCount) {
-		LOGd("removed %u old entrie(s)", removeCount);
+	FdsSimulator& simulator = FdsSimulator::getInstance();
+	if (!simulator.isEnabled()) {
+		storeRecord(data.type, data.id, data.value, data.size);
+		_stats.onWrite(data.type);
+		return ERR_SUCCESS;
 	}
 
-	LOGStorageMockDebug("Storage::write pushing back data.");
-	_storage.push_back(data);
-
-	return ERR_SUCCESS;
+	uint16_t recordKey = to_underlying_type(data.type);
+	if (isBusy(recordKey)) {
+		return ERR_BUSY;
+	}
+	switch (simulator.write(recordKey, getFileId(data.id), data.value, data.size)) {
+		case NRF_SUCCESS: {
+			setBusy(recordKey);
+			_stats.onWrite(data.type);
+			return ERR_SUCCESS;
+		}
+		case FDS_ERR_NO_SPACE_IN_FLASH: {
+			LOGStorageMockDebug("Flash full, start garbage collection");
+			garbageCollect();
+			return ERR_BUSY;
+		}
+		default: {
+			return ERR_BUSY;
+		}
+	}
 }
 
 cs_ret_code_t Storage::eraseAllPages() {
-	_storage.clear();
+	eraseRecords([](cs_state_data_t rec) { return true; });
 	return ERR_SUCCESS;
 }
 
@@ -217,8 +328,32 @@ cs_ret_code_t Storage::factoryReset() {
 	if (isBusy()) {
 		return ERR_BUSY;
 	}
-	_performingFactoryReset = true;
-	eraseAllPages();
+	if (!FdsSimulator::getInstance().isEnabled()) {
+		_performingFactoryReset = true;
+		eraseAllPages();
+		return ERR_SUCCESS;
+	}
+	cs_ret_code_t retCode = continueFactoryReset();
+	if (retCode == ERR_SUCCESS) {
+		_performingFactoryReset = true;
+	}
+	return retCode;
+}
+
+/**
+ * Removes one record at a time, continued when the remove is done. Finishes with garbage collection.
+ */
+cs_ret_code_t Storage::continueFactoryReset() {
+	auto recordIter = findIf(_storage, [](cs_state_data_t rec) { return removeOnFactoryReset(rec.type, rec.id); });
+	if (recordIter == NOT_FOUND()) {
+		return startGarbageCollection() == NRF_SUCCESS ? ERR_SUCCESS : ERR_BUSY;
+	}
+	uint16_t recordKey = to_underlying_type(recordIter->type);
+	if (FdsSimulator::getInstance().remove(recordKey, getFileId(recordIter->id)) != NRF_SUCCESS) {
+		return ERR_BUSY;
+	}
+	setBusy(recordKey);
+	_stats.onRemove(recordIter->type);
 	return ERR_SUCCESS;
 }
 
@@ -238,15 +373,77 @@ cs_ret_code_t Storage::findNext(CS_TYPE type, cs_state_id_t& id) {
 }
 
 cs_ret_code_t Storage::remove(CS_TYPE type, cs_state_id_t id) {
-	return _remove(*this, matchIdType(id, type));
+	if (FdsSimulator::getInstance().isEnabled()) {
+		if (!_initialized) {
+			return ERR_NOT_INITIALIZED;
+		}
+		uint16_t recordKey = to_underlying_type(type);
+		if (isBusy(recordKey)) {
+			return ERR_BUSY;
+		}
+		if (findIf(_storage, matchIdType(id, type)) == NOT_FOUND()) {
+			return ERR_NOT_FOUND;
+		}
+		if (FdsSimulator::getInstance().remove(recordKey, getFileId(id)) != NRF_SUCCESS) {
+			return ERR_BUSY;
+		}
+		setBusy(recordKey);
+		_stats.onRemove(type);
+		return ERR_SUCCESS;
+	}
+	cs_ret_code_t retCode = _remove(*this, matchIdType(id, type));
+	if (retCode == ERR_SUCCESS) {
+		_stats.onRemove(type);
+	}
+	return retCode;
 }
 
 cs_ret_code_t Storage::remove(CS_TYPE type) {
-	return _remove(*this, matchType(type));
+	if (FdsSimulator::getInstance().isEnabled()) {
+		if (!_initialized) {
+			return ERR_NOT_INITIALIZED;
+		}
+		uint16_t recordKey = to_underlying_type(type);
+		if (isBusy(recordKey)) {
+			return ERR_BUSY;
+		}
+		// Like FDS, each record is removed separately, so the record key can be set busy multiple times.
+		cs_ret_code_t retCode = ERR_NOT_FOUND;
+		for (auto& rec : _storage) {
+			if (rec.type != type) {
+				continue;
+			}
+			if (FdsSimulator::getInstance().remove(recordKey, getFileId(rec.id)) != NRF_SUCCESS) {
+				return ERR_BUSY;
+			}
+			setBusy(recordKey);
+			_stats.onRemove(type);
+			retCode = ERR_SUCCESS;
+		}
+		return retCode;
+	}
+	cs_ret_code_t retCode = _remove(*this, matchType(type));
+	if (retCode == ERR_SUCCESS) {
+		_stats.onRemove(type);
+	}
+	return retCode;
 }
 
 cs_ret_code_t Storage::remove(cs_state_id_t id) {
-	return _remove(*this, matchId(id));
+	if (!FdsSimulator::getInstance().isEnabled()) {
+		return _remove(*this, matchId(id));
+	}
+	if (!_initialized) {
+		return ERR_NOT_INITIALIZED;
+	}
+	if (isBusy()) {
+		return ERR_BUSY;
+	}
+	if (FdsSimulator::getInstance().removeFile(getFileId(id)) != NRF_SUCCESS) {
+		return ERR_BUSY;
+	}
+	_removingFile = true;
+	return ERR_SUCCESS;
 }
 
 cs_ret_code_t Storage::read(cs_state_data_t& data) {
@@ -266,6 +463,9 @@ cs_ret_code_t Storage::read(cs_state_data_t& data) {
 }
 
 cs_ret_code_t Storage::readFirst(cs_state_data_t& data) {
+	if (isBusy(to_underlying_type(data.type))) {
+		return ERR_BUSY;
+	}
 	return _readFrom(*this, data, std::begin(_storage));
 }
 
@@ -275,9 +475,12 @@ cs_ret_code_t Storage::readNext(cs_state_data_t& data) {
 	}
 	// Resumes search from lastFound. Call findFirst to restart.
 
+	if (isBusy(to_underlying_type(data.type))) {
+		return ERR_BUSY;
+	}
 	auto searchFrom = lastFound;
 	searchFrom++;
-	return _readFrom(*this, data, std::begin(_storage));
+	return _readFrom(*this, data, searchFrom);
 }
 
 cs_ret_code_t Storage::readV3ResetCounter(cs_state_data_t& data) {
@@ -300,6 +503,7 @@ void Storage::handleFileStorageEvent(fds_evt_t const* p_fds_evt) {
 		}
 		case FDS_EVT_WRITE:
 		case FDS_EVT_UPDATE: {
+			clearBusy(p_fds_evt->write.record_key);
 			TYPIFY(EVT_STORAGE_WRITE_DONE) eventData;
 			eventData.type = toCsType(p_fds_evt->write.record_key);
 			eventData.id   = getStateId(p_fds_evt->write.file_id);
@@ -310,6 +514,13 @@ void Storage::handleFileStorageEvent(fds_evt_t const* p_fds_evt) {
 			break;
 		}
 		case FDS_EVT_DEL_RECORD: {
+			clearBusy(p_fds_evt->del.record_key);
+			if (_performingFactoryReset && FdsSimulator::getInstance().isEnabled()) {
+				if (continueFactoryReset() != ERR_SUCCESS) {
+					LOGw("Factory reset stalled");
+				}
+				break;
+			}
 
 			TYPIFY(EVT_STORAGE_REMOVE_DONE) eventData;
 			eventData.type = toCsType(p_fds_evt->del.record_key);
@@ -320,6 +531,7 @@ void Storage::handleFileStorageEvent(fds_evt_t const* p_fds_evt) {
 			break;
 		}
 		case FDS_EVT_DEL_FILE: {
+			_removingFile    = false;
 			cs_state_id_t id = getStateId(p_fds_evt->write.file_id);
 
 			event_t event(CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE, &id, sizeof(id));
@@ -327,6 +539,15 @@ void Storage::handleFileStorageEvent(fds_evt_t const* p_fds_evt) {
 			break;
 		}
 		case FDS_EVT_GC: {
+			if (_collectingGarbage) {
+				_collectingGarbage      = false;
+				uint32_t durationMs     = FdsSimulator::getInstance().getTimeMs() - _garbageCollectionStartCount;
+				uint32_t reclaimedWords = 0;
+				if (_garbageCollectionFreeableWords > getFreeableWords()) {
+					reclaimedWords = _garbageCollectionFreeableWords - getFreeableWords();
+				}
+				_stats.onGarbageCollectionDone(durationMs, reclaimedWords * sizeof(uint32_t));
+			}
 			if (_performingFactoryReset) {
 				_performingFactoryReset = false;
 				event_t resetEvent(CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE);
@@ -359,8 +580,30 @@ void Storage::setErrorCallback(cs_storage_error_callback_t callback) {
 }
 
 cs_ret_code_t Storage::garbageCollect() {
-	// TODO: not implemented
-	return ERR_SUCCESS;
+	if (!FdsSimulator::getInstance().isEnabled()) {
+		return ERR_SUCCESS;
+	}
+	if (!_initialized) {
+		return ERR_NOT_INITIALIZED;
+	}
+	if (_collectingGarbage) {
+		return ERR_SUCCESS;
+	}
+	return startGarbageCollection() == NRF_SUCCESS ? ERR_SUCCESS : ERR_BUSY;
+}
+
+ret_code_t Storage::startGarbageCollection() {
+	ret_code_t fdsRetCode = FdsSimulator::getInstance().garbageCollect();
+	if (fdsRetCode == NRF_SUCCESS) {
+		_collectingGarbage              = true;
+		_garbageCollectionStartCount    = FdsSimulator::getInstance().getTimeMs();
+		_garbageCollectionFreeableWords = getFreeableWords();
+	}
+	return fdsRetCode;
+}
+
+uint32_t Storage::getFreeableWords() {
+	return FdsSimulator::getInstance().getFreeableWords();
 }
 
 cs_ret_code_t Storage::erasePages(const CS_TYPE doneEvent, void* startAddress, void* endAddress) {
@@ -0,0 +1,57 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <storage/cs_IpcRamBluenet.h>
+
+#include <cstring>
+
+/**
+ * Host version of the IPC ram: there is no retained ram, so the data only lives in the cache, and is never valid on
+ * boot.
+ */
+
+IpcRamBluenet::IpcRamBluenet() {
+	clearData();
+}
+
+IpcRamBluenet& IpcRamBluenet::getInstance() {
+	static IpcRamBluenet instance;
+	return instance;
+}
+
+void IpcRamBluenet::init() {
+	clearData();
+}
+
+bool IpcRamBluenet::isValidOnBoot() {
+	return _isValidOnBoot;
+}
+
+void IpcRamBluenet::clearData() {
+	memset(_ipcData.raw, 0, sizeof(_ipcData.raw));
+	_ipcData.bluenetRebootData.ipcDataMajor = BLUENET_IPC_BLUENET_REBOOT_DATA_MAJOR;
+	_ipcData.bluenetRebootData.ipcDataMinor = BLUENET_IPC_BLUENET_REBOOT_DATA_MINOR;
+}
+
+const bluenet_ipc_bluenet_data_t& IpcRamBluenet::getData() {
+	return _ipcData.bluenetRebootData;
+}
+
+void IpcRamBluenet::updateData() {}
+
+void IpcRamBluenet::updateEnergyUsed(const int64_t& energyUsed) {
+	_ipcData.bluenetRebootData.energyUsedMicroJoule = energyUsed;
+}
+
+void IpcRamBluenet::updateMicroappData(uint8_t appIndex, const microapp_reboot_data_t& data) {
+	if (appIndex >= BLUENET_IPC_MICROAPP_COUNT) {
+		return;
+	}
+	_ipcData.bluenetRebootData.microapp[appIndex] = data;
+}
+
+void IpcRamBluenet::printData() {}
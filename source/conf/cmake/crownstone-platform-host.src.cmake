@@ -6,11 +6,15 @@ message(STATUS "crownstone platform mock source files appended to FOLDER_SOURCE"
 
 list(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/util/cs_BleError.c")
 
+LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_ADC.cpp")
 LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_PWM.cpp")
 LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_Relay.cpp")
 LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_RNG.cpp")
 list(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_RTC.cpp")
 LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_Serial.cpp")
 LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_Storage.cpp")
+LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_FdsSimulator.cpp")
 list(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_Uicr.c")
 LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/drivers/cs_PWM.cpp")
+
+LIST(APPEND FOLDER_SOURCE "${CMAKE_BLUENET_SOURCE_DIR_MOCK}/storage/cs_IpcRamBluenet.cpp")
@@ -15,3 +15,25 @@ LIST(APPEND TEST_SOURCE_FILES "scenarios/test_BehaviourConflictWithPresence.cpp"
 LIST(APPEND TEST_SOURCE_FILES "storage/test_StorageWrite.cpp")
 LIST(APPEND TEST_SOURCE_FILES "storage/test_StateSetGet.cpp")
 LIST(APPEND TEST_SOURCE_FILES "storage/test_StorageEvents.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StateRamLookupBenchmark.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StateValuePool.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StateWriteBack.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StateStoreQueue.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StorageStats.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StorageSimulator.cpp")
+LIST(APPEND TEST_SOURCE_FILES "storage/test_StorageRecordIndex.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_EventDispatcherBenchmark.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_AdvIndex.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_AssetFilterPlan.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_IndexedStore.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_CuckooFilterLookup.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_ExactMatchFilterLayout.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_SlidingMedianFilter.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_PowerKernel.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_PowerQuality.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_RunningMedian.cpp")
+LIST(APPEND TEST_SOURCE_FILES "test_SoftfuseLatency.cpp")
+LIST(APPEND TEST_SOURCE_FILES "power/test_PowerSamplingReplay.cpp")
+LIST(APPEND TEST_SOURCE_FILES "power/test_PowerSamplingSteady.cpp")
+LIST(APPEND TEST_SOURCE_FILES "power/test_PowerSamplingHarmonics.cpp")
+LIST(APPEND TEST_SOURCE_FILES "power/test_RecognizeSwitchReplay.cpp")
@@ -145,6 +145,12 @@ ADD_DEFINITIONS("-DBUILD_CLOSEST_CROWNSTONE_TRACKER=${BUILD_CLOSEST_CROWNSTONE_T
 # Build for memory usage test
 ADD_DEFINITIONS("-DBUILD_MEM_USAGE_TEST=${BUILD_MEM_USAGE_TEST}")
 
+# Index the records in flash at boot
+ADD_DEFINITIONS("-DBUILD_FLASH_RECORD_INDEX=${BUILD_FLASH_RECORD_INDEX}")
+
+# Split the ADC buffers into a plane per channel
+ADD_DEFINITIONS("-DBUILD_ADC_DEINTERLEAVED=${BUILD_ADC_DEINTERLEAVED}")
+
 # Publish options as CMake options as well
 SET(NRF5_DIR                                    "${NRF5_DIR}"                       CACHE STRING "Nordic SDK Directory" FORCE)
 SET(NORDIC_SDK_VERSION                          "${NORDIC_SDK_VERSION}"             CACHE STRING "Nordic SDK Version" FORCE)
@@ -171,7 +171,7 @@
 //#define CURRENT_ZERO_EXP_AVG_DISCOUNT            1000 // No averaging
 #define POWER_EXP_AVG_DISCOUNT                   200 // Is divided by 1000, so 200 is a discount of 0.2. // 99% of the average is influenced by the last 21 values
 //#define POWER_EXP_AVG_DISCOUNT                   1000 // No averaging
-#define POWER_SAMPLING_RMS_WINDOW_SIZE           9 // Windows size used for filtering the power and current rms. Currently can only be 7, 9, or 25!
+#define POWER_SAMPLING_RMS_WINDOW_SIZE           9 // Windows size used for filtering the power and current rms. Should be odd.
 
 #define POWER_SAMPLING_CURVE_HALF_WINDOW_SIZE    5 // Half window size used for filtering the current curve. Can't just be any value!
 //#define POWER_SAMPLING_CURVE_HALF_WINDOW_SIZE    16 // Half window size used for filtering the current curve. Can't just be any value!
@@ -188,6 +188,18 @@
 #define CURRENT_USAGE_THRESHOLD_DIMMER           (1000)  // Power usage threshold in mA at which the PWM should be turned off.
 #define CURRENT_THRESHOLD_CONSECUTIVE            100 // Number of consecutive times the current has to be above the threshold before triggering the softfuse.
 #define CURRENT_THRESHOLD_DIMMER_CONSECUTIVE     20  // Number of consecutive times the current has to be above the threshold before triggering the softfuse.
+#define SOFTFUSE_LATENCY_BINS                    10  // Number of bins of the histogram of softfuse reaction latency.
+
+#define POWER_QUALITY_NUM_HARMONICS              4   // Number of odd harmonics of which the amplitude is measured: 1, 3, 5, 7.
+#define POWER_QUALITY_INTERVAL_PERIODS           50  // Number of AC periods over which the power quality is averaged, before it's published.
+
+#define POWER_SAMPLING_STEADY_ENABLED            false // Whether to skip processing of buffers while the load is steady.
+#define POWER_SAMPLING_STEADY_BUFFERS            50    // Number of consecutive buffers the load has to be within the band, before buffers are skipped.
+#define POWER_SAMPLING_STEADY_BAND_PART          0.05f // RMS current, RMS voltage and power have to stay within 5% of the values at the start of the band.
+#define POWER_SAMPLING_STEADY_BAND_MIN_MA        20    // But the band is at least so many mA wide.
+#define POWER_SAMPLING_STEADY_BAND_MIN_MV        2000  // And at least so many mV wide.
+#define POWER_SAMPLING_STEADY_BAND_MIN_MW        2000  // And at least so many mW wide.
+#define POWER_SAMPLING_STEADY_MAX_CURRENT_PART   0.8f  // Only skip buffers when the RMS current is below 80% of the softfuse threshold.
 
 
 #define SWITCHCRAFT_THRESHOLD                    (500000) // Threshold for switch recognition (float).
@@ -202,6 +214,15 @@ static const uint8_t DEFAULT_DIM_VALUE           = 40;
 
 #define SWITCH_DELAYED_STORE_MS                  (10 * 1000) // Timeout before storing the pwm switch value is stored.
 #define STATE_RETRY_STORE_DELAY_MS               200 // Time before retrying to store a varable to flash.
+#define STATE_RAM_INDEX_BUCKETS                  64 // Number of buckets of the index of state values in RAM, must be a power of 2.
+#define STATE_RAM_REGISTER_RESERVED_SIZE         64 // Number of state values in RAM to reserve space for at init.
+#define STATE_VALUE_POOL_SLAB_SIZE               128 // Bytes of slots per slab of the state value pool: each size class gets this size divided by its slot size slots per slab, at most 32.
+#define STATE_WRITE_BACK_DELAY_MS                1000 // Time without write-back sets before dirty state values are written to flash.
+#define STATE_WRITE_BACK_FLUSH_BUDGET            4 // Max number of dirty state values written to flash per tick.
+#define STATE_STORE_QUEUE_SIZE                   64 // Max number of queued flash operations of state, should fit an operation for every behaviour.
+#define STATE_STORE_QUEUE_BUCKETS                16 // Number of buckets of the index of the state store queue, must be a power of 2.
+#define STORAGE_STATS_NUM_TYPES                  8 // Number of types of which flash writes and removes are counted.
+#define STORAGE_STATS_LATENCY_BINS               10 // Number of bins of the histogram of flash operation latency.
 #define MESH_SEND_TIME_INTERVAL_MS               (50 * 1000) // Interval at which the time is sent via the mesh.
 #define MESH_SEND_TIME_INTERVAL_MS_VARIATION     (20 * 1000) // Max amount that gets added to interval.
 #define MESH_SEND_STATE_INTERVAL_MS              (50 * 1000) // Interval at which the stone state is sent via the mesh.
@@ -258,6 +279,8 @@ static const uint8_t DEFAULT_DIM_VALUE           = 40;
 #define ADVERTISING_REFRESH_PERIOD               500 // Push the changes in the advertisement packet to the stack every x milliseconds
 #define ADVERTISING_REFRESH_PERIOD_SETUP         500 // Push the changes in the advertisement packet to the stack every x milliseconds
 
+#define SCAN_ADV_INDEX_MAX_FIELDS                8 // Number of AD structures of a scanned advertisement that are indexed, more are searched on lookup.
+
 #define EXTERNAL_STATE_LIST_COUNT                10 // Number of stones to cache the state of, for advertising external state.
 #define EXTERNAL_STATE_TIMEOUT_MS                60000 // Time after which a state of another stone is considered to be timed out.
 
@@ -0,0 +1,492 @@
+/**
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+/**
+ * List of all types, with their properties.
+ *
+ * This file is included multiple times, with the macros below defined differently each time: once to declare the
+ * CS_TYPE enum, and once to build the table with properties of each type. So there is no include guard.
+ *
+ * - CS_STATE_TYPE(NAME, VALUE, IDS, FACTORY_RESET, ACCESS_SET, ACCESS_GET)
+ *   A state type, with the size of TYPIFY(NAME).
+ * - CS_STATE_TYPE_SIZED(NAME, VALUE, SIZE, IDS, FACTORY_RESET, ACCESS_SET, ACCESS_GET)
+ *   A state type, with an explicit size.
+ * - CS_INTERNAL_TYPE(NAME, VALUE)
+ *   An event or command type, with the size of TYPIFY(NAME).
+ *   These have a single ID, are removed on factory reset, and can't be set or get by the user.
+ * - CS_INTERNAL_TYPE_SIZED(NAME, VALUE, SIZE)
+ *   An event or command type, with an explicit size.
+ *
+ * Where:
+ * - IDS is SINGLE_ID or MULTIPLE_IDS.
+ * - FACTORY_RESET is REMOVE_ON_RESET or KEEP_ID_0_ON_RESET.
+ * - ACCESS_SET and ACCESS_GET are the EncryptionAccessLevel required to set or get the type.
+ *
+ * See cs_Types.h for the naming of types and the allowed values.
+ */
+
+// clang-format off
+
+// Record keys should be in the range 0x0001 - 0xBFFF. The value 0x0000 is reserved by the system. The values from
+// 0xC000 to 0xFFFF are reserved for use by the Peer Manager module and can only be used in applications that do not
+// include Peer Manager.
+CS_STATE_TYPE_SIZED(CONFIG_DO_NOT_USE, 0, 0, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+//	CONFIG_DEVICE_TYPE = 1
+//	CONFIG_ROOM = 2
+//	CONFIG_FLOOR = 3
+//	CONFIG_NEARBY_TIMEOUT = 4
+CS_STATE_TYPE(CONFIG_PWM_PERIOD, 5, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_IBEACON_MAJOR, 6, MULTIPLE_IDS, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_IBEACON_MINOR, 7, MULTIPLE_IDS, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_IBEACON_UUID, 8, MULTIPLE_IDS, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_IBEACON_TXPOWER, 9, MULTIPLE_IDS, REMOVE_ON_RESET, ADMIN, ADMIN)
+//	CONFIG_WIFI_SETTINGS = 10
+CS_STATE_TYPE(CONFIG_TX_POWER, 11, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+// Advertising interval in units of 0.625ms.
+CS_STATE_TYPE(CONFIG_ADV_INTERVAL, 12, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+//	CONFIG_PASSKEY = 13
+//	CONFIG_MIN_ENV_TEMP = 14
+//	CONFIG_MAX_ENV_TEMP = 15
+CS_STATE_TYPE(CONFIG_SCAN_DURATION, 16, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)  // Deprecate
+//	CONFIG_SCAN_SEND_DELAY = 17
+CS_STATE_TYPE(CONFIG_SCAN_BREAK_DURATION, 18, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)  // Deprecate
+CS_STATE_TYPE(CONFIG_BOOT_DELAY, 19, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_MAX_CHIP_TEMP, 20, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+//	CONFIG_SCAN_FILTER = 21
+//	CONFIG_SCAN_FILTER_SEND_FRACTION = 22
+// Not implemented yet, but something we want in the future.
+CS_STATE_TYPE_SIZED(CONFIG_CURRENT_LIMIT, 23, 0, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE(CONFIG_MESH_ENABLED, 24, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_ENCRYPTION_ENABLED, 25, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE(CONFIG_IBEACON_ENABLED, 26, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE(CONFIG_SCANNER_ENABLED, 27, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+//	CONFIG_CONT_POWER_SAMPLER_ENABLED = 28
+//	CONFIG_TRACKER_ENABLED = 29
+//	CONFIG_ADC_BURST_SAMPLE_RATE = 30
+//	CONFIG_POWER_SAMPLE_BURST_INTERVAL = 31
+//	CONFIG_POWER_SAMPLE_CONT_INTERVAL = 32
+CS_STATE_TYPE(CONFIG_SPHERE_ID, 33, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_CROWNSTONE_ID, 34, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE_SIZED(CONFIG_KEY_ADMIN, 35, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE_SIZED(CONFIG_KEY_MEMBER, 36, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE_SIZED(CONFIG_KEY_BASIC, 37, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+//	CONFIG_DEFAULT_ON = 38
+// Scan interval in 625 µs units.
+CS_STATE_TYPE(CONFIG_SCAN_INTERVAL_625US, 39, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+// Scan window in 625 µs units.
+CS_STATE_TYPE(CONFIG_SCAN_WINDOW_625US, 40, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_RELAY_HIGH_DURATION, 41, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_LOW_TX_POWER, 42, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_VOLTAGE_MULTIPLIER, 43, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_CURRENT_MULTIPLIER, 44, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_VOLTAGE_ADC_ZERO, 45, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_CURRENT_ADC_ZERO, 46, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_POWER_ZERO, 47, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+//	CONFIG_POWER_ZERO_AVG_WINDOW = 48
+//	CONFIG_MESH_ACCESS_ADDRESS = 49
+CS_STATE_TYPE(CONFIG_SOFT_FUSE_CURRENT_THRESHOLD, 50, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER, 51, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP, 52, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN, 53, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_DIMMING_ALLOWED, 54, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_SWITCH_LOCKED, 55, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_SWITCHCRAFT_ENABLED, 56, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_SWITCHCRAFT_THRESHOLD, 57, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+//	CONFIG_MESH_CHANNEL = 58
+CS_STATE_TYPE(CONFIG_UART_ENABLED, 59, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE_SIZED(CONFIG_NAME, 60, MAX_STRING_STORAGE_SIZE + 1, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE_SIZED(CONFIG_KEY_SERVICE_DATA, 61, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE_SIZED(CONFIG_MESH_DEVICE_KEY, 62, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE_SIZED(CONFIG_MESH_APP_KEY, 63, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE_SIZED(CONFIG_MESH_NET_KEY, 64, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE_SIZED(CONFIG_KEY_LOCALIZATION, 65, ENCRYPTION_KEY_LENGTH, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE(CONFIG_START_DIMMER_ON_ZERO_CROSSING, 66, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_TAP_TO_TOGGLE_ENABLED, 67, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET, 68, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE_SIZED(
+		STATE_BEHAVIOUR_RULE,
+		69,
+		WireFormat::size<SwitchBehaviour>(),
+		MULTIPLE_IDS,
+		REMOVE_ON_RESET,
+		NO_ONE,
+		NO_ONE)
+CS_STATE_TYPE_SIZED(
+		STATE_TWILIGHT_RULE,
+		70,
+		WireFormat::size<TwilightBehaviour>(),
+		MULTIPLE_IDS,
+		REMOVE_ON_RESET,
+		NO_ONE,
+		NO_ONE)
+CS_STATE_TYPE_SIZED(
+		STATE_EXTENDED_BEHAVIOUR_RULE,
+		71,
+		WireFormat::size<ExtendedSwitchBehaviour>(),
+		MULTIPLE_IDS,
+		REMOVE_ON_RESET,
+		NO_ONE,
+		NO_ONE)
+
+CS_STATE_TYPE(STATE_RESET_COUNTER, 128, SINGLE_ID, KEEP_ID_0_ON_RESET, NO_ONE, MEMBER)
+CS_STATE_TYPE(STATE_SWITCH_STATE, 129, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)
+CS_STATE_TYPE(STATE_ACCUMULATED_ENERGY, 130, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)  // Energy used in μJ.
+CS_STATE_TYPE(STATE_POWER_USAGE, 131, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)         // Power usage in mW.
+//	STATE_TRACKED_DEVICES
+//	STATE_SCHEDULE = 133
+CS_STATE_TYPE(STATE_OPERATION_MODE, 134, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+CS_STATE_TYPE(STATE_TEMPERATURE, 135, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)
+CS_STATE_TYPE(STATE_FACTORY_RESET, 137, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE)
+//	STATE_LEARNED_SWITCHES
+CS_STATE_TYPE(STATE_ERRORS, 139, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)
+//	STATE_ERROR_OVER_CURRENT
+//	STATE_ERROR_OVER_CURRENT_DIMMER
+//	STATE_ERROR_CHIP_TEMP
+//	STATE_ERROR_DIMMER_TEMP
+//	STATE_IGNORE_BITMASK
+//	STATE_IGNORE_ALL
+//	STATE_IGNORE_LOCATION
+//	STATE_ERROR_DIMMER_ON_FAILURE
+//	STATE_ERROR_DIMMER_OFF_FAILURE
+CS_STATE_TYPE(STATE_SUN_TIME, 149, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)
+CS_STATE_TYPE(STATE_BEHAVIOUR_SETTINGS, 150, SINGLE_ID, REMOVE_ON_RESET, MEMBER, BASIC)
+CS_STATE_TYPE(STATE_MESH_IV_INDEX, 151, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE(STATE_MESH_SEQ_NUMBER, 152, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE(STATE_BEHAVIOUR_MASTER_HASH, 153, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)
+CS_STATE_TYPE(STATE_IBEACON_CONFIG_ID, 154, MULTIPLE_IDS, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(STATE_MICROAPP, 155, MULTIPLE_IDS, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE(STATE_SOFT_ON_SPEED, 156, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(STATE_HUB_MODE, 157, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE_SIZED(STATE_UART_KEY, 158, ENCRYPTION_KEY_LENGTH, MULTIPLE_IDS, REMOVE_ON_RESET, ADMIN, NO_ONE)
+
+CS_STATE_TYPE(STATE_ASSET_FILTERS_VERSION, 159, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE_SIZED(STATE_ASSET_FILTER_32, 160, 32, MULTIPLE_IDS, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE_SIZED(STATE_ASSET_FILTER_64, 161, 64, MULTIPLE_IDS, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE_SIZED(STATE_ASSET_FILTER_128, 162, 128, MULTIPLE_IDS, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE_SIZED(STATE_ASSET_FILTER_256, 163, 256, MULTIPLE_IDS, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE_SIZED(STATE_ASSET_FILTER_512, 164, 512, MULTIPLE_IDS, REMOVE_ON_RESET, NO_ONE, ADMIN)
+
+CS_STATE_TYPE(STATE_MESH_IV_INDEX_V5, 165, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+CS_STATE_TYPE(STATE_MESH_SEQ_NUMBER_V5, 166, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, ADMIN)
+
+CS_STATE_TYPE(STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED, 167, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(STATE_DEFAULT_DIM_VALUE, 168, SINGLE_ID, REMOVE_ON_RESET, ADMIN, ADMIN)
+CS_STATE_TYPE(STATE_POWER_QUALITY, 169, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, MEMBER)
+
+/*
+ * Internal commands and events.
+ * Start at Internal_Base.
+ */
+
+// InternalBaseBluetooth
+// Sent when a background advertisement has been validated and parsed.
+CS_INTERNAL_TYPE(EVT_ADV_BACKGROUND_PARSED, InternalBaseBluetooth)
+CS_INTERNAL_TYPE(EVT_DEVICE_SCANNED, InternalBaseBluetooth + 1)        // Device was scanned.
+// Background advertisement has been received.
+CS_INTERNAL_TYPE(EVT_ADV_BACKGROUND, InternalBaseBluetooth + 2)
+// Sent when a v1 background advertisement has been received.
+CS_INTERNAL_TYPE(EVT_ADV_BACKGROUND_PARSED_V1, InternalBaseBluetooth + 3)
+// Advertisement was updated. TODO: advertisement data as payload?
+CS_INTERNAL_TYPE(EVT_ADVERTISEMENT_UPDATED, InternalBaseBluetooth + 4)
+CS_INTERNAL_TYPE(EVT_SCAN_STARTED, InternalBaseBluetooth + 5)          // Scanner started scanning.
+CS_INTERNAL_TYPE(EVT_SCAN_STOPPED, InternalBaseBluetooth + 6)          // Scanner stopped scanning.
+CS_INTERNAL_TYPE(EVT_BLE_CONNECT, InternalBaseBluetooth + 7)           // Device connected.
+// Device disconnected. Payload is connection handle.
+CS_INTERNAL_TYPE(EVT_BLE_DISCONNECT, InternalBaseBluetooth + 8)
+CS_INTERNAL_TYPE(CMD_ENABLE_ADVERTISEMENT, InternalBaseBluetooth + 9)  // Enable/disable advertising.
+
+// Switch (aggregator)
+CS_INTERNAL_TYPE(CMD_SWITCH_OFF, InternalBaseSwitch)           // Turn switch off.
+CS_INTERNAL_TYPE(CMD_SWITCH_ON, InternalBaseSwitch + 1)        // Turn switch on.
+CS_INTERNAL_TYPE(CMD_SWITCH_TOGGLE, InternalBaseSwitch + 2)    // Toggle switch.
+CS_INTERNAL_TYPE(CMD_SWITCH, InternalBaseSwitch + 3)           // Set switch.
+CS_INTERNAL_TYPE(CMD_SET_RELAY, InternalBaseSwitch + 4)        // Set the relay state.
+CS_INTERNAL_TYPE(CMD_SET_DIMMER, InternalBaseSwitch + 5)       // Set the dimmer state.
+CS_INTERNAL_TYPE(CMD_MULTI_SWITCH, InternalBaseSwitch + 6)     // Handle a multi switch.
+CS_INTERNAL_TYPE(CMD_LOCK_SWITCH, InternalBaseSwitch + 7)      // Set switch lock.
+CS_INTERNAL_TYPE(CMD_DIMMING_ALLOWED, InternalBaseSwitch + 8)  // Set allow dimming.
+
+// Power
+// Dimmer being powered is changed. Payload: true when powered, and ready to be used.
+CS_INTERNAL_TYPE(EVT_DIMMER_POWERED, InternalBasePower)
+CS_INTERNAL_TYPE(EVT_BROWNOUT_IMPENDING, InternalBasePower + 1)  // Brownout is impending (low chip supply voltage).
+
+// Errors
+// Current usage goes over the threshold.
+CS_INTERNAL_TYPE(EVT_CURRENT_USAGE_ABOVE_THRESHOLD, InternalBaseErrors)
+// Current usage goes over the dimmer threshold, while dimmer is on.
+CS_INTERNAL_TYPE(EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER, InternalBaseErrors + 1)
+// Dimmer leaks current, while it's supposed to be off.
+CS_INTERNAL_TYPE(EVT_DIMMER_ON_FAILURE_DETECTED, InternalBaseErrors + 2)
+// Dimmer blocks current, while it's supposed to be on.
+CS_INTERNAL_TYPE(EVT_DIMMER_OFF_FAILURE_DETECTED, InternalBaseErrors + 3)
+// Chip temperature is above threshold.
+CS_INTERNAL_TYPE(EVT_CHIP_TEMP_ABOVE_THRESHOLD, InternalBaseErrors + 4)
+CS_INTERNAL_TYPE(EVT_CHIP_TEMP_OK, InternalBaseErrors + 5)       // Chip temperature is ok again.
+// Dimmer temperature is above threshold.
+CS_INTERNAL_TYPE(EVT_DIMMER_TEMP_ABOVE_THRESHOLD, InternalBaseErrors + 6)
+// Dimmer temperature is ok again.
+CS_INTERNAL_TYPE(EVT_DIMMER_TEMP_OK, InternalBaseErrors + 7)
+CS_INTERNAL_TYPE(EVT_DIMMER_FORCED_OFF, InternalBaseErrors + 8)  // Dimmer was forced off.
+// Switch (relay and dimmer) was forced off.
+CS_INTERNAL_TYPE(EVT_SWITCH_FORCED_OFF, InternalBaseErrors + 9)
+CS_INTERNAL_TYPE(EVT_RELAY_FORCED_ON, InternalBaseErrors + 10)   // Relay was forced on.
+
+// Storage
+// Storage is initialized, storage is only usable after this event!
+CS_INTERNAL_TYPE(EVT_STORAGE_INITIALIZED, InternalBaseStorage)
+// An item has been written to storage.
+CS_INTERNAL_TYPE(EVT_STORAGE_WRITE_DONE, InternalBaseStorage + 1)
+// An item has been invalidated at storage.
+CS_INTERNAL_TYPE(EVT_STORAGE_REMOVE_DONE, InternalBaseStorage + 2)
+// All state values with a certain ID have been invalidated at storage.
+CS_INTERNAL_TYPE(EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE, InternalBaseStorage + 3)
+// Garbage collection is done, invalidated data is actually removed at this point.
+CS_INTERNAL_TYPE(EVT_STORAGE_GC_DONE, InternalBaseStorage + 4)
+// Factory reset of storage is done. /!\ Only to be used by State.
+CS_INTERNAL_TYPE(EVT_STORAGE_FACTORY_RESET_DONE, InternalBaseStorage + 5)
+// All storage pages are completely erased.
+CS_INTERNAL_TYPE(EVT_STORAGE_PAGES_ERASED, InternalBaseStorage + 6)
+// Perform a factory reset: clear all data.
+CS_INTERNAL_TYPE(CMD_FACTORY_RESET, InternalBaseStorage + 7)
+// Factory reset of state is done.
+CS_INTERNAL_TYPE(EVT_STATE_FACTORY_RESET_DONE, InternalBaseStorage + 8)
+// Factory reset of mesh storage is done.
+CS_INTERNAL_TYPE(EVT_MESH_FACTORY_RESET_DONE, InternalBaseStorage + 9)
+// Start garbage collection of FDS.
+CS_INTERNAL_TYPE(CMD_STORAGE_GARBAGE_COLLECT, InternalBaseStorage + 10)
+
+// Logging
+// Enable/disable power calculations logging.
+CS_INTERNAL_TYPE(CMD_ENABLE_LOG_POWER, InternalBaseLogging)
+// Enable/disable current samples logging.
+CS_INTERNAL_TYPE(CMD_ENABLE_LOG_CURRENT, InternalBaseLogging + 1)
+// Enable/disable voltage samples logging.
+CS_INTERNAL_TYPE(CMD_ENABLE_LOG_VOLTAGE, InternalBaseLogging + 2)
+// Enable/disable filtered current samples logging.
+CS_INTERNAL_TYPE(CMD_ENABLE_LOG_FILTERED_CURRENT, InternalBaseLogging + 3)
+// Set how the enabled samples are logged.
+CS_INTERNAL_TYPE(CMD_SET_LOG_SAMPLES_STREAM, InternalBaseLogging + 4)
+
+// ADC config
+// Toggle ADC voltage pin. TODO: pin as payload?
+CS_INTERNAL_TYPE(CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN, InternalBaseADC)
+// Toggle differential mode on current pin.
+CS_INTERNAL_TYPE(CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT, InternalBaseADC + 1)
+// Toggle differential mode on voltage pin.
+CS_INTERNAL_TYPE(CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE, InternalBaseADC + 2)
+CS_INTERNAL_TYPE(CMD_INC_VOLTAGE_RANGE, InternalBaseADC + 3)  // Increase voltage range.
+CS_INTERNAL_TYPE(CMD_DEC_VOLTAGE_RANGE, InternalBaseADC + 4)  // Decrease voltage range.
+CS_INTERNAL_TYPE(CMD_INC_CURRENT_RANGE, InternalBaseADC + 5)  // Increase current range.
+CS_INTERNAL_TYPE(CMD_DEC_CURRENT_RANGE, InternalBaseADC + 6)  // Decrease current range.
+// ADC has been restarted. Sent before the first buffer is to be processed.
+CS_INTERNAL_TYPE(EVT_ADC_RESTARTED, InternalBaseADC + 7)
+
+// Mesh
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG, InternalBaseMesh)                   // Send a mesh message.
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_SET_TIME, InternalBaseMesh + 1)      // Send a set time mesh message.
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_NOOP, InternalBaseMesh + 2)          // Send a noop mesh message.
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_MULTI_SWITCH, InternalBaseMesh + 3)  // Send a switch mesh message.
+// Send a profile location mesh message.
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_PROFILE_LOCATION, InternalBaseMesh + 4)
+// Send a set behaviour settings mesh message.
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS, InternalBaseMesh + 5)
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER, InternalBaseMesh + 6)
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN, InternalBaseMesh + 7)
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE, InternalBaseMesh + 8)
+// Send a control command via the mesh. All permission checks must have been done already!
+CS_INTERNAL_TYPE(CMD_SEND_MESH_CONTROL_COMMAND, InternalBaseMesh + 9)
+CS_INTERNAL_TYPE(CMD_ENABLE_MESH, InternalBaseMesh + 10)                // Enable/disable mesh.
+// Mesh received a tracked device to register.
+CS_INTERNAL_TYPE(EVT_MESH_TRACKED_DEVICE_REGISTER, InternalBaseMesh + 11)
+// Mesh received a tracked device token.
+CS_INTERNAL_TYPE(EVT_MESH_TRACKED_DEVICE_TOKEN, InternalBaseMesh + 12)
+// Mesh received a tracked device list size.
+CS_INTERNAL_TYPE(EVT_MESH_TRACKED_DEVICE_LIST_SIZE, InternalBaseMesh + 13)
+// Before an outgoing sync request is broadcasted, this event is fired internally so that other event handlers can
+// tag on.
+CS_INTERNAL_TYPE(EVT_MESH_SYNC_REQUEST_OUTGOING, InternalBaseMesh + 14)
+// When a sync request is received, this event is fired internally so that each event handler can individually
+// respond to it.
+CS_INTERNAL_TYPE(EVT_MESH_SYNC_REQUEST_INCOMING, InternalBaseMesh + 15)
+// When syncing is considered to have failed, no more retries.
+CS_INTERNAL_TYPE(EVT_MESH_SYNC_FAILED, InternalBaseMesh + 16)
+// Mesh received part 0 of the state of a Crownstone.
+CS_INTERNAL_TYPE(EVT_MESH_EXT_STATE_0, InternalBaseMesh + 17)
+// Mesh received part 1 of the state of a Crownstone.
+CS_INTERNAL_TYPE(EVT_MESH_EXT_STATE_1, InternalBaseMesh + 18)
+// All mesh storage pages are completely erased.
+CS_INTERNAL_TYPE(EVT_MESH_PAGES_ERASED, InternalBaseMesh + 19)
+// Send a tracked device heartbeat mesh message.
+CS_INTERNAL_TYPE(CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT, InternalBaseMesh + 20)
+// Mesh received a tracked device heartbeat.
+CS_INTERNAL_TYPE(EVT_MESH_TRACKED_DEVICE_HEARTBEAT, InternalBaseMesh + 21)
+// TODO: remove this type, it's not used.
+CS_INTERNAL_TYPE(EVT_MESH_RSSI_PING, InternalBaseMesh + 22)
+// TODO: remove this type, it's not used.
+CS_INTERNAL_TYPE(EVT_MESH_RSSI_DATA, InternalBaseMesh + 23)
+// A time sync message was received
+CS_INTERNAL_TYPE(EVT_MESH_TIME_SYNC, InternalBaseMesh + 24)
+CS_INTERNAL_TYPE(EVT_RECV_MESH_MSG, InternalBaseMesh + 25)              // A mesh message was received.
+
+// Behaviour
+CS_INTERNAL_TYPE(CMD_ADD_BEHAVIOUR, InternalBaseBehaviour)          // Add a behaviour.
+CS_INTERNAL_TYPE(CMD_REPLACE_BEHAVIOUR, InternalBaseBehaviour + 1)  // Replace a behaviour.
+CS_INTERNAL_TYPE(CMD_REMOVE_BEHAVIOUR, InternalBaseBehaviour + 2)   // Remove a behaviour.
+CS_INTERNAL_TYPE(CMD_GET_BEHAVIOUR, InternalBaseBehaviour + 3)      // Get a behaviour.
+// Get a list of indices of active behaviours.
+CS_INTERNAL_TYPE(CMD_GET_BEHAVIOUR_INDICES, InternalBaseBehaviour + 4)
+// Get info to debug behaviour. Multiple classes will handle this command to fill pieces of info.
+CS_INTERNAL_TYPE(CMD_GET_BEHAVIOUR_DEBUG, InternalBaseBehaviour + 5)
+// Clear all behaviours in the store, including persisted flash entries.
+CS_INTERNAL_TYPE_SIZED(CMD_CLEAR_ALL_BEHAVIOUR, InternalBaseBehaviour + 6, 0)
+// Sent by BehaviourStore, after a change to the stored behaviours.
+CS_INTERNAL_TYPE(EVT_BEHAVIOURSTORE_MUTATION, InternalBaseBehaviour + 7)
+// Informs whether behaviour is overridden by user (in override state).
+CS_INTERNAL_TYPE(EVT_BEHAVIOUR_OVERRIDDEN, InternalBaseBehaviour + 8)
+
+// Localisation of devices
+CS_INTERNAL_TYPE(CMD_REGISTER_TRACKED_DEVICE, InternalBaseLocalisation)    // Register a tracked device.
+CS_INTERNAL_TYPE(CMD_UPDATE_TRACKED_DEVICE, InternalBaseLocalisation + 1)  // Update data of a tracked device.
+// Received the location of a profile via mesh or command, or emulated by cs_TrackedDevices.
+CS_INTERNAL_TYPE(EVT_RECEIVED_PROFILE_LOCATION, InternalBaseLocalisation + 2)
+CS_INTERNAL_TYPE(EVT_PRESENCE_MUTATION, InternalBaseLocalisation + 3)      // Presence changed.
+// The state of another stone has been received.
+CS_INTERNAL_TYPE(EVT_STATE_EXTERNAL_STONE, InternalBaseLocalisation + 4)
+// Set location of a tracked device, with a TTL. This command can be sent instead of advertisements.
+CS_INTERNAL_TYPE(CMD_TRACKED_DEVICE_HEARTBEAT, InternalBaseLocalisation + 5)
+// The presence has changed. When the first user enters, multiple events will be sent.
+CS_INTERNAL_TYPE(EVT_PRESENCE_CHANGE, InternalBaseLocalisation + 6)
+CS_INTERNAL_TYPE(CMD_GET_PRESENCE, InternalBaseLocalisation + 7)           // Get the current presence.
+
+// Update data chunk for a filter. See PROTOCOL.md CTRL_CMD_FILTER_UPLOAD
+CS_INTERNAL_TYPE(CMD_UPLOAD_FILTER, InternalBaseLocalisation + 8)
+// Remove a filter by id. See PROTOCOL.md CTRL_CMD_FILTER_REMOVE
+CS_INTERNAL_TYPE(CMD_REMOVE_FILTER, InternalBaseLocalisation + 9)
+// Confirm all recent changes to filters. See PROTOCOL.md CTRL_CMD_FILTER_COMMIT
+CS_INTERNAL_TYPE(CMD_COMMIT_FILTER_CHANGES, InternalBaseLocalisation + 10)
+// Obtain status summary for each filter in RAM. See PROTOCOL.md CTRL_CMD_FILTER_GET_SUMMARIES
+CS_INTERNAL_TYPE(CMD_GET_FILTER_SUMMARIES, InternalBaseLocalisation + 11)
+// Sent when the asset filter master version was updated (after a commit command was accepted).
+CS_INTERNAL_TYPE(EVT_FILTERS_UPDATED, InternalBaseLocalisation + 12)
+// Sent when filter modification has started (payload is true) or stopped (payload is false).
+CS_INTERNAL_TYPE(EVT_FILTER_MODIFICATION, InternalBaseLocalisation + 13)
+
+// Sent by AssetFiltering when an incoming scan is accepted by a filter.
+CS_INTERNAL_TYPE(EVT_ASSET_ACCEPTED, InternalBaseLocalisation + 14)
+
+// System
+CS_INTERNAL_TYPE(CMD_RESET_DELAYED, InternalBaseSystem)     // Reboot scheduled with a (short) delay.
+CS_INTERNAL_TYPE(EVT_GOING_TO_DFU, InternalBaseSystem + 1)  // The system will reboot to DFU mode soon.
+
+CS_INTERNAL_TYPE(CMD_SET_TIME, InternalBaseSystem + 2)  // Set the time.
+// Set which ibeacon config id to use for advertising.
+CS_INTERNAL_TYPE(CMD_SET_IBEACON_CONFIG_ID, InternalBaseSystem + 3)
+// Time is set or changed. WARNING: this event is only sent on set time command. Payload: previous posix time
+CS_INTERNAL_TYPE(EVT_TIME_SET, InternalBaseSystem + 4)
+CS_INTERNAL_TYPE(EVT_TICK, InternalBaseSystem + 5)      // Sent about every TICK_INTERVAL_MS ms.
+
+CS_INTERNAL_TYPE(CMD_CONTROL_CMD, InternalBaseSystem + 6)  // Handle a control command.
+// Session data and setup key are generated. Data pointer has to point to memory that stays valid!
+CS_INTERNAL_TYPE(EVT_SESSION_DATA_SET, InternalBaseSystem + 7)
+
+CS_INTERNAL_TYPE(CMD_GET_ADC_RESTARTS, InternalBaseSystem + 8)        // Get number of ADC restarts.
+CS_INTERNAL_TYPE(CMD_GET_SWITCH_HISTORY, InternalBaseSystem + 9)      // Get the switch command history.
+CS_INTERNAL_TYPE(CMD_GET_POWER_SAMPLES, InternalBaseSystem + 10)      // Get power samples of interesting events.
+// Get minimum queue space left of app scheduler observed so far.
+CS_INTERNAL_TYPE(CMD_GET_SCHEDULER_MIN_FREE, InternalBaseSystem + 11)
+// Get last reset reason. Contents of POWER->RESETREAS as it was on boot.
+CS_INTERNAL_TYPE(CMD_GET_RESET_REASON, InternalBaseSystem + 12)
+// Get the Nth general purpose retention register as it was on boot.
+CS_INTERNAL_TYPE(CMD_GET_GPREGRET, InternalBaseSystem + 13)
+CS_INTERNAL_TYPE(CMD_GET_ADC_CHANNEL_SWAPS, InternalBaseSystem + 14)  // Get number of detected ADC channel swaps.
+CS_INTERNAL_TYPE(CMD_GET_RAM_STATS, InternalBaseSystem + 15)          // Get RAM statistics.
+
+CS_INTERNAL_TYPE(CMD_MICROAPP_GET_INFO, InternalBaseSystem + 16)            // Microapp control command.
+// Microapp control command. The data pointer is assume to remain valid until write is completed!
+CS_INTERNAL_TYPE(CMD_MICROAPP_UPLOAD, InternalBaseSystem + 17)
+CS_INTERNAL_TYPE(CMD_MICROAPP_VALIDATE, InternalBaseSystem + 18)            // Microapp control command.
+CS_INTERNAL_TYPE(CMD_MICROAPP_REMOVE, InternalBaseSystem + 19)              // Microapp control command.
+CS_INTERNAL_TYPE(CMD_MICROAPP_ENABLE, InternalBaseSystem + 20)              // Microapp control command.
+CS_INTERNAL_TYPE(CMD_MICROAPP_DISABLE, InternalBaseSystem + 21)             // Microapp control command.
+CS_INTERNAL_TYPE(CMD_MICROAPP_MESSAGE, InternalBaseSystem + 22)             // Microapp control command.
+// A microapp wants to advertise something.
+CS_INTERNAL_TYPE(CMD_MICROAPP_ADVERTISE, InternalBaseSystem + 23)
+CS_INTERNAL_TYPE(EVT_MICROAPP_FACTORY_RESET_DONE, InternalBaseSystem + 24)  // All microapps have been erased.
+
+// Connect to a device. See BleCentral::connect().
+CS_INTERNAL_TYPE(CMD_BLE_CENTRAL_CONNECT, InternalBaseSystem + 25)
+// Disconnect from device. See BleCentral::disconnect().
+CS_INTERNAL_TYPE(CMD_BLE_CENTRAL_DISCONNECT, InternalBaseSystem + 26)
+// Discover services. See BleCentral::discoverServices().
+CS_INTERNAL_TYPE(CMD_BLE_CENTRAL_DISCOVER, InternalBaseSystem + 27)
+// Read a characteristic. See BleCentral::read().
+CS_INTERNAL_TYPE(CMD_BLE_CENTRAL_READ, InternalBaseSystem + 28)
+// Write a characteristic. See BleCentral::write().
+CS_INTERNAL_TYPE(CMD_BLE_CENTRAL_WRITE, InternalBaseSystem + 29)
+
+// Request for an outgoing connection, handlers should set the return code. Will always followed by
+// EVT_BLE_CENTRAL_CONNECT_RESULT.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST, InternalBaseSystem + 30)
+// If the return code of the request was WAIT_FOR_SUCCESS, this event is what will be waited for.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY, InternalBaseSystem + 31)
+// Result of a connection attempt.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_CONNECT_RESULT, InternalBaseSystem + 32)
+// Outgoing connection was terminated. By request, or due to some error.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_DISCONNECTED, InternalBaseSystem + 33)
+// A single service or characteristic is discovered.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_DISCOVERY, InternalBaseSystem + 34)
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_DISCOVERY_RESULT, InternalBaseSystem + 35)  // Result of service discovery.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_READ_RESULT, InternalBaseSystem + 36)       // Result of a read.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_WRITE_RESULT, InternalBaseSystem + 37)      // Result of a write.
+// A notification has been received.
+CS_INTERNAL_TYPE(EVT_BLE_CENTRAL_NOTIFICATION, InternalBaseSystem + 38)
+
+// Connect to a device. See CrownstoneCentral::connect().
+CS_INTERNAL_TYPE(CMD_CS_CENTRAL_CONNECT, InternalBaseSystem + 39)
+// Disconnect from device. See CrownstoneCentral::disconnect().
+CS_INTERNAL_TYPE(CMD_CS_CENTRAL_DISCONNECT, InternalBaseSystem + 40)
+// Write a control command. See CrownstoneCentral::write().
+CS_INTERNAL_TYPE(CMD_CS_CENTRAL_WRITE, InternalBaseSystem + 41)
+// Request the write buffer. See CrownstoneCentral::requestWriteBuffer(). The result.buf will be set to the write
+// buffer.
+CS_INTERNAL_TYPE(CMD_CS_CENTRAL_GET_WRITE_BUF, InternalBaseSystem + 42)
+
+CS_INTERNAL_TYPE(EVT_CS_CENTRAL_CONNECT_RESULT, InternalBaseSystem + 43)
+CS_INTERNAL_TYPE(EVT_CS_CENTRAL_READ_RESULT, InternalBaseSystem + 44)
+CS_INTERNAL_TYPE(EVT_CS_CENTRAL_WRITE_RESULT, InternalBaseSystem + 45)
+
+CS_INTERNAL_TYPE(CMD_MESH_TOPO_GET_MAC, InternalBaseSystem + 46)     // Get the MAC address of a given stone ID.
+CS_INTERNAL_TYPE(EVT_MESH_TOPO_MAC_RESULT, InternalBaseSystem + 47)  // The resulting MAC address.
+CS_INTERNAL_TYPE(CMD_MESH_TOPO_RESET, InternalBaseSystem + 48)       // Reset the stored mesh topology.
+// Get the RSSI to a stoneId. The RSSI is set in the result.
+CS_INTERNAL_TYPE(CMD_MESH_TOPO_GET_RSSI, InternalBaseSystem + 49)
+
+CS_INTERNAL_TYPE(EVT_TWI_INIT, InternalBaseSystem + 50)   // TWI initialisation.
+CS_INTERNAL_TYPE(EVT_TWI_WRITE, InternalBaseSystem + 51)  // TWI write.
+CS_INTERNAL_TYPE(EVT_TWI_READ, InternalBaseSystem + 52)   // TWI read (request).
+// TWI update from TWI module to listeners (not implemented yet).
+CS_INTERNAL_TYPE(EVT_TWI_UPDATE, InternalBaseSystem + 53)
+
+CS_INTERNAL_TYPE(EVT_GPIO_INIT, InternalBaseSystem + 54)    // GPIO, init pin (eventually event handler)
+CS_INTERNAL_TYPE(EVT_GPIO_WRITE, InternalBaseSystem + 55)   // GPIO, write value
+CS_INTERNAL_TYPE(EVT_GPIO_READ, InternalBaseSystem + 56)    // GPIO, read value (directly)
+CS_INTERNAL_TYPE(EVT_GPIO_UPDATE, InternalBaseSystem + 57)  // GPIO, update other modules with read values
+
+// When a control command returned WAIT_FOR_SUCCESS, this event finalizes that control command.
+CS_INTERNAL_TYPE(CMD_RESOLVE_ASYNC_CONTROL_COMMAND, InternalBaseSystem + 58)
+// Sends the async result to the user via BLE.
+CS_INTERNAL_TYPE(CMD_SEND_ASYNC_RESULT_TO_BLE, InternalBaseSystem + 59)
+CS_INTERNAL_TYPE(CMD_GET_STORAGE_STATS, InternalBaseSystem + 60)     // Get flash operation statistics.
+CS_INTERNAL_TYPE(CMD_GET_SOFTFUSE_LATENCY, InternalBaseSystem + 61)  // Get softfuse reaction latency statistics.
+
+CS_INTERNAL_TYPE(CMD_TEST_SET_TIME, InternalBaseTests)  // Set time for testing.
+
+// Can be used by the python test python lib for ad hoc tests during development.
+CS_INTERNAL_TYPE_SIZED(EVT_GENERIC_TEST, 0xFFFF, 0)
+
+// clang-format on
@@ -75,356 +75,19 @@ constexpr auto to_underlying_type(T e) noexcept -> std::enable_if_t<std::is_enum
  *   - Prefixed with CMD.
  *   - Types that are sent to request something to be done.
  *   - If a fixed number is required, put it right after Internal_Base.
+ *
+ * The types, and their properties, are listed in cs_TypeList.h.
  */
 enum class CS_TYPE : uint16_t {
-	CONFIG_DO_NOT_USE =
-			State_Base,  // Record keys should be in the range 0x0001 - 0xBFFF. The value 0x0000 is reserved by the
-						 // system. The values from 0xC000 to 0xFFFF are reserved for use by the Peer Manager module and
-						 // can only be used in applications that do not include Peer Manager.
-						 //	CONFIG_DEVICE_TYPE                      = 1,
-						 //	CONFIG_ROOM                             = 2,
-						 //	CONFIG_FLOOR                            = 3,
-						 //	CONFIG_NEARBY_TIMEOUT                   = 4,
-	CONFIG_PWM_PERIOD                          = 5,
-	CONFIG_IBEACON_MAJOR                       = 6,
-	CONFIG_IBEACON_MINOR                       = 7,
-	CONFIG_IBEACON_UUID                        = 8,
-	CONFIG_IBEACON_TXPOWER                     = 9,
-	//	CONFIG_WIFI_SETTINGS                    = 10,
-	CONFIG_TX_POWER                            = 11,
-	CONFIG_ADV_INTERVAL                        = 12,  // Advertising interval in units of 0.625ms.
-													  //	CONFIG_PASSKEY                          = 13,
-													  //	CONFIG_MIN_ENV_TEMP                     = 14,
-													  //	CONFIG_MAX_ENV_TEMP                     = 15,
-	CONFIG_SCAN_DURATION                       = 16,  // Deprecate
-													  //	CONFIG_SCAN_SEND_DELAY                  = 17,
-	CONFIG_SCAN_BREAK_DURATION                 = 18,  // Deprecate
-	CONFIG_BOOT_DELAY                          = 19,
-	CONFIG_MAX_CHIP_TEMP                       = 20,
-	//	CONFIG_SCAN_FILTER                      = 21,
-	//	CONFIG_SCAN_FILTER_SEND_FRACTION        = 22,
-	CONFIG_CURRENT_LIMIT                       = 23,  // Not implemented yet, but something we want in the future.
-	CONFIG_MESH_ENABLED                        = 24,
-	CONFIG_ENCRYPTION_ENABLED                  = 25,
-	CONFIG_IBEACON_ENABLED                     = 26,
-	CONFIG_SCANNER_ENABLED                     = 27,
-	//	CONFIG_CONT_POWER_SAMPLER_ENABLED       = 28,
-	//	CONFIG_TRACKER_ENABLED                  = 29,
-	//	CONFIG_ADC_BURST_SAMPLE_RATE            = 30,
-	//	CONFIG_POWER_SAMPLE_BURST_INTERVAL      = 31,
-	//	CONFIG_POWER_SAMPLE_CONT_INTERVAL       = 32,
-	CONFIG_SPHERE_ID                           = 33,
-	CONFIG_CROWNSTONE_ID                       = 34,
-	CONFIG_KEY_ADMIN                           = 35,
-	CONFIG_KEY_MEMBER                          = 36,
-	CONFIG_KEY_BASIC                           = 37,
-	//	CONFIG_DEFAULT_ON                       = 38,
-	CONFIG_SCAN_INTERVAL_625US                 = 39,  // Scan interval in 625 µs units.
-	CONFIG_SCAN_WINDOW_625US                   = 40,  // Scan window in 625 µs units.
-	CONFIG_RELAY_HIGH_DURATION                 = 41,
-	CONFIG_LOW_TX_POWER                        = 42,
-	CONFIG_VOLTAGE_MULTIPLIER                  = 43,
-	CONFIG_CURRENT_MULTIPLIER                  = 44,
-	CONFIG_VOLTAGE_ADC_ZERO                    = 45,
-	CONFIG_CURRENT_ADC_ZERO                    = 46,
-	CONFIG_POWER_ZERO                          = 47,
-	//	CONFIG_POWER_ZERO_AVG_WINDOW            = 48,
-	//	CONFIG_MESH_ACCESS_ADDRESS              = 49,
-	CONFIG_SOFT_FUSE_CURRENT_THRESHOLD         = 50,
-	CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER  = 51,
-	CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP       = 52,
-	CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN     = 53,
-	CONFIG_DIMMING_ALLOWED                     = 54,
-	CONFIG_SWITCH_LOCKED                       = 55,
-	CONFIG_SWITCHCRAFT_ENABLED                 = 56,
-	CONFIG_SWITCHCRAFT_THRESHOLD               = 57,
-	//	CONFIG_MESH_CHANNEL                     = 58,
-	CONFIG_UART_ENABLED                        = 59,
-	CONFIG_NAME                                = 60,
-	CONFIG_KEY_SERVICE_DATA                    = 61,
-	CONFIG_MESH_DEVICE_KEY                     = 62,
-	CONFIG_MESH_APP_KEY                        = 63,
-	CONFIG_MESH_NET_KEY                        = 64,
-	CONFIG_KEY_LOCALIZATION                    = 65,
-	CONFIG_START_DIMMER_ON_ZERO_CROSSING       = 66,
-	CONFIG_TAP_TO_TOGGLE_ENABLED               = 67,
-	CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET = 68,
-	STATE_BEHAVIOUR_RULE                       = 69,
-	STATE_TWILIGHT_RULE                        = 70,
-	STATE_EXTENDED_BEHAVIOUR_RULE              = 71,
-
-	STATE_RESET_COUNTER                        = 128,
-	STATE_SWITCH_STATE                         = 129,
-	STATE_ACCUMULATED_ENERGY                   = 130,  // Energy used in μJ.
-	STATE_POWER_USAGE                          = 131,  // Power usage in mW.
-													   //	STATE_TRACKED_DEVICES,
-													   //	STATE_SCHEDULE                          = 133,
-	STATE_OPERATION_MODE                       = 134,
-	STATE_TEMPERATURE                          = 135,
-	STATE_FACTORY_RESET                        = 137,
-	//	STATE_LEARNED_SWITCHES,
-	STATE_ERRORS                               = 139,
-	//	STATE_ERROR_OVER_CURRENT,
-	//	STATE_ERROR_OVER_CURRENT_DIMMER,
-	//	STATE_ERROR_CHIP_TEMP,
-	//	STATE_ERROR_DIMMER_TEMP,
-	//	STATE_IGNORE_BITMASK,
-	//	STATE_IGNORE_ALL,
-	//	STATE_IGNORE_LOCATION,
-	//	STATE_ERROR_DIMMER_ON_FAILURE,
-	//	STATE_ERROR_DIMMER_OFF_FAILURE,
-	STATE_SUN_TIME                             = 149,
-	STATE_BEHAVIOUR_SETTINGS                   = 150,
-	STATE_MESH_IV_INDEX                        = 151,
-	STATE_MESH_SEQ_NUMBER                      = 152,
-	STATE_BEHAVIOUR_MASTER_HASH                = 153,
-	STATE_IBEACON_CONFIG_ID                    = 154,
-	STATE_MICROAPP                             = 155,
-	STATE_SOFT_ON_SPEED                        = 156,
-	STATE_HUB_MODE                             = 157,
-	STATE_UART_KEY                             = 158,
-
-	STATE_ASSET_FILTERS_VERSION                = 159,
-	STATE_ASSET_FILTER_32                      = 160,
-	STATE_ASSET_FILTER_64                      = 161,
-	STATE_ASSET_FILTER_128                     = 162,
-	STATE_ASSET_FILTER_256                     = 163,
-	STATE_ASSET_FILTER_512                     = 164,
-
-	STATE_MESH_IV_INDEX_V5                     = 165,
-	STATE_MESH_SEQ_NUMBER_V5                   = 166,
-
-	STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED       = 167,
-	STATE_DEFAULT_DIM_VALUE                    = 168,
-
-	/*
-	 * Internal commands and events.
-	 * Start at Internal_Base.
-	 */
-
-	// InternalBaseBluetooth
-	EVT_ADV_BACKGROUND_PARSED =
-			InternalBaseBluetooth,  // Sent when a background advertisement has been validated and parsed.
-	EVT_DEVICE_SCANNED,             // Device was scanned.
-	EVT_ADV_BACKGROUND,             // Background advertisement has been received.
-	EVT_ADV_BACKGROUND_PARSED_V1,   // Sent when a v1 background advertisement has been received.
-	EVT_ADVERTISEMENT_UPDATED,      // Advertisement was updated. TODO: advertisement data as payload?
-	EVT_SCAN_STARTED,               // Scanner started scanning.
-	EVT_SCAN_STOPPED,               // Scanner stopped scanning.
-	EVT_BLE_CONNECT,                // Device connected.
-	EVT_BLE_DISCONNECT,             // Device disconnected. Payload is connection handle.
-	CMD_ENABLE_ADVERTISEMENT,       // Enable/disable advertising.
-
-	// Switch (aggregator)
-	CMD_SWITCH_OFF = InternalBaseSwitch,  // Turn switch off.
-	CMD_SWITCH_ON,                        // Turn switch on.
-	CMD_SWITCH_TOGGLE,                    // Toggle switch.
-	CMD_SWITCH,                           // Set switch.
-	CMD_SET_RELAY,                        // Set the relay state.
-	CMD_SET_DIMMER,                       // Set the dimmer state.
-	CMD_MULTI_SWITCH,                     // Handle a multi switch.
-	CMD_LOCK_SWITCH,                      // Set switch lock.
-	CMD_DIMMING_ALLOWED,                  // Set allow dimming.
-
-	// Power
-	EVT_DIMMER_POWERED =
-			InternalBasePower,  // Dimmer being powered is changed. Payload: true when powered, and ready to be used.
-	EVT_BROWNOUT_IMPENDING,     // Brownout is impending (low chip supply voltage).
-
-	// Errors
-	EVT_CURRENT_USAGE_ABOVE_THRESHOLD = InternalBaseErrors,  // Current usage goes over the threshold.
-	EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER,  // Current usage goes over the dimmer threshold, while dimmer is on.
-	EVT_DIMMER_ON_FAILURE_DETECTED,            // Dimmer leaks current, while it's supposed to be off.
-	EVT_DIMMER_OFF_FAILURE_DETECTED,           // Dimmer blocks current, while it's supposed to be on.
-	EVT_CHIP_TEMP_ABOVE_THRESHOLD,             // Chip temperature is above threshold.
-	EVT_CHIP_TEMP_OK,                          // Chip temperature is ok again.
-	EVT_DIMMER_TEMP_ABOVE_THRESHOLD,           // Dimmer temperature is above threshold.
-	EVT_DIMMER_TEMP_OK,                        // Dimmer temperature is ok again.
-	EVT_DIMMER_FORCED_OFF,                     // Dimmer was forced off.
-	EVT_SWITCH_FORCED_OFF,                     // Switch (relay and dimmer) was forced off.
-	EVT_RELAY_FORCED_ON,                       // Relay was forced on.
-
-	// Storage
-	EVT_STORAGE_INITIALIZED = InternalBaseStorage,  // Storage is initialized, storage is only usable after this event!
-	EVT_STORAGE_WRITE_DONE,                         // An item has been written to storage.
-	EVT_STORAGE_REMOVE_DONE,                        // An item has been invalidated at storage.
-	EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE,  // All state values with a certain ID have been invalidated at storage.
-	EVT_STORAGE_GC_DONE,             // Garbage collection is done, invalidated data is actually removed at this point.
-	EVT_STORAGE_FACTORY_RESET_DONE,  // Factory reset of storage is done. /!\ Only to be used by State.
-	EVT_STORAGE_PAGES_ERASED,        // All storage pages are completely erased.
-	CMD_FACTORY_RESET,               // Perform a factory reset: clear all data.
-	EVT_STATE_FACTORY_RESET_DONE,    // Factory reset of state is done.
-	EVT_MESH_FACTORY_RESET_DONE,     // Factory reset of mesh storage is done.
-	CMD_STORAGE_GARBAGE_COLLECT,     // Start garbage collection of FDS.
-
-	// Logging
-	CMD_ENABLE_LOG_POWER = InternalBaseLogging,  // Enable/disable power calculations logging.
-	CMD_ENABLE_LOG_CURRENT,                      // Enable/disable current samples logging.
-	CMD_ENABLE_LOG_VOLTAGE,                      // Enable/disable voltage samples logging.
-	CMD_ENABLE_LOG_FILTERED_CURRENT,             // Enable/disable filtered current samples logging.
-
-	// ADC config
-	CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN = InternalBaseADC,  // Toggle ADC voltage pin. TODO: pin as payload?
-	CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT,                         // Toggle differential mode on current pin.
-	CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE,                         // Toggle differential mode on voltage pin.
-	CMD_INC_VOLTAGE_RANGE,                                       // Increase voltage range.
-	CMD_DEC_VOLTAGE_RANGE,                                       // Decrease voltage range.
-	CMD_INC_CURRENT_RANGE,                                       // Increase current range.
-	CMD_DEC_CURRENT_RANGE,                                       // Decrease current range.
-	EVT_ADC_RESTARTED,  // ADC has been restarted. Sent before the first buffer is to be processed.
-
-	// Mesh
-	CMD_SEND_MESH_MSG = InternalBaseMesh,      // Send a mesh message.
-	CMD_SEND_MESH_MSG_SET_TIME,                // Send a set time mesh message.
-	CMD_SEND_MESH_MSG_NOOP,                    // Send a noop mesh message.
-	CMD_SEND_MESH_MSG_MULTI_SWITCH,            // Send a switch mesh message.
-	CMD_SEND_MESH_MSG_PROFILE_LOCATION,        // Send a profile location mesh message.
-	CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS,  // Send a set behaviour settings mesh message.
-	CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER,
-	CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN,
-	CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE,
-	CMD_SEND_MESH_CONTROL_COMMAND,     // Send a control command via the mesh. All permission checks must have been done
-									   // already!
-	CMD_ENABLE_MESH,                   // Enable/disable mesh.
-	EVT_MESH_TRACKED_DEVICE_REGISTER,  // Mesh received a tracked device to register.
-	EVT_MESH_TRACKED_DEVICE_TOKEN,     // Mesh received a tracked device token.
-	EVT_MESH_TRACKED_DEVICE_LIST_SIZE,  // Mesh received a tracked device list size.
-	EVT_MESH_SYNC_REQUEST_OUTGOING,  // Before an outgoing sync request is broadcasted, this event is fired internally
-									 // so that other event handlers can tag on.
-	EVT_MESH_SYNC_REQUEST_INCOMING,  // When a sync request is received, this event is fired internally so that each
-									 // event handler can individually respond to it.
-	EVT_MESH_SYNC_FAILED,            // When syncing is considered to have failed, no more retries.
-	EVT_MESH_EXT_STATE_0,            // Mesh received part 0 of the state of a Crownstone.
-	EVT_MESH_EXT_STATE_1,            // Mesh received part 1 of the state of a Crownstone.
-	EVT_MESH_PAGES_ERASED,           // All mesh storage pages are completely erased.
-	CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT,  // Send a tracked device heartbeat mesh message.
-	EVT_MESH_TRACKED_DEVICE_HEARTBEAT,           // Mesh received a tracked device heartbeat.
-	EVT_MESH_RSSI_PING,                          // TODO: remove this type, it's not used.
-	EVT_MESH_RSSI_DATA,                          // TODO: remove this type, it's not used.
-	EVT_MESH_TIME_SYNC,                          // A time sync message was received
-	EVT_RECV_MESH_MSG,                           // A mesh message was received.
-
-	// Behaviour
-	CMD_ADD_BEHAVIOUR = InternalBaseBehaviour,  // Add a behaviour.
-	CMD_REPLACE_BEHAVIOUR,                      // Replace a behaviour.
-	CMD_REMOVE_BEHAVIOUR,                       // Remove a behaviour.
-	CMD_GET_BEHAVIOUR,                          // Get a behaviour.
-	CMD_GET_BEHAVIOUR_INDICES,                  // Get a list of indices of active behaviours.
-	CMD_GET_BEHAVIOUR_DEBUG,  // Get info to debug behaviour. Multiple classes will handle this command to fill pieces
-							  // of info.
-	CMD_CLEAR_ALL_BEHAVIOUR,  // Clear all behaviours in the store, including persisted flash entries.
-	EVT_BEHAVIOURSTORE_MUTATION,  // Sent by BehaviourStore, after a change to the stored behaviours.
-	EVT_BEHAVIOUR_OVERRIDDEN,     // Informs whether behaviour is overridden by user (in override state).
-
-	// Localisation of devices
-	CMD_REGISTER_TRACKED_DEVICE = InternalBaseLocalisation,  // Register a tracked device.
-	CMD_UPDATE_TRACKED_DEVICE,                               // Update data of a tracked device.
-	EVT_RECEIVED_PROFILE_LOCATION,  // Received the location of a profile via mesh or command, or emulated by
-									// cs_TrackedDevices.
-	EVT_PRESENCE_MUTATION,          // Presence changed.
-	EVT_STATE_EXTERNAL_STONE,       // The state of another stone has been received.
-	CMD_TRACKED_DEVICE_HEARTBEAT,   // Set location of a tracked device, with a TTL. This command can be sent instead of
-									// advertisements.
-	EVT_PRESENCE_CHANGE,  // The presence has changed. When the first user enters, multiple events will be sent.
-	CMD_GET_PRESENCE,     // Get the current presence.
-
-	CMD_UPLOAD_FILTER,  // Update data chunk for a filter.                 See PROTOCOL.md CTRL_CMD_FILTER_UPLOAD
-	CMD_REMOVE_FILTER,  // Remove a filter by id.                          See PROTOCOL.md CTRL_CMD_FILTER_REMOVE
-	CMD_COMMIT_FILTER_CHANGES,  // Confirm all recent changes to filters.          See PROTOCOL.md
-								// CTRL_CMD_FILTER_COMMIT
-	CMD_GET_FILTER_SUMMARIES,   // Obtain status summary for each filter in RAM.   See PROTOCOL.md
-								// CTRL_CMD_FILTER_GET_SUMMARIES
-	EVT_FILTERS_UPDATED,        // Sent when the asset filter master version was updated (after a commit command was
-								// accepted).
-	EVT_FILTER_MODIFICATION,    // Sent when filter modification has started (payload is true) or stopped (payload is
-								// false).
-
-	EVT_ASSET_ACCEPTED,  // Sent by AssetFiltering when an incoming scan is accepted by a filter.
-
-	// System
-	CMD_RESET_DELAYED = InternalBaseSystem,  // Reboot scheduled with a (short) delay.
-	EVT_GOING_TO_DFU,                        // The system will reboot to DFU mode soon.
-
-	CMD_SET_TIME,               // Set the time.
-	CMD_SET_IBEACON_CONFIG_ID,  // Set which ibeacon config id to use for advertising.
-	EVT_TIME_SET,  // Time is set or changed. WARNING: this event is only sent on set time command. Payload: previous
-				   // posix time
-	EVT_TICK,      // Sent about every TICK_INTERVAL_MS ms.
-
-	CMD_CONTROL_CMD,       // Handle a control command.
-	EVT_SESSION_DATA_SET,  // Session data and setup key are generated. Data pointer has to point to memory that stays
-						   // valid!
-
-	CMD_GET_ADC_RESTARTS,        // Get number of ADC restarts.
-	CMD_GET_SWITCH_HISTORY,      // Get the switch command history.
-	CMD_GET_POWER_SAMPLES,       // Get power samples of interesting events.
-	CMD_GET_SCHEDULER_MIN_FREE,  // Get minimum queue space left of app scheduler observed so far.
-	CMD_GET_RESET_REASON,        // Get last reset reason. Contents of POWER->RESETREAS as it was on boot.
-	CMD_GET_GPREGRET,            // Get the Nth general purpose retention register as it was on boot.
-	CMD_GET_ADC_CHANNEL_SWAPS,   // Get number of detected ADC channel swaps.
-	CMD_GET_RAM_STATS,           // Get RAM statistics.
-
-	CMD_MICROAPP_GET_INFO,   // Microapp control command.
-	CMD_MICROAPP_UPLOAD,     // Microapp control command. The data pointer is assume to remain valid until write is
-							 // completed!
-	CMD_MICROAPP_VALIDATE,   // Microapp control command.
-	CMD_MICROAPP_REMOVE,     // Microapp control command.
-	CMD_MICROAPP_ENABLE,     // Microapp control command.
-	CMD_MICROAPP_DISABLE,    // Microapp control command.
-	CMD_MICROAPP_MESSAGE,    // Microapp control command.
-	CMD_MICROAPP_ADVERTISE,  // A microapp wants to advertise something.
-	EVT_MICROAPP_FACTORY_RESET_DONE,  // All microapps have been erased.
-
-	CMD_BLE_CENTRAL_CONNECT,     // Connect to a device.       See BleCentral::connect().
-	CMD_BLE_CENTRAL_DISCONNECT,  // Disconnect from device.    See BleCentral::disconnect().
-	CMD_BLE_CENTRAL_DISCOVER,    // Discover services.         See BleCentral::discoverServices().
-	CMD_BLE_CENTRAL_READ,        // Read a characteristic.     See BleCentral::read().
-	CMD_BLE_CENTRAL_WRITE,       // Write a characteristic.    See BleCentral::write().
-
-	EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST,  // Request for an outgoing connection, handlers should set the return
-												// code. Will always followed by EVT_BLE_CENTRAL_CONNECT_RESULT.
-	EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY,    // If the return code of the request was WAIT_FOR_SUCCESS, this event is
-												// what will be waited for.
-	EVT_BLE_CENTRAL_CONNECT_RESULT,             // Result of a connection attempt.
-	EVT_BLE_CENTRAL_DISCONNECTED,               // Outgoing connection was terminated. By request, or due to some error.
-	EVT_BLE_CENTRAL_DISCOVERY,                  // A single service or characteristic is discovered.
-	EVT_BLE_CENTRAL_DISCOVERY_RESULT,           // Result of service discovery.
-	EVT_BLE_CENTRAL_READ_RESULT,                // Result of a read.
-	EVT_BLE_CENTRAL_WRITE_RESULT,               // Result of a write.
-	EVT_BLE_CENTRAL_NOTIFICATION,               // A notification has been received.
-
-	CMD_CS_CENTRAL_CONNECT,        // Connect to a device.       See CrownstoneCentral::connect().
-	CMD_CS_CENTRAL_DISCONNECT,     // Disconnect from device.    See CrownstoneCentral::disconnect().
-	CMD_CS_CENTRAL_WRITE,          // Write a control command.   See CrownstoneCentral::write().
-	CMD_CS_CENTRAL_GET_WRITE_BUF,  // Request the write buffer.  See CrownstoneCentral::requestWriteBuffer(). The
-								   // result.buf will be set to the write buffer.
-
-	EVT_CS_CENTRAL_CONNECT_RESULT,
-	EVT_CS_CENTRAL_READ_RESULT,
-	EVT_CS_CENTRAL_WRITE_RESULT,
-
-	CMD_MESH_TOPO_GET_MAC,     // Get the MAC address of a given stone ID.
-	EVT_MESH_TOPO_MAC_RESULT,  // The resulting MAC address.
-	CMD_MESH_TOPO_RESET,       // Reset the stored mesh topology.
-	CMD_MESH_TOPO_GET_RSSI,    // Get the RSSI to a stoneId. The RSSI is set in the result.
-
-	EVT_TWI_INIT,    // TWI initialisation.
-	EVT_TWI_WRITE,   // TWI write.
-	EVT_TWI_READ,    // TWI read (request).
-	EVT_TWI_UPDATE,  // TWI update from TWI module to listeners (not implemented yet).
-
-	EVT_GPIO_INIT,    // GPIO, init pin (eventually event handler)
-	EVT_GPIO_WRITE,   // GPIO, write value
-	EVT_GPIO_READ,    // GPIO, read value (directly)
-	EVT_GPIO_UPDATE,  // GPIO, update other modules with read values
-
-	CMD_RESOLVE_ASYNC_CONTROL_COMMAND,  // When a control command returned WAIT_FOR_SUCCESS, this event finalizes that
-										// control command.
-	CMD_SEND_ASYNC_RESULT_TO_BLE,       // Sends the async result to the user via BLE.
-
-	CMD_TEST_SET_TIME = InternalBaseTests,  // Set time for testing.
-
-	EVT_GENERIC_TEST  = 0xFFFF,  // Can be used by the python test python lib for ad hoc tests during development.
+#define CS_STATE_TYPE(NAME, VALUE, ...) NAME = VALUE,
+#define CS_STATE_TYPE_SIZED(NAME, VALUE, ...) NAME = VALUE,
+#define CS_INTERNAL_TYPE(NAME, VALUE) NAME = VALUE,
+#define CS_INTERNAL_TYPE_SIZED(NAME, VALUE, SIZE) NAME = VALUE,
+#include <common/cs_TypeList.h>
+#undef CS_STATE_TYPE
+#undef CS_STATE_TYPE_SIZED
+#undef CS_INTERNAL_TYPE
+#undef CS_INTERNAL_TYPE_SIZED
 };
 
 CS_TYPE toCsType(uint16_t type);
@@ -525,6 +188,7 @@ typedef state_errors_t TYPIFY(STATE_ERRORS);
 typedef uint8_t TYPIFY(STATE_FACTORY_RESET);
 typedef uint8_t TYPIFY(STATE_OPERATION_MODE);
 typedef int32_t TYPIFY(STATE_POWER_USAGE);
+typedef cs_power_quality_t TYPIFY(STATE_POWER_QUALITY);
 typedef uint16_t TYPIFY(STATE_RESET_COUNTER);
 typedef switch_state_t TYPIFY(STATE_SWITCH_STATE);
 typedef int8_t TYPIFY(STATE_TEMPERATURE);
@@ -591,6 +255,7 @@ typedef BOOL TYPIFY(CMD_ENABLE_LOG_CURRENT);
 typedef BOOL TYPIFY(CMD_ENABLE_LOG_FILTERED_CURRENT);
 typedef BOOL TYPIFY(CMD_ENABLE_LOG_POWER);
 typedef BOOL TYPIFY(CMD_ENABLE_LOG_VOLTAGE);
+typedef uint8_t TYPIFY(CMD_SET_LOG_SAMPLES_STREAM);
 typedef BOOL TYPIFY(CMD_ENABLE_MESH);
 typedef void TYPIFY(CMD_INC_VOLTAGE_RANGE);
 typedef void TYPIFY(CMD_INC_CURRENT_RANGE);
@@ -690,6 +355,8 @@ typedef void TYPIFY(CMD_GET_RESET_REASON);
 typedef uint8_t TYPIFY(CMD_GET_GPREGRET);
 typedef void TYPIFY(CMD_GET_ADC_CHANNEL_SWAPS);
 typedef void TYPIFY(CMD_GET_RAM_STATS);
+typedef void TYPIFY(CMD_GET_STORAGE_STATS);
+typedef void TYPIFY(CMD_GET_SOFTFUSE_LATENCY);
 typedef void TYPIFY(CMD_MICROAPP_GET_INFO);
 typedef microapp_upload_internal_t TYPIFY(CMD_MICROAPP_UPLOAD);
 typedef microapp_ctrl_header_t TYPIFY(CMD_MICROAPP_VALIDATE);
@@ -723,6 +390,27 @@ typedef cs_gpio_update_t TYPIFY(EVT_GPIO_UPDATE);
 typedef cs_async_result_t TYPIFY(CMD_RESOLVE_ASYNC_CONTROL_COMMAND);
 typedef cs_async_result_t TYPIFY(CMD_SEND_ASYNC_RESULT_TO_BLE);
 
+/**
+ * Maps a state type to the type of its value, so that the size of a value can be checked at compile time.
+ *
+ * Only defined for state types that have the size of TYPIFY(NAME).
+ */
+template <CS_TYPE type>
+struct cs_state_value_type;
+
+// clang-format off
+#define CS_STATE_TYPE(NAME, VALUE, ...) \
+	template <> struct cs_state_value_type<CS_TYPE::NAME> { typedef TYPIFY(NAME) type; };
+#define CS_STATE_TYPE_SIZED(NAME, VALUE, ...)
+#define CS_INTERNAL_TYPE(NAME, VALUE)
+#define CS_INTERNAL_TYPE_SIZED(NAME, VALUE, SIZE)
+#include <common/cs_TypeList.h>
+#undef CS_STATE_TYPE
+#undef CS_STATE_TYPE_SIZED
+#undef CS_INTERNAL_TYPE
+#undef CS_INTERNAL_TYPE_SIZED
+// clang-format on
+
 /**
  * The size of a particular default value. In case of strings or arrays this is the maximum size of the corresponding
  * field. There are no fields that are of unrestricted size. For fields that are not implemented it is possible to
@@ -257,6 +257,13 @@ private:
 	 */
 	void configureAdvertisement();
 
+	/**
+	 * Log how long the boot step took since the previous step, and the time since boot.
+	 *
+	 * Used to get a breakdown of the time until the first advertisement.
+	 */
+	void logBootStep(const char* step);
+
 	/**
 	 * The default name. This can later be altered by the user if the corresponding service and characteristic is
 	 * enabled. It is loaded from memory or from the default and written to the Stack.
@@ -392,6 +399,9 @@ private:
 	//! Store reset reason as it was on boot.
 	uint32_t _resetReason           = 0;
 
+	//! RTC count at the end of the previous boot step.
+	uint32_t _bootStepStartCount    = 0;
+
 	static cs_ram_stats_t _ramStats;
 
 	/**
@@ -128,6 +128,29 @@ public:
 	 */
 	void enableZeroCrossingInterrupt(adc_channel_id_t channel, int32_t zeroVal);
 
+	/**
+	 * Enable the limit guard on given channel.
+	 *
+	 * The guard triggers when a sample is below the low limit, or above the high limit, after which it disables itself.
+	 * Uses the SAADC limit events, so it can't be used on the zero crossing channel.
+	 *
+	 * @param[in] channel              The channel to guard.
+	 * @param[in] lowLimit             The lowest sample value that doesn't trigger the guard.
+	 * @param[in] highLimit            The highest sample value that doesn't trigger the guard.
+	 * @return                         Return code.
+	 */
+	cs_ret_code_t enableLimitGuard(adc_channel_id_t channel, int32_t lowLimit, int32_t highLimit);
+
+	/**
+	 * Disable the limit guard.
+	 */
+	void disableLimitGuard();
+
+	/**
+	 * Whether the limit guard triggered since it was enabled.
+	 */
+	bool isLimitGuardTriggered();
+
 	/**
 	 * Change channel config.
 	 *
@@ -155,6 +178,10 @@ public:
 	 */
 	void _handleAdcLimitInterrupt(nrf_saadc_limit_t type);
 
+	/** Called when a sample of the guarded channel is outside the limits.
+	 */
+	void _handleLimitGuardInterrupt();
+
 	/**
 	 * Handles the ADC interrupt.
 	 *
@@ -306,6 +333,35 @@ private:
 	 */
 	int _criticalRegionEntered    = 0;
 
+	/**
+	 * Cache limit guard events.
+	 *
+	 * == Used in interrupt! ==
+	 */
+	nrf_saadc_event_t _eventLimitGuardLow;
+	nrf_saadc_event_t _eventLimitGuardHigh;
+
+	/**
+	 * The channel of the limit guard.
+	 *
+	 * == Used in interrupt! ==
+	 */
+	adc_channel_id_t _limitGuardChannel = 0;
+
+	/**
+	 * Keep up whether the limit guard is enabled.
+	 *
+	 * == Used in interrupt! ==
+	 */
+	volatile bool _limitGuardEnabled   = false;
+
+	/**
+	 * Keep up whether the limit guard triggered.
+	 *
+	 * == Used in interrupt! ==
+	 */
+	volatile bool _limitGuardTriggered = false;
+
 	cs_ret_code_t initSaadc();
 
 	/**
@@ -323,6 +379,9 @@ private:
 	// Set the adc limit such that it triggers when going below zero
 	void setLimitDown();
 
+	// Disable the limit guard interrupts and limits
+	void clearLimitGuard();
+
 	// Initialize buffer queue
 	cs_ret_code_t initBufferQueue();
 
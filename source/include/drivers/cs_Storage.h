@@ -10,6 +10,8 @@
 #include <common/cs_Types.h>
 #include <components/libraries/fds/fds.h>
 #include <storage/cs_StateData.h>
+#include <storage/cs_StorageRecordIndex.h>
+#include <storage/cs_StorageStats.h>
 #include <util/cs_Utils.h>
 #include <test/cs_TestAccess.h>
 
@@ -46,6 +48,10 @@ typedef void (*cs_storage_error_callback_t)(cs_storage_operation_t operation, CS
  * (TODO). Since FDS always appends records, it is assumed that the last valid record should be kept. Checking for
  * duplicates is done for each write and each read.
  *
+ * When built with BUILD_FLASH_RECORD_INDEX, all records are indexed at init. Reads and writes then look up the record
+ * in the index instead of searching through flash, and duplicates are only checked at init. This makes the first reads
+ * of State at boot a lot faster, especially for values that are not in flash at all.
+ *
  * Some operations will block other operations. For example, you can't write a record while performing garbage
  * collection. You can't write a record while it's already being written. This is what the "busy" functions are for.
  * Each type can be set busy multiple times, for example in case multiple records of the same type are being deleted.
@@ -274,6 +280,11 @@ public:
 	 */
 	uint8_t* allocate(size16_t& size);
 
+	/**
+	 * Get statistics of flash operations since boot.
+	 */
+	const cs_storage_stats_t& getStats() { return _stats.getStats(); }
+
 	/**
 	 * Handle FDS events.
 	 */
@@ -304,7 +315,27 @@ private:
 	bool _collectingGarbage      = false;
 	bool _removingFile           = false;
 	bool _performingFactoryReset = false;
-	std::vector<uint16_t> _busyRecordKeys;
+
+	/**
+	 * A record key that is busy, and the RTC count at which the operation was started.
+	 */
+	struct cs_storage_busy_record_t {
+		uint16_t recordKey;
+		uint32_t startCount;
+	};
+	std::vector<cs_storage_busy_record_t> _busyRecordKeys;
+
+	StorageStats _stats;
+
+	/**
+	 * RTC count at which the garbage collection was started.
+	 */
+	uint32_t _garbageCollectionStartCount = 0;
+
+	/**
+	 * Number of words that could be freed by garbage collection, at the start of the garbage collection.
+	 */
+	uint32_t _garbageCollectionFreeableWords = 0;
 
 	/**
 	 * Next page to erase. Used by eraseAllPages().
@@ -318,6 +349,18 @@ private:
 
 	CS_TYPE _eraseDoneEvent = CS_TYPE::CONFIG_DO_NOT_USE;
 
+#if BUILD_FLASH_RECORD_INDEX == 1
+	/**
+	 * Index of all valid records in flash, built at init, and kept up to date by the FDS events.
+	 */
+	StorageRecordIndex _recordIndex;
+
+	/**
+	 * Iterate over all records in flash, and add them to the index.
+	 */
+	void buildRecordIndex();
+#endif
+
 	/**
 	 * Find next fileId for given recordKey.
 	 */
@@ -332,8 +375,9 @@ private:
 	 * Read a record: copy data to buffer, and sets fileId.
 	 *
 	 * Only returns success when data has been copied to buffer.
+	 * The record descriptor is updated by FDS when the record has been moved.
 	 */
-	cs_ret_code_t readRecord(fds_record_desc_t recordDesc, uint8_t* buf, uint16_t size, uint16_t& fileId);
+	cs_ret_code_t readRecord(fds_record_desc_t& recordDesc, uint8_t* buf, uint16_t size, uint16_t& fileId);
 
 	/** Write to persistent storage.
 	 */
@@ -341,6 +385,16 @@ private:
 
 	ret_code_t garbageCollectInternal();
 
+	/**
+	 * Start garbage collection, and keep up the stats.
+	 */
+	ret_code_t startGarbageCollection();
+
+	/**
+	 * Get the number of words that could be freed by garbage collection.
+	 */
+	uint32_t getFreeableWords();
+
 	bool isErasingPages();
 
 	/**
@@ -11,8 +11,25 @@
 
 #define MAX_EVENT_LISTENERS 48
 
+/**
+ * Maximum number of distinct types that listeners can subscribe to.
+ * When the table is full, a listener will fall back to receiving all events.
+ */
+#define MAX_EVENT_SUBSCRIPTIONS 64
+
+/**
+ * Bitmask of listeners, bit N corresponds with the listener at index N.
+ */
+typedef uint64_t event_listener_mask_t;
+
+static_assert(MAX_EVENT_LISTENERS <= sizeof(event_listener_mask_t) * 8, "Listener mask too small");
+
 /**
  * Event dispatcher.
+ *
+ * Listeners either receive all events, or only the types they subscribed to.
+ * The subscriptions are kept in a table sorted by type, each entry holds a bitmask of the subscribed listeners.
+ * A dispatch looks up the type, and only calls the listeners of which the bit is set, in order of registration.
  */
 class EventDispatcher {
 
@@ -25,6 +42,50 @@ private:
 	//! Count of added listeners
 	uint16_t _listenerCount;
 
+	//! Listeners that receive every event.
+	event_listener_mask_t _broadcastListeners = 0;
+
+	//! Subscribed types, sorted.
+	CS_TYPE _subscriptionTypes[MAX_EVENT_SUBSCRIPTIONS];
+
+	//! Subscribed listeners, for each entry in _subscriptionTypes.
+	event_listener_mask_t _subscriptionListeners[MAX_EVENT_SUBSCRIPTIONS];
+
+	//! Number of used entries in the subscription table.
+	uint8_t _subscriptionCount = 0;
+
+	/**
+	 * Get the index of a listener.
+	 *
+	 * @return Index, or -1 when not registered.
+	 */
+	int getListenerIndex(EventListener* listener);
+
+	/**
+	 * Get the index in the subscription table of the first entry with a type that is equal to or larger than given
+	 * type.
+	 */
+	uint8_t lowerBound(CS_TYPE type);
+
+	/**
+	 * Get the mask of listeners that subscribed to given type.
+	 */
+	event_listener_mask_t getSubscribers(CS_TYPE type);
+
+	/**
+	 * Add the listener at given index to the subscribers of given type.
+	 *
+	 * @return False when the subscription table is full.
+	 */
+	bool addSubscription(CS_TYPE type, uint8_t listenerIndex);
+
+	/**
+	 * Clear all subscriptions of the listener at given index.
+	 *
+	 * @param[in] shift      Whether to shift down the bits of all listeners with a higher index.
+	 */
+	void clearSubscriptions(uint8_t listenerIndex, bool shift);
+
 public:
 	static EventDispatcher& getInstance() {
 		static EventDispatcher instance;
@@ -34,12 +95,20 @@ public:
 	EventDispatcher(EventDispatcher const&) = delete;
 	void operator=(EventDispatcher const&) = delete;
 
-	//! Add a listener
+	//! Add a listener, that will receive all events.
 	bool addListener(EventListener* listener);
 
+	/**
+	 * Add a listener, that will only receive events of the given types.
+	 *
+	 * When the listener was already added, its previous subscriptions are replaced.
+	 * When the subscription table is full, the listener will receive all events instead.
+	 */
+	bool addListener(EventListener* listener, const CS_TYPE* types, uint8_t typeCount);
+
 	//! Nulls all elements in _listeners equal to listener.
 	void removeListener(EventListener* listener);
 
-	//! Dispatch an event to all registered (non-null) listeners.
+	//! Dispatch an event to all registered (non-null) listeners that are interested in the event type.
 	void dispatch(event_t& event);
 };
@@ -10,6 +10,7 @@
 #include <events/cs_Event.h>
 
 #include <cstdint>
+#include <initializer_list>
 
 /**
  * Event listener.
@@ -31,7 +32,15 @@ public:
 	virtual void handleEvent(event_t& event) = 0;
 
 	/**
-	 * Registers this with the EventDispatcher.
+	 * Registers this with the EventDispatcher, to receive all events.
 	 */
 	void listen();
+
+	/**
+	 * Registers this with the EventDispatcher, to only receive events of the given types.
+	 *
+	 * Make sure the list contains every type that is handled in handleEvent().
+	 * Calling this again replaces the previous list of types.
+	 */
+	void listen(std::initializer_list<CS_TYPE> types);
 };
@@ -163,11 +163,11 @@ public:
 	CuckooFilter cuckooFilter();
 
 	/**
-	 * Get the cuckoo filter.
+	 * Get the exact match filter, with the items in the given layout.
 	 *
 	 * Only valid if filter type is FilterType::ExactMatchFilter.
 	 */
-	ExactMatchFilter exactMatchFilter();
+	ExactMatchFilter exactMatchFilter(ExactMatchFilterLayout layout = ExactMatchFilterLayout::Sorted);
 
 	/**
 	 * Checks if the data has valid values.
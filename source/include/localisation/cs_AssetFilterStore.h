@@ -263,6 +263,7 @@ private:
 	 * When all checks pass:
 	 * - Stores the filters, if store == true.
 	 * - Marks filters as committed.
+	 * - Reorders the filters for faster lookups.
 	 * - Unsets "modification in progress".
 	 * - Sets master version.
 	 */
@@ -315,6 +316,16 @@ private:
 	 */
 	void markFiltersCommitted();
 
+	/**
+	 * Reorders the items of exact match filters to the Eytzinger layout.
+	 *
+	 * Must be done after storing, as the persisted data, and its CRC, are of the sorted layout.
+	 *
+	 * - Skips filters that are already reordered (flags.eytzingerLayout == true).
+	 * - Sets flags.eytzingerLayout to true.
+	 */
+	void applyLookupLayouts();
+
 public:
 	/**
 	 * Internal usage.
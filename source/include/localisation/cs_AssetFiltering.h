@@ -14,6 +14,7 @@
 #include <localisation/cs_AssetForwarder.h>
 #include <localisation/cs_AssetHandler.h>
 #include <localisation/cs_NearestCrownstoneTracker.h>
+#include <util/cs_AssetFilterPlan.h>
 #include <util/cs_Utils.h>
 
 class AssetFiltering : public EventListener, public Component {
@@ -60,6 +61,16 @@ private:
 	};
 	AssetFilteringState _initState = AssetFilteringState::NONE;
 
+	/**
+	 * Evaluates the filters of the filter store for scanned devices.
+	 */
+	AssetFilterPlan _filterPlan;
+
+	/**
+	 * Whether the filters changed since the filter plan was made.
+	 */
+	bool _filterPlanOutdated = true;
+
 	/**
 	 * Initializes this class.
 	 *
@@ -75,12 +86,9 @@ private:
 	void handleScannedDevice(const scanned_device_t& asset);
 
 	/**
-	 * Check if the filter with given index accepts the device, call handleAcceptedAsset and.
-	 * dispatches EVT_ASSET_ACCEPTED if so.
-	 *
-	 * Returns true if the filter accepts the device and the exclude flag is false.
+	 * Calls handleAcceptedAsset and dispatches EVT_ASSET_ACCEPTED, for a filter that accepts the device.
 	 */
-	bool checkIfFilterAccepts(uint8_t filterIndex, const scanned_device_t& device);
+	void handleAcceptingFilter(uint8_t filterIndex, const scanned_device_t& device);
 
 	/**
 	 * splits out into subhandlers based on filter output type.
@@ -93,10 +101,10 @@ private:
 	void handleAcceptedAssetOutputAssetIdNearest(uint8_t filterId, AssetFilter filter, const scanned_device_t& asset);
 
 	/**
-	 * Returns true if there is a filter that rejects this device.
+	 * Makes the filter plan for the current filters in the filter store.
 	 * (Does not check if the filterstore is ready.)
 	 */
-	bool isAssetRejected(const scanned_device_t& device);
+	void updateFilterPlan();
 
 public:
 	/**
@@ -10,7 +10,7 @@
 #include <events/cs_EventListener.h>
 #include <localisation/cs_AssetRecord.h>
 #include <util/cs_Coroutine.h>
-#include <util/cs_Store.h>
+#include <util/cs_IndexedStore.h>
 
 class AssetStore : public EventListener, public Component {
 public:
@@ -73,7 +73,7 @@ private:
 
 	// =================== private variables ===================
 
-	Store<asset_record_t, MAX_RECORDS> _store;
+	IndexedStore<asset_record_t, MAX_RECORDS> _store;
 
 	Coroutine updateLastReceivedCounterRoutine;
 	Coroutine updateLastSentCounterRoutine;
@@ -0,0 +1,129 @@
+/**
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Mar 19, 2018
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <protocol/cs_Typedefs.h>
+
+#include <cstdint>
+
+/**
+ * Sliding window median filter, that updates the window per sample instead of sorting each window.
+ *
+ * The window is kept in a double heap (the "mediator"): a max heap of the values below the median, and a min heap of
+ * the values above the median, with the median in between. Both heaps have half the window size. For each sample, the
+ * oldest value in the window is replaced by the new value, which is then moved up or down the heaps. This takes
+ * O(log k) operations per sample, for a window size of k.
+ *
+ * The filter works on a channel of interleaved samples, like the ADC buffers, so the samples don't have to be copied.
+ */
+class SlidingMedianFilter {
+public:
+	/**
+	 * @param[in] halfWindowSize  Number of samples on each side of the center of the window.
+	 *                            The window size will be 2 * halfWindowSize + 1.
+	 */
+	SlidingMedianFilter(uint16_t halfWindowSize);
+
+	~SlidingMedianFilter();
+
+	/**
+	 * Filter a channel of interleaved samples.
+	 *
+	 * Each output sample is the median of the window of input samples, centered at the same index. At the edges, the
+	 * input is padded with copies of the first and last sample.
+	 *
+	 * Input and output may point to the same samples: each sample is read before the output at that index is written.
+	 *
+	 * @param[in] input           First sample of the channel.
+	 * @param[out] output         First sample of the channel to write the filtered samples to.
+	 * @param[in] stride          Distance between consecutive samples of the channel, the number of channels.
+	 * @param[in] numSamples      Number of samples of the channel.
+	 */
+	void filter(const adc_sample_value_t* input, adc_sample_value_t* output, uint16_t stride, uint16_t numSamples);
+
+	uint16_t getHalfWindowSize() { return _halfWindowSize; }
+
+private:
+	uint16_t _halfWindowSize;
+	uint16_t _windowSize;
+
+	/**
+	 * Index of the oldest value in the window, which will be replaced next.
+	 *
+	 * Values are indexed in order of arrival, modulo the window size.
+	 */
+	uint16_t _oldest = 0;
+
+	/**
+	 * For each value index, its position in the heap.
+	 */
+	int16_t* _heapPositions;
+
+	/**
+	 * Heap of the values in the window, with their value index.
+	 *
+	 * Positions from -halfWindowSize to -1 are the max heap, position 0 is the median, and positions from 1 to
+	 * halfWindowSize are the min heap. The children of position p are at 2p and 2p+1 (or 2p and 2p-1 for the max heap).
+	 *
+	 * The values are kept in the heap itself, instead of indices into a buffer of values, so that comparing and
+	 * swapping does not need an extra lookup.
+	 */
+	adc_sample_value_t* _heapValues;
+	uint16_t* _heapIndices;
+
+	/**
+	 * Start of the allocated heap arrays, the heap pointers point to the middle of them.
+	 */
+	adc_sample_value_t* _heapValuesBuf;
+	uint16_t* _heapIndicesBuf;
+
+	/**
+	 * Fill the whole window with a value.
+	 */
+	void reset(adc_sample_value_t value);
+
+	/**
+	 * Replace the oldest value in the window with a new value.
+	 */
+	void insert(adc_sample_value_t value);
+
+	inline adc_sample_value_t getMedian() { return _heapValues[0]; }
+
+	inline bool isLess(int16_t i, int16_t j) { return _heapValues[i] < _heapValues[j]; }
+
+	/**
+	 * Swap values at heap positions i and j, if the value at i is less than the value at j.
+	 *
+	 * @return True when swapped.
+	 */
+	bool swapIfLess(int16_t i, int16_t j);
+
+	/**
+	 * Move the value at heap position i down the min heap.
+	 */
+	void minSortDown(int16_t i);
+
+	/**
+	 * Move the value at heap position i down the max heap.
+	 */
+	void maxSortDown(int16_t i);
+
+	/**
+	 * Move the value at heap position i up the min heap, up to the median.
+	 *
+	 * @return True when the value became the median.
+	 */
+	bool minSortUp(int16_t i);
+
+	/**
+	 * Move the value at heap position i up the max heap, up to the median.
+	 *
+	 * @return True when the value became the median.
+	 */
+	bool maxSortUp(int16_t i);
+};
@@ -0,0 +1,171 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <cfg/cs_Config.h>
+#include <protocol/cs_Typedefs.h>
+
+#include <cstdint>
+
+/**
+ * Raw sums over a buffer of interleaved samples of two channels.
+ *
+ * From these, the sums of squares and products of the zero-corrected samples can be derived, without going over the
+ * samples again. See powerKernelCenteredProductSum().
+ *
+ * numSamples:       Number of samples per channel.
+ * sum:              Sum of the samples, per channel.
+ * squareSum:        Sum of the squared samples, per channel.
+ * productSum:       Sum of the product of the samples of both channels.
+ */
+struct power_kernel_sums_t {
+	adc_sample_value_id_t numSamples = 0;
+	int32_t sum[2]                   = {0, 0};
+	int64_t squareSum[2]             = {0, 0};
+	int64_t productSum               = 0;
+};
+
+/**
+ * Calculate the raw sums of a buffer with 2 interleaved channels, in a single pass.
+ *
+ * On a Cortex-M4, this uses the DSP instructions to process 2 samples per channel at once: two dual 16x16 multiply
+ * accumulates for the squares, and one for the product. On other platforms, these instructions are emulated, so the
+ * result is always the same as that of powerKernelAccumulateReference().
+ *
+ * @param[in] samples         Interleaved samples: channel 0, channel 1, channel 0, etc.
+ * @param[in] numSamples      Number of samples per channel.
+ * @param[out] sums           The calculated sums.
+ */
+void powerKernelAccumulate(
+		const adc_sample_value_t* samples, adc_sample_value_id_t numSamples, power_kernel_sums_t& sums);
+
+/**
+ * Same as powerKernelAccumulate(), for a buffer with a separate plane per channel.
+ *
+ * Two consecutive samples of a channel are loaded as one word, so the samples don't have to be packed first.
+ *
+ * @param[in] samples0        Samples of channel 0.
+ * @param[in] samples1        Samples of channel 1.
+ * @param[in] numSamples      Number of samples per channel.
+ * @param[out] sums           The calculated sums.
+ */
+void powerKernelAccumulatePlanar(
+		const adc_sample_value_t* samples0,
+		const adc_sample_value_t* samples1,
+		adc_sample_value_id_t numSamples,
+		power_kernel_sums_t& sums);
+
+/**
+ * Portable reference of powerKernelAccumulate(), that processes one sample per channel at a time.
+ */
+void powerKernelAccumulateReference(
+		const adc_sample_value_t* samples, adc_sample_value_id_t numSamples, power_kernel_sums_t& sums);
+
+/**
+ * Number of samples per channel of the AC period, for which the harmonics can be calculated.
+ *
+ * The cosine and sine tables are generated at compile time for this length, which follows from the configured
+ * sampling interval.
+ */
+static constexpr adc_sample_value_id_t POWER_KERNEL_PERIOD_LENGTH = CS_ADC_NUM_SAMPLES_PER_CHANNEL;
+
+/**
+ * Correlation of the samples of a channel with the cosine and the sine of a harmonic, scaled by 32767.
+ */
+struct power_kernel_phasor_t {
+	int64_t cos = 0;
+	int64_t sin = 0;
+};
+
+/**
+ * Correlations of both channels with the odd harmonics of the AC frequency: 1, 3, 5, etc.
+ *
+ * The amplitude of a harmonic, in the unit of the samples, is:
+ *   2 * sqrt(cos^2 + sin^2) / (32767 * POWER_KERNEL_PERIOD_LENGTH)
+ *
+ * Over a period, the cosine and sine of an odd harmonic sum to exactly 0, so the zero offset of the samples drops out.
+ */
+struct power_kernel_harmonic_sums_t {
+	power_kernel_phasor_t harmonics[2][POWER_QUALITY_NUM_HARMONICS];
+};
+
+/**
+ * Same as powerKernelAccumulate(), but also correlates both channels with the odd harmonics, in the same pass.
+ *
+ * The buffer should hold exactly POWER_KERNEL_PERIOD_LENGTH samples per channel. On a Cortex-M4, each pair of samples
+ * of a channel costs one dual 16x16 multiply accumulate per harmonic for the cosine, and one for the sine.
+ *
+ * @param[in] samples         Interleaved samples: channel 0, channel 1, channel 0, etc.
+ * @param[out] sums           The calculated sums.
+ * @param[out] harmonicSums   The calculated correlations.
+ */
+void powerKernelAccumulateHarmonics(
+		const adc_sample_value_t* samples, power_kernel_sums_t& sums, power_kernel_harmonic_sums_t& harmonicSums);
+
+/**
+ * Same as powerKernelAccumulateHarmonics(), for a buffer with a separate plane per channel.
+ */
+void powerKernelAccumulateHarmonicsPlanar(
+		const adc_sample_value_t* samples0,
+		const adc_sample_value_t* samples1,
+		power_kernel_sums_t& sums,
+		power_kernel_harmonic_sums_t& harmonicSums);
+
+/**
+ * Portable reference of powerKernelAccumulateHarmonics(), that processes one sample per channel at a time.
+ */
+void powerKernelAccumulateHarmonicsReference(
+		const adc_sample_value_t* samples, power_kernel_sums_t& sums, power_kernel_harmonic_sums_t& harmonicSums);
+
+/**
+ * Get the sum of the product of zero-corrected samples of 2 channels, or of the square when both channels are the same.
+ *
+ * Each sample is corrected as (sample * 1024 - zero), and the sum is divided by 1024 * 1024 at the end.
+ *
+ * The int64_t sum is large enough for 12 bit samples: the terms are at most 2^20 * 2^24, so many more samples than the
+ * 100 we use fit.
+ *
+ * @param[in] sums            Raw sums, as calculated by powerKernelAccumulate().
+ * @param[in] channelA        First channel.
+ * @param[in] zeroA           Zero of the first channel, times 1024.
+ * @param[in] channelB        Second channel.
+ * @param[in] zeroB           Zero of the second channel, times 1024.
+ * @return                    Sum of (sampleA * 1024 - zeroA) * (sampleB * 1024 - zeroB) / (1024 * 1024).
+ */
+int64_t powerKernelCenteredProductSum(
+		const power_kernel_sums_t& sums,
+		adc_channel_id_t channelA,
+		int32_t zeroA,
+		adc_channel_id_t channelB,
+		int32_t zeroB);
+
+/**
+ * Get the sum of the squared differences between the samples of 2 buffers of a single channel.
+ *
+ * Stops early, once the sum has reached the limit, so the result is only exact when it's below the limit.
+ *
+ * On a Cortex-M4, this subtracts 2 samples at once, and uses a dual 16x16 multiply accumulate for the squares. The
+ * accumulator is 32 bit: with 12 bit samples, at most 128 samples fit.
+ *
+ * @param[in] samplesA        Samples of the first buffer.
+ * @param[in] samplesB        Samples of the second buffer.
+ * @param[in] numSamples      Number of samples.
+ * @param[in] limit           Sum at which to stop.
+ * @return                    The sum, or a partial sum at or above the limit.
+ */
+uint32_t powerKernelSquaredDiffSum(
+		const adc_sample_value_t* samplesA,
+		const adc_sample_value_t* samplesB,
+		adc_sample_value_id_t numSamples,
+		uint32_t limit);
+
+/**
+ * Portable reference of powerKernelSquaredDiffSum(), without the early stop.
+ */
+uint32_t powerKernelSquaredDiffSumReference(
+		const adc_sample_value_t* samplesA, const adc_sample_value_t* samplesB, adc_sample_value_id_t numSamples);
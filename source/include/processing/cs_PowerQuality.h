@@ -0,0 +1,72 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <processing/cs_PowerKernel.h>
+#include <protocol/cs_Packets.h>
+
+#include <cstdint>
+
+/**
+ * Averages the power factor and harmonics over a number of AC periods.
+ *
+ * The harmonics of each period are calculated by powerKernelAccumulateHarmonics(), from the unfiltered samples. This
+ * class only does a few floating point operations per period, and the conversion to the published units once every
+ * POWER_QUALITY_INTERVAL_PERIODS periods.
+ */
+class PowerQuality {
+public:
+	PowerQuality() { reset(); }
+
+	/**
+	 * Add the measurements of one AC period.
+	 *
+	 * @param[in] voltageHarmonics      Harmonics of the voltage, as calculated by powerKernelAccumulateHarmonics().
+	 * @param[in] currentHarmonics      Harmonics of the current, as calculated by powerKernelAccumulateHarmonics().
+	 * @param[in] powerMilliWatt        Real power.
+	 * @param[in] currentRmsMA          RMS current.
+	 * @param[in] voltageRmsMilliVolt   RMS voltage.
+	 * @return                          True when enough periods have been added, and calculate() should be called.
+	 */
+	bool add(
+			const power_kernel_phasor_t voltageHarmonics[POWER_QUALITY_NUM_HARMONICS],
+			const power_kernel_phasor_t currentHarmonics[POWER_QUALITY_NUM_HARMONICS],
+			int32_t powerMilliWatt,
+			int32_t currentRmsMA,
+			int32_t voltageRmsMilliVolt);
+
+	/**
+	 * Calculate the power quality of the added periods, and start over.
+	 *
+	 * @param[in] voltageMultiplier     Multiplier to get volts from voltage samples.
+	 * @param[in] currentMultiplier     Multiplier to get amps from current samples.
+	 * @param[out] powerQuality         The calculated power quality.
+	 */
+	void calculate(float voltageMultiplier, float currentMultiplier, cs_power_quality_t& powerQuality);
+
+private:
+	uint16_t _numPeriods;
+
+	int64_t _realPowerSumMilliWatt;
+	int64_t _apparentPowerSumMilliWatt;
+
+	// Sums of the real part of V1 * conj(I1), and of |V1| * |I1|, of the fundamentals.
+	float _fundamentalProductSum;
+	float _fundamentalMagnitudeSum;
+
+	// Sums of the squared magnitudes of the harmonics.
+	float _voltageHarmonicSquareSums[POWER_QUALITY_NUM_HARMONICS];
+	float _currentHarmonicSquareSums[POWER_QUALITY_NUM_HARMONICS];
+
+	void reset();
+
+	/**
+	 * Get the RMS of a harmonic, from the sum of its squared magnitudes.
+	 */
+	float getHarmonicRms(float squareSum, float multiplier);
+};
@@ -9,10 +9,13 @@
 #include <cfg/cs_Boards.h>
 #include <drivers/cs_ADC.h>
 #include <events/cs_EventListener.h>
+#include <processing/cs_MedianFilter.h>
+#include <processing/cs_PowerQuality.h>
+#include <protocol/cs_UartProtocol.h>
 #include <storage/cs_State.h>
 #include <structs/buffer/cs_AdcBuffer.h>
 #include <structs/buffer/cs_CircularBuffer.h>
-#include <third/Median.h>
+#include <util/cs_RunningMedian.h>
 
 #include <cstdint>
 
@@ -67,6 +70,25 @@ public:
 	 */
 	uint32_t getSkippedBufCount();
 
+	/**
+	 * Enable or disable skipping the processing of buffers while the load is steady.
+	 *
+	 * While the load is steady, only the RMS current, RMS voltage and power of the unfiltered samples are calculated.
+	 * The current is also guarded by the ADC limits, at the softfuse threshold. Processing resumes at the first buffer
+	 * that is outside the band, or when the switch state changes.
+	 */
+	void enableSteadyMode(bool enable);
+
+	/**
+	 * Get the number of buffers that have not been processed, because the load was steady.
+	 */
+	uint32_t getSteadySkippedBufCount();
+
+	/**
+	 * Get an estimate of the CPU time saved by not processing buffers, in ms.
+	 */
+	uint32_t getSteadySavedMs();
+
 	/** handle (crownstone) events
 	 */
 	void handleEvent(event_t& event);
@@ -161,16 +183,15 @@ private:
 	int32_t _avgCurrentRmsMilliAmp;   //! Used for storing the average rms current (in mA).
 	int32_t _avgVoltageRmsMilliVolt;  //! Used for storing the average rms voltage (in mV).
 
-	PowerVector* _inputSamples;   //! Used for storing the samples to be filtered.
-	PowerVector* _outputSamples;  //! Used for storing the filtered samples.
-	MedianFilter* _filterParams;  //! Stores the parameters for the moving median filter.
+	SlidingMedianFilter* _medianFilter;  //! Moving median filter, applied to each channel of the ADC buffers.
+
+	CircularBuffer<int32_t>* _powerMilliWattHist;  //! Used to store a history of the power
+
+	//! Histories of the current_rms, the filtered current_rms, and the voltage_rms, with their running median.
+	RunningMedian<int32_t, POWER_SAMPLING_RMS_WINDOW_SIZE> _currentRmsMilliAmpHist;
+	RunningMedian<int32_t, POWER_SAMPLING_RMS_WINDOW_SIZE> _filteredCurrentRmsHistMA;
+	RunningMedian<int32_t, POWER_SAMPLING_RMS_WINDOW_SIZE> _voltageRmsMilliVoltHist;
 
-	CircularBuffer<int32_t>* _powerMilliWattHist;        //! Used to store a history of the power
-	CircularBuffer<int32_t>* _currentRmsMilliAmpHist;    //! Used to store a history of the current_rms
-	CircularBuffer<int32_t>* _filteredCurrentRmsHistMA;  //! Used to store a history of the filtered current_rms
-	CircularBuffer<int32_t>* _voltageRmsMilliVoltHist;   //! Used to store a history of the voltage_rms
-	int32_t _histCopy[POWER_SAMPLING_RMS_WINDOW_SIZE];   //! Used to copy a history to (so it can be used to calculate
-														 //! the median)
 	uint16_t _consecutiveDimmerOvercurrent = 0;
 	uint16_t _consecutiveOvercurrent       = 0;
 
@@ -207,6 +228,9 @@ private:
 		uint32_t asInt;
 	} _logsEnabled;
 
+	//! How the enabled samples are logged.
+	UartSamplesStreamMode _logSamplesStreamMode = UART_SAMPLES_STREAM_OFF;
+
 	adc_buffer_seq_nr_t _lastBufSeqNr     = 0;
 	adc_buffer_id_t _lastBufIndex         = 0;
 	adc_buffer_id_t _lastFilteredBufIndex = 0;
@@ -217,6 +241,38 @@ private:
 	//! Count number of buffers that have been skipped for processing.
 	uint32_t _bufSkipCount = 0;
 
+	//! Switch state at the start of the steady period.
+	switch_state_t _steadySwitchState;
+
+	//! Whether switchcraft is enabled, it needs every buffer.
+	bool _switchcraftEnabled              = false;
+
+	//! Whether buffers may be left unprocessed while the load is steady.
+	bool _steadyModeEnabled               = POWER_SAMPLING_STEADY_ENABLED;
+
+	//! Whether the load is steady, and buffers are left unprocessed.
+	bool _steady                          = false;
+
+	//! Number of consecutive buffers within the band around the steady values, and the steady values.
+	uint16_t _steadyBufCount              = 0;
+	int32_t _steadyCurrentRmsMA           = 0;
+	int32_t _steadyVoltageRmsMilliVolt    = 0;
+	int32_t _steadyPowerMilliWatt         = 0;
+
+	//! Number of buffers left unprocessed, and the RTC ticks spent on them.
+	uint32_t _steadySkippedBufCount       = 0;
+	uint64_t _steadySkippedRtcTicks       = 0;
+
+	//! Number of processed buffers, and the RTC ticks spent on them.
+	uint32_t _processedBufCount           = 0;
+	uint64_t _processedRtcTicks           = 0;
+
+	//! Number of buffers left unprocessed in the current steady period.
+	uint32_t _steadyPeriodSkippedBufCount = 0;
+
+	//! Averages the power factor and harmonics, until they're published.
+	PowerQuality _powerQuality;
+
 	/**
 	 * Load energy used from IPC ram.
 	 */
@@ -276,9 +332,55 @@ private:
 	/**
 	 * Calculate the average power usage
 	 *
+	 * @param[in] bufIndex                       Buffer with the filtered samples.
+	 * @param[in] unfilteredBufIndex             Buffer with the unfiltered samples, used for the harmonics.
 	 * @return true when calculation was successful.
 	 */
-	bool calculatePower(adc_buffer_id_t bufIndex);
+	bool calculatePower(adc_buffer_id_t bufIndex, adc_buffer_id_t unfilteredBufIndex);
+
+	/**
+	 * Calculate the RMS current, RMS voltage and real power of the samples in a buffer, over one AC period.
+	 *
+	 * Uses the average zero values, but doesn't correct for the power zero.
+	 */
+	void calculateRms(
+			adc_buffer_id_t bufIndex, int32_t& currentRmsMA, int32_t& voltageRmsMilliVolt, int32_t& powerMilliWatt);
+
+	/**
+	 * Calculate the harmonics of the samples in a buffer, over one AC period.
+	 *
+	 * @return true when the harmonics have been calculated: the buffer holds POWER_KERNEL_PERIOD_LENGTH samples per
+	 *         channel, and is still valid.
+	 */
+	bool calculateHarmonics(adc_buffer_id_t bufIndex, power_kernel_harmonic_sums_t& harmonicSums);
+
+	/**
+	 * Calculate the power quality of the last interval, and publish it to the state and the power log.
+	 */
+	void publishPowerQuality();
+
+	/**
+	 * Check whether the load is steady, so that the buffer doesn't have to be processed.
+	 *
+	 * Keeps up the steady values, and starts or stops the steady period.
+	 *
+	 * @return true when the buffer doesn't have to be processed.
+	 */
+	bool skipSteadyBuf(adc_buffer_id_t bufIndex);
+
+	/**
+	 * Whether buffers may be left unprocessed, given the last processed values.
+	 */
+	bool isSteadyAllowed(switch_state_t switchState);
+
+	/**
+	 * Get the current threshold of the softfuse that can trigger in the given switch state.
+	 */
+	int32_t getSoftfuseCurrentThreshold(switch_state_t switchState);
+
+	void startSteady(switch_state_t switchState);
+
+	void stopSteady();
 
 	void calculateSlowAveragePower(float powerMilliWatt, float fastAvgPowerMilliWatt);
 
@@ -327,4 +429,14 @@ private:
 	void enableSwitchcraft(bool enable);
 
 	void printBuf(adc_buffer_id_t bufIndex);
+
+	/**
+	 * Write the samples of a channel over UART, according to the samples stream mode.
+	 */
+	void logSamples(
+			adc_buffer_id_t bufIndex,
+			adc_channel_id_t channel,
+			UartOpcodeTx opCode,
+			UartSamplesType type,
+			uint32_t timestamp);
 };
@@ -32,6 +32,30 @@ private:
 
 	const static uint8_t _numStoredBuffers   = _numBuffersRequired;
 
+	// The buffers are compared in windows of half a buffer, that start every quarter buffer.
+	// The differences are summed per quarter buffer (segment), so that each window is the sum of 2 segments.
+	static_assert(AdcBuffer::getChannelLength() % 4 == 0, "Channel length should be a multiple of 4");
+	const static adc_sample_value_id_t _segmentLength = AdcBuffer::getChannelLength() / 4;
+	const static uint8_t _numSegments                 = 4;
+	const static uint8_t _numWindows                  = _numSegments - 1;
+
+	// The ADC buffers that are compared.
+	// Index 0 is the first buffer, index _numBuffersRequired - 1 is the last buffer, the others are center buffers.
+	adc_buffer_id_t _bufIndices[_numBuffersRequired];
+
+	// The voltage samples of the buffers that are compared, as contiguous arrays.
+	const adc_sample_value_t* _voltage[_numBuffersRequired];
+
+#if BUILD_ADC_DEINTERLEAVED == 0
+	// With interleaved ADC buffers, the voltage samples are copied here, so that the squared difference kernel can
+	// read them as contiguous arrays. This costs 4 buffers * 100 samples * 2 B = 800 B of RAM. With deinterleaved
+	// ADC buffers, the samples are read from the ADC buffers instead.
+	alignas(4) adc_sample_value_t _voltageCopy[_numBuffersRequired][AdcBuffer::getChannelLength()];
+#endif
+
+	// Whether any of the loaded samples should be ignored, see ignoreSample().
+	bool _hasIgnoredSamples = false;
+
 	// Store the samples and meta data of the last detection.
 	cs_power_samples_header_t _lastDetection;
 	cs_power_samples_header_t _lastAlmostDetection;
@@ -41,38 +65,50 @@ private:
 	enum FoundSwitch { True, Almost, False };
 
 	/**
-	 * Check if a switch is detected in the given buffers.
+	 * Load the voltage samples of the buffers to compare: copy them, or point to them when the buffers are
+	 * deinterleaved.
+	 *
+	 * @return                                   False when one of the buffers is not valid.
 	 */
-	FoundSwitch detect(
-			const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId, uint8_t iteration);
+	bool loadBuffers(const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId);
 
 	/**
-	 * Check if a switch is detected in the given buffers.
-	 *
-	 * Different way of calculating, using calcDiff().
-	 * Seems to go slower though.
+	 * Check whether the loaded buffers are still valid, and thus not overwritten.
 	 */
-	FoundSwitch detectSwitch(const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId);
+	bool buffersValid();
+
+	/**
+	 * Check if a switch is detected in the loaded buffers, with the given center buffer.
+	 */
+	FoundSwitch detect(uint8_t iteration);
 
 	/*
-	 * Calculate the difference between 2 buffers.
+	 * Calculate the summed squared difference between 2 loaded buffers.
+	 *
+	 * Samples that should be ignored in any of the 3 given buffers are skipped.
+	 * Stops early once the sum reaches the limit.
 	 *
-	 * Start at sample <shift> and iterates over <numSamples> samples.
+	 * @param[in] buffer1                        Loaded buffer to compare.
+	 * @param[in] buffer2                        Loaded buffer to compare.
+	 * @param[in] buffer3                        Loaded buffer that is only checked for ignored samples.
+	 * @param[in] startIndex                     First sample.
+	 * @param[in] numSamples                     Number of samples.
+	 * @param[in] limit                          Sum at which to stop.
+	 * @return                                   The sum, or a partial sum at or above the limit.
 	 */
-	inline float calcDiff(
-			const CircularBuffer<adc_buffer_id_t>& bufQueue,
-			const adc_channel_id_t voltageChannelId,
-			const adc_buffer_id_t bufIndex1,
-			const adc_buffer_id_t bufIndex2,
-			const adc_sample_value_id_t startIndex,
-			const adc_sample_value_id_t numSamples);
+	uint32_t calcDiff(
+			uint8_t buffer1,
+			uint8_t buffer2,
+			uint8_t buffer3,
+			adc_sample_value_id_t startIndex,
+			adc_sample_value_id_t numSamples,
+			uint32_t limit);
 
 	bool ignoreSample(const adc_sample_value_t value1, const adc_sample_value_t value2);
 	bool ignoreSample(
 			const adc_sample_value_t value0, const adc_sample_value_t value1, const adc_sample_value_t value2);
 
-	void setLastDetection(
-			bool aboveThreshold, const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId);
+	void setLastDetection(bool aboveThreshold);
 
 public:
 	// Gets a static singleton (no dynamic memory allocation)
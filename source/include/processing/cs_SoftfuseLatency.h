@@ -0,0 +1,80 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <protocol/cs_Packets.h>
+
+#include <cstdint>
+
+/**
+ * Keeps up how long it takes from an ADC buffer with overcurrent, to the switch being turned off.
+ *
+ * The path is split in stages: the buffer being done, the buffer being checked for overcurrent, the softfuse event
+ * being dispatched, and the switch being turned off. Each stage is timestamped with the RTC, so latencies have a
+ * resolution of about 31 us.
+ *
+ * Since the softfuse event is handled synchronously, a switch off is only attributed to the softfuse when it happens
+ * before the next buffer is checked. Switch offs for other reasons, like chip temperature, are ignored.
+ */
+class SoftfuseLatency {
+public:
+	static SoftfuseLatency& getInstance() {
+		static SoftfuseLatency instance;
+		return instance;
+	}
+
+	/**
+	 * To be called when a buffer is checked for overcurrent.
+	 *
+	 * @param[in] bufferDoneTicks  RTC count of when the ADC finished the buffer.
+	 * @param[in] checkTicks       RTC count of now.
+	 */
+	void onCheck(uint32_t bufferDoneTicks, uint32_t checkTicks);
+
+	/**
+	 * To be called right before the softfuse event is dispatched.
+	 *
+	 * @param[in] dispatchTicks    RTC count of now.
+	 */
+	void onDispatch(uint32_t dispatchTicks);
+
+	/**
+	 * To be called when the switch has been turned off.
+	 *
+	 * @param[in] switchOffTicks   RTC count of now.
+	 */
+	void onSwitchOff(uint32_t switchOffTicks);
+
+	const cs_softfuse_latency_stats_t& getStats() { return _stats; }
+
+	/**
+	 * Get the histogram bin for given latency.
+	 */
+	static uint8_t getHistogramBin(uint32_t latencyUs);
+
+private:
+	SoftfuseLatency() = default;
+
+	cs_softfuse_latency_stats_t _stats;
+
+	// Sums of the latencies, to calculate the averages.
+	uint64_t _bufferToCheckTotalUs       = 0;
+	uint64_t _checkToDispatchTotalUs     = 0;
+	uint64_t _dispatchToSwitchOffTotalUs = 0;
+	uint64_t _bufferToSwitchOffTotalUs   = 0;
+
+	// Timestamps of the last checked buffer.
+	uint32_t _bufferDoneTicks = 0;
+	uint32_t _checkTicks      = 0;
+	uint32_t _dispatchTicks   = 0;
+	bool _dispatched          = false;
+
+	static uint32_t ticksToUs(uint32_t ticksTo, uint32_t ticksFrom);
+
+	static void add(cs_latency_stats_t& stats, uint64_t& totalUs, uint32_t latencyUs);
+};
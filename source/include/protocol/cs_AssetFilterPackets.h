@@ -77,6 +77,7 @@ enum class AssetFilterOutputFormat : uint8_t {
 union __attribute__((__packed__)) asset_filter_flags_t {
 	struct __attribute__((packed)) {
 		bool exclude : 1;
+		bool fnv1aHash : 1;  // Cuckoo filter only: hash keys with CuckooFilterHashVersion::Fnv1a.
 	} flags;
 	uint8_t asInt = 0;
 };
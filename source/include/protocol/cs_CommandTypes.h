@@ -63,6 +63,7 @@ enum CommandHandlerTypes {
 	CTRL_CMD_GET_GPREGRET             = 86,
 	CTRL_CMD_GET_ADC_CHANNEL_SWAPS    = 87,
 	CTRL_CMD_GET_RAM_STATS            = 88,
+	CTRL_CMD_GET_STORAGE_STATS        = 89,
 
 	CTRL_CMD_MICROAPP_GET_INFO        = 90,
 	CTRL_CMD_MICROAPP_UPLOAD          = 91,
@@ -73,6 +74,7 @@ enum CommandHandlerTypes {
 	CTRL_CMD_MICROAPP_MESSAGE         = 96,
 
 	CTRL_CMD_CLEAN_FLASH              = 100,
+	CTRL_CMD_GET_SOFTFUSE_LATENCY     = 101,
 
 	CTRL_CMD_FILTER_UPLOAD            = 110,
 	CTRL_CMD_FILTER_REMOVE            = 111,
@@ -14,6 +14,15 @@ typedef const void* cuckoo_key_t;
 typedef uint16_t cuckoo_fingerprint_t;
 typedef uint8_t cuckoo_index_t;
 
+/**
+ * How keys are hashed to a fingerprint and bucket index.
+ * The hub has to use the same hash to fill the filter.
+ */
+enum class CuckooFilterHashVersion : uint8_t {
+	Crc16Djb2 = 0,  // crc16 for the fingerprint, djb2 for the bucket index.
+	Fnv1a     = 1,  // A single FNV-1a hash with a final mix, split into fingerprint and bucket index.
+};
+
 /**
  * Representation of an object (O) in this filter comprises of a fingerprint (F)
  * and a the bucket index (A) where this fingerprint is located. Each object
@@ -32,6 +41,15 @@ struct __attribute__((__packed__)) cuckoo_compressed_fingerprint_t {
 	cuckoo_index_t bucket;  // the bucket this fingerprint should be put in
 };
 
+/**
+ * The hashes of a key, before they are reduced to the bucket count of a filter.
+ * Can be used to look up the same key in several filters, while hashing it only once.
+ */
+struct __attribute__((__packed__)) cuckoo_key_hash_t {
+	cuckoo_fingerprint_t fingerprint;
+	cuckoo_fingerprint_t bucketHash;  // the untruncated bucket index.
+};
+
 /**
  * Data content of the cuckoo filter.
  */
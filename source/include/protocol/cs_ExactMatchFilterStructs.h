@@ -12,6 +12,14 @@
 
 typedef const uint8_t* filter_entry_t;
 
+/**
+ * Order of the items in the item array.
+ */
+enum class ExactMatchFilterLayout : uint8_t {
+	Sorted    = 0,  // Sorted by memcmp, as uploaded and persisted.
+	Eytzinger = 1,  // Breadth first order of the binary search tree over the sorted items, only kept in RAM.
+};
+
 /**
  * Data content of the exact match filter.
  */
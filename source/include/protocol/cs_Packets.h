@@ -504,6 +504,80 @@ struct __attribute__((packed)) cs_ram_stats_t {
 	uint32_t maxHeapEnd   = 0;
 	uint32_t minFree      = 0;
 	uint32_t numSbrkFails = 0;
+	// Memory used for state values.
+	uint32_t stateValueBytes         = 0;
+	uint32_t stateValuePeakBytes     = 0;
+	uint32_t stateValueReservedBytes = 0;
+};
+
+/**
+ * Number of flash writes and removes of a single type.
+ */
+struct __attribute__((packed)) cs_storage_type_stats_t {
+	uint16_t type       = 0;
+	uint32_t numWrites  = 0;
+	uint32_t numRemoves = 0;
+};
+
+/**
+ * Statistics of flash operations.
+ *
+ * Bin 0 of the latency histogram counts operations that took less than 1 ms, bin N counts operations that took
+ * [2^(N-1), 2^N) ms, and the last bin counts all operations that took longer.
+ */
+struct __attribute__((packed)) cs_storage_stats_t {
+	uint32_t numWrites                                    = 0;
+	uint32_t numRemoves                                   = 0;
+	uint32_t numGarbageCollections                        = 0;
+	uint32_t garbageCollectionTotalMs                     = 0;
+	uint32_t garbageCollectionMaxMs                       = 0;
+	uint32_t garbageCollectionReclaimedBytes              = 0;
+	uint32_t latencyHistogram[STORAGE_STATS_LATENCY_BINS] = {0};
+	cs_storage_type_stats_t typeStats[STORAGE_STATS_NUM_TYPES];
+};
+
+/**
+ * Number of measurements, and min, average and max of a latency in us.
+ */
+struct __attribute__((packed)) cs_latency_stats_t {
+	uint32_t count = 0;
+	uint32_t minUs = 0;
+	uint32_t avgUs = 0;
+	uint32_t maxUs = 0;
+};
+
+/**
+ * Statistics of the time it takes to switch off after an overcurrent.
+ *
+ * Bin 0 of the histogram counts softfuses that took less than 1 ms from buffer to switch off, bin N counts softfuses
+ * that took [2^(N-1), 2^N) ms, and the last bin counts all softfuses that took longer.
+ */
+struct __attribute__((packed)) cs_softfuse_latency_stats_t {
+	// From the ADC finishing a buffer, to checking that buffer for overcurrent. Measured for every checked buffer.
+	cs_latency_stats_t bufferToCheck;
+	// From checking the buffer, to dispatching the softfuse event.
+	cs_latency_stats_t checkToDispatch;
+	// From dispatching the softfuse event, to the switch being turned off.
+	cs_latency_stats_t dispatchToSwitchOff;
+	// From the ADC finishing the buffer, to the switch being turned off.
+	cs_latency_stats_t bufferToSwitchOff;
+	uint32_t histogram[SOFTFUSE_LATENCY_BINS] = {0};
+};
+
+/**
+ * Power quality, averaged over POWER_QUALITY_INTERVAL_PERIODS AC periods.
+ *
+ * The power factors are in 1/1000, and negative when power is delivered instead of used.
+ */
+struct __attribute__((packed)) cs_power_quality_t {
+	// Real power divided by apparent power.
+	int16_t powerFactor                                               = 0;
+	// Cosine of the phase difference between the fundamentals of voltage and current.
+	int16_t displacementPowerFactor                                   = 0;
+	// RMS of the odd harmonics of the current: 1, 3, 5, etc.
+	int32_t currentHarmonicsRmsMA[POWER_QUALITY_NUM_HARMONICS]        = {0};
+	// RMS of the odd harmonics of the voltage: 1, 3, 5, etc.
+	int32_t voltageHarmonicsRmsMilliVolt[POWER_QUALITY_NUM_HARMONICS] = {0};
 };
 
 struct __attribute__((packed)) cs_bootloader_info_t {
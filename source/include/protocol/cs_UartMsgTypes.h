@@ -132,6 +132,40 @@ struct __attribute__((__packed__)) uart_msg_voltage_t {
 	int16_t samples[CS_ADC_NUM_SAMPLES_PER_CHANNEL];
 };
 
+/**
+ * How samples are written: as separate current and voltage msgs, or as a stream of samples msgs.
+ */
+enum UartSamplesStreamMode {
+	UART_SAMPLES_STREAM_OFF   = 0,  // Current and voltage msgs, never dropped.
+	UART_SAMPLES_STREAM_RAW   = 1,  // Samples msgs with raw samples, dropped when the UART can't keep up.
+	UART_SAMPLES_STREAM_DELTA = 2,  // Samples msgs with delta encoded samples, dropped when the UART can't keep up.
+};
+
+enum UartSamplesType {
+	UART_SAMPLES_TYPE_CURRENT          = 0,
+	UART_SAMPLES_TYPE_VOLTAGE          = 1,
+	UART_SAMPLES_TYPE_FILTERED_CURRENT = 2,
+};
+
+enum UartSamplesEncoding {
+	// Each sample as int16.
+	UART_SAMPLES_ENCODING_RAW   = 0,
+	// The first sample as int16, followed by the difference with the previous sample as int8. When the difference
+	// doesn't fit, it's replaced by UART_SAMPLES_DELTA_ESCAPE, followed by the sample as int16.
+	UART_SAMPLES_ENCODING_DELTA = 1,
+};
+
+#define UART_SAMPLES_DELTA_ESCAPE -128
+
+struct __attribute__((__packed__)) uart_msg_samples_header_t {
+	uint32_t timestamp;
+	uint8_t type;           // UartSamplesType
+	uint8_t encoding;       // UartSamplesEncoding
+	uint16_t droppedCount;  // Number of samples msgs dropped so far, overflows.
+	uint16_t numSamples;
+	// Followed by the encoded samples.
+};
+
 struct __attribute__((__packed__)) uart_msg_adc_channel_config_t {
 	adc_channel_id_t channel;
 	adc_channel_config_t config;
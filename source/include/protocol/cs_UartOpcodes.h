@@ -18,6 +18,7 @@ enum UartOpcodeRx {
 	UART_OPCODE_RX_HEARTBEAT                    = 2,
 	UART_OPCODE_RX_STATUS                       = 3,
 	UART_OPCODE_RX_GET_MAC                      = 4,  // Get MAC address of this Crownstone
+	UART_OPCODE_RX_GET_STORAGE_STATS            = 5,  // Get flash operation statistics
 	UART_OPCODE_RX_CONTROL                      = 10,
 	UART_OPCODE_RX_HUB_DATA_REPLY               = 11,  // Payload starts with uart_msg_hub_data_reply_header_t.
 
@@ -46,9 +47,10 @@ enum UartOpcodeRx {
 			50202,  // Enable writing filtered current samples (payload: bool enable)
 	//	UART_OPCODE_RX_POWER_LOG_FILTERED_VOLTAGE =       50203, // Enable writing filtered voltage samples (payload:
 	// bool enable)
-	UART_OPCODE_RX_POWER_LOG_POWER = 50204,  // Enable writing calculated power (payload: bool enable)
+	UART_OPCODE_RX_POWER_LOG_POWER          = 50204,  // Enable writing calculated power (payload: bool enable)
+	UART_OPCODE_RX_POWER_LOG_SAMPLES_STREAM = 50205,  // Set how samples are written (payload: UartSamplesStreamMode)
 
-	UART_OPCODE_RX_INJECT_EVENT    = 60000,  // Dispatch any event. Payload: CS_TYPE + event data structure.
+	UART_OPCODE_RX_INJECT_EVENT             = 60000,  // Dispatch any event. Payload: CS_TYPE + event data structure.
 };
 
 /**
@@ -62,6 +64,7 @@ enum UartOpcodeTx {
 	UART_OPCODE_TX_HEARTBEAT      = 2,
 	UART_OPCODE_TX_STATUS         = 3,
 	UART_OPCODE_TX_MAC            = 4,   // MAC address (payload: mac address (6B))
+	UART_OPCODE_TX_STORAGE_STATS  = 5,   // Flash operation statistics (payload: cs_storage_stats_t)
 	UART_OPCODE_TX_CONTROL_RESULT = 10,  // The result of the control command, payload: result_packet_header_t + data.
 	UART_OPCODE_TX_HUB_DATA_REPLY_ACK = 11,
 
@@ -138,6 +141,8 @@ enum UartOpcodeTx {
 	UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT = 50202,
 	UART_OPCODE_TX_POWER_LOG_FILTERED_VOLTAGE = 50203,
 	UART_OPCODE_TX_POWER_LOG_POWER            = 50204,
+	UART_OPCODE_TX_POWER_LOG_SAMPLES          = 50205,  // Payload: uart_msg_samples_header_t + samples
+	UART_OPCODE_TX_POWER_LOG_POWER_QUALITY    = 50206,  // Payload: cs_power_quality_t
 
 	UART_OPCODE_TX_TEXT                       = 60000,  // Payload is ascii text.
 	UART_OPCODE_TX_FIRMWARESTATE              = 60001,
@@ -13,7 +13,10 @@
 #include <drivers/cs_Timer.h>
 #include <events/cs_EventListener.h>
 #include <protocol/cs_ErrorCodes.h>
+#include <storage/cs_StateStoreQueue.h>
+#include <storage/cs_StateValuePool.h>
 
+#include <type_traits>
 #include <vector>
 
 /**
@@ -59,34 +62,26 @@ enum class StateQueueMode { DELAY, THROTTLE };
 #define FACTORY_RESET_STATE_LOWTX 1
 #define FACTORY_RESET_STATE_RESET 2
 
-enum StateQueueOp {
-	CS_STATE_QUEUE_OP_WRITE,
-	CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE,
-	CS_STATE_QUEUE_OP_FACTORY_RESET,
-	CS_STATE_QUEUE_OP_GC,
-};
+const uint32_t CS_STATE_QUEUE_DELAY_SECONDS_MAX = 0xFFFFFFFF / 1000;
 
 /**
- * Struct for queuing operations.
+ * Index in the RAM register that indicates no entry.
+ */
+const size16_t CS_STATE_RAM_INDEX_NONE = 0xFFFF;
+
+static_assert((STATE_RAM_INDEX_BUCKETS & (STATE_RAM_INDEX_BUCKETS - 1)) == 0, "Bucket count must be a power of 2");
+
+/**
+ * Statistics of the write-back mode of State.
  *
- * operation:      Type of operation to perform.
- * type:           State type
- * id:             State id
- * counter:        Number of ticks until item is executed and removed from queue.
- * init_counter:   When set, and execute is true, this item is added again with counter set to this value.
- * execute:        Whether or not to execute the operation when the counter reaches 0.
+ * numWrites:      Number of values written to flash when flushing dirty values.
+ * numCoalesced:   Number of flash writes saved, because a value was set again while it was still dirty.
  */
-struct __attribute__((__packed__)) cs_state_store_queue_t {
-	StateQueueOp operation;
-	CS_TYPE type;
-	cs_state_id_t id;
-	uint32_t counter;  // Uint32, so it can fit 24h.
-	uint32_t init_counter;
-	bool execute;
+struct cs_state_write_back_stats_t {
+	uint32_t numWrites    = 0;
+	uint32_t numCoalesced = 0;
 };
 
-const uint32_t CS_STATE_QUEUE_DELAY_SECONDS_MAX = 0xFFFFFFFF / 1000;
-
 struct cs_id_list_t {
 	CS_TYPE type;
 	std::vector<cs_state_id_t>* ids;
@@ -141,6 +136,18 @@ struct cs_id_list_t {
  *   3. Write to storage.
  *     - If success, return.
  *     - If busy, add state type to queue, return.
+ *
+ * RAM register:
+ *   Values in RAM are kept in a register, of which the index of an entry stays the same until it's removed.
+ *   Removed entries are reused for new values.
+ *   Entries are found via a hash table on type and id, of which each bucket is a chain of indices in the register.
+ *   The values of the entries are allocated from a pool, see StateValuePool.
+ *
+ * Write-back:
+ *   Values set with setWriteBack() are only marked dirty in a bitmap over the RAM register.
+ *   Once no value has been set this way for STATE_WRITE_BACK_DELAY_MS, dirty values are written to flash, at most
+ *   STATE_WRITE_BACK_FLUSH_BUDGET per tick. On brownout, all dirty values are written immediately.
+ *   A value that is set multiple times before it's written, is only written once.
  */
 class State : public BaseClass<>, EventListener {
 public:
@@ -178,6 +185,41 @@ public:
 	 */
 	cs_ret_code_t get(const CS_TYPE type, void* value, size16_t size);
 
+	/**
+	 * Get a state value of given type, with id 0.
+	 *
+	 * The size of the value is checked at compile time.
+	 * The value is copied from RAM, after loading it into RAM when it's not there yet.
+	 *
+	 * Example usage:
+	 *     TYPIFY(CONFIG_SPHERE_ID) sphereId = State::getInstance().get<CS_TYPE::CONFIG_SPHERE_ID>();
+	 *
+	 * @return                    The value, or a zero initialized value when it could not be loaded.
+	 */
+	template <CS_TYPE type>
+	typename cs_state_value_type<type>::type get() {
+		return getRef<type>();
+	}
+
+	/**
+	 * Get a reference to a state value of given type, with id 0.
+	 *
+	 * Same as get<>(), but without copy: the reference is to the value in RAM.
+	 * The reference stays valid until the value is removed, so only keep it for types that are never removed.
+	 * Don't modify the value via this reference, use set() instead.
+	 */
+	template <CS_TYPE type>
+	const typename cs_state_value_type<type>::type& getRef() {
+		typedef typename cs_state_value_type<type>::type value_t;
+		static_assert(!std::is_void<value_t>::value, "State type has no value");
+		const uint8_t* value = getValueInRam(type, sizeof(value_t));
+		if (value == nullptr) {
+			static const value_t zeroValue = {};
+			return zeroValue;
+		}
+		return *reinterpret_cast<const value_t*>(value);
+	}
+
 	/**
 	 * Shorthand for get() for boolean data types, and id 0.
 	 *
@@ -255,6 +297,23 @@ public:
 	 */
 	cs_ret_code_t setThrottled(const cs_state_data_t& data, uint32_t period);
 
+	/**
+	 * Set the state to a new value, and write it to flash later, together with other values set this way.
+	 *
+	 * Assumes persistence mode STRATEGY1.
+	 * Use this for bursts of sets, like storing many behaviours or filters at once.
+	 * Every call postpones the write to flash by STATE_WRITE_BACK_DELAY_MS.
+	 *
+	 * @param[in] data            Data struct with state type, id, data, and size.
+	 * @return                    Return code.
+	 */
+	cs_ret_code_t setWriteBack(const cs_state_data_t& data);
+
+	/**
+	 * Get the statistics of the write-back mode.
+	 */
+	const cs_state_write_back_stats_t& getWriteBackStats() { return _writeBackStats; }
+
 	/**
 	 * Verify size of user data for getting a state.
 	 *
@@ -337,6 +396,11 @@ public:
 	 */
 	void handleEvent(event_t& event);
 
+	/**
+	 * Get the statistics of the memory used for state values in RAM.
+	 */
+	const cs_state_value_pool_stats_t& getValuePoolStats() { return _valuePool.getStats(); }
+
 protected:
 	Storage* _storage;
 
@@ -383,16 +447,39 @@ protected:
 	 */
 	cs_ret_code_t loadFromRam(cs_state_data_t& data);
 
+	/**
+	 * Make sure a state variable is in ram.
+	 *
+	 * When not in ram yet, it's read from flash, or set to the default value, depending on the default location.
+	 *
+	 * @param[in] type            State type.
+	 * @param[in] id              State id.
+	 * @param[out] index_in_ram   Index where the data is stored.
+	 * @return                    Return code.
+	 */
+	cs_ret_code_t loadIntoRam(const CS_TYPE& type, cs_state_id_t id, size16_t& index_in_ram);
+
+	/**
+	 * Get a pointer to the value in ram of given type, with id 0.
+	 *
+	 * @param[in] type            State type.
+	 * @param[in] size            Size of the value type, should be equal to the type size.
+	 * @return                    Pointer to the value, or nullptr on failure.
+	 */
+	const uint8_t* getValueInRam(const CS_TYPE& type, size16_t size);
+
 	/**
 	 * Adds a new state_data struct to ram.
 	 *
 	 * Allocates the struct and the data pointer.
 	 *
 	 * @param[in] type            State type.
+	 * @param[in] id              State id.
 	 * @param[in] size            State variable size.
-	 * @return                    Struct with allocated data pointer.
+	 * @param[out] index_in_ram   Index where the struct is stored.
+	 * @return                    ERR_SUCCESS, or ERR_NO_SPACE when the value could not be allocated.
 	 */
-	cs_state_data_t& addToRam(const CS_TYPE& type, cs_state_id_t id, size16_t size);
+	cs_ret_code_t addToRam(const CS_TYPE& type, cs_state_id_t id, size16_t size, size16_t& index_in_ram);
 
 	/**
 	 * Removed a state variable from ram.
@@ -444,20 +531,94 @@ protected:
 	 * @param[in] fileId          Flash file ID of the entry.
 	 * @param[in] type            State type.
 	 * @param[in] delayMs         Delay in ms.
-	 * @return                    Return code.
+	 * @return                    Return code, ERR_NO_SPACE when the queue is full.
 	 */
 	cs_ret_code_t addToQueue(
 			StateQueueOp operation, const CS_TYPE& type, cs_state_id_t id, uint32_t delayMs, const StateQueueMode mode);
 
+	/**
+	 * Allocate the value of a state variable in ram, of size data.size.
+	 */
 	cs_ret_code_t allocate(cs_state_data_t& data);
 
+	/**
+	 * Free the value of a state variable in ram.
+	 */
+	void deallocate(cs_state_data_t& data);
+
+	/**
+	 * Execute the operations in the queue of which the deadline has been reached.
+	 */
 	void delayedStoreTick();
 
+	/**
+	 * Execute a queued operation.
+	 *
+	 * @return                    True when the item should stay in the queue.
+	 */
+	bool executeQueueItem(cs_state_store_queue_t& item);
+
+	/**
+	 * Get the deadline for an operation that should be executed after given number of ticks.
+	 */
+	uint32_t getDeadline(uint32_t delayTicks) { return _tickCount + delayTicks + 1; }
+
+	/**
+	 * Write dirty values in ram to flash.
+	 *
+	 * @param[in] maxWrites       Max number of values to write.
+	 */
+	void flushWriteBack(uint16_t maxWrites);
+
+	/**
+	 * Mark or unmark an entry in the RAM register as dirty.
+	 */
+	void setDirty(size16_t index_in_ram, bool dirty);
+
 	/**
 	 * Stores state data structs with pointers to state data.
+	 *
+	 * Entries with type CONFIG_DO_NOT_USE are not in use.
 	 */
 	std::vector<cs_state_data_t> _ram_data_register;
 
+	/**
+	 * For each entry in the RAM register: the index of the next entry in the same bucket.
+	 */
+	std::vector<size16_t> _ramIndexNext;
+
+	/**
+	 * For each bucket: the index of the first entry in the RAM register.
+	 */
+	size16_t _ramIndexBuckets[STATE_RAM_INDEX_BUCKETS];
+
+	/**
+	 * Indices of entries in the RAM register that are not in use.
+	 */
+	std::vector<size16_t> _ramFreeIndices;
+
+	/**
+	 * Allocator for the values of the entries in the RAM register.
+	 */
+	StateValuePool _valuePool;
+
+	/**
+	 * Bitmap of entries in the RAM register that have to be written to flash.
+	 */
+	std::vector<uint32_t> _ramDirtyBitmap;
+
+	/**
+	 * Number of bits set in the dirty bitmap.
+	 */
+	size16_t _numDirty = 0;
+
+	/**
+	 * Number of ticks until the dirty values will be written to flash.
+	 */
+	uint16_t _writeBackDelayTicks = 0;
+
+	cs_state_write_back_stats_t _writeBackStats;
+
 	/**
 	 * Stores list of existing ids for certain types.
 	 */
@@ -466,7 +627,12 @@ protected:
 	/**
 	 * Stores the queue of flash operations.
 	 */
-	std::vector<cs_state_store_queue_t> _store_queue;
+	StateStoreQueue _storeQueue;
+
+	/**
+	 * Number of ticks since boot, used for the deadlines in the store queue.
+	 */
+	uint32_t _tickCount = 0;
 
 	bool _startedWritingToFlash  = false;
 
@@ -495,6 +661,11 @@ private:
 
 	cs_ret_code_t getDefaultValue(cs_state_data_t& data);
 
+	/**
+	 * Get the bucket in the RAM index for given type and id.
+	 */
+	size16_t getRamIndexBucket(const CS_TYPE& type, cs_state_id_t id);
+
 	/**
 	 * Get and cache all IDs with given type from flash.
 	 *
@@ -0,0 +1,155 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <cfg/cs_Config.h>
+#include <common/cs_Types.h>
+#include <protocol/cs_ErrorCodes.h>
+
+#include <cstdint>
+
+enum StateQueueOp : uint8_t {
+	CS_STATE_QUEUE_OP_WRITE,
+	CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE,
+	CS_STATE_QUEUE_OP_FACTORY_RESET,
+	CS_STATE_QUEUE_OP_GC,
+};
+
+/**
+ * Struct for queuing operations.
+ *
+ * operation:      Type of operation to perform.
+ * type:           State type
+ * id:             State id
+ * deadline:       Tick at which the item is executed and removed from queue.
+ * init_counter:   When set, and execute is true, this item is added again with a deadline this number of ticks later.
+ * execute:        Whether or not to execute the operation when the deadline is reached.
+ */
+struct __attribute__((__packed__)) cs_state_store_queue_t {
+	StateQueueOp operation;
+	CS_TYPE type;
+	cs_state_id_t id;
+	uint32_t deadline;  // Uint32, so it can fit 24h.
+	uint32_t init_counter;
+	bool execute;
+};
+
+/**
+ * Index in the store queue that indicates no item.
+ */
+const uint8_t CS_STATE_STORE_QUEUE_INDEX_NONE = 0xFF;
+
+static_assert(STATE_STORE_QUEUE_SIZE < CS_STATE_STORE_QUEUE_INDEX_NONE, "Store queue size too large");
+static_assert(
+		(STATE_STORE_QUEUE_BUCKETS & (STATE_STORE_QUEUE_BUCKETS - 1)) == 0, "Bucket count must be a power of 2");
+
+/**
+ * Queue of flash operations of State, ordered by deadline.
+ *
+ * Items are kept in a fixed number of slots, of which the index stays the same while the item is queued.
+ * - A min-heap of slot indices keeps the item with the earliest deadline on top.
+ * - A hash table on type and id, of which each bucket is a chain of slot indices, finds an item of a type and id.
+ *
+ * Deadlines are compared with wrap around, so they should be less than 2^31 ticks apart.
+ */
+class StateStoreQueue {
+public:
+	StateStoreQueue();
+
+	/**
+	 * Find the queued item for given operation, type, and id.
+	 *
+	 * Write and remove operations of the same type and id are regarded as the same item.
+	 *
+	 * @return                    Pointer to the item, or nullptr when not found.
+	 */
+	cs_state_store_queue_t* find(StateQueueOp operation, const CS_TYPE& type, cs_state_id_t id);
+
+	/**
+	 * Add an item.
+	 *
+	 * Does not check if an item for the same type and id is already queued.
+	 *
+	 * @return                    ERR_SUCCESS, or ERR_NO_SPACE when the queue is full.
+	 */
+	cs_ret_code_t add(const cs_state_store_queue_t& item);
+
+	/**
+	 * Get the item with the earliest deadline.
+	 *
+	 * @return                    Pointer to the item, or nullptr when the queue is empty.
+	 */
+	cs_state_store_queue_t* front();
+
+	/**
+	 * Set the deadline of a queued item.
+	 */
+	void setDeadline(cs_state_store_queue_t* item, uint32_t deadline);
+
+	/**
+	 * Remove a queued item.
+	 */
+	void remove(cs_state_store_queue_t* item);
+
+	/**
+	 * Remove all items.
+	 */
+	void clear();
+
+	uint8_t size() { return _heapSize; }
+
+	bool empty() { return _heapSize == 0; }
+
+protected:
+	cs_state_store_queue_t _items[STATE_STORE_QUEUE_SIZE];
+
+	/**
+	 * Min-heap of slot indices, ordered by deadline.
+	 */
+	uint8_t _heap[STATE_STORE_QUEUE_SIZE];
+
+	uint8_t _heapSize = 0;
+
+	/**
+	 * For each slot: the position in the heap.
+	 */
+	uint8_t _heapPos[STATE_STORE_QUEUE_SIZE];
+
+	/**
+	 * For each slot: the index of the next slot in the same bucket, or of the next free slot.
+	 */
+	uint8_t _next[STATE_STORE_QUEUE_SIZE];
+
+	/**
+	 * For each bucket: the index of the first slot.
+	 */
+	uint8_t _buckets[STATE_STORE_QUEUE_BUCKETS];
+
+	/**
+	 * Index of the first free slot.
+	 */
+	uint8_t _firstFree;
+
+	static uint8_t getBucket(const CS_TYPE& type, cs_state_id_t id);
+
+	static bool isSameItem(
+			const cs_state_store_queue_t& item, StateQueueOp operation, const CS_TYPE& type, cs_state_id_t id);
+
+	/**
+	 * Whether the item in slot a has an earlier deadline than the item in slot b.
+	 */
+	bool isEarlier(uint8_t a, uint8_t b);
+
+	void swap(uint8_t heapPosA, uint8_t heapPosB);
+
+	void siftUp(uint8_t heapPos);
+
+	void siftDown(uint8_t heapPos);
+
+	uint8_t getSlot(cs_state_store_queue_t* item) { return item - _items; }
+};
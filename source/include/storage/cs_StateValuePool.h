@@ -0,0 +1,113 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <protocol/cs_Typedefs.h>
+
+#include <cstdint>
+
+/**
+ * Number of size classes of the state value pool: 4, 8, 16, 32, and 64 bytes.
+ */
+const uint8_t CS_STATE_VALUE_POOL_NUM_SIZE_CLASSES = 5;
+
+/**
+ * Smallest size class, values are always padded to a multiple of this.
+ */
+const size16_t CS_STATE_VALUE_POOL_MIN_SLOT_SIZE   = 4;
+
+/**
+ * Max number of slots per slab, limited by the size of the free slots bitmask.
+ */
+const uint8_t CS_STATE_VALUE_POOL_MAX_SLOTS        = 32;
+
+/**
+ * Statistics of the state value pool.
+ *
+ * usedBytes:          Number of bytes of values currently allocated.
+ * peakUsedBytes:      Maximum of usedBytes since boot.
+ * reservedBytes:      Number of bytes currently taken from the heap, including slab headers, padding and free slots.
+ * numHeapAllocations: Number of allocations done on the heap since boot.
+ */
+struct __attribute__((packed)) cs_state_value_pool_stats_t {
+	uint32_t usedBytes          = 0;
+	uint32_t peakUsedBytes      = 0;
+	uint32_t reservedBytes      = 0;
+	uint32_t numHeapAllocations = 0;
+};
+
+/**
+ * Allocator for state values.
+ *
+ * Instead of a malloc per value, values are put in slots of slabs, with a separate list of slabs per size class.
+ * Slabs are allocated on the heap when all slots of that size class are in use, and freed when all their slots are
+ * free again, except for the last slab of a size class.
+ * This keeps the many small, long lived, state values close together, and avoids fragmenting the heap when values
+ * are removed and added again.
+ *
+ * Values that are larger than the largest size class are allocated on the heap directly.
+ *
+ * All values are padded to a multiple of 4 bytes, with the padding set to 0xFF, so that they can be written to flash.
+ */
+class StateValuePool {
+public:
+	~StateValuePool();
+
+	/**
+	 * Allocate a buffer for a value.
+	 *
+	 * @param[in] size            Size of the value.
+	 * @return                    Pointer to the buffer, or nullptr when out of memory.
+	 */
+	uint8_t* allocate(size16_t size);
+
+	/**
+	 * Free a buffer that was allocated by this pool.
+	 *
+	 * @param[in] ptr             Pointer to the buffer.
+	 * @param[in] size            Size of the value, as given to allocate().
+	 */
+	void free(uint8_t* ptr, size16_t size);
+
+	/**
+	 * Get the statistics of this pool.
+	 */
+	const cs_state_value_pool_stats_t& getStats() const { return _stats; }
+
+protected:
+	struct slab_t {
+		//! Next slab of the same size class.
+		slab_t* next;
+		//! Bitmask of free slots.
+		uint32_t freeSlots;
+	};
+
+	slab_t* _slabs[CS_STATE_VALUE_POOL_NUM_SIZE_CLASSES] = {};
+
+	cs_state_value_pool_stats_t _stats;
+
+	/**
+	 * Get the size class of a (padded) size.
+	 *
+	 * @return                    Size class, or -1 when the size is larger than the largest size class.
+	 */
+	static int8_t getSizeClass(size16_t paddedSize);
+
+	static size16_t getSlotSize(uint8_t sizeClass);
+
+	static uint8_t getNumSlots(uint8_t sizeClass);
+
+	/**
+	 * Get the bitmask of free slots of a slab that has all slots free.
+	 */
+	static uint32_t getAllFreeSlots(uint8_t sizeClass);
+
+	static uint8_t* getSlot(slab_t* slab, uint8_t sizeClass, uint8_t slotIndex);
+
+	void useBytes(size16_t size);
+};
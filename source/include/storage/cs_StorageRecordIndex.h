@@ -0,0 +1,110 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <ble/cs_Nordic.h>
+#include <components/libraries/fds/fds.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * A record in flash, and its descriptor.
+ *
+ * The descriptor is updated by FDS when the record has been moved by garbage collection.
+ */
+struct cs_storage_record_index_entry_t {
+	uint16_t recordKey;
+	uint16_t fileId;
+	fds_record_desc_t recordDesc;
+};
+
+/**
+ * Index of the valid records in flash, used by Storage when built with BUILD_FLASH_RECORD_INDEX.
+ *
+ * With this index, reading a value doesn't have to search through flash, and values that are not in flash are found
+ * to be missing without searching.
+ *
+ * Sorted by record key, then by file id, so that entries are found with a binary search, and the entries of a record
+ * key are next to each other.
+ */
+class StorageRecordIndex {
+public:
+	/**
+	 * Remove all entries.
+	 */
+	void clear();
+
+	/**
+	 * Append a record while building the index, without keeping the index sorted.
+	 *
+	 * Call sort() once all records are appended.
+	 */
+	void append(uint16_t recordKey, uint16_t fileId, const fds_record_desc_t& recordDesc);
+
+	/**
+	 * Sort the appended records.
+	 *
+	 * In case of duplicates, the last appended record is kept, like Storage reads the last found record.
+	 *
+	 * @return                    Number of duplicates that were removed.
+	 */
+	uint16_t sort();
+
+	/**
+	 * Find the entry of given record key and file id.
+	 *
+	 * @return                    Pointer to the entry, or nullptr when not found.
+	 */
+	cs_storage_record_index_entry_t* find(uint16_t recordKey, uint16_t fileId);
+
+	/**
+	 * Start a new search with findNext().
+	 */
+	void initSearch();
+
+	/**
+	 * Find the next entry of given record key, starting at the current search position.
+	 *
+	 * @return                    Pointer to the entry, or nullptr when not found.
+	 */
+	cs_storage_record_index_entry_t* findNext(uint16_t recordKey);
+
+	/**
+	 * Add a record, or replace the descriptor when the record key and file id are already indexed.
+	 */
+	void add(uint16_t recordKey, uint16_t fileId, const fds_record_desc_t& recordDesc);
+
+	/**
+	 * Remove the record of given record key and file id, if indexed.
+	 */
+	void remove(uint16_t recordKey, uint16_t fileId);
+
+	/**
+	 * Remove all records of given file id.
+	 */
+	void removeFile(uint16_t fileId);
+
+	/**
+	 * Get the number of indexed records.
+	 */
+	uint16_t size() const;
+
+private:
+	std::vector<cs_storage_record_index_entry_t> _entries;
+
+	/**
+	 * Position of the current search, like the find token of FDS.
+	 */
+	uint16_t _searchPos = 0;
+
+	/**
+	 * Get the position of the first entry that is equal to or larger than given record key and file id.
+	 */
+	uint16_t lowerBound(uint16_t recordKey, uint16_t fileId);
+};
@@ -0,0 +1,66 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <common/cs_Types.h>
+#include <protocol/cs_Packets.h>
+
+#include <cstdint>
+
+/**
+ * Keeps up statistics of flash operations, to find out which types cause most flash wear.
+ *
+ * Writes and removes are counted per type, for a limited number of types. When a type is not in the table, and the
+ * table is full, the type with the least writes and removes is replaced, and the new type continues counting from
+ * the counts of the replaced type (the "space saving" algorithm). So the counts of a type can be too high, but the
+ * types that cause most wear will stay in the table.
+ *
+ * Durations are given in ms, so this class doesn't depend on a clock.
+ */
+class StorageStats {
+public:
+	/**
+	 * To be called when a write of given type has been started.
+	 */
+	void onWrite(const CS_TYPE& type);
+
+	/**
+	 * To be called when a remove of given type has been started.
+	 */
+	void onRemove(const CS_TYPE& type);
+
+	/**
+	 * To be called when a write or remove is done.
+	 *
+	 * @param[in] latencyMs       Time between starting the operation and the FDS event.
+	 */
+	void onOperationDone(uint32_t latencyMs);
+
+	/**
+	 * To be called when garbage collection is done.
+	 *
+	 * @param[in] durationMs      Time between starting the garbage collection and the FDS event.
+	 * @param[in] reclaimedBytes  Number of bytes that became available.
+	 */
+	void onGarbageCollectionDone(uint32_t durationMs, uint32_t reclaimedBytes);
+
+	const cs_storage_stats_t& getStats() { return _stats; }
+
+	/**
+	 * Get the latency histogram bin for given latency.
+	 */
+	static uint8_t getLatencyBin(uint32_t latencyMs);
+
+private:
+	cs_storage_stats_t _stats;
+
+	/**
+	 * Get the stats of a type, adds the type if it's not in the table yet.
+	 */
+	cs_storage_type_stats_t& getTypeStats(const CS_TYPE& type);
+};
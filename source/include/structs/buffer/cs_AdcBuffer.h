@@ -13,6 +13,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 // The number of channels per buffer.
 static const adc_channel_id_t ADC_CHANNEL_COUNT             = CS_ADC_NUM_CHANNELS;
@@ -26,17 +27,46 @@ static const uint32_t ADC_BUFFER_SAMPLE_COUNT               = ADC_CHANNEL_COUNT
 // The number of buffers.
 static const adc_buffer_id_t ADC_BUFFER_COUNT               = CS_ADC_NUM_BUFFERS;
 
+// Whether the channels of a buffer are split into a plane per channel, once the SAADC filled it.
+#if BUILD_ADC_DEINTERLEAVED == 1
+static const bool ADC_BUFFER_DEINTERLEAVED = true;
+#else
+static const bool ADC_BUFFER_DEINTERLEAVED = false;
+#endif
+
+/**
+ * View on the samples of a single channel of a buffer.
+ *
+ * With deinterleaved buffers, the stride is 1, so the values can be used as a plain array.
+ */
+struct adc_channel_values_t {
+	const adc_sample_value_t* values;
+	adc_sample_value_id_t stride;
+	adc_sample_value_id_t length;
+
+	adc_sample_value_t operator[](adc_sample_value_id_t index) const { return values[index * stride]; }
+};
+
 /**
  * Class that keeps up the buffers used for ADC.
  *
  * - Allocates the buffers.
- * - Abstracts away the interleaved nature of the ADC samples.
+ * - Abstracts away the layout of the ADC samples.
+ *
+ * The SAADC writes the samples of all channels interleaved. When built with BUILD_ADC_DEINTERLEAVED, each buffer is
+ * split into a plane per channel after the SAADC is done with it, so that processing reads each channel as a
+ * contiguous array.
  */
 class AdcBuffer {
 private:
 	adc_buffer_t* _buf[ADC_BUFFER_COUNT] = {nullptr};
 	bool _allocated                      = false;
 
+#if BUILD_ADC_DEINTERLEAVED == 1
+	//! Copy of the interleaved samples, while deinterleaving.
+	adc_sample_value_t _interleavedSamples[ADC_BUFFER_SAMPLE_COUNT];
+#endif
+
 	AdcBuffer(){};
 	AdcBuffer(AdcBuffer const&){};
 
@@ -124,6 +154,74 @@ public:
 		return ADC_BUFFER_COUNT;
 	}
 
+	/**
+	 * Whether the buffers hold a plane per channel, instead of interleaved samples.
+	 */
+	static inline constexpr bool isDeinterleaved() {
+		return ADC_BUFFER_DEINTERLEAVED;
+	}
+
+	/**
+	 * Get the distance between two consecutive values of a channel, in number of values.
+	 */
+	static inline constexpr adc_sample_value_id_t getChannelStride() {
+		return isDeinterleaved() ? 1 : ADC_CHANNEL_COUNT;
+	}
+
+	/**
+	 * Get the index of the first value of a channel in a buffer.
+	 */
+	static inline constexpr adc_sample_value_id_t getChannelOffset(adc_channel_id_t channel_id) {
+		return isDeinterleaved() ? channel_id * ADC_CHANNEL_SAMPLE_COUNT : channel_id;
+	}
+
+	/**
+	 * Get a pointer to the first value of a channel in a buffer.
+	 *
+	 * The other values of the channel follow with getChannelStride() in between, so the channel can be read without
+	 * copying it first.
+	 *
+	 * @param[in] buffer_id                      Index to the buffer (0 up to getBufferCount() - 1)
+	 * @param[in] channel_id                     Particular channel within this buffer (0 or 1)
+	 * @return                                   Pointer to the first value of the channel.
+	 */
+	const adc_sample_value_t* getChannelValues(adc_buffer_id_t buffer_id, adc_channel_id_t channel_id) {
+		return getBuffer(buffer_id)->samples + getChannelOffset(channel_id);
+	}
+
+	/**
+	 * Get a view on the values of a channel in a buffer.
+	 *
+	 * Unlike getValue(), indexing the view doesn't check the index.
+	 *
+	 * @param[in] buffer_id                      Index to the buffer (0 up to getBufferCount() - 1)
+	 * @param[in] channel_id                     Particular channel within this buffer (0 or 1)
+	 * @return                                   View on the values of the channel.
+	 */
+	adc_channel_values_t getChannel(adc_buffer_id_t buffer_id, adc_channel_id_t channel_id) {
+		return adc_channel_values_t{getChannelValues(buffer_id, channel_id), getChannelStride(), getChannelLength()};
+	}
+
+	/**
+	 * Split the interleaved samples, as written by the SAADC, into a plane per channel.
+	 *
+	 * To be called once, after the SAADC is done with the buffer. Does nothing when the buffers are kept interleaved.
+	 *
+	 * @param[in] buffer_id                      Index to the buffer (0 up to getBufferCount() - 1)
+	 */
+	void deinterleave([[maybe_unused]] adc_buffer_id_t buffer_id) {
+#if BUILD_ADC_DEINTERLEAVED == 1
+		adc_sample_value_t* samples = getBuffer(buffer_id)->samples;
+		memcpy(_interleavedSamples, samples, sizeof(_interleavedSamples));
+		for (adc_channel_id_t channel_id = 0; channel_id < ADC_CHANNEL_COUNT; ++channel_id) {
+			adc_sample_value_t* plane = samples + getChannelOffset(channel_id);
+			for (adc_sample_value_id_t i = 0; i < ADC_CHANNEL_SAMPLE_COUNT; ++i) {
+				plane[i] = _interleavedSamples[i * ADC_CHANNEL_COUNT + channel_id];
+			}
+		}
+#endif
+	}
+
 	/**
 	 * Get a particular value from a buffer.
 	 *
@@ -139,7 +237,7 @@ public:
 		static_assert(std::is_unsigned<adc_sample_value_id_t>::value, "value id should be unsigned");
 		assert(value_id < getChannelLength(), "value id should be smaller than channel size");
 
-		adc_sample_value_id_t value_id_in_channel = value_id * getChannelCount() + channel_id;
+		adc_sample_value_id_t value_id_in_channel = getChannelOffset(channel_id) + value_id * getChannelStride();
 		adc_sample_value_t* buf                   = getBuffer(buffer_id)->samples;
 		adc_sample_value_t value                  = buf[value_id_in_channel];
 		return value;
@@ -161,7 +259,7 @@ public:
 		static_assert(std::is_unsigned<adc_sample_value_id_t>::value, "value id should be unsigned");
 		assert(value_id < getChannelLength(), "value id should be smaller than channel size");
 
-		adc_sample_value_id_t value_id_in_channel = value_id * getChannelCount() + channel_id;
+		adc_sample_value_id_t value_id_in_channel = getChannelOffset(channel_id) + value_id * getChannelStride();
 		adc_sample_value_t* buf                   = getBuffer(buffer_id)->samples;
 		buf[value_id_in_channel]                  = value;
 	}
@@ -24,8 +24,9 @@ struct __attribute__((__packed__)) asset_filter_runtime_data_t {
 
 	union __attribute__((packed)) {
 		struct __attribute__((packed)) {
-			bool crcCalculated : 1;  // Whether the CRC of this filter has been calculated.
-			bool committed : 1;      // Whether this filter has been committed.
+			bool crcCalculated : 1;    // Whether the CRC of this filter has been calculated.
+			bool committed : 1;        // Whether this filter has been committed.
+			bool eytzingerLayout : 1;  // Whether the items of an exact match filter are in the Eytzinger layout.
 		} flags;
 		uint8_t asInt = 0;
 	} flags;
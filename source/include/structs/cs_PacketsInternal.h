@@ -99,6 +99,19 @@ struct __attribute__((packed)) device_address_t {
 	uint8_t addressType = CS_ADDRESS_TYPE_RANDOM_STATIC;
 };
 
+/**
+ * Index of the AD structures in advertisement data, so they can be looked up without parsing the data again.
+ *
+ * Made by CsUtils::indexAdvTypes(), used by CsUtils::findAdvType().
+ */
+struct __attribute__((packed)) adv_index_t {
+	uint8_t count;                               // Number of indexed AD structures.
+	uint8_t unindexedOffset;                     // Offset of the first AD structure that didn't fit, or 0 if all fit.
+	uint8_t types[SCAN_ADV_INDEX_MAX_FIELDS];    // AD type of each indexed structure.
+	uint8_t offsets[SCAN_ADV_INDEX_MAX_FIELDS];  // Offset of the data of each indexed structure.
+	uint8_t lengths[SCAN_ADV_INDEX_MAX_FIELDS];  // Length of the data of each indexed structure.
+};
+
 /**
  * Scanned device.
  *
@@ -113,7 +126,8 @@ struct __attribute__((packed)) scanned_device_t {
 	uint8_t setId;
 	uint8_t advType;
 	uint8_t dataSize;
-	uint8_t* data;  // Advertisement or scan response data.
+	uint8_t* data;                // Advertisement or scan response data.
+	const adv_index_t* advIndex;  // Index of the AD structures in data, or nullptr when not indexed.
 	// More possibilities: addressType, connectable, isScanResponse, directed, scannable, extended advertisements, etc.
 };
 
@@ -358,6 +372,11 @@ struct adc_buffer_t {
 	 */
 	adc_buffer_seq_nr_t seqNr = 0;
 
+	/**
+	 * RTC count of when the ADC finished sampling this buffer.
+	 */
+	uint32_t doneTicks        = 0;
+
 	/**
 	 * The ADC config that was used to sample this buffer.
 	 */
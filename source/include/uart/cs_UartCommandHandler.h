@@ -59,5 +59,6 @@ private:
 	void handleCommandEnableMesh(cs_data_t commandData);
 	void handleCommandGetId(cs_data_t commandData);
 	void handleCommandGetMacAddress(cs_data_t commandData);
+	void handleCommandGetStorageStats(cs_data_t commandData);
 	void handleCommandInjectEvent(cs_data_t commandData);
 };
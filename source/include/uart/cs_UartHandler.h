@@ -17,6 +17,23 @@
 #define UART_TX_ENCRYPTION_BUFFER_SIZE AES_BLOCK_SIZE
 //#define UART_TX_MAX_PAYLOAD_SIZE       500
 
+//! Size of the buffer that samples are encoded in, before they are written.
+#define UART_TX_SAMPLES_CHUNK_SIZE 32
+
+/**
+ * Bytes per second that samples msgs may write.
+ *
+ * A byte takes 10 bits on the line. Half of the bandwidth is left for other msgs and logs.
+ */
+#ifdef UART_BAUDRATE
+#define UART_TX_SAMPLES_BYTES_PER_SECOND (UART_BAUDRATE / 10 / 2)
+#else
+#define UART_TX_SAMPLES_BYTES_PER_SECOND (230400 / 10 / 2)
+#endif
+
+//! Max number of bytes that samples msgs may write in a burst, after not having written for a while.
+#define UART_TX_SAMPLES_MAX_BURST_SIZE 512
+
 /**
  * Class that implements the binary UART protocol.
  * - Wraps messages.
@@ -99,6 +116,37 @@ public:
 	ret_code_t writeMsgEnd(
 			UartOpcodeTx opCode, UartProtocol::Encrypt encrypt = UartProtocol::ENCRYPT_ACCORDING_TO_TYPE);
 
+	/**
+	 * Write a msg with samples over UART, in one call.
+	 *
+	 * The samples are read in place, with the given stride, so that a channel of an interleaved ADC buffer can be
+	 * written without copying it first. The CRC, escaping and encryption are done per chunk of samples, instead of per
+	 * sample.
+	 *
+	 * @param[in] opCode         OpCode of the msg.
+	 * @param[in] header         Data to write before the samples.
+	 * @param[in] samples        Pointer to the first sample.
+	 * @param[in] numSamples     Number of samples to write.
+	 * @param[in] stride         Distance between two consecutive samples, in number of samples.
+	 * @param[in] encoding       How to encode the samples.
+	 * @param[in] dropWhenBusy   Whether to drop the msg when samples msgs use up their share of the UART bandwidth.
+	 * @return ERR_SUCCESS       When the msg was written.
+	 * @return ERR_BUSY          When the msg was dropped.
+	 */
+	cs_ret_code_t writeMsgSamples(
+			UartOpcodeTx opCode,
+			cs_data_t header,
+			const int16_t* samples,
+			uint16_t numSamples,
+			uint16_t stride,
+			UartSamplesEncoding encoding,
+			bool dropWhenBusy);
+
+	/**
+	 * Get the number of samples msgs that have been dropped, overflows.
+	 */
+	uint16_t getSamplesDroppedCount();
+
 	/**
 	 * To be called when a byte was read. Can be called from interrupt.
 	 *
@@ -179,6 +227,19 @@ private:
 	//! Stone ID, part of the msg header.
 	TYPIFY(CONFIG_CROWNSTONE_ID) _stoneId = 0;
 
+	/**
+	 * Number of bytes samples msgs may still write, multiplied by RTC_CLOCK_FREQ.
+	 *
+	 * Grows with UART_TX_SAMPLES_BYTES_PER_SECOND, up to UART_TX_SAMPLES_MAX_BURST_SIZE.
+	 */
+	uint32_t _samplesBudget               = 0;
+
+	//! RTC count at which the samples budget was last updated.
+	uint32_t _samplesBudgetRtcCount       = 0;
+
+	//! Number of samples msgs that have been dropped.
+	uint16_t _samplesDroppedCount         = 0;
+
 	/**
 	 * Write the start byte.
 	 */
@@ -195,6 +256,25 @@ private:
 	 */
 	cs_ret_code_t writeBytes(cs_data_t data, bool updateCrc);
 
+	/**
+	 * Update the samples budget, and take the given size from it.
+	 *
+	 * @param[in] size       Number of bytes that will be written.
+	 * @return               False when the budget is too low.
+	 */
+	bool reserveSamplesBudget(uint16_t size);
+
+	/**
+	 * Encode a sample.
+	 *
+	 * @param[in] sample     The sample to encode.
+	 * @param[in] previous   Pointer to the previous sample, or nullptr for the first sample.
+	 * @param[in] encoding   How to encode the sample.
+	 * @param[out] out       Buffer to write the encoded sample to, or nullptr to only get the size.
+	 * @return               Size of the encoded sample.
+	 */
+	uint8_t encodeSample(int16_t sample, const int16_t* previous, UartSamplesEncoding encoding, uint8_t* out);
+
 	/**
 	 * Writes wrapper header (including start and size), and initializes CRC.
 	 */
@@ -34,6 +34,13 @@ public:
 	 */
 	AssetFilterData filterdata();
 
+	/**
+	 * Get the exact match filter, in the layout that the runtime data says its items are in.
+	 *
+	 * Only valid if filter type is FilterType::ExactMatchFilter.
+	 */
+	ExactMatchFilter exactMatchFilter();
+
 	// FilterInterface
 
 	/**
@@ -61,6 +68,25 @@ public:
 	 */
 	asset_id_t getAssetId(const scanned_device_t& asset);
 
+	/**
+	 * Max size of the input data of a filter.
+	 *
+	 * A normal advertisement payload size is 31B at most, masked input is also limited by the 32b mask.
+	 */
+	static constexpr uint8_t MAX_INPUT_SIZE = 31;
+
+	/**
+	 * Gets the data of a scanned device that is selected by an input description.
+	 *
+	 * @param[in]  device       The scanned device.
+	 * @param[in]  input        Describes which data to select.
+	 * @param[in]  buffer       Buffer of MAX_INPUT_SIZE bytes, used when the data has to be copied.
+	 * @param[out] inputData    The selected data, either in the device data or in the buffer.
+	 * @return                  False when the device doesn't have the selected data.
+	 */
+	static bool getInputData(
+			const scanned_device_t& device, AssetFilterInput input, uint8_t* buffer, cs_const_data_t& inputData);
+
 private:
 	/**
 	 * A assetId is generated as crc32 from filtered input data.
@@ -78,9 +104,7 @@ private:
 	 * delegateExpression should be of the form (FilterInterface&, void*, size_t) -> ReturnType.
 	 *
 	 * The argument that is passed into `delegateExpression` is based on the AssetFilterInputType
-	 * of the `assetFilter`. Buffers are only allocated when strictly necessary.
-	 * (E.g. MacAddress is already available in the `device`, but for MaskedAdDataType a buffer
-	 * of 31 bytes needs to be allocated on the stack.)
+	 * of the `assetFilter`, see getInputData().
 	 *
 	 * The delegate return type is left as free template parameter so that this template can be
 	 * used for both `contains` and `assetId` return values.
@@ -0,0 +1,92 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <structs/cs_PacketsInternal.h>
+#include <util/cs_AssetFilter.h>
+
+#include <optional>
+
+/**
+ * Evaluation plan for a set of asset filters.
+ *
+ * The filters are grouped by their input: filters that select the same data of a scanned device, share an input.
+ * When a device is evaluated, the data of each input is selected once, and hashed once for all cuckoo filters that
+ * share it and use the same hash version. So the cost per scanned device grows with the number of distinct inputs,
+ * instead of the number of filters.
+ *
+ * Inputs that are used by exclude filters are evaluated first, so that a rejected device is not checked any further.
+ *
+ * The plan refers to the filter data, so it has to be made again whenever the filters change.
+ */
+class AssetFilterPlan {
+public:
+	/**
+	 * Max number of filters in a plan.
+	 */
+	static constexpr uint8_t MAX_FILTERS = 8;
+
+	/**
+	 * Remove all filters from the plan.
+	 */
+	void clear();
+
+	/**
+	 * Add a filter to the plan.
+	 *
+	 * The filters get an index in the order they are added, starting at 0.
+	 *
+	 * @param[in] filter         The filter, its data has to stay valid while the plan is used.
+	 * @return                   False when the plan is full.
+	 */
+	bool add(AssetFilter filter);
+
+	/**
+	 * Evaluate the filters for a scanned device.
+	 *
+	 * @param[in]  device              The scanned device.
+	 * @param[out] acceptingFilters    Bitmask of the indices of the filters that accept the device. Exclude filters
+	 *                                 are not part of this.
+	 * @return                         Index of an exclude filter that accepts the device, if any. In that case, the
+	 *                                 device should be rejected, and acceptingFilters is incomplete.
+	 */
+	std::optional<uint8_t> evaluate(const scanned_device_t& device, uint8_t& acceptingFilters);
+
+	/**
+	 * Get the number of distinct inputs of the filters in the plan.
+	 */
+	uint8_t getInputCount() { return _inputCount; }
+
+private:
+	/**
+	 * A distinct input, and the filters that use it.
+	 */
+	struct asset_filter_plan_input_t {
+		uint8_t inputFilterIndex;  // Index of a filter that has this input, to get the input description from.
+		uint8_t excludeFilters;    // Bitmask of the indices of the exclude filters with this input.
+		uint8_t otherFilters;      // Bitmask of the indices of the other filters with this input.
+		uint8_t hashVersions;      // Bitmask of the hash versions of the cuckoo filters with this input.
+	};
+
+	uint8_t* _filters[MAX_FILTERS]                 = {};
+	uint8_t _filterCount                           = 0;
+
+	asset_filter_plan_input_t _inputs[MAX_FILTERS] = {};
+	uint8_t _inputCount                            = 0;
+
+	/**
+	 * Get the bitmask of the filters that contain the given key.
+	 */
+	uint8_t getContainingFilters(uint8_t filterMask, const cs_const_data_t& key, const cuckoo_key_hash_t* keyHashes);
+
+	/**
+	 * Check the filters of an input, see evaluate().
+	 */
+	std::optional<uint8_t> evaluateInput(
+			const asset_filter_plan_input_t& input, const scanned_device_t& device, uint8_t& acceptingFilters);
+};
@@ -99,6 +99,25 @@ public:
 		return contains(getExtendedFingerprint(finger, bucketIndex));
 	}
 
+	// -------------------------------------------------------------
+	// These are useful to look up the same key in several filters.
+	// -------------------------------------------------------------
+
+	/**
+	 * Hashes a key, independent of the size of the filter.
+	 */
+	static cuckoo_key_hash_t hashKey(
+			cuckoo_key_t key,
+			size_t keyLengthInBytes,
+			CuckooFilterHashVersion hashVersion = CuckooFilterHashVersion::Crc16Djb2);
+
+	/**
+	 * The hash version that keys are hashed with for this filter.
+	 */
+	CuckooFilterHashVersion hashVersion() { return _hashVersion; }
+
+	bool contains(const cuckoo_key_hash_t& keyHash) { return contains(getExtendedFingerprint(keyHash)); }
+
 	// -------------------------------------------------------------
 	// these might be useful for stuff that comes in from commands
 	// -------------------------------------------------------------
@@ -120,9 +139,13 @@ public:
 	// -------------------------------------------------------------
 
 	/**
-	 * Wraps a data struct into a CuckooFilter object
+	 * Wraps a data struct into a CuckooFilter object.
+	 *
+	 * The hash version is not part of the data struct, it has to match the one the data was made with.
 	 */
-	CuckooFilter(cuckoo_filter_data_t* data) : _data(data) {}
+	CuckooFilter(
+			cuckoo_filter_data_t* data, CuckooFilterHashVersion hashVersion = CuckooFilterHashVersion::Crc16Djb2)
+			: _data(data), _hashVersion(hashVersion) {}
 
 	/**
 	 * Use this with loads of care, _data is never checked to be non-nullptr in this class.
@@ -190,6 +213,7 @@ private:
 	// -------------------------------------------------------------
 
 	cuckoo_filter_data_t* _data;
+	CuckooFilterHashVersion _hashVersion = CuckooFilterHashVersion::Crc16Djb2;
 
 	// -------------------------------------------------------------
 	// ----- Private methods -----
@@ -203,6 +227,13 @@ private:
 	 */
 	cuckoo_extended_fingerprint_t getExtendedFingerprint(cuckoo_key_t key, size_t keyLengthInBytes);
 
+	/**
+	 * Reduces the hashes of a key to an extended fingerprint for this filter.
+	 *
+	 * Note: bucketCount _must_ be a power of two. (which is validated at construction/init)
+	 */
+	cuckoo_extended_fingerprint_t getExtendedFingerprint(const cuckoo_key_hash_t& keyHash);
+
 	/**
 	 * Expands a fingerprint and the index where it is placed into an extended fingerprint,
 	 * by computing the alternative index in the fingerprint array.
@@ -219,12 +250,17 @@ private:
 	/**
 	 * Hashes the given key into a fingerprint.
 	 */
-	cuckoo_fingerprint_t hashToFingerprint(cuckoo_key_t key, size_t keyLengthInBytes);
+	static cuckoo_fingerprint_t hashToFingerprint(cuckoo_key_t key, size_t keyLengthInBytes);
 
 	/**
 	 * Hashes the given key to obtain an (untruncated) bucket index.
 	 */
-	cuckoo_fingerprint_t hashToBucket(cuckoo_key_t key, size_t keyLengthInBytes);
+	static cuckoo_fingerprint_t hashToBucket(cuckoo_key_t key, size_t keyLengthInBytes);
+
+	/**
+	 * Hashes the given key to a fingerprint and (untruncated) bucket index at once, see CuckooFilterHashVersion::Fnv1a.
+	 */
+	static cuckoo_key_hash_t hashKeyFnv1a(cuckoo_key_t key, size_t keyLengthInBytes);
 
 	/**
 	 * Returns a reference to the fingerprint at the given coordinates.
@@ -234,6 +270,13 @@ private:
 		return (cuckoo_fingerprint_t&)_data->bucketArray[(bucketIndex * _data->nestsPerBucket) + fingerIndex];
 	}
 
+	/**
+	 * Returns true if the fingerprint is in the bucket.
+	 *
+	 * Compares two fingerprints at a time, by loading them as one word.
+	 */
+	bool bucketContains(cuckoo_fingerprint_t fingerprint, cuckoo_index_t bucketIndex);
+
 	/**
 	 * Returns true if there was an empty space in the bucket and placement
 	 * was successful, returns false otherwise.
@@ -6,28 +6,57 @@
  */
 #pragma once
 
+#include <protocol/cs_ErrorCodes.h>
 #include <protocol/cs_ExactMatchFilterStructs.h>
+#include <protocol/cs_Typedefs.h>
 #include <util/cs_FilterInterface.h>
 
+/**
+ * An ExactMatchFilter is a sorted array of items of equal size.
+ *
+ * The items can be reordered to the Eytzinger layout: the breadth first order of the binary search tree over the
+ * sorted items. A lookup then walks down the tree without branching on the comparisons, and it compares the first bytes
+ * of the items as a single word, so that a full compare is only needed when those are equal, and for the final
+ * candidate. The top of the tree is at the start of the array, so the first steps of every lookup hit the same memory.
+ */
 class ExactMatchFilter : public FilterInterface {
 public:
 	// -------------------------------------------------------------
 	// Interface methods.
 	// -------------------------------------------------------------
 
-	ExactMatchFilter(exact_match_filter_data_t* data);
+	/**
+	 * Wraps a data struct into a ExactMatchFilter object.
+	 *
+	 * The layout is not part of the data struct, it has to match the current order of the items.
+	 */
+	ExactMatchFilter(exact_match_filter_data_t* data, ExactMatchFilterLayout layout = ExactMatchFilterLayout::Sorted);
 
 	/**
 	 * Use this default constructor with care, _data is never checked in this class.
 	 */
 	ExactMatchFilter() : _data(nullptr) {}
 
+	/**
+	 * Reorder the items from the sorted to the Eytzinger layout.
+	 *
+	 * @return ERR_SUCCESS               The items are in the Eytzinger layout.
+	 * @return ERR_WRONG_STATE           The items are not in the sorted layout.
+	 * @return ERR_NO_SPACE              Not enough heap to reorder, the items are still in the sorted layout.
+	 */
+	cs_ret_code_t toEytzingerLayout();
+
+	ExactMatchFilterLayout layout() { return _layout; }
+
 	bool contains(const void* key, size_t keyLengthInBytes) override;
 
+	/**
+	 * Checks that the items are sorted: in the Eytzinger layout, that an in order walk of the tree gives them sorted.
+	 */
 	bool isValid() override;
 
 	/**
-	 * if contains(key,itemSize): returns the index of the item
+	 * if contains(key,itemSize): returns the index of the item in the current layout
 	 * else: return -1
 	 */
 	int find(const void* item, size_t itemSize);
@@ -53,7 +82,33 @@ public:
 	constexpr size_t size() { return size(_data->itemCount, _data->itemSize); }
 
 private:
+	/**
+	 * Number of leading bytes of an item that are compared as a single word.
+	 */
+	static constexpr size_t PREFIX_SIZE = sizeof(uint32_t);
+
 	uint8_t* getItem(size_t index);
 
+	/**
+	 * Returns the first bytes of an item as a number, that compares like the bytes would with memcmp.
+	 */
+	uint32_t getPrefix(const uint8_t* item);
+
+	/**
+	 * Binary search in the sorted layout.
+	 */
+	int findSorted(const uint8_t* item);
+
+	/**
+	 * Search in the Eytzinger layout.
+	 */
+	int findEytzinger(const uint8_t* item);
+
+	/**
+	 * Fill the tree node with given (1 based) index and its children with the sorted items, starting at sortedIndex.
+	 */
+	void fillEytzinger(const uint8_t* sortedItems, size_t nodeIndex, size_t& sortedIndex);
+
 	exact_match_filter_data_t* _data;
+	ExactMatchFilterLayout _layout = ExactMatchFilterLayout::Sorted;
 };
@@ -57,3 +57,21 @@ inline uint16_t Djb2(const uint8_t* data, const uint16_t size) {
 	}
 	return hash;
 }
+
+/**
+ * @brief Calculates a 32 bit FNV-1a hash of given data.
+ *
+ * See http://www.isthe.com/chongo/tech/comp/fnv/ for implementation details
+ *
+ * @param[in] Pointer to the data.
+ * @param[in] Size of the data.
+ * @retval    The hash.
+ */
+inline uint32_t Fnv1a(const uint8_t* data, const uint16_t size) {
+	uint32_t hash = 2166136261u;
+	for (int i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
@@ -0,0 +1,241 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#pragma once
+
+#include <util/cs_Hash.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * A variant of Store with an index over the id() of the records, so that records can be looked up and added in
+ * constant time, instead of with a linear search.
+ *
+ * The index is an open addressing hash table with linear probing, with at least twice as many entries as records.
+ * Entries are removed by shifting the entries after it back, so that no tombstones are needed.
+ *
+ * Records are iterated like in Store: begin() to end() covers every record that has been in use, invalid records
+ * have to be skipped by the caller.
+ *
+ * RecordType should implement:
+ *   - IdType id();
+ *   - bool isValid();
+ *   - void invalidate();
+ *
+ * Where IdType is hashed by its bytes, so it should be trivially copyable without padding.
+ * Furthermore it must be default constructible.
+ *
+ * As the index refers to the records by their id, records that are in the store should only be invalidated
+ * via remove(), and their id should not be changed.
+ */
+template <class RecordType, unsigned int MaxItemCount>
+class IndexedStore {
+public:
+	/**
+	 * Identifies and simplifies the type returned by the id() method of RecordType.
+	 */
+	typedef typename std::remove_reference<decltype(((RecordType*)nullptr)->id())>::type IdType;
+
+	RecordType* begin() { return _records; }
+
+	RecordType* end() { return _records + _currentSize; }
+
+	/**
+	 * invalidate all records, and clear the index.
+	 */
+	void clear() {
+		for (auto& rec : *this) {
+			rec.invalidate();
+		}
+		memset(_index, 0, sizeof(_index));
+		_currentSize = 0;
+		_freeCount   = 0;
+		_count       = 0;
+	}
+
+	/**
+	 * Look up the valid record with id() == id.
+	 *
+	 * Returns nullptr if no such element exists.
+	 */
+	RecordType* get(const IdType& id) {
+		RecordIndexType entry = _index[findPosition(id)];
+		if (entry == 0 || !_records[entry - 1].isValid()) {
+			return nullptr;
+		}
+		return &_records[entry - 1];
+	}
+
+	/**
+	 * returns the first object `obj` in the store satisfying `p(obj) == true`.
+	 * This is a linear search, and does _not_ check for isValid.
+	 */
+	template <class UnaryPredicate>
+	RecordType* get(UnaryPredicate p) {
+		for (auto& obj : *this) {
+			if (p(obj)) {
+				return &obj;
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Returns a pointer to the valid element in the store which minimizes the value function `getValue`.
+	 */
+	template <class ValueFunction>
+	RecordType* getMin(ValueFunction getValue) {
+		RecordType* smallest = nullptr;
+		for (auto& obj : *this) {
+			if (obj.isValid() && (smallest == nullptr || getValue(obj) < getValue(*smallest))) {
+				smallest = &obj;
+			}
+		}
+		return smallest;
+	}
+
+	/**
+	 * Returns the record with the given id if it is in the index, else adds an invalidated record to the index.
+	 *
+	 * The caller has to set the id of a newly added record to the given id, before using the store again.
+	 *
+	 * Returns nullptr if full();
+	 */
+	RecordType* getOrAdd(const IdType& id) {
+		uint16_t position = findPosition(id);
+		if (_index[position] != 0) {
+			return &_records[_index[position] - 1];
+		}
+
+		uint16_t recordIndex;
+		if (_freeCount > 0) {
+			recordIndex = _freeRecords[--_freeCount];
+		}
+		else if (_currentSize < MaxItemCount) {
+			recordIndex = _currentSize++;
+		}
+		else {
+			return nullptr;
+		}
+
+		_records[recordIndex].invalidate();
+		_index[position] = recordIndex + 1;
+		_count++;
+		return &_records[recordIndex];
+	}
+
+	/**
+	 * Invalidates the record, and removes it from the index.
+	 */
+	void remove(RecordType* record) {
+		uint16_t recordIndex = record - _records;
+		uint16_t position    = findPosition(record->id());
+		record->invalidate();
+		if (_index[position] != recordIndex + 1) {
+			// Not in the index.
+			return;
+		}
+
+		// Shift back the entries after it, up to the first empty entry, as long as they don't end up before their
+		// home position.
+		uint16_t next = position;
+		while (true) {
+			next = (next + 1) & INDEX_MASK;
+			if (_index[next] == 0) {
+				break;
+			}
+			uint16_t home = getHomePosition(_records[_index[next] - 1].id());
+			if (((next - home) & INDEX_MASK) >= ((next - position) & INDEX_MASK)) {
+				_index[position] = _index[next];
+				position         = next;
+			}
+		}
+		_index[position] = 0;
+
+		_freeRecords[_freeCount++] = recordIndex;
+		_count--;
+	}
+
+	uint16_t size() { return _currentSize; }
+
+	/**
+	 * returns number of elements that satisfy the predicate.
+	 */
+	template <class UnaryPredicate>
+	uint16_t countIf(UnaryPredicate p) {
+		uint16_t s = 0;
+		for (auto& rec : *this) {
+			s += p(rec) ? 1 : 0;
+		}
+		return s;
+	}
+
+	/**
+	 * returns number of records in the index.
+	 */
+	uint16_t count() { return _count; }
+
+	/**
+	 * returns true if all records are in the index.
+	 */
+	bool full() { return _count == MaxItemCount; }
+
+private:
+	typedef typename std::conditional<(MaxItemCount < 0xFF), uint8_t, uint16_t>::type RecordIndexType;
+
+	static constexpr uint16_t getIndexSize() {
+		uint16_t size = 1;
+		while (size < 2 * MaxItemCount) {
+			size <<= 1;
+		}
+		return size;
+	}
+
+	static constexpr uint16_t INDEX_SIZE = getIndexSize();
+	static constexpr uint16_t INDEX_MASK = INDEX_SIZE - 1;
+
+	RecordType _records[MaxItemCount]          = {};
+
+	/**
+	 * Index of the record + 1, or 0 for an empty entry.
+	 */
+	RecordIndexType _index[INDEX_SIZE]         = {};
+
+	/**
+	 * Indices of records below _currentSize that have been removed.
+	 */
+	RecordIndexType _freeRecords[MaxItemCount] = {};
+	uint16_t _freeCount                        = 0;
+
+	/**
+	 * Number of records that have been in use, see Store.
+	 */
+	uint16_t _currentSize                      = 0;
+
+	/**
+	 * Number of records in the index.
+	 */
+	uint16_t _count                            = 0;
+
+	static uint16_t getHomePosition(IdType id) {
+		uint16_t hash = Djb2(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+		return (hash ^ (hash >> 8)) & INDEX_MASK;
+	}
+
+	/**
+	 * Returns the position of the entry of the record with given id, or of the empty entry where it would go.
+	 */
+	uint16_t findPosition(const IdType& id) {
+		uint16_t position = getHomePosition(id);
+		while (_index[position] != 0 && !(_records[_index[position] - 1].id() == id)) {
+			position = (position + 1) & INDEX_MASK;
+		}
+		return position;
+	}
+};
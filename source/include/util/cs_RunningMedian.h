@@ -0,0 +1,122 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Median and average of the last N values, updated on each push.
+ *
+ * Besides the values in order of arrival, a sorted copy of the window is kept. On push, the oldest value is evicted
+ * and the new value is moved into place in the same pass, so the median can be read without copying or selecting.
+ * This takes at most N moves per push, which is cheap for the small windows this is meant for.
+ *
+ * @param T                   Value type.
+ * @param N                   Window size, should be odd, so that the median is a value in the window.
+ */
+template <typename T, uint16_t N>
+class RunningMedian {
+public:
+	static_assert(N % 2 == 1, "Window size should be odd");
+
+	/**
+	 * Add a value, evicting the oldest value when the window is full.
+	 */
+	void push(T value) {
+		if (_size < N) {
+			insertSorted(_size, value);
+			_values[_size] = value;
+			_size++;
+			_sum += value;
+			return;
+		}
+		T oldest = _values[_oldest];
+		_sum += static_cast<int64_t>(value) - oldest;
+		_values[_oldest] = value;
+		if (++_oldest == N) {
+			_oldest = 0;
+		}
+		replaceSorted(oldest, value);
+	}
+
+	/**
+	 * Remove all values.
+	 */
+	void clear() {
+		_size   = 0;
+		_oldest = 0;
+		_sum    = 0;
+	}
+
+	uint16_t size() const { return _size; }
+
+	bool full() const { return _size == N; }
+
+	/**
+	 * Get the median of the values, or the lower median when the number of values is even.
+	 *
+	 * Should not be called when empty.
+	 */
+	T getMedian() const { return _sorted[(_size - 1) / 2]; }
+
+	/**
+	 * Get the average of the values, rounded towards zero.
+	 *
+	 * Should not be called when empty.
+	 */
+	T getAverage() const { return _sum / _size; }
+
+private:
+	/**
+	 * Values in order of arrival, the oldest at _oldest once the window is full.
+	 */
+	T _values[N];
+
+	/**
+	 * The same values, in ascending order.
+	 */
+	T _sorted[N];
+
+	uint16_t _size   = 0;
+	uint16_t _oldest = 0;
+	int64_t _sum     = 0;
+
+	/**
+	 * Insert a value in the first size sorted values.
+	 */
+	void insertSorted(uint16_t size, T value) {
+		uint16_t i = size;
+		while (i > 0 && value < _sorted[i - 1]) {
+			_sorted[i] = _sorted[i - 1];
+			i--;
+		}
+		_sorted[i] = value;
+	}
+
+	/**
+	 * Replace a value in the full sorted window by another, by shifting the values in between.
+	 */
+	void replaceSorted(T oldValue, T newValue) {
+		uint16_t i = 0;
+		while (_sorted[i] != oldValue) {
+			i++;
+		}
+		if (oldValue < newValue) {
+			while (i + 1 < N && _sorted[i + 1] < newValue) {
+				_sorted[i] = _sorted[i + 1];
+				i++;
+			}
+		}
+		else {
+			while (i > 0 && newValue < _sorted[i - 1]) {
+				_sorted[i] = _sorted[i - 1];
+				i--;
+			}
+		}
+		_sorted[i] = newValue;
+	}
+};
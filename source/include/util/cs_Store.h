@@ -191,7 +191,7 @@ public:
 	 * returns number of valid elements.
 	 */
 	constexpr uint16_t count() {
-		return countIf([](auto& rec) { rec.isValid(); });
+		return countIf([](auto& rec) { return rec.isValid(); });
 	}
 
 	/**
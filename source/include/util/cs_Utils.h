@@ -164,6 +164,72 @@ inline static cs_ret_code_t findAdvType(uint8_t type, uint8_t* advData, uint8_t
 	return ERR_NOT_FOUND;
 }
 
+/**
+ * Index the AD structures of advertisement data, so that they can be looked up without parsing the data again.
+ *
+ * Like findAdvType(), parsing stops at the first malformed AD structure.
+ *
+ * @param[in]  Pointer to advertisement data.
+ * @param[in]  Advertisement data length.
+ * @param[out] The index.
+ */
+inline static void indexAdvTypes(const uint8_t* advData, uint8_t advLen, adv_index_t& advIndex) {
+	int index                = 0;
+	advIndex.count           = 0;
+	advIndex.unindexedOffset = 0;
+	while (index < advLen - 1) {
+		uint8_t fieldLen = advData[index];
+		// Check if length is not 0 or larger than remaining advertisement data.
+		if (fieldLen == 0 || index + 1 + fieldLen > advLen) {
+			return;
+		}
+
+		if (advIndex.count == SCAN_ADV_INDEX_MAX_FIELDS) {
+			advIndex.unindexedOffset = index;
+			return;
+		}
+		advIndex.types[advIndex.count]   = advData[index + 1];
+		advIndex.offsets[advIndex.count] = index + 2;
+		advIndex.lengths[advIndex.count] = fieldLen - 1;
+		advIndex.count++;
+		index += fieldLen + 1;
+	}
+}
+
+/**
+ * Same as findAdvType() on the data of a scanned device, but uses the index of the AD structures when available.
+ *
+ * @param[in]  Type of data to be looked for in advertisement data.
+ * @param[in]  The scanned device.
+ * @param[out] If data type requested is found: pointer to data of given type and its length.
+ *
+ * @retval ERR_SUCCESS if the data type is found in the report.
+ * @retval ERR_NOT_FOUND if the type could not be found.
+ */
+inline static cs_ret_code_t findAdvType(uint8_t type, const scanned_device_t& device, cs_data_t* foundData) {
+	const adv_index_t* advIndex = device.advIndex;
+	if (advIndex == nullptr) {
+		return findAdvType(type, device.data, device.dataSize, foundData);
+	}
+
+	for (uint8_t i = 0; i < advIndex->count; ++i) {
+		if (advIndex->types[i] == type) {
+			foundData->data = device.data + advIndex->offsets[i];
+			foundData->len  = advIndex->lengths[i];
+			return ERR_SUCCESS;
+		}
+	}
+
+	// The index was full: search the remaining AD structures.
+	uint8_t offset = advIndex->unindexedOffset;
+	if (offset != 0) {
+		return findAdvType(type, device.data + offset, device.dataSize - offset, foundData);
+	}
+	foundData->data = nullptr;
+	foundData->len  = 0;
+	return ERR_NOT_FOUND;
+}
+
 /**
  * Gets the string length of a null terminated constant string.
  * Unlike strlen(), this function is guaranteed to be optimized out.
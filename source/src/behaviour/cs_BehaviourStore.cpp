@@ -19,6 +19,9 @@
 #define LOGBehaviourStoreInfo LOGvv
 #define LOGBehaviourStoreDebug LOGvv
 
+// Removing all behaviours queues a flash operation for each of them, as they share a record key.
+static_assert(BehaviourStore::MaxBehaviours < STATE_STORE_QUEUE_SIZE, "State store queue can't fit all behaviours");
+
 // ======================= public interface ========================
 
 ErrorCodesGeneral BehaviourStore::addBehaviour(Behaviour* behaviour) {
@@ -133,7 +136,7 @@ void BehaviourStore::storeUpdate(uint8_t index, SwitchBehaviour::Type type, uint
 	}
 
 	cs_state_data_t data(csType, index, buf, bufSize);
-	State::getInstance().set(data);
+	State::getInstance().setWriteBack(data);
 	storeMasterHash();
 }
 
@@ -400,17 +403,18 @@ ErrorCodesGeneral BehaviourStore::removeBehaviour(uint8_t index) {
 	delete activeBehaviours[index];
 	activeBehaviours[index] = nullptr;
 
+	cs_ret_code_t retCode = ERR_SUCCESS;
 	switch (type) {
 		case Behaviour::Type::Switch: {
-			State::getInstance().remove(CS_TYPE::STATE_BEHAVIOUR_RULE, index);
+			retCode = State::getInstance().remove(CS_TYPE::STATE_BEHAVIOUR_RULE, index);
 			break;
 		}
 		case Behaviour::Type::Twilight: {
-			State::getInstance().remove(CS_TYPE::STATE_TWILIGHT_RULE, index);
+			retCode = State::getInstance().remove(CS_TYPE::STATE_TWILIGHT_RULE, index);
 			break;
 		}
 		case Behaviour::Type::Extended: {
-			State::getInstance().remove(CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE, index);
+			retCode = State::getInstance().remove(CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE, index);
 			break;
 		}
 		default: {
@@ -418,6 +422,9 @@ ErrorCodesGeneral BehaviourStore::removeBehaviour(uint8_t index) {
 			break;
 		}
 	}
+	if (retCode != ERR_SUCCESS) {
+		LOGe("Failed to remove behaviour #%u from flash: retCode=%u", index, retCode);
+	}
 
 	storeMasterHash();
 	return ERR_SUCCESS;
@@ -439,7 +446,8 @@ uint32_t BehaviourStore::calculateMasterHash() {
 void BehaviourStore::storeMasterHash() {
 	TYPIFY(STATE_BEHAVIOUR_MASTER_HASH) hash = calculateMasterHash();
 	LOGBehaviourStoreDebug("storeMasterHash %u", hash);
-	State::getInstance().set(CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH, &hash, sizeof(hash));
+	cs_state_data_t data(CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH, reinterpret_cast<uint8_t*>(&hash), sizeof(hash));
+	State::getInstance().setWriteBack(data);
 }
 
 template <class BehaviourType>
@@ -142,7 +142,7 @@ void ServiceData::updateServiceData(bool initial) {
 	uint32_t timestamp = SystemTime::posix();
 
 	// Update the state errors.
-	State::getInstance().get(CS_TYPE::STATE_ERRORS, &_stateErrors, sizeof(_stateErrors));
+	_stateErrors = State::getInstance().get<CS_TYPE::STATE_ERRORS>();
 
 	// Update flags.
 	_flags.flags.timeSet = (timestamp != 0);
@@ -177,7 +177,7 @@ void ServiceData::updateServiceData(bool initial) {
 
 	UartHandler::getInstance().writeMsg(UART_OPCODE_TX_SERVICE_DATA, _serviceData.array, sizeof(_serviceData.array));
 
-	if (encrypt && State::getInstance().isTrue(CS_TYPE::CONFIG_ENCRYPTION_ENABLED)) {
+	if (encrypt && State::getInstance().get<CS_TYPE::CONFIG_ENCRYPTION_ENABLED>()) {
 		encryptServiceData();
 	}
 
@@ -198,9 +198,7 @@ void ServiceData::updateServiceData(bool initial) {
 bool ServiceData::fillServiceData(uint32_t timestamp) {
 	bool serviceDataSet = false;
 
-	TYPIFY(STATE_HUB_MODE) hubMode;
-	State::getInstance().get(CS_TYPE::STATE_HUB_MODE, &hubMode, sizeof(hubMode));
-	if (hubMode) {
+	if (State::getInstance().get<CS_TYPE::STATE_HUB_MODE>()) {
 		// In hub mode, only use hub state as service data.
 		fillWithHubState(timestamp);
 		return _operationMode != OperationMode::OPERATION_MODE_SETUP;
@@ -304,8 +302,8 @@ bool ServiceData::fillWithExternalState() {
 }
 
 void ServiceData::fillWithAlternativeState(uint32_t timestamp) {
-	TYPIFY(STATE_BEHAVIOUR_MASTER_HASH) behaviourHash;
-	State::getInstance().get(CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH, &behaviourHash, sizeof(behaviourHash));
+	TYPIFY(STATE_BEHAVIOUR_MASTER_HASH) behaviourHash =
+			State::getInstance().get<CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH>();
 	_serviceData.params.type                                   = SERVICE_DATA_TYPE_ENCRYPTED;
 	_serviceData.params.encrypted.type                         = SERVICE_DATA_DATA_TYPE_ALTERNATIVE_STATE;
 	_serviceData.params.encrypted.altState.id                  = _crownstoneId;
@@ -313,8 +311,8 @@ void ServiceData::fillWithAlternativeState(uint32_t timestamp) {
 	_serviceData.params.encrypted.altState.flags               = _flags;
 	_serviceData.params.encrypted.altState.behaviourMasterHash = getPartialBehaviourHash(behaviourHash);
 
-	TYPIFY(STATE_ASSET_FILTERS_VERSION) filtersVersion;
-	State::getInstance().get(CS_TYPE::STATE_ASSET_FILTERS_VERSION, &filtersVersion, sizeof(filtersVersion));
+	const TYPIFY(STATE_ASSET_FILTERS_VERSION)& filtersVersion =
+			State::getInstance().getRef<CS_TYPE::STATE_ASSET_FILTERS_VERSION>();
 	_serviceData.params.encrypted.altState.assetFiltersVersion = filtersVersion.masterVersion;
 	_serviceData.params.encrypted.altState.assetFiltersCrc     = filtersVersion.masterCrc;
 
@@ -501,6 +501,11 @@ void csStackOnScan(const ble_gap_evt_adv_report_t* advReport) {
 	scan.dataSize               = advReport->data.len;
 	scan.data                   = advReport->data.p_data;
 
+	// Parse the AD structures once, for all handlers of the event.
+	adv_index_t advIndex;
+	CsUtils::indexAdvTypes(scan.data, scan.dataSize, advIndex);
+	scan.advIndex = &advIndex;
+
 	event_t event(CS_TYPE::EVT_DEVICE_SCANNED, (void*)&scan, sizeof(scan));
 	EventDispatcher::getInstance().dispatch(event);
 }
@@ -8,1548 +8,200 @@
 #include <common/cs_Types.h>
 #include <localisation/cs_TrackableEvent.h>
 
-CS_TYPE toCsType(uint16_t type) {
+namespace {
+
+// Values used in cs_TypeList.h.
+constexpr bool SINGLE_ID    = false;
+constexpr bool MULTIPLE_IDS = true;
+
+enum FactoryResetMode : uint8_t {
+	REMOVE_ON_RESET    = 0,  // All IDs are removed on factory reset.
+	KEEP_ID_0_ON_RESET = 1,  // All IDs, except ID 0, are removed on factory reset.
+};
+
+/**
+ * Size of a type, where void has size 0.
+ */
+template <typename T>
+constexpr size16_t payloadSize() {
+	return sizeof(T);
+}
+
+template <>
+constexpr size16_t payloadSize<void>() {
+	return 0;
+}
+
+/**
+ * Properties of a type.
+ */
+struct type_info_t {
+	uint16_t type;
+	size16_t size;
+	bool multipleIds;
+	uint8_t factoryReset;  // FactoryResetMode
+	uint8_t accessSet;     // EncryptionAccessLevel
+	uint8_t accessGet;     // EncryptionAccessLevel
+};
+
+// clang-format off
+constexpr type_info_t typeInfo[] = {
+#define CS_STATE_TYPE(NAME, VALUE, IDS, FACTORY_RESET, ACCESS_SET, ACCESS_GET) \
+	{to_underlying_type(CS_TYPE::NAME), payloadSize<TYPIFY(NAME)>(), IDS, FACTORY_RESET, ACCESS_SET, ACCESS_GET},
+#define CS_STATE_TYPE_SIZED(NAME, VALUE, SIZE, IDS, FACTORY_RESET, ACCESS_SET, ACCESS_GET) \
+	{to_underlying_type(CS_TYPE::NAME), SIZE, IDS, FACTORY_RESET, ACCESS_SET, ACCESS_GET},
+#define CS_INTERNAL_TYPE(NAME, VALUE) \
+	{to_underlying_type(CS_TYPE::NAME), payloadSize<TYPIFY(NAME)>(), SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE},
+#define CS_INTERNAL_TYPE_SIZED(NAME, VALUE, SIZE) \
+	{to_underlying_type(CS_TYPE::NAME), SIZE, SINGLE_ID, REMOVE_ON_RESET, NO_ONE, NO_ONE},
+#include <common/cs_TypeList.h>
+#undef CS_STATE_TYPE
+#undef CS_STATE_TYPE_SIZED
+#undef CS_INTERNAL_TYPE
+#undef CS_INTERNAL_TYPE_SIZED
+};
+// clang-format on
 
-	CS_TYPE csType = static_cast<CS_TYPE>(type);
-	switch (csType) {
-		case CS_TYPE::CONFIG_DO_NOT_USE:
-		case CS_TYPE::CONFIG_NAME:
-		case CS_TYPE::CONFIG_PWM_PERIOD:
-		case CS_TYPE::CONFIG_IBEACON_MAJOR:
-		case CS_TYPE::CONFIG_IBEACON_MINOR:
-		case CS_TYPE::CONFIG_IBEACON_UUID:
-		case CS_TYPE::CONFIG_IBEACON_TXPOWER:
-		case CS_TYPE::CONFIG_TX_POWER:
-		case CS_TYPE::CONFIG_ADV_INTERVAL:
-		case CS_TYPE::CONFIG_SCAN_DURATION:
-		case CS_TYPE::CONFIG_SCAN_BREAK_DURATION:
-		case CS_TYPE::CONFIG_BOOT_DELAY:
-		case CS_TYPE::CONFIG_MAX_CHIP_TEMP:
-		case CS_TYPE::CONFIG_CURRENT_LIMIT:
-		case CS_TYPE::CONFIG_MESH_ENABLED:
-		case CS_TYPE::CONFIG_ENCRYPTION_ENABLED:
-		case CS_TYPE::CONFIG_IBEACON_ENABLED:
-		case CS_TYPE::CONFIG_SCANNER_ENABLED:
-		case CS_TYPE::CONFIG_SPHERE_ID:
-		case CS_TYPE::CONFIG_CROWNSTONE_ID:
-		case CS_TYPE::CONFIG_KEY_ADMIN:
-		case CS_TYPE::CONFIG_KEY_MEMBER:
-		case CS_TYPE::CONFIG_KEY_BASIC:
-		case CS_TYPE::CONFIG_KEY_SERVICE_DATA:
-		case CS_TYPE::CONFIG_MESH_DEVICE_KEY:
-		case CS_TYPE::CONFIG_MESH_APP_KEY:
-		case CS_TYPE::CONFIG_MESH_NET_KEY:
-		case CS_TYPE::CONFIG_KEY_LOCALIZATION:
-		case CS_TYPE::CONFIG_SCAN_INTERVAL_625US:
-		case CS_TYPE::CONFIG_SCAN_WINDOW_625US:
-		case CS_TYPE::CONFIG_RELAY_HIGH_DURATION:
-		case CS_TYPE::CONFIG_LOW_TX_POWER:
-		case CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER:
-		case CS_TYPE::CONFIG_CURRENT_MULTIPLIER:
-		case CS_TYPE::CONFIG_VOLTAGE_ADC_ZERO:
-		case CS_TYPE::CONFIG_CURRENT_ADC_ZERO:
-		case CS_TYPE::CONFIG_POWER_ZERO:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN:
-		case CS_TYPE::CONFIG_DIMMING_ALLOWED:
-		case CS_TYPE::CONFIG_START_DIMMER_ON_ZERO_CROSSING:
-		case CS_TYPE::CONFIG_SWITCH_LOCKED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_THRESHOLD:
-		case CS_TYPE::STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET:
-		case CS_TYPE::CONFIG_UART_ENABLED:
-		case CS_TYPE::STATE_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_TWILIGHT_RULE:
-		case CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH:
-		case CS_TYPE::STATE_RESET_COUNTER:
-		case CS_TYPE::STATE_OPERATION_MODE:
-		case CS_TYPE::STATE_SWITCH_STATE:
-		case CS_TYPE::STATE_ACCUMULATED_ENERGY:
-		case CS_TYPE::STATE_POWER_USAGE:
-		case CS_TYPE::STATE_TEMPERATURE:
-		case CS_TYPE::STATE_SUN_TIME:
-		case CS_TYPE::STATE_FACTORY_RESET:
-		case CS_TYPE::STATE_ERRORS:
-		case CS_TYPE::STATE_MESH_IV_INDEX:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER:
-		case CS_TYPE::STATE_MESH_IV_INDEX_V5:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER_V5:
-		case CS_TYPE::STATE_IBEACON_CONFIG_ID:
-		case CS_TYPE::STATE_MICROAPP:
-		case CS_TYPE::STATE_SOFT_ON_SPEED:
-		case CS_TYPE::STATE_DEFAULT_DIM_VALUE:
-		case CS_TYPE::STATE_HUB_MODE:
-		case CS_TYPE::STATE_UART_KEY:
-		case CS_TYPE::STATE_ASSET_FILTERS_VERSION:
-		case CS_TYPE::STATE_ASSET_FILTER_32:
-		case CS_TYPE::STATE_ASSET_FILTER_64:
-		case CS_TYPE::STATE_ASSET_FILTER_128:
-		case CS_TYPE::STATE_ASSET_FILTER_256:
-		case CS_TYPE::STATE_ASSET_FILTER_512:
-		case CS_TYPE::CMD_SWITCH_OFF:
-		case CS_TYPE::CMD_SWITCH_ON:
-		case CS_TYPE::CMD_SWITCH_TOGGLE:
-		case CS_TYPE::CMD_SWITCH:
-		case CS_TYPE::CMD_MULTI_SWITCH:
-		case CS_TYPE::EVT_ADV_BACKGROUND:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED_V1:
-		case CS_TYPE::EVT_ADVERTISEMENT_UPDATED:
-		case CS_TYPE::EVT_SCAN_STARTED:
-		case CS_TYPE::EVT_SCAN_STOPPED:
-		case CS_TYPE::EVT_DEVICE_SCANNED:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_OFF_FAILURE_DETECTED:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_CONTROL_COMMAND:
-		case CS_TYPE::CMD_BLE_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCOVER:
-		case CS_TYPE::CMD_BLE_CENTRAL_READ:
-		case CS_TYPE::CMD_BLE_CENTRAL_WRITE:
-		case CS_TYPE::EVT_BLE_CONNECT:
-		case CS_TYPE::EVT_BLE_DISCONNECT:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCONNECTED:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_NOTIFICATION:
-		case CS_TYPE::CMD_CS_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_WRITE:
-		case CS_TYPE::CMD_CS_CENTRAL_GET_WRITE_BUF:
-		case CS_TYPE::EVT_CS_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BROWNOUT_IMPENDING:
-		case CS_TYPE::EVT_SESSION_DATA_SET:
-		case CS_TYPE::EVT_DIMMER_FORCED_OFF:
-		case CS_TYPE::EVT_SWITCH_FORCED_OFF:
-		case CS_TYPE::EVT_RELAY_FORCED_ON:
-		case CS_TYPE::EVT_CHIP_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_CHIP_TEMP_OK:
-		case CS_TYPE::EVT_DIMMER_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_TEMP_OK:
-		case CS_TYPE::EVT_TICK:
-		case CS_TYPE::EVT_TIME_SET:
-		case CS_TYPE::EVT_DIMMER_POWERED:
-		case CS_TYPE::CMD_DIMMING_ALLOWED:
-		case CS_TYPE::CMD_LOCK_SWITCH:
-		case CS_TYPE::EVT_STATE_EXTERNAL_STONE:
-		case CS_TYPE::EVT_STATE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_INITIALIZED:
-		case CS_TYPE::EVT_STORAGE_WRITE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE:
-		case CS_TYPE::EVT_STORAGE_GC_DONE:
-		case CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_STORAGE_GARBAGE_COLLECT:
-		case CS_TYPE::EVT_ADC_RESTARTED:
-		case CS_TYPE::CMD_SEND_MESH_MSG:
-		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH:
-		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::CMD_SET_TIME:
-		case CS_TYPE::CMD_FACTORY_RESET:
-		case CS_TYPE::CMD_ENABLE_LOG_POWER:
-		case CS_TYPE::CMD_ENABLE_LOG_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
-		case CS_TYPE::CMD_RESET_DELAYED:
-		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT:
-		case CS_TYPE::CMD_ENABLE_MESH:
-		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE:
-		case CS_TYPE::CMD_INC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_DEC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_INC_CURRENT_RANGE:
-		case CS_TYPE::CMD_DEC_CURRENT_RANGE:
-		case CS_TYPE::CMD_CONTROL_CMD:
-		case CS_TYPE::CMD_ADD_BEHAVIOUR:
-		case CS_TYPE::CMD_REPLACE_BEHAVIOUR:
-		case CS_TYPE::CMD_REMOVE_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_INDICES:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_DEBUG:
-		case CS_TYPE::CMD_CLEAR_ALL_BEHAVIOUR:
-		case CS_TYPE::EVT_BEHAVIOURSTORE_MUTATION:
-		case CS_TYPE::EVT_BEHAVIOUR_OVERRIDDEN:
-		case CS_TYPE::CMD_REGISTER_TRACKED_DEVICE:
-		case CS_TYPE::CMD_UPDATE_TRACKED_DEVICE:
-		case CS_TYPE::CMD_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_PRESENCE_MUTATION:
-		case CS_TYPE::EVT_PRESENCE_CHANGE:
-		case CS_TYPE::CMD_GET_PRESENCE:
-		case CS_TYPE::CMD_SET_RELAY:
-		case CS_TYPE::CMD_SET_DIMMER:
-		case CS_TYPE::EVT_GOING_TO_DFU:
-		case CS_TYPE::EVT_RECEIVED_PROFILE_LOCATION:
-		case CS_TYPE::CMD_UPLOAD_FILTER:
-		case CS_TYPE::CMD_REMOVE_FILTER:
-		case CS_TYPE::CMD_COMMIT_FILTER_CHANGES:
-		case CS_TYPE::CMD_GET_FILTER_SUMMARIES:
-		case CS_TYPE::EVT_FILTERS_UPDATED:
-		case CS_TYPE::EVT_FILTER_MODIFICATION:
-		case CS_TYPE::EVT_ASSET_ACCEPTED:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_OUTGOING:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_INCOMING:
-		case CS_TYPE::EVT_MESH_SYNC_FAILED:
-		case CS_TYPE::EVT_MESH_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_EXT_STATE_0:
-		case CS_TYPE::EVT_MESH_EXT_STATE_1:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_TIME:
-		case CS_TYPE::CMD_SET_IBEACON_CONFIG_ID:
-		case CS_TYPE::CMD_SEND_MESH_MSG_NOOP:
-		case CS_TYPE::EVT_MESH_RSSI_PING:
-		case CS_TYPE::EVT_MESH_RSSI_DATA:
-		case CS_TYPE::EVT_MESH_TIME_SYNC:
-		case CS_TYPE::EVT_RECV_MESH_MSG:
-		case CS_TYPE::CMD_GET_ADC_RESTARTS:
-		case CS_TYPE::CMD_GET_SWITCH_HISTORY:
-		case CS_TYPE::CMD_GET_POWER_SAMPLES:
-		case CS_TYPE::CMD_GET_SCHEDULER_MIN_FREE:
-		case CS_TYPE::CMD_GET_RESET_REASON:
-		case CS_TYPE::CMD_GET_GPREGRET:
-		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
-		case CS_TYPE::CMD_GET_RAM_STATS:
-		case CS_TYPE::EVT_GENERIC_TEST:
-		case CS_TYPE::CMD_TEST_SET_TIME:
-		case CS_TYPE::CMD_MICROAPP_GET_INFO:
-		case CS_TYPE::CMD_MICROAPP_UPLOAD:
-		case CS_TYPE::CMD_MICROAPP_VALIDATE:
-		case CS_TYPE::CMD_MICROAPP_REMOVE:
-		case CS_TYPE::CMD_MICROAPP_ENABLE:
-		case CS_TYPE::CMD_MICROAPP_DISABLE:
-		case CS_TYPE::CMD_MICROAPP_MESSAGE:
-		case CS_TYPE::CMD_MICROAPP_ADVERTISE:
-		case CS_TYPE::EVT_MICROAPP_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_MESH_TOPO_GET_MAC:
-		case CS_TYPE::EVT_MESH_TOPO_MAC_RESULT:
-		case CS_TYPE::CMD_MESH_TOPO_RESET:
-		case CS_TYPE::CMD_MESH_TOPO_GET_RSSI:
-		case CS_TYPE::EVT_TWI_INIT:
-		case CS_TYPE::EVT_TWI_WRITE:
-		case CS_TYPE::EVT_TWI_READ:
-		case CS_TYPE::EVT_TWI_UPDATE:
-		case CS_TYPE::EVT_GPIO_INIT:
-		case CS_TYPE::EVT_GPIO_WRITE:
-		case CS_TYPE::EVT_GPIO_READ:
-		case CS_TYPE::EVT_GPIO_UPDATE:
-		case CS_TYPE::CMD_RESOLVE_ASYNC_CONTROL_COMMAND:
-		case CS_TYPE::CMD_SEND_ASYNC_RESULT_TO_BLE: return csType;
+constexpr uint16_t TYPE_INFO_COUNT = sizeof(typeInfo) / sizeof(typeInfo[0]);
+constexpr uint8_t INVALID_INDEX    = 0xFF;
+static_assert(TYPE_INFO_COUNT < INVALID_INDEX, "Too many types for the type index");
+
+constexpr uint16_t maxTypeBelow(uint16_t limit) {
+	uint16_t result = 0;
+	for (uint16_t i = 0; i < TYPE_INFO_COUNT; ++i) {
+		if (typeInfo[i].type < limit && typeInfo[i].type > result) {
+			result = typeInfo[i].type;
+		}
 	}
-	return CS_TYPE::CONFIG_DO_NOT_USE;
+	return result;
 }
 
-// bool validateSize(cs_state_data_t const & data, size16_t size) {
-//	auto type = data.type;
-//	switch (type) {
-//		case CS_TYPE::CONFIG_BEHAVIOUR: {
-//			return SwitchBehaviour::checkSize(data.data, data.size, size);
-//		}
-//	}
-//	return size == TypeSize(type);
-//}
+/**
+ * The type values are sparse, so they are mapped to a dense range of slots:
+ * - State and internal types map to slot [0, MAX_INTERNAL_TYPE].
+ * - Test types follow after that.
+ * - The generic test type gets the last slot.
+ */
+constexpr uint16_t MAX_INTERNAL_TYPE = maxTypeBelow(InternalBaseTests);
+constexpr uint16_t MAX_TEST_TYPE     = maxTypeBelow(to_underlying_type(CS_TYPE::EVT_GENERIC_TEST));
+constexpr uint16_t TEST_SLOTS_START  = MAX_INTERNAL_TYPE + 1;
+constexpr uint16_t GENERIC_TEST_SLOT = TEST_SLOTS_START + MAX_TEST_TYPE - InternalBaseTests + 1;
+constexpr uint16_t SLOT_COUNT        = GENERIC_TEST_SLOT + 1;
+constexpr uint16_t INVALID_SLOT      = 0xFFFF;
 
-size16_t TypeSize(CS_TYPE const& type) {
+constexpr uint16_t getSlot(uint16_t type) {
+	if (type <= MAX_INTERNAL_TYPE) {
+		return type;
+	}
+	if (type >= InternalBaseTests && type <= MAX_TEST_TYPE) {
+		return TEST_SLOTS_START + type - InternalBaseTests;
+	}
+	if (type == to_underlying_type(CS_TYPE::EVT_GENERIC_TEST)) {
+		return GENERIC_TEST_SLOT;
+	}
+	return INVALID_SLOT;
+}
 
-	switch (type) {
-		case CS_TYPE::CONFIG_DO_NOT_USE: return 0;
-		case CS_TYPE::CONFIG_NAME: return MAX_STRING_STORAGE_SIZE + 1;
-		case CS_TYPE::CONFIG_PWM_PERIOD: return sizeof(TYPIFY(CONFIG_PWM_PERIOD));
-		case CS_TYPE::CONFIG_IBEACON_MAJOR: return sizeof(TYPIFY(CONFIG_IBEACON_MAJOR));
-		case CS_TYPE::CONFIG_IBEACON_MINOR: return sizeof(TYPIFY(CONFIG_IBEACON_MINOR));
-		case CS_TYPE::CONFIG_IBEACON_UUID: return sizeof(TYPIFY(CONFIG_IBEACON_UUID));
-		case CS_TYPE::CONFIG_IBEACON_TXPOWER: return sizeof(TYPIFY(CONFIG_IBEACON_TXPOWER));
-		case CS_TYPE::CONFIG_TX_POWER: return sizeof(TYPIFY(CONFIG_TX_POWER));
-		case CS_TYPE::CONFIG_ADV_INTERVAL: return sizeof(TYPIFY(CONFIG_ADV_INTERVAL));
-		case CS_TYPE::CONFIG_SCAN_DURATION: return sizeof(TYPIFY(CONFIG_SCAN_DURATION));
-		case CS_TYPE::CONFIG_SCAN_BREAK_DURATION: return sizeof(TYPIFY(CONFIG_SCAN_BREAK_DURATION));
-		case CS_TYPE::CONFIG_BOOT_DELAY: return sizeof(TYPIFY(CONFIG_BOOT_DELAY));
-		case CS_TYPE::CONFIG_MAX_CHIP_TEMP: return sizeof(TYPIFY(CONFIG_MAX_CHIP_TEMP));
-		case CS_TYPE::CONFIG_CURRENT_LIMIT: return 0;  // Not implemented
-		case CS_TYPE::CONFIG_MESH_ENABLED: return sizeof(TYPIFY(CONFIG_MESH_ENABLED));
-		case CS_TYPE::CONFIG_ENCRYPTION_ENABLED: return sizeof(TYPIFY(CONFIG_ENCRYPTION_ENABLED));
-		case CS_TYPE::CONFIG_IBEACON_ENABLED: return sizeof(TYPIFY(CONFIG_IBEACON_ENABLED));
-		case CS_TYPE::CONFIG_SCANNER_ENABLED: return sizeof(TYPIFY(CONFIG_SCANNER_ENABLED));
-		case CS_TYPE::CONFIG_SPHERE_ID: return sizeof(TYPIFY(CONFIG_SPHERE_ID));
-		case CS_TYPE::CONFIG_CROWNSTONE_ID: return sizeof(TYPIFY(CONFIG_CROWNSTONE_ID));
-		case CS_TYPE::CONFIG_KEY_ADMIN: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_KEY_MEMBER: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_KEY_BASIC: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_KEY_SERVICE_DATA: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_MESH_DEVICE_KEY: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_MESH_APP_KEY: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_MESH_NET_KEY: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_KEY_LOCALIZATION: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::CONFIG_SCAN_INTERVAL_625US: return sizeof(TYPIFY(CONFIG_SCAN_INTERVAL_625US));
-		case CS_TYPE::CONFIG_SCAN_WINDOW_625US: return sizeof(TYPIFY(CONFIG_SCAN_WINDOW_625US));
-		case CS_TYPE::CONFIG_RELAY_HIGH_DURATION: return sizeof(TYPIFY(CONFIG_RELAY_HIGH_DURATION));
-		case CS_TYPE::CONFIG_LOW_TX_POWER: return sizeof(TYPIFY(CONFIG_LOW_TX_POWER));
-		case CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER: return sizeof(TYPIFY(CONFIG_VOLTAGE_MULTIPLIER));
-		case CS_TYPE::CONFIG_CURRENT_MULTIPLIER: return sizeof(TYPIFY(CONFIG_CURRENT_MULTIPLIER));
-		case CS_TYPE::CONFIG_VOLTAGE_ADC_ZERO: return sizeof(TYPIFY(CONFIG_VOLTAGE_ADC_ZERO));
-		case CS_TYPE::CONFIG_CURRENT_ADC_ZERO: return sizeof(TYPIFY(CONFIG_CURRENT_ADC_ZERO));
-		case CS_TYPE::CONFIG_POWER_ZERO: return sizeof(TYPIFY(CONFIG_POWER_ZERO));
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD: return sizeof(TYPIFY(CONFIG_SOFT_FUSE_CURRENT_THRESHOLD));
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER:
-			return sizeof(TYPIFY(CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER));
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP: return sizeof(TYPIFY(CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP));
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN:
-			return sizeof(TYPIFY(CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN));
-		case CS_TYPE::CONFIG_DIMMING_ALLOWED: return sizeof(TYPIFY(CONFIG_DIMMING_ALLOWED));
-		case CS_TYPE::CONFIG_START_DIMMER_ON_ZERO_CROSSING: return sizeof(TYPIFY(CONFIG_START_DIMMER_ON_ZERO_CROSSING));
-		case CS_TYPE::CONFIG_SWITCH_LOCKED: return sizeof(TYPIFY(CONFIG_SWITCH_LOCKED));
-		case CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED: return sizeof(TYPIFY(CONFIG_SWITCHCRAFT_ENABLED));
-		case CS_TYPE::CONFIG_SWITCHCRAFT_THRESHOLD: return sizeof(TYPIFY(CONFIG_SWITCHCRAFT_THRESHOLD));
-		case CS_TYPE::STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED: return sizeof(TYPIFY(STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED));
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED: return sizeof(TYPIFY(CONFIG_TAP_TO_TOGGLE_ENABLED));
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET:
-			return sizeof(TYPIFY(CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET));
-		case CS_TYPE::CONFIG_UART_ENABLED: return sizeof(TYPIFY(CONFIG_UART_ENABLED));
-		case CS_TYPE::STATE_BEHAVIOUR_RULE: return WireFormat::size<SwitchBehaviour>();
-		case CS_TYPE::STATE_TWILIGHT_RULE: return WireFormat::size<TwilightBehaviour>();
-		case CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE: return WireFormat::size<ExtendedSwitchBehaviour>();
-		case CS_TYPE::STATE_BEHAVIOUR_SETTINGS: return sizeof(TYPIFY(STATE_BEHAVIOUR_SETTINGS));
-		case CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH: return sizeof(TYPIFY(STATE_BEHAVIOUR_MASTER_HASH));
-		case CS_TYPE::STATE_RESET_COUNTER: return sizeof(TYPIFY(STATE_RESET_COUNTER));
-		case CS_TYPE::STATE_SWITCH_STATE: return sizeof(TYPIFY(STATE_SWITCH_STATE));
-		case CS_TYPE::STATE_ACCUMULATED_ENERGY: return sizeof(TYPIFY(STATE_ACCUMULATED_ENERGY));
-		case CS_TYPE::STATE_POWER_USAGE: return sizeof(TYPIFY(STATE_POWER_USAGE));
-		case CS_TYPE::STATE_OPERATION_MODE: return sizeof(TYPIFY(STATE_OPERATION_MODE));
-		case CS_TYPE::STATE_TEMPERATURE: return sizeof(TYPIFY(STATE_TEMPERATURE));
-		case CS_TYPE::STATE_SUN_TIME: return sizeof(TYPIFY(STATE_SUN_TIME));
-		case CS_TYPE::STATE_FACTORY_RESET: return sizeof(TYPIFY(STATE_FACTORY_RESET));
-		case CS_TYPE::STATE_ERRORS: return sizeof(TYPIFY(STATE_ERRORS));
-		case CS_TYPE::STATE_MESH_IV_INDEX: return sizeof(TYPIFY(STATE_MESH_IV_INDEX));
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER: return sizeof(TYPIFY(STATE_MESH_SEQ_NUMBER));
-		case CS_TYPE::STATE_MESH_IV_INDEX_V5: return sizeof(TYPIFY(STATE_MESH_IV_INDEX_V5));
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER_V5: return sizeof(TYPIFY(STATE_MESH_SEQ_NUMBER_V5));
-		case CS_TYPE::STATE_IBEACON_CONFIG_ID: return sizeof(TYPIFY(STATE_IBEACON_CONFIG_ID));
-		case CS_TYPE::STATE_MICROAPP: return sizeof(TYPIFY(STATE_MICROAPP));
-		case CS_TYPE::STATE_SOFT_ON_SPEED: return sizeof(TYPIFY(STATE_SOFT_ON_SPEED));
-		case CS_TYPE::STATE_DEFAULT_DIM_VALUE: return sizeof(TYPIFY(STATE_DEFAULT_DIM_VALUE));
-		case CS_TYPE::STATE_HUB_MODE: return sizeof(TYPIFY(STATE_HUB_MODE));
-		case CS_TYPE::STATE_UART_KEY: return ENCRYPTION_KEY_LENGTH;
-		case CS_TYPE::STATE_ASSET_FILTERS_VERSION: return sizeof(TYPIFY(STATE_ASSET_FILTERS_VERSION));
-		case CS_TYPE::STATE_ASSET_FILTER_32: return 32;
-		case CS_TYPE::STATE_ASSET_FILTER_64: return 64;
-		case CS_TYPE::STATE_ASSET_FILTER_128: return 128;
-		case CS_TYPE::STATE_ASSET_FILTER_256: return 256;
-		case CS_TYPE::STATE_ASSET_FILTER_512: return 512;
-		case CS_TYPE::CMD_SWITCH_OFF: return 0;
-		case CS_TYPE::CMD_SWITCH_ON: return 0;
-		case CS_TYPE::CMD_SWITCH_TOGGLE: return 0;
-		case CS_TYPE::CMD_SWITCH: return sizeof(TYPIFY(CMD_SWITCH));
-		case CS_TYPE::CMD_MULTI_SWITCH: return sizeof(TYPIFY(CMD_MULTI_SWITCH));
-		case CS_TYPE::EVT_ADV_BACKGROUND: return sizeof(TYPIFY(EVT_ADV_BACKGROUND));
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED: return sizeof(TYPIFY(EVT_ADV_BACKGROUND_PARSED));
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED_V1: return sizeof(TYPIFY(EVT_ADV_BACKGROUND_PARSED_V1));
-		case CS_TYPE::EVT_ADVERTISEMENT_UPDATED: return 0;
-		case CS_TYPE::EVT_SCAN_STARTED: return 0;
-		case CS_TYPE::EVT_SCAN_STOPPED: return 0;
-		case CS_TYPE::EVT_DEVICE_SCANNED: return sizeof(TYPIFY(EVT_DEVICE_SCANNED));
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER: return 0;
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD: return 0;
-		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED: return 0;
-		case CS_TYPE::EVT_DIMMER_OFF_FAILURE_DETECTED: return 0;
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_REGISTER: return sizeof(TYPIFY(EVT_MESH_TRACKED_DEVICE_REGISTER));
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER:
-			return sizeof(TYPIFY(CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER));
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_TOKEN: return sizeof(TYPIFY(EVT_MESH_TRACKED_DEVICE_TOKEN));
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN:
-			return sizeof(TYPIFY(CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN));
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_HEARTBEAT: return sizeof(TYPIFY(EVT_MESH_TRACKED_DEVICE_HEARTBEAT));
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT:
-			return sizeof(TYPIFY(CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT));
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_LIST_SIZE: return sizeof(TYPIFY(EVT_MESH_TRACKED_DEVICE_LIST_SIZE));
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE:
-			return sizeof(TYPIFY(CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE));
-		case CS_TYPE::CMD_SEND_MESH_CONTROL_COMMAND: return sizeof(TYPIFY(CMD_SEND_MESH_CONTROL_COMMAND));
-		case CS_TYPE::CMD_BLE_CENTRAL_CONNECT: return sizeof(TYPIFY(CMD_BLE_CENTRAL_CONNECT));
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCONNECT: return 0;
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCOVER: return sizeof(TYPIFY(CMD_BLE_CENTRAL_DISCOVER));
-		case CS_TYPE::CMD_BLE_CENTRAL_READ: return sizeof(TYPIFY(CMD_BLE_CENTRAL_READ));
-		case CS_TYPE::CMD_BLE_CENTRAL_WRITE: return sizeof(TYPIFY(CMD_BLE_CENTRAL_WRITE));
-		case CS_TYPE::EVT_BLE_CONNECT: return sizeof(TYPIFY(EVT_BLE_CONNECT));
-		case CS_TYPE::EVT_BLE_DISCONNECT: return sizeof(TYPIFY(EVT_BLE_DISCONNECT));
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST: return 0;
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY: return 0;
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_RESULT: return sizeof(TYPIFY(EVT_BLE_CENTRAL_CONNECT_RESULT));
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCONNECTED: return 0;
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY: return sizeof(TYPIFY(EVT_BLE_CENTRAL_DISCOVERY));
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY_RESULT: return sizeof(TYPIFY(EVT_BLE_CENTRAL_DISCOVERY_RESULT));
-		case CS_TYPE::EVT_BLE_CENTRAL_READ_RESULT: return sizeof(TYPIFY(EVT_BLE_CENTRAL_READ_RESULT));
-		case CS_TYPE::EVT_BLE_CENTRAL_WRITE_RESULT: return sizeof(TYPIFY(EVT_BLE_CENTRAL_WRITE_RESULT));
-		case CS_TYPE::EVT_BLE_CENTRAL_NOTIFICATION: return sizeof(TYPIFY(EVT_BLE_CENTRAL_NOTIFICATION));
-		case CS_TYPE::CMD_CS_CENTRAL_CONNECT: return sizeof(TYPIFY(CMD_CS_CENTRAL_CONNECT));
-		case CS_TYPE::CMD_CS_CENTRAL_DISCONNECT: return 0;
-		case CS_TYPE::CMD_CS_CENTRAL_WRITE: return sizeof(TYPIFY(CMD_CS_CENTRAL_WRITE));
-		case CS_TYPE::CMD_CS_CENTRAL_GET_WRITE_BUF: return 0;
-		case CS_TYPE::EVT_CS_CENTRAL_CONNECT_RESULT: return sizeof(TYPIFY(EVT_CS_CENTRAL_CONNECT_RESULT));
-		case CS_TYPE::EVT_CS_CENTRAL_READ_RESULT: return sizeof(TYPIFY(EVT_CS_CENTRAL_READ_RESULT));
-		case CS_TYPE::EVT_CS_CENTRAL_WRITE_RESULT: return sizeof(TYPIFY(EVT_CS_CENTRAL_WRITE_RESULT));
-		case CS_TYPE::EVT_BROWNOUT_IMPENDING: return 0;
-		case CS_TYPE::EVT_SESSION_DATA_SET: return sizeof(TYPIFY(EVT_SESSION_DATA_SET));
-		case CS_TYPE::EVT_DIMMER_FORCED_OFF: return 0;
-		case CS_TYPE::EVT_SWITCH_FORCED_OFF: return 0;
-		case CS_TYPE::EVT_RELAY_FORCED_ON: return 0;
-		case CS_TYPE::EVT_CHIP_TEMP_ABOVE_THRESHOLD: return 0;
-		case CS_TYPE::EVT_CHIP_TEMP_OK: return 0;
-		case CS_TYPE::EVT_DIMMER_TEMP_ABOVE_THRESHOLD: return 0;
-		case CS_TYPE::EVT_DIMMER_TEMP_OK: return 0;
-		case CS_TYPE::EVT_TICK: return sizeof(uint32_t);
-		case CS_TYPE::EVT_TIME_SET: return sizeof(uint32_t);
-		case CS_TYPE::EVT_DIMMER_POWERED: return sizeof(TYPIFY(EVT_DIMMER_POWERED));
-		case CS_TYPE::CMD_DIMMING_ALLOWED: return sizeof(TYPIFY(CMD_DIMMING_ALLOWED));
-		case CS_TYPE::CMD_LOCK_SWITCH: return sizeof(TYPIFY(CMD_LOCK_SWITCH));
-		case CS_TYPE::EVT_STATE_EXTERNAL_STONE: return sizeof(TYPIFY(EVT_STATE_EXTERNAL_STONE));
-		case CS_TYPE::EVT_STATE_FACTORY_RESET_DONE: return 0;
-		case CS_TYPE::EVT_STORAGE_INITIALIZED: return 0;
-		case CS_TYPE::EVT_STORAGE_WRITE_DONE: return sizeof(TYPIFY(EVT_STORAGE_WRITE_DONE));
-		case CS_TYPE::EVT_STORAGE_REMOVE_DONE: return sizeof(TYPIFY(EVT_STORAGE_REMOVE_DONE));
-		case CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE:
-			return sizeof(TYPIFY(EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE));
-		case CS_TYPE::EVT_STORAGE_GC_DONE: return 0;
-		case CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE: return 0;
-		case CS_TYPE::EVT_STORAGE_PAGES_ERASED: return 0;
-		case CS_TYPE::EVT_MESH_FACTORY_RESET_DONE: return 0;
-		case CS_TYPE::CMD_STORAGE_GARBAGE_COLLECT: return 0;
-		case CS_TYPE::EVT_ADC_RESTARTED: return 0;
-		case CS_TYPE::CMD_ENABLE_LOG_POWER: return sizeof(TYPIFY(CMD_ENABLE_LOG_POWER));
-		case CS_TYPE::CMD_ENABLE_LOG_CURRENT: return sizeof(TYPIFY(CMD_ENABLE_LOG_CURRENT));
-		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE: return sizeof(TYPIFY(CMD_ENABLE_LOG_VOLTAGE));
-		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT: return sizeof(TYPIFY(CMD_ENABLE_LOG_FILTERED_CURRENT));
-		case CS_TYPE::CMD_RESET_DELAYED: return sizeof(TYPIFY(CMD_RESET_DELAYED));
-		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT: return sizeof(TYPIFY(CMD_ENABLE_ADVERTISEMENT));
-		case CS_TYPE::CMD_ENABLE_MESH: return sizeof(TYPIFY(CMD_ENABLE_MESH));
-		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN: return 0;
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT: return sizeof(TYPIFY(CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT));
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE: return sizeof(TYPIFY(CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE));
-		case CS_TYPE::CMD_INC_VOLTAGE_RANGE: return 0;
-		case CS_TYPE::CMD_DEC_VOLTAGE_RANGE: return 0;
-		case CS_TYPE::CMD_INC_CURRENT_RANGE: return 0;
-		case CS_TYPE::CMD_DEC_CURRENT_RANGE: return 0;
-		case CS_TYPE::CMD_CONTROL_CMD: return sizeof(TYPIFY(CMD_CONTROL_CMD));
-		case CS_TYPE::CMD_SEND_MESH_MSG: return sizeof(TYPIFY(CMD_SEND_MESH_MSG));
-		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH: return sizeof(TYPIFY(CMD_SEND_MESH_MSG_MULTI_SWITCH));
-		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION: return sizeof(TYPIFY(CMD_SEND_MESH_MSG_PROFILE_LOCATION));
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
-			return sizeof(TYPIFY(CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS));
-		case CS_TYPE::CMD_SET_TIME: return sizeof(TYPIFY(CMD_SET_TIME));
-		case CS_TYPE::CMD_FACTORY_RESET: return 0;
-		case CS_TYPE::CMD_ADD_BEHAVIOUR: return sizeof(TYPIFY(CMD_ADD_BEHAVIOUR));
-		case CS_TYPE::CMD_REPLACE_BEHAVIOUR: return sizeof(TYPIFY(CMD_REPLACE_BEHAVIOUR));
-		case CS_TYPE::CMD_REMOVE_BEHAVIOUR: return sizeof(TYPIFY(CMD_REMOVE_BEHAVIOUR));
-		case CS_TYPE::CMD_GET_BEHAVIOUR: return sizeof(TYPIFY(CMD_GET_BEHAVIOUR));
-		case CS_TYPE::CMD_GET_BEHAVIOUR_INDICES: return 0;
-		case CS_TYPE::CMD_GET_BEHAVIOUR_DEBUG: return 0;
-		case CS_TYPE::CMD_CLEAR_ALL_BEHAVIOUR: return 0;
-		case CS_TYPE::EVT_BEHAVIOURSTORE_MUTATION: return sizeof(TYPIFY(EVT_BEHAVIOURSTORE_MUTATION));
-		case CS_TYPE::EVT_BEHAVIOUR_OVERRIDDEN: return sizeof(TYPIFY(EVT_BEHAVIOUR_OVERRIDDEN));
-		case CS_TYPE::CMD_REGISTER_TRACKED_DEVICE: return sizeof(TYPIFY(CMD_REGISTER_TRACKED_DEVICE));
-		case CS_TYPE::CMD_UPDATE_TRACKED_DEVICE: return sizeof(TYPIFY(CMD_UPDATE_TRACKED_DEVICE));
-		case CS_TYPE::CMD_TRACKED_DEVICE_HEARTBEAT: return sizeof(TYPIFY(CMD_TRACKED_DEVICE_HEARTBEAT));
-		case CS_TYPE::EVT_PRESENCE_MUTATION: return sizeof(TYPIFY(EVT_PRESENCE_MUTATION));
-		case CS_TYPE::EVT_PRESENCE_CHANGE: return sizeof(TYPIFY(EVT_PRESENCE_CHANGE));
-		case CS_TYPE::CMD_GET_PRESENCE: return 0;
-		case CS_TYPE::CMD_SET_RELAY: return sizeof(TYPIFY(CMD_SET_RELAY));
-		case CS_TYPE::CMD_SET_DIMMER: return sizeof(TYPIFY(CMD_SET_DIMMER));
-		case CS_TYPE::EVT_GOING_TO_DFU: return 0;
-		case CS_TYPE::EVT_RECEIVED_PROFILE_LOCATION: return sizeof(TYPIFY(EVT_RECEIVED_PROFILE_LOCATION));
-		case CS_TYPE::CMD_UPLOAD_FILTER: return sizeof(asset_filter_cmd_upload_filter_t);
-		case CS_TYPE::CMD_REMOVE_FILTER: return sizeof(asset_filter_cmd_remove_filter_t);
-		case CS_TYPE::CMD_COMMIT_FILTER_CHANGES: return sizeof(asset_filter_cmd_commit_filter_changes_t);
-		case CS_TYPE::CMD_GET_FILTER_SUMMARIES: return 0;
-		case CS_TYPE::EVT_FILTERS_UPDATED: return 0;
-		case CS_TYPE::EVT_FILTER_MODIFICATION: return sizeof(TYPIFY(EVT_FILTER_MODIFICATION));
-		case CS_TYPE::EVT_ASSET_ACCEPTED: return sizeof(TYPIFY(EVT_ASSET_ACCEPTED));
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_OUTGOING: return sizeof(TYPIFY(EVT_MESH_SYNC_REQUEST_OUTGOING));
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_INCOMING: return sizeof(TYPIFY(EVT_MESH_SYNC_REQUEST_INCOMING));
-		case CS_TYPE::EVT_MESH_SYNC_FAILED: return 0;
-		case CS_TYPE::EVT_MESH_PAGES_ERASED: return 0;
-		case CS_TYPE::EVT_MESH_EXT_STATE_0: return sizeof(TYPIFY(EVT_MESH_EXT_STATE_0));
-		case CS_TYPE::EVT_MESH_EXT_STATE_1: return sizeof(TYPIFY(EVT_MESH_EXT_STATE_1));
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_TIME: return sizeof(TYPIFY(CMD_SEND_MESH_MSG_SET_TIME));
-		case CS_TYPE::CMD_SET_IBEACON_CONFIG_ID: return sizeof(TYPIFY(CMD_SET_IBEACON_CONFIG_ID));
-		case CS_TYPE::CMD_SEND_MESH_MSG_NOOP: return 0;
-		case CS_TYPE::EVT_MESH_RSSI_PING: return sizeof(TYPIFY(EVT_MESH_RSSI_PING));
-		case CS_TYPE::EVT_MESH_RSSI_DATA: return sizeof(TYPIFY(EVT_MESH_RSSI_DATA));
-		case CS_TYPE::EVT_MESH_TIME_SYNC: return sizeof(TYPIFY(EVT_MESH_TIME_SYNC));
-		case CS_TYPE::EVT_RECV_MESH_MSG: return sizeof(TYPIFY(EVT_RECV_MESH_MSG));
-		case CS_TYPE::CMD_GET_ADC_RESTARTS: return 0;
-		case CS_TYPE::CMD_GET_SWITCH_HISTORY: return 0;
-		case CS_TYPE::CMD_GET_POWER_SAMPLES: return sizeof(TYPIFY(CMD_GET_POWER_SAMPLES));
-		case CS_TYPE::CMD_GET_SCHEDULER_MIN_FREE: return 0;
-		case CS_TYPE::CMD_GET_RESET_REASON: return 0;
-		case CS_TYPE::CMD_GET_GPREGRET: return sizeof(TYPIFY(CMD_GET_GPREGRET));
-		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS: return 0;
-		case CS_TYPE::CMD_GET_RAM_STATS: return 0;
-		case CS_TYPE::EVT_GENERIC_TEST: return 0;
-		case CS_TYPE::CMD_TEST_SET_TIME: return sizeof(TYPIFY(CMD_TEST_SET_TIME));
-		case CS_TYPE::CMD_MICROAPP_GET_INFO: return 0;
-		case CS_TYPE::CMD_MICROAPP_UPLOAD: return sizeof(TYPIFY(CMD_MICROAPP_UPLOAD));
-		case CS_TYPE::CMD_MICROAPP_VALIDATE: return sizeof(TYPIFY(CMD_MICROAPP_VALIDATE));
-		case CS_TYPE::CMD_MICROAPP_REMOVE: return sizeof(TYPIFY(CMD_MICROAPP_REMOVE));
-		case CS_TYPE::CMD_MICROAPP_ENABLE: return sizeof(TYPIFY(CMD_MICROAPP_ENABLE));
-		case CS_TYPE::CMD_MICROAPP_DISABLE: return sizeof(TYPIFY(CMD_MICROAPP_DISABLE));
-		case CS_TYPE::CMD_MICROAPP_MESSAGE: return sizeof(TYPIFY(CMD_MICROAPP_MESSAGE));
-		case CS_TYPE::CMD_MICROAPP_ADVERTISE: return sizeof(TYPIFY(CMD_MICROAPP_ADVERTISE));
-		case CS_TYPE::EVT_MICROAPP_FACTORY_RESET_DONE: return 0;
-		case CS_TYPE::CMD_MESH_TOPO_GET_MAC: return sizeof(TYPIFY(CMD_MESH_TOPO_GET_MAC));
-		case CS_TYPE::EVT_MESH_TOPO_MAC_RESULT: return sizeof(TYPIFY(EVT_MESH_TOPO_MAC_RESULT));
-		case CS_TYPE::CMD_MESH_TOPO_RESET: return 0;
-		case CS_TYPE::CMD_MESH_TOPO_GET_RSSI: return sizeof(TYPIFY(CMD_MESH_TOPO_GET_RSSI));
-		case CS_TYPE::EVT_TWI_INIT: return sizeof(TYPIFY(EVT_TWI_INIT));
-		case CS_TYPE::EVT_TWI_WRITE: return sizeof(TYPIFY(EVT_TWI_WRITE));
-		case CS_TYPE::EVT_TWI_READ: return sizeof(TYPIFY(EVT_TWI_READ));
-		case CS_TYPE::EVT_TWI_UPDATE: return sizeof(TYPIFY(EVT_TWI_UPDATE));
-		case CS_TYPE::EVT_GPIO_INIT: return sizeof(TYPIFY(EVT_GPIO_INIT));
-		case CS_TYPE::EVT_GPIO_WRITE: return sizeof(TYPIFY(EVT_GPIO_WRITE));
-		case CS_TYPE::EVT_GPIO_READ: return sizeof(TYPIFY(EVT_GPIO_READ));
-		case CS_TYPE::EVT_GPIO_UPDATE: return sizeof(TYPIFY(EVT_GPIO_UPDATE));
-		case CS_TYPE::CMD_RESOLVE_ASYNC_CONTROL_COMMAND: return sizeof(TYPIFY(CMD_RESOLVE_ASYNC_CONTROL_COMMAND));
-		case CS_TYPE::CMD_SEND_ASYNC_RESULT_TO_BLE: return sizeof(TYPIFY(CMD_SEND_ASYNC_RESULT_TO_BLE));
-	}  // end switch
+/**
+ * Index in typeInfo for each slot.
+ */
+struct type_index_t {
+	uint8_t index[SLOT_COUNT];
+};
 
-	// should never happen
-	return 0;
+constexpr type_index_t buildTypeIndex() {
+	type_index_t result = {};
+	for (uint16_t slot = 0; slot < SLOT_COUNT; ++slot) {
+		result.index[slot] = INVALID_INDEX;
+	}
+	for (uint16_t i = 0; i < TYPE_INFO_COUNT; ++i) {
+		result.index[getSlot(typeInfo[i].type)] = i;
+	}
+	return result;
+}
+
+constexpr bool allTypesHaveUniqueSlot() {
+	type_index_t typeIndex = buildTypeIndex();
+	for (uint16_t i = 0; i < TYPE_INFO_COUNT; ++i) {
+		uint16_t slot = getSlot(typeInfo[i].type);
+		if (slot == INVALID_SLOT || typeIndex.index[slot] != i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static_assert(allTypesHaveUniqueSlot(), "Type values in cs_TypeList.h should be unique, and map to a slot");
+
+constexpr type_index_t typeIndex = buildTypeIndex();
+
+/**
+ * Get the properties of a type.
+ *
+ * @return Pointer to the properties, or nullptr when the type does not exist.
+ */
+const type_info_t* getTypeInfo(uint16_t type) {
+	uint16_t slot = getSlot(type);
+	if (slot == INVALID_SLOT) {
+		return nullptr;
+	}
+	uint8_t index = typeIndex.index[slot];
+	if (index == INVALID_INDEX) {
+		return nullptr;
+	}
+	return &typeInfo[index];
+}
+
+}  // namespace
+
+CS_TYPE toCsType(uint16_t type) {
+	if (getTypeInfo(type) == nullptr) {
+		return CS_TYPE::CONFIG_DO_NOT_USE;
+	}
+	return static_cast<CS_TYPE>(type);
+}
+
+size16_t TypeSize(CS_TYPE const& type) {
+	const type_info_t* info = getTypeInfo(to_underlying_type(type));
+	if (info == nullptr) {
+		// should never happen
+		return 0;
+	}
+	return info->size;
 }
 
 bool hasMultipleIds(CS_TYPE const& type) {
-	switch (type) {
-		case CS_TYPE::CONFIG_NAME:
-		case CS_TYPE::CONFIG_PWM_PERIOD:
-		case CS_TYPE::CONFIG_TX_POWER:
-		case CS_TYPE::CONFIG_ADV_INTERVAL:
-		case CS_TYPE::CONFIG_SCAN_DURATION:
-		case CS_TYPE::CONFIG_SCAN_BREAK_DURATION:
-		case CS_TYPE::CONFIG_BOOT_DELAY:
-		case CS_TYPE::CONFIG_MAX_CHIP_TEMP:
-		case CS_TYPE::CONFIG_CURRENT_LIMIT:
-		case CS_TYPE::CONFIG_MESH_ENABLED:
-		case CS_TYPE::CONFIG_ENCRYPTION_ENABLED:
-		case CS_TYPE::CONFIG_IBEACON_ENABLED:
-		case CS_TYPE::CONFIG_SCANNER_ENABLED:
-		case CS_TYPE::CONFIG_SPHERE_ID:
-		case CS_TYPE::CONFIG_CROWNSTONE_ID:
-		case CS_TYPE::CONFIG_KEY_ADMIN:
-		case CS_TYPE::CONFIG_KEY_MEMBER:
-		case CS_TYPE::CONFIG_KEY_BASIC:
-		case CS_TYPE::CONFIG_KEY_SERVICE_DATA:
-		case CS_TYPE::CONFIG_MESH_DEVICE_KEY:
-		case CS_TYPE::CONFIG_MESH_APP_KEY:
-		case CS_TYPE::CONFIG_MESH_NET_KEY:
-		case CS_TYPE::CONFIG_KEY_LOCALIZATION:
-		case CS_TYPE::CONFIG_SCAN_INTERVAL_625US:
-		case CS_TYPE::CONFIG_SCAN_WINDOW_625US:
-		case CS_TYPE::CONFIG_RELAY_HIGH_DURATION:
-		case CS_TYPE::CONFIG_LOW_TX_POWER:
-		case CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER:
-		case CS_TYPE::CONFIG_CURRENT_MULTIPLIER:
-		case CS_TYPE::CONFIG_VOLTAGE_ADC_ZERO:
-		case CS_TYPE::CONFIG_CURRENT_ADC_ZERO:
-		case CS_TYPE::CONFIG_POWER_ZERO:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN:
-		case CS_TYPE::CONFIG_DIMMING_ALLOWED:
-		case CS_TYPE::CONFIG_START_DIMMER_ON_ZERO_CROSSING:
-		case CS_TYPE::CONFIG_SWITCH_LOCKED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_THRESHOLD:
-		case CS_TYPE::STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET:
-		case CS_TYPE::CONFIG_UART_ENABLED:
-		case CS_TYPE::STATE_OPERATION_MODE:
-		case CS_TYPE::STATE_SWITCH_STATE:
-		case CS_TYPE::STATE_RESET_COUNTER:
-		case CS_TYPE::CONFIG_DO_NOT_USE:
-		case CS_TYPE::STATE_ACCUMULATED_ENERGY:
-		case CS_TYPE::STATE_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH:
-		case CS_TYPE::STATE_POWER_USAGE:
-		case CS_TYPE::STATE_TEMPERATURE:
-		case CS_TYPE::STATE_SUN_TIME:
-		case CS_TYPE::STATE_FACTORY_RESET:
-		case CS_TYPE::STATE_MESH_IV_INDEX:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER:
-		case CS_TYPE::STATE_MESH_IV_INDEX_V5:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER_V5:
-		case CS_TYPE::STATE_ERRORS:
-		case CS_TYPE::STATE_SOFT_ON_SPEED:
-		case CS_TYPE::STATE_DEFAULT_DIM_VALUE:
-		case CS_TYPE::STATE_HUB_MODE:
-		case CS_TYPE::STATE_ASSET_FILTERS_VERSION:
-		case CS_TYPE::CMD_SWITCH_OFF:
-		case CS_TYPE::CMD_SWITCH_ON:
-		case CS_TYPE::CMD_SWITCH_TOGGLE:
-		case CS_TYPE::CMD_SWITCH:
-		case CS_TYPE::CMD_MULTI_SWITCH:
-		case CS_TYPE::EVT_ADV_BACKGROUND:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED_V1:
-		case CS_TYPE::EVT_ADVERTISEMENT_UPDATED:
-		case CS_TYPE::EVT_SCAN_STARTED:
-		case CS_TYPE::EVT_SCAN_STOPPED:
-		case CS_TYPE::EVT_DEVICE_SCANNED:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_OFF_FAILURE_DETECTED:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_CONTROL_COMMAND:
-		case CS_TYPE::CMD_BLE_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCOVER:
-		case CS_TYPE::CMD_BLE_CENTRAL_READ:
-		case CS_TYPE::CMD_BLE_CENTRAL_WRITE:
-		case CS_TYPE::EVT_BLE_CONNECT:
-		case CS_TYPE::EVT_BLE_DISCONNECT:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCONNECTED:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_NOTIFICATION:
-		case CS_TYPE::CMD_CS_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_WRITE:
-		case CS_TYPE::CMD_CS_CENTRAL_GET_WRITE_BUF:
-		case CS_TYPE::EVT_CS_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BROWNOUT_IMPENDING:
-		case CS_TYPE::EVT_SESSION_DATA_SET:
-		case CS_TYPE::EVT_DIMMER_FORCED_OFF:
-		case CS_TYPE::EVT_SWITCH_FORCED_OFF:
-		case CS_TYPE::EVT_RELAY_FORCED_ON:
-		case CS_TYPE::EVT_CHIP_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_CHIP_TEMP_OK:
-		case CS_TYPE::EVT_DIMMER_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_TEMP_OK:
-		case CS_TYPE::EVT_TICK:
-		case CS_TYPE::EVT_TIME_SET:
-		case CS_TYPE::EVT_DIMMER_POWERED:
-		case CS_TYPE::CMD_DIMMING_ALLOWED:
-		case CS_TYPE::CMD_LOCK_SWITCH:
-		case CS_TYPE::EVT_STATE_EXTERNAL_STONE:
-		case CS_TYPE::EVT_STATE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_INITIALIZED:
-		case CS_TYPE::EVT_STORAGE_WRITE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE:
-		case CS_TYPE::EVT_STORAGE_GC_DONE:
-		case CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_STORAGE_GARBAGE_COLLECT:
-		case CS_TYPE::EVT_ADC_RESTARTED:
-		case CS_TYPE::CMD_ENABLE_LOG_POWER:
-		case CS_TYPE::CMD_ENABLE_LOG_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
-		case CS_TYPE::CMD_RESET_DELAYED:
-		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT:
-		case CS_TYPE::CMD_ENABLE_MESH:
-		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE:
-		case CS_TYPE::CMD_INC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_DEC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_INC_CURRENT_RANGE:
-		case CS_TYPE::CMD_DEC_CURRENT_RANGE:
-		case CS_TYPE::CMD_CONTROL_CMD:
-		case CS_TYPE::CMD_SEND_MESH_MSG:
-		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH:
-		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::CMD_SET_TIME:
-		case CS_TYPE::CMD_FACTORY_RESET:
-		case CS_TYPE::CMD_ADD_BEHAVIOUR:
-		case CS_TYPE::CMD_REPLACE_BEHAVIOUR:
-		case CS_TYPE::CMD_REMOVE_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_INDICES:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_DEBUG:
-		case CS_TYPE::CMD_CLEAR_ALL_BEHAVIOUR:
-		case CS_TYPE::EVT_BEHAVIOURSTORE_MUTATION:
-		case CS_TYPE::EVT_BEHAVIOUR_OVERRIDDEN:
-		case CS_TYPE::CMD_REGISTER_TRACKED_DEVICE:
-		case CS_TYPE::CMD_UPDATE_TRACKED_DEVICE:
-		case CS_TYPE::CMD_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_PRESENCE_MUTATION:
-		case CS_TYPE::EVT_PRESENCE_CHANGE:
-		case CS_TYPE::CMD_GET_PRESENCE:
-		case CS_TYPE::CMD_SET_RELAY:
-		case CS_TYPE::CMD_SET_DIMMER:
-		case CS_TYPE::EVT_GOING_TO_DFU:
-		case CS_TYPE::EVT_RECEIVED_PROFILE_LOCATION:
-		case CS_TYPE::CMD_UPLOAD_FILTER:
-		case CS_TYPE::CMD_REMOVE_FILTER:
-		case CS_TYPE::CMD_COMMIT_FILTER_CHANGES:
-		case CS_TYPE::CMD_GET_FILTER_SUMMARIES:
-		case CS_TYPE::EVT_FILTERS_UPDATED:
-		case CS_TYPE::EVT_FILTER_MODIFICATION:
-		case CS_TYPE::EVT_ASSET_ACCEPTED:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_OUTGOING:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_INCOMING:
-		case CS_TYPE::EVT_MESH_SYNC_FAILED:
-		case CS_TYPE::EVT_MESH_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_EXT_STATE_0:
-		case CS_TYPE::EVT_MESH_EXT_STATE_1:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_TIME:
-		case CS_TYPE::CMD_SET_IBEACON_CONFIG_ID:
-		case CS_TYPE::CMD_SEND_MESH_MSG_NOOP:
-		case CS_TYPE::EVT_MESH_RSSI_PING:
-		case CS_TYPE::EVT_MESH_RSSI_DATA:
-		case CS_TYPE::EVT_MESH_TIME_SYNC:
-		case CS_TYPE::EVT_RECV_MESH_MSG:
-		case CS_TYPE::CMD_GET_ADC_RESTARTS:
-		case CS_TYPE::CMD_GET_SWITCH_HISTORY:
-		case CS_TYPE::CMD_GET_POWER_SAMPLES:
-		case CS_TYPE::CMD_GET_SCHEDULER_MIN_FREE:
-		case CS_TYPE::CMD_GET_RESET_REASON:
-		case CS_TYPE::CMD_GET_GPREGRET:
-		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
-		case CS_TYPE::CMD_GET_RAM_STATS:
-		case CS_TYPE::EVT_GENERIC_TEST:
-		case CS_TYPE::CMD_TEST_SET_TIME:
-		case CS_TYPE::CMD_MICROAPP_GET_INFO:
-		case CS_TYPE::CMD_MICROAPP_UPLOAD:
-		case CS_TYPE::CMD_MICROAPP_VALIDATE:
-		case CS_TYPE::CMD_MICROAPP_REMOVE:
-		case CS_TYPE::CMD_MICROAPP_ENABLE:
-		case CS_TYPE::CMD_MICROAPP_DISABLE:
-		case CS_TYPE::CMD_MICROAPP_MESSAGE:
-		case CS_TYPE::CMD_MICROAPP_ADVERTISE:
-		case CS_TYPE::EVT_MICROAPP_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_MESH_TOPO_GET_MAC:
-		case CS_TYPE::EVT_MESH_TOPO_MAC_RESULT:
-		case CS_TYPE::CMD_MESH_TOPO_RESET:
-		case CS_TYPE::CMD_MESH_TOPO_GET_RSSI:
-		case CS_TYPE::EVT_TWI_INIT:
-		case CS_TYPE::EVT_TWI_WRITE:
-		case CS_TYPE::EVT_TWI_READ:
-		case CS_TYPE::EVT_TWI_UPDATE:
-		case CS_TYPE::EVT_GPIO_INIT:
-		case CS_TYPE::EVT_GPIO_WRITE:
-		case CS_TYPE::EVT_GPIO_READ:
-		case CS_TYPE::EVT_GPIO_UPDATE:
-		case CS_TYPE::CMD_RESOLVE_ASYNC_CONTROL_COMMAND:
-		case CS_TYPE::CMD_SEND_ASYNC_RESULT_TO_BLE: return false;
-		case CS_TYPE::STATE_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_TWILIGHT_RULE:
-		case CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE:
-		case CS_TYPE::CONFIG_IBEACON_MAJOR:
-		case CS_TYPE::CONFIG_IBEACON_MINOR:
-		case CS_TYPE::CONFIG_IBEACON_UUID:
-		case CS_TYPE::CONFIG_IBEACON_TXPOWER:
-		case CS_TYPE::STATE_IBEACON_CONFIG_ID:
-		case CS_TYPE::STATE_MICROAPP:
-		case CS_TYPE::STATE_UART_KEY:
-		case CS_TYPE::STATE_ASSET_FILTER_32:
-		case CS_TYPE::STATE_ASSET_FILTER_64:
-		case CS_TYPE::STATE_ASSET_FILTER_128:
-		case CS_TYPE::STATE_ASSET_FILTER_256:
-		case CS_TYPE::STATE_ASSET_FILTER_512: return true;
+	const type_info_t* info = getTypeInfo(to_underlying_type(type));
+	if (info == nullptr) {
+		return false;
 	}
-	// should not reach this
-	return false;
+	return info->multipleIds;
 }
 
 bool removeOnFactoryReset(CS_TYPE const& type, cs_state_id_t id) {
-	switch (type) {
-		case CS_TYPE::STATE_RESET_COUNTER: {
-			return id != 0;
-		}
-		case CS_TYPE::CONFIG_NAME:
-		case CS_TYPE::CONFIG_PWM_PERIOD:
-		case CS_TYPE::CONFIG_IBEACON_MAJOR:
-		case CS_TYPE::CONFIG_IBEACON_MINOR:
-		case CS_TYPE::CONFIG_IBEACON_UUID:
-		case CS_TYPE::CONFIG_IBEACON_TXPOWER:
-		case CS_TYPE::CONFIG_TX_POWER:
-		case CS_TYPE::CONFIG_ADV_INTERVAL:
-		case CS_TYPE::CONFIG_SCAN_DURATION:
-		case CS_TYPE::CONFIG_SCAN_BREAK_DURATION:
-		case CS_TYPE::CONFIG_BOOT_DELAY:
-		case CS_TYPE::CONFIG_MAX_CHIP_TEMP:
-		case CS_TYPE::CONFIG_CURRENT_LIMIT:
-		case CS_TYPE::CONFIG_MESH_ENABLED:
-		case CS_TYPE::CONFIG_ENCRYPTION_ENABLED:
-		case CS_TYPE::CONFIG_IBEACON_ENABLED:
-		case CS_TYPE::CONFIG_SCANNER_ENABLED:
-		case CS_TYPE::CONFIG_SPHERE_ID:
-		case CS_TYPE::CONFIG_CROWNSTONE_ID:
-		case CS_TYPE::CONFIG_KEY_ADMIN:
-		case CS_TYPE::CONFIG_KEY_MEMBER:
-		case CS_TYPE::CONFIG_KEY_BASIC:
-		case CS_TYPE::CONFIG_KEY_SERVICE_DATA:
-		case CS_TYPE::CONFIG_MESH_DEVICE_KEY:
-		case CS_TYPE::CONFIG_MESH_APP_KEY:
-		case CS_TYPE::CONFIG_MESH_NET_KEY:
-		case CS_TYPE::CONFIG_KEY_LOCALIZATION:
-		case CS_TYPE::CONFIG_SCAN_INTERVAL_625US:
-		case CS_TYPE::CONFIG_SCAN_WINDOW_625US:
-		case CS_TYPE::CONFIG_RELAY_HIGH_DURATION:
-		case CS_TYPE::CONFIG_LOW_TX_POWER:
-		case CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER:
-		case CS_TYPE::CONFIG_CURRENT_MULTIPLIER:
-		case CS_TYPE::CONFIG_VOLTAGE_ADC_ZERO:
-		case CS_TYPE::CONFIG_CURRENT_ADC_ZERO:
-		case CS_TYPE::CONFIG_POWER_ZERO:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN:
-		case CS_TYPE::CONFIG_DIMMING_ALLOWED:
-		case CS_TYPE::CONFIG_START_DIMMER_ON_ZERO_CROSSING:
-		case CS_TYPE::CONFIG_SWITCH_LOCKED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_THRESHOLD:
-		case CS_TYPE::STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET:
-		case CS_TYPE::CONFIG_UART_ENABLED:
-		case CS_TYPE::STATE_OPERATION_MODE:
-		case CS_TYPE::STATE_SWITCH_STATE:
-		case CS_TYPE::STATE_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_TWILIGHT_RULE:
-		case CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE:
-		case CS_TYPE::CONFIG_DO_NOT_USE:
-		case CS_TYPE::STATE_ACCUMULATED_ENERGY:
-		case CS_TYPE::STATE_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH:
-		case CS_TYPE::STATE_POWER_USAGE:
-		case CS_TYPE::STATE_TEMPERATURE:
-		case CS_TYPE::STATE_SUN_TIME:
-		case CS_TYPE::STATE_FACTORY_RESET:
-		case CS_TYPE::STATE_ERRORS:
-		case CS_TYPE::STATE_MESH_IV_INDEX:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER:
-		case CS_TYPE::STATE_MESH_IV_INDEX_V5:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER_V5:
-		case CS_TYPE::STATE_IBEACON_CONFIG_ID:
-		case CS_TYPE::STATE_MICROAPP:
-		case CS_TYPE::STATE_SOFT_ON_SPEED:
-		case CS_TYPE::STATE_DEFAULT_DIM_VALUE:
-		case CS_TYPE::STATE_HUB_MODE:
-		case CS_TYPE::STATE_UART_KEY:
-		case CS_TYPE::STATE_ASSET_FILTERS_VERSION:
-		case CS_TYPE::STATE_ASSET_FILTER_32:
-		case CS_TYPE::STATE_ASSET_FILTER_64:
-		case CS_TYPE::STATE_ASSET_FILTER_128:
-		case CS_TYPE::STATE_ASSET_FILTER_256:
-		case CS_TYPE::STATE_ASSET_FILTER_512:
-		case CS_TYPE::CMD_SWITCH_OFF:
-		case CS_TYPE::CMD_SWITCH_ON:
-		case CS_TYPE::CMD_SWITCH_TOGGLE:
-		case CS_TYPE::CMD_SWITCH:
-		case CS_TYPE::CMD_MULTI_SWITCH:
-		case CS_TYPE::EVT_ADV_BACKGROUND:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED_V1:
-		case CS_TYPE::EVT_ADVERTISEMENT_UPDATED:
-		case CS_TYPE::EVT_SCAN_STARTED:
-		case CS_TYPE::EVT_SCAN_STOPPED:
-		case CS_TYPE::EVT_DEVICE_SCANNED:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_OFF_FAILURE_DETECTED:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_CONTROL_COMMAND:
-		case CS_TYPE::CMD_BLE_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCOVER:
-		case CS_TYPE::CMD_BLE_CENTRAL_READ:
-		case CS_TYPE::CMD_BLE_CENTRAL_WRITE:
-		case CS_TYPE::EVT_BLE_CONNECT:
-		case CS_TYPE::EVT_BLE_DISCONNECT:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCONNECTED:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_NOTIFICATION:
-		case CS_TYPE::CMD_CS_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_WRITE:
-		case CS_TYPE::CMD_CS_CENTRAL_GET_WRITE_BUF:
-		case CS_TYPE::EVT_CS_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BROWNOUT_IMPENDING:
-		case CS_TYPE::EVT_SESSION_DATA_SET:
-		case CS_TYPE::EVT_DIMMER_FORCED_OFF:
-		case CS_TYPE::EVT_SWITCH_FORCED_OFF:
-		case CS_TYPE::EVT_RELAY_FORCED_ON:
-		case CS_TYPE::EVT_CHIP_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_CHIP_TEMP_OK:
-		case CS_TYPE::EVT_DIMMER_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_TEMP_OK:
-		case CS_TYPE::EVT_TICK:
-		case CS_TYPE::EVT_TIME_SET:
-		case CS_TYPE::EVT_DIMMER_POWERED:
-		case CS_TYPE::CMD_DIMMING_ALLOWED:
-		case CS_TYPE::CMD_LOCK_SWITCH:
-		case CS_TYPE::EVT_STATE_EXTERNAL_STONE:
-		case CS_TYPE::EVT_STATE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_INITIALIZED:
-		case CS_TYPE::EVT_STORAGE_WRITE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE:
-		case CS_TYPE::EVT_STORAGE_GC_DONE:
-		case CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_STORAGE_GARBAGE_COLLECT:
-		case CS_TYPE::EVT_ADC_RESTARTED:
-		case CS_TYPE::CMD_ENABLE_LOG_POWER:
-		case CS_TYPE::CMD_ENABLE_LOG_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
-		case CS_TYPE::CMD_RESET_DELAYED:
-		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT:
-		case CS_TYPE::CMD_ENABLE_MESH:
-		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE:
-		case CS_TYPE::CMD_INC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_DEC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_INC_CURRENT_RANGE:
-		case CS_TYPE::CMD_DEC_CURRENT_RANGE:
-		case CS_TYPE::CMD_CONTROL_CMD:
-		case CS_TYPE::CMD_SEND_MESH_MSG:
-		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH:
-		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::CMD_SET_TIME:
-		case CS_TYPE::CMD_FACTORY_RESET:
-		case CS_TYPE::CMD_ADD_BEHAVIOUR:
-		case CS_TYPE::CMD_REPLACE_BEHAVIOUR:
-		case CS_TYPE::CMD_REMOVE_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_INDICES:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_DEBUG:
-		case CS_TYPE::CMD_CLEAR_ALL_BEHAVIOUR:
-		case CS_TYPE::EVT_BEHAVIOURSTORE_MUTATION:
-		case CS_TYPE::EVT_BEHAVIOUR_OVERRIDDEN:
-		case CS_TYPE::CMD_REGISTER_TRACKED_DEVICE:
-		case CS_TYPE::CMD_UPDATE_TRACKED_DEVICE:
-		case CS_TYPE::CMD_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_PRESENCE_MUTATION:
-		case CS_TYPE::EVT_PRESENCE_CHANGE:
-		case CS_TYPE::CMD_GET_PRESENCE:
-		case CS_TYPE::CMD_SET_RELAY:
-		case CS_TYPE::CMD_SET_DIMMER:
-		case CS_TYPE::EVT_GOING_TO_DFU:
-		case CS_TYPE::EVT_RECEIVED_PROFILE_LOCATION:
-		case CS_TYPE::CMD_UPLOAD_FILTER:
-		case CS_TYPE::CMD_REMOVE_FILTER:
-		case CS_TYPE::CMD_COMMIT_FILTER_CHANGES:
-		case CS_TYPE::CMD_GET_FILTER_SUMMARIES:
-		case CS_TYPE::EVT_FILTERS_UPDATED:
-		case CS_TYPE::EVT_FILTER_MODIFICATION:
-		case CS_TYPE::EVT_ASSET_ACCEPTED:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_OUTGOING:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_INCOMING:
-		case CS_TYPE::EVT_MESH_SYNC_FAILED:
-		case CS_TYPE::EVT_MESH_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_EXT_STATE_0:
-		case CS_TYPE::EVT_MESH_EXT_STATE_1:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_TIME:
-		case CS_TYPE::CMD_SET_IBEACON_CONFIG_ID:
-		case CS_TYPE::CMD_SEND_MESH_MSG_NOOP:
-		case CS_TYPE::EVT_MESH_RSSI_PING:
-		case CS_TYPE::EVT_MESH_RSSI_DATA:
-		case CS_TYPE::EVT_MESH_TIME_SYNC:
-		case CS_TYPE::EVT_RECV_MESH_MSG:
-		case CS_TYPE::CMD_GET_ADC_RESTARTS:
-		case CS_TYPE::CMD_GET_SWITCH_HISTORY:
-		case CS_TYPE::CMD_GET_POWER_SAMPLES:
-		case CS_TYPE::CMD_GET_SCHEDULER_MIN_FREE:
-		case CS_TYPE::CMD_GET_RESET_REASON:
-		case CS_TYPE::CMD_GET_GPREGRET:
-		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
-		case CS_TYPE::CMD_GET_RAM_STATS:
-		case CS_TYPE::EVT_GENERIC_TEST:
-		case CS_TYPE::CMD_TEST_SET_TIME:
-		case CS_TYPE::CMD_MICROAPP_GET_INFO:
-		case CS_TYPE::CMD_MICROAPP_UPLOAD:
-		case CS_TYPE::CMD_MICROAPP_VALIDATE:
-		case CS_TYPE::CMD_MICROAPP_REMOVE:
-		case CS_TYPE::CMD_MICROAPP_ENABLE:
-		case CS_TYPE::CMD_MICROAPP_DISABLE:
-		case CS_TYPE::CMD_MICROAPP_MESSAGE:
-		case CS_TYPE::CMD_MICROAPP_ADVERTISE:
-		case CS_TYPE::EVT_MICROAPP_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_MESH_TOPO_GET_MAC:
-		case CS_TYPE::EVT_MESH_TOPO_MAC_RESULT:
-		case CS_TYPE::CMD_MESH_TOPO_RESET:
-		case CS_TYPE::CMD_MESH_TOPO_GET_RSSI:
-		case CS_TYPE::EVT_TWI_INIT:
-		case CS_TYPE::EVT_TWI_WRITE:
-		case CS_TYPE::EVT_TWI_READ:
-		case CS_TYPE::EVT_TWI_UPDATE:
-		case CS_TYPE::EVT_GPIO_INIT:
-		case CS_TYPE::EVT_GPIO_WRITE:
-		case CS_TYPE::EVT_GPIO_READ:
-		case CS_TYPE::EVT_GPIO_UPDATE:
-		case CS_TYPE::CMD_RESOLVE_ASYNC_CONTROL_COMMAND:
-		case CS_TYPE::CMD_SEND_ASYNC_RESULT_TO_BLE: return true;
+	const type_info_t* info = getTypeInfo(to_underlying_type(type));
+	if (info == nullptr) {
+		return true;
+	}
+	switch (info->factoryReset) {
+		case KEEP_ID_0_ON_RESET: return id != 0;
+		case REMOVE_ON_RESET:
+		default: return true;
 	}
-	// should not reach this
-	return true;
 }
 
 EncryptionAccessLevel getUserAccessLevelSet(CS_TYPE const& type) {
-	switch (type) {
-		case CS_TYPE::CONFIG_ADV_INTERVAL:
-		case CS_TYPE::CONFIG_BOOT_DELAY:
-		case CS_TYPE::CONFIG_SPHERE_ID:
-		case CS_TYPE::CONFIG_CROWNSTONE_ID:
-		case CS_TYPE::CONFIG_CURRENT_ADC_ZERO:
-		case CS_TYPE::CONFIG_CURRENT_MULTIPLIER:
-		case CS_TYPE::CONFIG_IBEACON_MAJOR:
-		case CS_TYPE::CONFIG_IBEACON_MINOR:
-		case CS_TYPE::CONFIG_IBEACON_UUID:
-		case CS_TYPE::CONFIG_IBEACON_TXPOWER:
-		case CS_TYPE::CONFIG_LOW_TX_POWER:
-		case CS_TYPE::CONFIG_MAX_CHIP_TEMP:
-		case CS_TYPE::CONFIG_MESH_ENABLED:
-		case CS_TYPE::CONFIG_NAME:
-		case CS_TYPE::CONFIG_POWER_ZERO:
-		case CS_TYPE::CONFIG_DIMMING_ALLOWED:
-		case CS_TYPE::CONFIG_PWM_PERIOD:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP:
-		case CS_TYPE::CONFIG_RELAY_HIGH_DURATION:
-		case CS_TYPE::CONFIG_SCAN_BREAK_DURATION:
-		case CS_TYPE::CONFIG_SCAN_DURATION:
-		case CS_TYPE::CONFIG_SCANNER_ENABLED:
-		case CS_TYPE::CONFIG_SCAN_INTERVAL_625US:
-		case CS_TYPE::CONFIG_SCAN_WINDOW_625US:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER:
-		case CS_TYPE::CONFIG_START_DIMMER_ON_ZERO_CROSSING:
-		case CS_TYPE::CONFIG_SWITCH_LOCKED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_THRESHOLD:
-		case CS_TYPE::STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET:
-		case CS_TYPE::CONFIG_TX_POWER:
-		case CS_TYPE::CONFIG_UART_ENABLED:
-		case CS_TYPE::CONFIG_VOLTAGE_ADC_ZERO:
-		case CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER:
-		case CS_TYPE::STATE_IBEACON_CONFIG_ID:
-		case CS_TYPE::STATE_SOFT_ON_SPEED:
-		case CS_TYPE::STATE_DEFAULT_DIM_VALUE:
-		case CS_TYPE::STATE_HUB_MODE:
-		case CS_TYPE::STATE_UART_KEY: return ADMIN;
-		case CS_TYPE::STATE_BEHAVIOUR_SETTINGS: return MEMBER;
-		case CS_TYPE::CONFIG_CURRENT_LIMIT:
-		case CS_TYPE::CONFIG_ENCRYPTION_ENABLED:
-		case CS_TYPE::CONFIG_IBEACON_ENABLED:
-		case CS_TYPE::CONFIG_KEY_ADMIN:
-		case CS_TYPE::CONFIG_KEY_MEMBER:
-		case CS_TYPE::CONFIG_KEY_BASIC:
-		case CS_TYPE::CONFIG_KEY_SERVICE_DATA:
-		case CS_TYPE::CONFIG_MESH_DEVICE_KEY:
-		case CS_TYPE::CONFIG_MESH_APP_KEY:
-		case CS_TYPE::CONFIG_MESH_NET_KEY:
-		case CS_TYPE::CONFIG_KEY_LOCALIZATION:
-		case CS_TYPE::CONFIG_DO_NOT_USE:
-		case CS_TYPE::STATE_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_TWILIGHT_RULE:
-		case CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH:
-		case CS_TYPE::STATE_ACCUMULATED_ENERGY:
-		case CS_TYPE::STATE_ERRORS:
-		case CS_TYPE::STATE_FACTORY_RESET:
-		case CS_TYPE::STATE_OPERATION_MODE:
-		case CS_TYPE::STATE_POWER_USAGE:
-		case CS_TYPE::STATE_RESET_COUNTER:
-		case CS_TYPE::STATE_SWITCH_STATE:
-		case CS_TYPE::STATE_TEMPERATURE:
-		case CS_TYPE::STATE_SUN_TIME:
-		case CS_TYPE::STATE_MESH_IV_INDEX:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER:
-		case CS_TYPE::STATE_MESH_IV_INDEX_V5:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER_V5:
-		case CS_TYPE::STATE_MICROAPP:
-		case CS_TYPE::STATE_ASSET_FILTERS_VERSION:
-		case CS_TYPE::STATE_ASSET_FILTER_32:
-		case CS_TYPE::STATE_ASSET_FILTER_64:
-		case CS_TYPE::STATE_ASSET_FILTER_128:
-		case CS_TYPE::STATE_ASSET_FILTER_256:
-		case CS_TYPE::STATE_ASSET_FILTER_512:
-		case CS_TYPE::CMD_CONTROL_CMD:
-		case CS_TYPE::CMD_DEC_CURRENT_RANGE:
-		case CS_TYPE::CMD_DEC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT:
-		case CS_TYPE::CMD_ENABLE_LOG_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_POWER:
-		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_MESH:
-		case CS_TYPE::CMD_FACTORY_RESET:
-		case CS_TYPE::CMD_INC_CURRENT_RANGE:
-		case CS_TYPE::CMD_INC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_RESET_DELAYED:
-		case CS_TYPE::CMD_SEND_MESH_MSG:
-		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH:
-		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::CMD_SET_TIME:
-		case CS_TYPE::CMD_SWITCH_OFF:
-		case CS_TYPE::CMD_SWITCH_ON:
-		case CS_TYPE::CMD_SWITCH_TOGGLE:
-		case CS_TYPE::CMD_SWITCH:
-		case CS_TYPE::CMD_MULTI_SWITCH:
-		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN:
-		case CS_TYPE::EVT_ADC_RESTARTED:
-		case CS_TYPE::EVT_ADV_BACKGROUND:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED_V1:
-		case CS_TYPE::EVT_ADVERTISEMENT_UPDATED:
-		case CS_TYPE::CMD_BLE_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCOVER:
-		case CS_TYPE::CMD_BLE_CENTRAL_READ:
-		case CS_TYPE::CMD_BLE_CENTRAL_WRITE:
-		case CS_TYPE::EVT_BLE_CONNECT:
-		case CS_TYPE::EVT_BLE_DISCONNECT:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCONNECTED:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_NOTIFICATION:
-		case CS_TYPE::CMD_CS_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_WRITE:
-		case CS_TYPE::CMD_CS_CENTRAL_GET_WRITE_BUF:
-		case CS_TYPE::EVT_CS_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BROWNOUT_IMPENDING:
-		case CS_TYPE::EVT_CHIP_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_CHIP_TEMP_OK:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DEVICE_SCANNED:
-		case CS_TYPE::EVT_DIMMER_FORCED_OFF:
-		case CS_TYPE::EVT_DIMMER_OFF_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_POWERED:
-		case CS_TYPE::EVT_DIMMER_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_TEMP_OK:
-		case CS_TYPE::CMD_DIMMING_ALLOWED:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_CONTROL_COMMAND:
-		case CS_TYPE::EVT_RELAY_FORCED_ON:
-		case CS_TYPE::EVT_SCAN_STARTED:
-		case CS_TYPE::EVT_SCAN_STOPPED:
-		case CS_TYPE::EVT_SESSION_DATA_SET:
-		case CS_TYPE::EVT_STATE_EXTERNAL_STONE:
-		case CS_TYPE::EVT_STATE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_INITIALIZED:
-		case CS_TYPE::EVT_STORAGE_WRITE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE:
-		case CS_TYPE::EVT_STORAGE_GC_DONE:
-		case CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_STORAGE_GARBAGE_COLLECT:
-		case CS_TYPE::EVT_SWITCH_FORCED_OFF:
-		case CS_TYPE::CMD_LOCK_SWITCH:
-		case CS_TYPE::EVT_TICK:
-		case CS_TYPE::EVT_TIME_SET:
-		case CS_TYPE::CMD_ADD_BEHAVIOUR:
-		case CS_TYPE::CMD_REPLACE_BEHAVIOUR:
-		case CS_TYPE::CMD_REMOVE_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_INDICES:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_DEBUG:
-		case CS_TYPE::CMD_CLEAR_ALL_BEHAVIOUR:
-		case CS_TYPE::EVT_BEHAVIOURSTORE_MUTATION:
-		case CS_TYPE::EVT_BEHAVIOUR_OVERRIDDEN:
-		case CS_TYPE::CMD_REGISTER_TRACKED_DEVICE:
-		case CS_TYPE::CMD_UPDATE_TRACKED_DEVICE:
-		case CS_TYPE::CMD_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_PRESENCE_MUTATION:
-		case CS_TYPE::EVT_PRESENCE_CHANGE:
-		case CS_TYPE::CMD_GET_PRESENCE:
-		case CS_TYPE::CMD_SET_RELAY:
-		case CS_TYPE::CMD_SET_DIMMER:
-		case CS_TYPE::EVT_GOING_TO_DFU:
-		case CS_TYPE::EVT_RECEIVED_PROFILE_LOCATION:
-		case CS_TYPE::CMD_UPLOAD_FILTER:
-		case CS_TYPE::CMD_REMOVE_FILTER:
-		case CS_TYPE::CMD_COMMIT_FILTER_CHANGES:
-		case CS_TYPE::CMD_GET_FILTER_SUMMARIES:
-		case CS_TYPE::EVT_FILTERS_UPDATED:
-		case CS_TYPE::EVT_FILTER_MODIFICATION:
-		case CS_TYPE::EVT_ASSET_ACCEPTED:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_OUTGOING:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_INCOMING:
-		case CS_TYPE::EVT_MESH_SYNC_FAILED:
-		case CS_TYPE::EVT_MESH_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_EXT_STATE_0:
-		case CS_TYPE::EVT_MESH_EXT_STATE_1:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_TIME:
-		case CS_TYPE::CMD_SET_IBEACON_CONFIG_ID:
-		case CS_TYPE::CMD_SEND_MESH_MSG_NOOP:
-		case CS_TYPE::EVT_MESH_RSSI_PING:
-		case CS_TYPE::EVT_MESH_RSSI_DATA:
-		case CS_TYPE::EVT_MESH_TIME_SYNC:
-		case CS_TYPE::EVT_RECV_MESH_MSG:
-		case CS_TYPE::CMD_GET_ADC_RESTARTS:
-		case CS_TYPE::CMD_GET_SWITCH_HISTORY:
-		case CS_TYPE::CMD_GET_POWER_SAMPLES:
-		case CS_TYPE::CMD_GET_SCHEDULER_MIN_FREE:
-		case CS_TYPE::CMD_GET_RESET_REASON:
-		case CS_TYPE::CMD_GET_GPREGRET:
-		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
-		case CS_TYPE::CMD_GET_RAM_STATS:
-		case CS_TYPE::EVT_GENERIC_TEST:
-		case CS_TYPE::CMD_TEST_SET_TIME:
-		case CS_TYPE::CMD_MICROAPP_GET_INFO:
-		case CS_TYPE::CMD_MICROAPP_UPLOAD:
-		case CS_TYPE::CMD_MICROAPP_VALIDATE:
-		case CS_TYPE::CMD_MICROAPP_REMOVE:
-		case CS_TYPE::CMD_MICROAPP_ENABLE:
-		case CS_TYPE::CMD_MICROAPP_DISABLE:
-		case CS_TYPE::CMD_MICROAPP_MESSAGE:
-		case CS_TYPE::CMD_MICROAPP_ADVERTISE:
-		case CS_TYPE::EVT_MICROAPP_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_MESH_TOPO_GET_MAC:
-		case CS_TYPE::EVT_MESH_TOPO_MAC_RESULT:
-		case CS_TYPE::CMD_MESH_TOPO_RESET:
-		case CS_TYPE::CMD_MESH_TOPO_GET_RSSI:
-		case CS_TYPE::EVT_TWI_INIT:
-		case CS_TYPE::EVT_TWI_WRITE:
-		case CS_TYPE::EVT_TWI_READ:
-		case CS_TYPE::EVT_TWI_UPDATE:
-		case CS_TYPE::EVT_GPIO_INIT:
-		case CS_TYPE::EVT_GPIO_WRITE:
-		case CS_TYPE::EVT_GPIO_READ:
-		case CS_TYPE::EVT_GPIO_UPDATE:
-		case CS_TYPE::CMD_RESOLVE_ASYNC_CONTROL_COMMAND:
-		case CS_TYPE::CMD_SEND_ASYNC_RESULT_TO_BLE: return NO_ONE;
+	const type_info_t* info = getTypeInfo(to_underlying_type(type));
+	if (info == nullptr) {
+		return NO_ONE;
 	}
-	return NO_ONE;
+	return static_cast<EncryptionAccessLevel>(info->accessSet);
 }
 
 EncryptionAccessLevel getUserAccessLevelGet(CS_TYPE const& type) {
-	switch (type) {
-		case CS_TYPE::CONFIG_ADV_INTERVAL:
-		case CS_TYPE::CONFIG_BOOT_DELAY:
-		case CS_TYPE::CONFIG_SPHERE_ID:
-		case CS_TYPE::CONFIG_CROWNSTONE_ID:
-		case CS_TYPE::CONFIG_CURRENT_ADC_ZERO:
-		case CS_TYPE::CONFIG_CURRENT_MULTIPLIER:
-		case CS_TYPE::CONFIG_ENCRYPTION_ENABLED:
-		case CS_TYPE::CONFIG_IBEACON_ENABLED:
-		case CS_TYPE::CONFIG_IBEACON_MAJOR:
-		case CS_TYPE::CONFIG_IBEACON_MINOR:
-		case CS_TYPE::CONFIG_IBEACON_UUID:
-		case CS_TYPE::CONFIG_IBEACON_TXPOWER:
-		case CS_TYPE::CONFIG_LOW_TX_POWER:
-		case CS_TYPE::CONFIG_MAX_CHIP_TEMP:
-		case CS_TYPE::CONFIG_MESH_ENABLED:
-		case CS_TYPE::CONFIG_NAME:
-		case CS_TYPE::CONFIG_POWER_ZERO:
-		case CS_TYPE::CONFIG_DIMMING_ALLOWED:
-		case CS_TYPE::CONFIG_PWM_PERIOD:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_DOWN:
-		case CS_TYPE::CONFIG_PWM_TEMP_VOLTAGE_THRESHOLD_UP:
-		case CS_TYPE::CONFIG_RELAY_HIGH_DURATION:
-		case CS_TYPE::CONFIG_SCAN_BREAK_DURATION:
-		case CS_TYPE::CONFIG_SCAN_DURATION:
-		case CS_TYPE::CONFIG_SCANNER_ENABLED:
-		case CS_TYPE::CONFIG_SCAN_INTERVAL_625US:
-		case CS_TYPE::CONFIG_SCAN_WINDOW_625US:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD:
-		case CS_TYPE::CONFIG_SOFT_FUSE_CURRENT_THRESHOLD_DIMMER:
-		case CS_TYPE::CONFIG_START_DIMMER_ON_ZERO_CROSSING:
-		case CS_TYPE::CONFIG_SWITCH_LOCKED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_ENABLED:
-		case CS_TYPE::CONFIG_SWITCHCRAFT_THRESHOLD:
-		case CS_TYPE::STATE_SWITCHCRAFT_DOUBLE_TAP_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED:
-		case CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET:
-		case CS_TYPE::CONFIG_TX_POWER:
-		case CS_TYPE::CONFIG_UART_ENABLED:
-		case CS_TYPE::CONFIG_VOLTAGE_ADC_ZERO:
-		case CS_TYPE::CONFIG_VOLTAGE_MULTIPLIER:
-		case CS_TYPE::STATE_MESH_IV_INDEX:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER:
-		case CS_TYPE::STATE_MESH_IV_INDEX_V5:
-		case CS_TYPE::STATE_MESH_SEQ_NUMBER_V5:
-		case CS_TYPE::STATE_IBEACON_CONFIG_ID:
-		case CS_TYPE::STATE_MICROAPP:
-		case CS_TYPE::STATE_SOFT_ON_SPEED:
-		case CS_TYPE::STATE_DEFAULT_DIM_VALUE:
-		case CS_TYPE::STATE_HUB_MODE:
-		case CS_TYPE::STATE_ASSET_FILTERS_VERSION:
-		case CS_TYPE::STATE_ASSET_FILTER_32:
-		case CS_TYPE::STATE_ASSET_FILTER_64:
-		case CS_TYPE::STATE_ASSET_FILTER_128:
-		case CS_TYPE::STATE_ASSET_FILTER_256:
-		case CS_TYPE::STATE_ASSET_FILTER_512: return ADMIN;
-		case CS_TYPE::STATE_ACCUMULATED_ENERGY:
-		case CS_TYPE::STATE_ERRORS:
-		case CS_TYPE::STATE_POWER_USAGE:
-		case CS_TYPE::STATE_RESET_COUNTER:
-		case CS_TYPE::STATE_SWITCH_STATE:
-		case CS_TYPE::STATE_TEMPERATURE:
-		case CS_TYPE::STATE_SUN_TIME:
-		case CS_TYPE::STATE_BEHAVIOUR_MASTER_HASH: return MEMBER;
-		case CS_TYPE::STATE_BEHAVIOUR_SETTINGS: return BASIC;
-		case CS_TYPE::CONFIG_CURRENT_LIMIT:
-		case CS_TYPE::CONFIG_KEY_ADMIN:
-		case CS_TYPE::CONFIG_KEY_MEMBER:
-		case CS_TYPE::CONFIG_KEY_BASIC:
-		case CS_TYPE::CONFIG_KEY_SERVICE_DATA:
-		case CS_TYPE::CONFIG_MESH_DEVICE_KEY:
-		case CS_TYPE::CONFIG_MESH_APP_KEY:
-		case CS_TYPE::CONFIG_MESH_NET_KEY:
-		case CS_TYPE::CONFIG_KEY_LOCALIZATION:
-		case CS_TYPE::CONFIG_DO_NOT_USE:
-		case CS_TYPE::STATE_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_TWILIGHT_RULE:
-		case CS_TYPE::STATE_EXTENDED_BEHAVIOUR_RULE:
-		case CS_TYPE::STATE_FACTORY_RESET:
-		case CS_TYPE::STATE_OPERATION_MODE:
-		case CS_TYPE::STATE_UART_KEY:
-		case CS_TYPE::CMD_CONTROL_CMD:
-		case CS_TYPE::CMD_DEC_CURRENT_RANGE:
-		case CS_TYPE::CMD_DEC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT:
-		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT:
-		case CS_TYPE::CMD_ENABLE_LOG_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
-		case CS_TYPE::CMD_ENABLE_LOG_POWER:
-		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE:
-		case CS_TYPE::CMD_ENABLE_MESH:
-		case CS_TYPE::CMD_FACTORY_RESET:
-		case CS_TYPE::CMD_INC_CURRENT_RANGE:
-		case CS_TYPE::CMD_INC_VOLTAGE_RANGE:
-		case CS_TYPE::CMD_RESET_DELAYED:
-		case CS_TYPE::CMD_SEND_MESH_MSG:
-		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH:
-		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
-		case CS_TYPE::CMD_SET_TIME:
-		case CS_TYPE::CMD_SWITCH_OFF:
-		case CS_TYPE::CMD_SWITCH_ON:
-		case CS_TYPE::CMD_SWITCH_TOGGLE:
-		case CS_TYPE::CMD_SWITCH:
-		case CS_TYPE::CMD_MULTI_SWITCH:
-		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN:
-		case CS_TYPE::EVT_ADC_RESTARTED:
-		case CS_TYPE::EVT_ADV_BACKGROUND:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED:
-		case CS_TYPE::EVT_ADV_BACKGROUND_PARSED_V1:
-		case CS_TYPE::EVT_ADVERTISEMENT_UPDATED:
-		case CS_TYPE::CMD_BLE_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_BLE_CENTRAL_DISCOVER:
-		case CS_TYPE::CMD_BLE_CENTRAL_READ:
-		case CS_TYPE::CMD_BLE_CENTRAL_WRITE:
-		case CS_TYPE::EVT_BLE_CONNECT:
-		case CS_TYPE::EVT_BLE_DISCONNECT:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REQUEST:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_CLEARANCE_REPLY:
-		case CS_TYPE::EVT_BLE_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCONNECTED:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY:
-		case CS_TYPE::EVT_BLE_CENTRAL_DISCOVERY_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BLE_CENTRAL_NOTIFICATION:
-		case CS_TYPE::CMD_CS_CENTRAL_CONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_DISCONNECT:
-		case CS_TYPE::CMD_CS_CENTRAL_WRITE:
-		case CS_TYPE::CMD_CS_CENTRAL_GET_WRITE_BUF:
-		case CS_TYPE::EVT_CS_CENTRAL_CONNECT_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_READ_RESULT:
-		case CS_TYPE::EVT_CS_CENTRAL_WRITE_RESULT:
-		case CS_TYPE::EVT_BROWNOUT_IMPENDING:
-		case CS_TYPE::EVT_CHIP_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_CHIP_TEMP_OK:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER:
-		case CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DEVICE_SCANNED:
-		case CS_TYPE::EVT_DIMMER_FORCED_OFF:
-		case CS_TYPE::EVT_DIMMER_OFF_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED:
-		case CS_TYPE::EVT_DIMMER_POWERED:
-		case CS_TYPE::EVT_DIMMER_TEMP_ABOVE_THRESHOLD:
-		case CS_TYPE::EVT_DIMMER_TEMP_OK:
-		case CS_TYPE::CMD_DIMMING_ALLOWED:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_REGISTER:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_TOKEN:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_MESH_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_MSG_TRACKED_DEVICE_LIST_SIZE:
-		case CS_TYPE::CMD_SEND_MESH_CONTROL_COMMAND:
-		case CS_TYPE::EVT_RELAY_FORCED_ON:
-		case CS_TYPE::EVT_SCAN_STARTED:
-		case CS_TYPE::EVT_SCAN_STOPPED:
-		case CS_TYPE::EVT_SESSION_DATA_SET:
-		case CS_TYPE::EVT_STATE_EXTERNAL_STONE:
-		case CS_TYPE::EVT_STATE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_INITIALIZED:
-		case CS_TYPE::EVT_STORAGE_WRITE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_DONE:
-		case CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE:
-		case CS_TYPE::EVT_STORAGE_GC_DONE:
-		case CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE:
-		case CS_TYPE::EVT_STORAGE_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_STORAGE_GARBAGE_COLLECT:
-		case CS_TYPE::EVT_SWITCH_FORCED_OFF:
-		case CS_TYPE::CMD_LOCK_SWITCH:
-		case CS_TYPE::EVT_TICK:
-		case CS_TYPE::EVT_TIME_SET:
-		case CS_TYPE::CMD_ADD_BEHAVIOUR:
-		case CS_TYPE::CMD_REPLACE_BEHAVIOUR:
-		case CS_TYPE::CMD_REMOVE_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_INDICES:
-		case CS_TYPE::CMD_GET_BEHAVIOUR_DEBUG:
-		case CS_TYPE::CMD_CLEAR_ALL_BEHAVIOUR:
-		case CS_TYPE::EVT_BEHAVIOURSTORE_MUTATION:
-		case CS_TYPE::EVT_BEHAVIOUR_OVERRIDDEN:
-		case CS_TYPE::CMD_REGISTER_TRACKED_DEVICE:
-		case CS_TYPE::CMD_UPDATE_TRACKED_DEVICE:
-		case CS_TYPE::CMD_TRACKED_DEVICE_HEARTBEAT:
-		case CS_TYPE::EVT_PRESENCE_MUTATION:
-		case CS_TYPE::EVT_PRESENCE_CHANGE:
-		case CS_TYPE::CMD_GET_PRESENCE:
-		case CS_TYPE::CMD_SET_RELAY:
-		case CS_TYPE::CMD_SET_DIMMER:
-		case CS_TYPE::EVT_GOING_TO_DFU:
-		case CS_TYPE::EVT_RECEIVED_PROFILE_LOCATION:
-		case CS_TYPE::CMD_UPLOAD_FILTER:
-		case CS_TYPE::CMD_REMOVE_FILTER:
-		case CS_TYPE::CMD_COMMIT_FILTER_CHANGES:
-		case CS_TYPE::CMD_GET_FILTER_SUMMARIES:
-		case CS_TYPE::EVT_FILTERS_UPDATED:
-		case CS_TYPE::EVT_FILTER_MODIFICATION:
-		case CS_TYPE::EVT_ASSET_ACCEPTED:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_OUTGOING:
-		case CS_TYPE::EVT_MESH_SYNC_REQUEST_INCOMING:
-		case CS_TYPE::EVT_MESH_SYNC_FAILED:
-		case CS_TYPE::EVT_MESH_PAGES_ERASED:
-		case CS_TYPE::EVT_MESH_EXT_STATE_0:
-		case CS_TYPE::EVT_MESH_EXT_STATE_1:
-		case CS_TYPE::CMD_SEND_MESH_MSG_SET_TIME:
-		case CS_TYPE::CMD_SET_IBEACON_CONFIG_ID:
-		case CS_TYPE::CMD_SEND_MESH_MSG_NOOP:
-		case CS_TYPE::EVT_MESH_RSSI_PING:
-		case CS_TYPE::EVT_MESH_RSSI_DATA:
-		case CS_TYPE::EVT_MESH_TIME_SYNC:
-		case CS_TYPE::EVT_RECV_MESH_MSG:
-		case CS_TYPE::CMD_GET_ADC_RESTARTS:
-		case CS_TYPE::CMD_GET_SWITCH_HISTORY:
-		case CS_TYPE::CMD_GET_POWER_SAMPLES:
-		case CS_TYPE::CMD_GET_SCHEDULER_MIN_FREE:
-		case CS_TYPE::CMD_GET_RESET_REASON:
-		case CS_TYPE::CMD_GET_GPREGRET:
-		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
-		case CS_TYPE::CMD_GET_RAM_STATS:
-		case CS_TYPE::EVT_GENERIC_TEST:
-		case CS_TYPE::CMD_TEST_SET_TIME:
-		case CS_TYPE::CMD_MICROAPP_GET_INFO:
-		case CS_TYPE::CMD_MICROAPP_UPLOAD:
-		case CS_TYPE::CMD_MICROAPP_VALIDATE:
-		case CS_TYPE::CMD_MICROAPP_REMOVE:
-		case CS_TYPE::CMD_MICROAPP_ENABLE:
-		case CS_TYPE::CMD_MICROAPP_DISABLE:
-		case CS_TYPE::CMD_MICROAPP_MESSAGE:
-		case CS_TYPE::CMD_MICROAPP_ADVERTISE:
-		case CS_TYPE::EVT_MICROAPP_FACTORY_RESET_DONE:
-		case CS_TYPE::CMD_MESH_TOPO_GET_MAC:
-		case CS_TYPE::EVT_MESH_TOPO_MAC_RESULT:
-		case CS_TYPE::CMD_MESH_TOPO_RESET:
-		case CS_TYPE::CMD_MESH_TOPO_GET_RSSI:
-		case CS_TYPE::EVT_TWI_INIT:
-		case CS_TYPE::EVT_TWI_WRITE:
-		case CS_TYPE::EVT_TWI_READ:
-		case CS_TYPE::EVT_TWI_UPDATE:
-		case CS_TYPE::EVT_GPIO_INIT:
-		case CS_TYPE::EVT_GPIO_WRITE:
-		case CS_TYPE::EVT_GPIO_READ:
-		case CS_TYPE::EVT_GPIO_UPDATE:
-		case CS_TYPE::CMD_RESOLVE_ASYNC_CONTROL_COMMAND:
-		case CS_TYPE::CMD_SEND_ASYNC_RESULT_TO_BLE: return NO_ONE;
+	const type_info_t* info = getTypeInfo(to_underlying_type(type));
+	if (info == nullptr) {
+		return NO_ONE;
 	}
-	return NO_ONE;
+	return static_cast<EncryptionAccessLevel>(info->accessGet);
 }
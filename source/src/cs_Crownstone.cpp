@@ -252,6 +252,7 @@ void Crownstone::init0() {
 }
 
 void Crownstone::init1() {
+	logBootStep("storage");
 	initDrivers1();
 	LOG_FLUSH();
 
@@ -265,6 +266,7 @@ void Crownstone::init1() {
 	//! configure the crownstone
 	LOGi(FMT_HEADER "configure");
 	configure();
+	logBootStep("configure");
 	LOG_FLUSH();
 
 	LOGi(FMT_CREATE "timer");
@@ -273,16 +275,19 @@ void Crownstone::init1() {
 
 	LOGi(FMT_HEADER "mode");
 	switchMode(_operationMode);
+	logBootStep("mode");
 	LOG_FLUSH();
 
 	LOGi(FMT_HEADER "init services");
 	_stack->initServices();
+	logBootStep("services");
 	LOG_FLUSH();
 
 	if (_operationMode == OperationMode::OPERATION_MODE_NORMAL) {
 		LOGi(FMT_HEADER "init central");
 		_bleCentral->init();
 		_crownstoneCentral->init();
+		logBootStep("central");
 	}
 }
 
@@ -293,6 +298,7 @@ void Crownstone::initDrivers0() {
 	_timer->init();
 	_stack->initSoftdevice();
 	IpcRamBluenet::getInstance().init();
+	logBootStep("drivers");
 
 #if BUILD_MESHING == 1 && MESH_PERSISTENT_STORAGE == 1
 	// Check if flash pages of mesh are valid, else erase them.
@@ -319,6 +325,7 @@ void Crownstone::initDrivers0() {
 
 void Crownstone::initDrivers1() {
 	_state->init(&_boardsConfig);
+	logBootStep("state");
 
 	// If not done already, init UART
 	// TODO: make into a class with proper init() function
@@ -333,6 +340,7 @@ void Crownstone::initDrivers1() {
 		// Init UartHandler only now, because it will read State.
 		UartHandler::getInstance().init(SERIAL_ENABLE_RX_AND_TX);
 	}
+	logBootStep("uart");
 
 	LOGi("GPRegRet: %u %u", GpRegRet::getValue(GpRegRet::GPREGRET), GpRegRet::getValue(GpRegRet::GPREGRET2));
 
@@ -371,6 +379,7 @@ void Crownstone::initDrivers1() {
 
 	LOGi(FMT_INIT "command handler");
 	_commandHandler->init(&_boardsConfig);
+	logBootStep("command handler");
 
 	LOGi(FMT_INIT "factory reset");
 	_factoryReset->init();
@@ -378,16 +387,19 @@ void Crownstone::initDrivers1() {
 	LOGi(FMT_INIT "encryption");
 	ConnectionEncryption::getInstance().init();
 	KeysAndAccess::getInstance().init();
+	logBootStep("encryption");
 
 	if (IS_CROWNSTONE(_boardsConfig.deviceType)) {
 		LOGi(FMT_INIT "switch");
 		_switchAggregator.init(_boardsConfig);
+		logBootStep("switch");
 
 		LOGi(FMT_INIT "temperature guard");
 		_temperatureGuard->init(_boardsConfig);
 
 		LOGi(FMT_INIT "power sampler");
 		_powerSampler->init(&_boardsConfig);
+		logBootStep("power sampler");
 	}
 
 	// init GPIOs
@@ -452,6 +464,15 @@ void Crownstone::configureAdvertisement() {
 	_advertiser->configureAdvertisement(*_serviceData, false);
 }
 
+void Crownstone::logBootStep(const char* step) {
+	uint32_t count = RTC::getCount();
+	LOGi("Boot step %s took %u ms, at %u ms",
+		 step,
+		 RTC::differenceMs(count, _bootStepStartCount),
+		 RTC::ticksToMs(count));
+	_bootStepStartCount = count;
+}
+
 void Crownstone::createService(const ServiceEvent event) {
 	switch (event) {
 		case CREATE_DEVICE_INFO_SERVICE:
@@ -694,8 +715,10 @@ void Crownstone::startUp() {
 		nrf_delay_ms(bootDelay);
 	}
 
+	logBootStep("startup");
 	LOGi("Start advertising");
 	_advertiser->startAdvertising();
+	logBootStep("advertising");
 
 	// Have to give the stack a moment of pause to start advertising, otherwise we get into race conditions.
 	// TODO: Is this still the case? Can we solve this differently?
@@ -935,6 +958,18 @@ void Crownstone::handleEvent(event_t& event) {
 			event.result.returnCode = ERR_SUCCESS;
 			break;
 		}
+		case CS_TYPE::CMD_GET_STORAGE_STATS: {
+			LOGi("Get storage stats");
+			const cs_storage_stats_t& storageStats = _storage->getStats();
+			if (event.result.buf.len < sizeof(storageStats)) {
+				event.result.returnCode = ERR_BUFFER_TOO_SMALL;
+				break;
+			}
+			memcpy(event.result.buf.data, &storageStats, sizeof(storageStats));
+			event.result.dataSize   = sizeof(storageStats);
+			event.result.returnCode = ERR_SUCCESS;
+			break;
+		}
 		default: LOGnone("Event: $typeName(%u)", to_underlying_type(event.type));
 	}
 
@@ -952,6 +987,11 @@ void Crownstone::updateHeapStats() {
 	_ramStats.maxHeapEnd   = (uint32_t)getHeapEndMax();
 	_ramStats.minFree      = _ramStats.minStackEnd - _ramStats.maxHeapEnd;
 	_ramStats.numSbrkFails = getSbrkNumFails();
+
+	const cs_state_value_pool_stats_t& valuePoolStats = State::getInstance().getValuePoolStats();
+	_ramStats.stateValueBytes                         = valuePoolStats.usedBytes;
+	_ramStats.stateValuePeakBytes                     = valuePoolStats.peakUsedBytes;
+	_ramStats.stateValueReservedBytes                 = valuePoolStats.reservedBytes;
 }
 
 void Crownstone::updateMinStackEnd() {
@@ -976,6 +1016,10 @@ void Crownstone::printLoadStats() {
 		 _ramStats.minStackEnd,
 		 _ramStats.minFree,
 		 _ramStats.numSbrkFails);
+	LOGi("State values: used=%u peak=%u reserved=%u",
+		 _ramStats.stateValueBytes,
+		 _ramStats.stateValuePeakBytes,
+		 _ramStats.stateValueReservedBytes);
 
 	// Log scheduler usage.
 	__attribute__((unused)) uint16_t maxUsed     = app_sched_queue_utilization_get();
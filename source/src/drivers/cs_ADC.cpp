@@ -18,6 +18,8 @@
 #include <uart/cs_UartHandler.h>
 #include <util/cs_BleError.h>
 
+#include <algorithm>
+
 #define LOGAdcDebug LOGd
 #define LOGAdcVerbose LOGnone
 #define LOGAdcInterruptWarn LOGnone
@@ -567,6 +569,43 @@ void ADC::enableZeroCrossingInterrupt(adc_channel_id_t channel, int32_t zeroVal)
 	setLimitUp();
 }
 
+cs_ret_code_t ADC::enableLimitGuard(adc_channel_id_t channel, int32_t lowLimit, int32_t highLimit) {
+	if (channel >= _config.channelCount) {
+		return ERR_ADC_INVALID_CHANNEL;
+	}
+	if (_zeroCrossingEnabled && channel == _zeroCrossingChannel) {
+		return ERR_WRONG_STATE;
+	}
+	LOGAdcDebug("enable limit guard chan=%u low=%i high=%i", channel, lowLimit, highLimit);
+	disableLimitGuard();
+	lowLimit             = std::max(lowLimit, (int32_t)LIMIT_LOW_DISABLED);
+	highLimit            = std::min(highLimit, (int32_t)LIMIT_HIGH_DISABLED);
+	_limitGuardChannel   = channel;
+	_eventLimitGuardLow  = getLimitLowEvent(channel);
+	_eventLimitGuardHigh = getLimitHighEvent(channel);
+	_limitGuardTriggered = false;
+	nrf_saadc_channel_limits_set(channel, lowLimit, highLimit);
+	nrf_saadc_event_clear(_eventLimitGuardLow);
+	nrf_saadc_event_clear(_eventLimitGuardHigh);
+	_limitGuardEnabled = true;
+	nrf_saadc_int_enable(
+			nrf_saadc_limit_int_get(channel, NRF_SAADC_LIMIT_LOW)
+			| nrf_saadc_limit_int_get(channel, NRF_SAADC_LIMIT_HIGH));
+	return ERR_SUCCESS;
+}
+
+void ADC::disableLimitGuard() {
+	if (!_limitGuardEnabled) {
+		return;
+	}
+	_limitGuardEnabled = false;
+	clearLimitGuard();
+}
+
+bool ADC::isLimitGuardTriggered() {
+	return _limitGuardTriggered;
+}
+
 cs_ret_code_t ADC::changeChannel(adc_channel_id_t channel, adc_channel_config_t& config) {
 	if (channel >= _config.channelCount) {
 		return ERR_ADC_INVALID_CHANNEL;
@@ -615,6 +654,16 @@ void ADC::setLimitDown() {
 	nrf_saadc_int_disable(int_mask);
 }
 
+// No logs, this function can be called from interrupt
+void ADC::clearLimitGuard() {
+	nrf_saadc_int_disable(
+			nrf_saadc_limit_int_get(_limitGuardChannel, NRF_SAADC_LIMIT_LOW)
+			| nrf_saadc_limit_int_get(_limitGuardChannel, NRF_SAADC_LIMIT_HIGH));
+	nrf_saadc_channel_limits_set(_limitGuardChannel, LIMIT_LOW_DISABLED, LIMIT_HIGH_DISABLED);
+	nrf_saadc_event_clear(_eventLimitGuardLow);
+	nrf_saadc_event_clear(_eventLimitGuardHigh);
+}
+
 void ADC::handleEvent(event_t& event) {
 	switch (event.type) {
 		default: {
@@ -634,6 +683,9 @@ void ADC::_handleAdcDone(adc_buffer_id_t bufIndex) {
 #endif
 
 	if (dataCallbackRegistered()) {
+		// The SAADC is done with this buffer, so it can be rearranged for processing.
+		AdcBuffer::getInstance().deinterleave(bufIndex);
+
 		if (_firstBuffer) {
 			LOGw("ADC restarted (ignore first warning on boot)");
 			event_t event(CS_TYPE::EVT_ADC_RESTARTED, NULL, 0);
@@ -691,6 +743,14 @@ void ADC::_handleAdcLimitInterrupt(nrf_saadc_limit_t type) {
 	}
 }
 
+// No logs, this function is called from interrupt
+void ADC::_handleLimitGuardInterrupt() {
+	// Only trigger once: the limit events keep on coming for every sample outside the limits.
+	_limitGuardEnabled   = false;
+	_limitGuardTriggered = true;
+	clearLimitGuard();
+}
+
 void ADC::_handleAdcInterrupt() {
 	if (nrf_saadc_event_check(NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
@@ -721,14 +781,15 @@ void ADC::_handleAdcInterrupt() {
 		}
 
 		// This buffer is no longer in use by saadc: move it to the buffer queue.
-		adc_buffer_id_t bufIndex                            = _saadcBufferQueue.pop();
+		adc_buffer_id_t bufIndex                                = _saadcBufferQueue.pop();
 
 		// Mark buffer valid.
 		// TODO: In case processing is really slow, it might be marked valid again while it's being processed.
 		// Idea: Only have 1 call in the app scheduler, without buf index.
 		//       Let processing loop over all valid buffers in _bufferQueue.
-		AdcBuffer::getInstance().getBuffer(bufIndex)->valid = true;
-		AdcBuffer::getInstance().getBuffer(bufIndex)->seqNr = _bufSeqNr++;
+		AdcBuffer::getInstance().getBuffer(bufIndex)->valid     = true;
+		AdcBuffer::getInstance().getBuffer(bufIndex)->seqNr     = _bufSeqNr++;
+		AdcBuffer::getInstance().getBuffer(bufIndex)->doneTicks = RTC::getCount();
 
 		_bufferQueue.pushUnique(bufIndex);
 
@@ -791,15 +852,22 @@ void ADC::_handleAdcInterrupt() {
 		_saadcState = ADC_SAADC_STATE_IDLE;
 	}
 
-	// No zero crossing events if we stop the SAADC.
-	else if (_zeroCrossingEnabled) {
-		if (nrf_saadc_event_check(_eventLimitLow)) {
-			nrf_saadc_event_clear(_eventLimitLow);
-			_handleAdcLimitInterrupt(NRF_SAADC_LIMIT_LOW);
+	// No zero crossing or limit guard events if we stop the SAADC.
+	else {
+		if (_zeroCrossingEnabled) {
+			if (nrf_saadc_event_check(_eventLimitLow)) {
+				nrf_saadc_event_clear(_eventLimitLow);
+				_handleAdcLimitInterrupt(NRF_SAADC_LIMIT_LOW);
+			}
+			if (nrf_saadc_event_check(_eventLimitHigh)) {
+				nrf_saadc_event_clear(_eventLimitHigh);
+				_handleAdcLimitInterrupt(NRF_SAADC_LIMIT_HIGH);
+			}
 		}
-		if (nrf_saadc_event_check(_eventLimitHigh)) {
-			nrf_saadc_event_clear(_eventLimitHigh);
-			_handleAdcLimitInterrupt(NRF_SAADC_LIMIT_HIGH);
+		if (_limitGuardEnabled) {
+			if (nrf_saadc_event_check(_eventLimitGuardLow) || nrf_saadc_event_check(_eventLimitGuardHigh)) {
+				_handleLimitGuardInterrupt();
+			}
 		}
 	}
 }
@@ -18,7 +18,7 @@ Gpio& Gpio::getInstance() {
 }
 
 Gpio::Gpio() : EventListener() {
-	EventDispatcher::getInstance().addListener(this);
+	listen({CS_TYPE::EVT_GPIO_INIT, CS_TYPE::EVT_GPIO_WRITE, CS_TYPE::EVT_GPIO_READ, CS_TYPE::EVT_TICK});
 }
 
 /*
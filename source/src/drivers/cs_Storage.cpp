@@ -6,6 +6,7 @@
  */
 
 #include <common/cs_Handlers.h>
+#include <drivers/cs_RTC.h>
 #include <drivers/cs_Storage.h>
 #include <events/cs_EventDispatcher.h>
 #include <float.h>
@@ -14,6 +15,7 @@
 #include <storage/cs_State.h>
 #include <util/cs_BleError.h>
 
+#include <algorithm>
 #include <climits>
 
 #define LOGStorageInit LOGi
@@ -103,6 +105,14 @@ cs_ret_code_t Storage::findNextInternal(uint16_t recordKey, uint16_t& fileId) {
 	if (!isValidRecordKey(recordKey)) {
 		return ERR_WRONG_PARAMETER;
 	}
+#if BUILD_FLASH_RECORD_INDEX == 1
+	cs_storage_record_index_entry_t* entry = _recordIndex.findNext(recordKey);
+	if (entry == nullptr) {
+		return ERR_NOT_FOUND;
+	}
+	fileId = entry->fileId;
+	return ERR_SUCCESS;
+#else
 	fds_record_desc_t recordDesc;
 	fds_flash_record_t flashRecord;
 	ret_code_t fdsRetCode;
@@ -115,10 +125,12 @@ cs_ret_code_t Storage::findNextInternal(uint16_t recordKey, uint16_t& fileId) {
 		}
 	}
 	return ERR_NOT_FOUND;
+#endif
 }
 
 /**
  * Iterate over all records, so that in case of duplicates, the last written record will be used to read.
+ * With the record index, the record is looked up in RAM instead.
  */
 cs_ret_code_t Storage::read(cs_state_data_t& stateData) {
 	if (!_initialized) {
@@ -133,6 +145,15 @@ cs_ret_code_t Storage::read(cs_state_data_t& stateData) {
 	if (isBusy(recordKey)) {
 		return ERR_BUSY;
 	}
+#if BUILD_FLASH_RECORD_INDEX == 1
+	LOGStorageDebug("Read record key=%u file=%u", recordKey, fileId);
+	cs_storage_record_index_entry_t* entry = _recordIndex.find(recordKey, fileId);
+	if (entry == nullptr) {
+		LOGStorageDebug("Record not found");
+		return ERR_NOT_FOUND;
+	}
+	return readRecord(entry->recordDesc, stateData.value, stateData.size, fileId);
+#else
 	fds_record_desc_t recordDesc;
 	cs_ret_code_t csRetCode = ERR_NOT_FOUND;
 	bool done               = false;
@@ -154,6 +175,7 @@ cs_ret_code_t Storage::read(cs_state_data_t& stateData) {
 		LOGStorageDebug("Record not found");
 	}
 	return csRetCode;
+#endif
 }
 
 cs_ret_code_t Storage::readV3ResetCounter(cs_state_data_t& stateData) {
@@ -243,18 +265,29 @@ cs_ret_code_t Storage::readNextInternal(uint16_t recordKey, uint16_t& fileId, ui
 	if (!isValidRecordKey(recordKey)) {
 		return ERR_WRONG_PARAMETER;
 	}
-	fds_record_desc_t recordDesc;
 	cs_ret_code_t csRetCode = ERR_NOT_FOUND;
+#if BUILD_FLASH_RECORD_INDEX == 1
+	cs_storage_record_index_entry_t* entry = _recordIndex.findNext(recordKey);
+	while (entry != nullptr) {
+		csRetCode = readRecord(entry->recordDesc, buf, size, fileId);
+		if (csRetCode == ERR_SUCCESS) {
+			return csRetCode;
+		}
+		entry = _recordIndex.findNext(recordKey);
+	}
+#else
+	fds_record_desc_t recordDesc;
 	while (fds_record_find_by_key(recordKey, &recordDesc, &_findToken) == NRF_SUCCESS) {
 		csRetCode = readRecord(recordDesc, buf, size, fileId);
 		if (csRetCode == ERR_SUCCESS) {
 			return csRetCode;
 		}
 	}
+#endif
 	return csRetCode;
 }
 
-cs_ret_code_t Storage::readRecord(fds_record_desc_t recordDesc, uint8_t* buf, uint16_t size, uint16_t& fileId) {
+cs_ret_code_t Storage::readRecord(fds_record_desc_t& recordDesc, uint8_t* buf, uint16_t size, uint16_t& fileId) {
 	fds_flash_record_t flashRecord;
 	ret_code_t fdsRetCode = fds_record_open(&recordDesc, &flashRecord);
 	switch (fdsRetCode) {
@@ -336,6 +369,7 @@ ret_code_t Storage::writeInternal(const cs_state_data_t& stateData) {
 	switch (fdsRetCode) {
 		case NRF_SUCCESS:
 			setBusy(recordKey);
+			_stats.onWrite(stateData.type);
 			LOGStorageVerbose("Started writing");
 			break;
 		case FDS_ERR_NO_SPACE_IN_FLASH: {
@@ -383,6 +417,7 @@ cs_ret_code_t Storage::remove(CS_TYPE type, cs_state_id_t id) {
 		LOGStorageVerbose("fds_record_delete %u", fdsRetCode);
 		if (fdsRetCode == NRF_SUCCESS) {
 			setBusy(recordKey);
+			_stats.onRemove(type);
 		}
 		else {
 			break;
@@ -415,6 +450,7 @@ cs_ret_code_t Storage::remove(CS_TYPE type) {
 		LOGStorageVerbose("fds_record_delete %u", fdsRetCode);
 		if (fdsRetCode == NRF_SUCCESS) {
 			setBusy(recordKey);
+			_stats.onRemove(type);
 		}
 		else {
 			break;
@@ -514,16 +550,7 @@ cs_ret_code_t Storage::continueFactoryReset() {
 		}
 	}
 	LOGStorageInfo("Done removing all records.");
-	fdsRetCode = fds_gc();
-	if (fdsRetCode != NRF_SUCCESS) {
-		LOGw("Failed to start garbage collection (err=%i)", fdsRetCode);
-		return getErrorCode(fdsRetCode);
-	}
-	else {
-		LOGStorageDebug("Started garbage collection");
-		_collectingGarbage = true;
-		return ERR_SUCCESS;
-	}
+	return getErrorCode(startGarbageCollection());
 }
 
 cs_ret_code_t Storage::garbageCollect() {
@@ -535,7 +562,6 @@ ret_code_t Storage::garbageCollectInternal() {
 		LOGe(STR_ERR_NOT_INITIALIZED);
 		return ERR_NOT_INITIALIZED;
 	}
-	ret_code_t fdsRetCode;
 	uint8_t enabled = nrf_sdh_is_enabled();
 	if (!enabled) {
 		LOGe("Softdevice is not enabled yet!");
@@ -543,18 +569,33 @@ ret_code_t Storage::garbageCollectInternal() {
 	if (isBusy()) {
 		return FDS_ERR_BUSY;
 	}
+	return startGarbageCollection();
+}
+
+ret_code_t Storage::startGarbageCollection() {
+	uint32_t freeableWords = getFreeableWords();
 	LOGStorageVerbose("fds_gc");
-	fdsRetCode = fds_gc();
+	ret_code_t fdsRetCode = fds_gc();
 	if (fdsRetCode != NRF_SUCCESS) {
 		LOGw("Failed to start garbage collection (err=%i)", fdsRetCode);
 	}
 	else {
 		LOGStorageDebug("Started garbage collection");
-		_collectingGarbage = true;
+		_collectingGarbage              = true;
+		_garbageCollectionStartCount    = RTC::getCount();
+		_garbageCollectionFreeableWords = freeableWords;
 	}
 	return fdsRetCode;
 }
 
+uint32_t Storage::getFreeableWords() {
+	fds_stat_t stat;
+	if (fds_stat(&stat) != NRF_SUCCESS) {
+		return 0;
+	}
+	return stat.freeable_words;
+}
+
 cs_ret_code_t Storage::eraseAllPages() {
 	LOGw("eraseAllPages");
 	if (_initialized || isErasingPages()) {
@@ -679,6 +720,9 @@ void Storage::initSearch() {
 	// clear fds token before every use
 	memset(&_findToken, 0x00, sizeof(fds_find_token_t));
 	_currentSearchType = CS_TYPE::CONFIG_DO_NOT_USE;
+#if BUILD_FLASH_RECORD_INDEX == 1
+	_recordIndex.initSearch();
+#endif
 }
 
 /**
@@ -688,6 +732,14 @@ void Storage::initSearch() {
  * Returns the last found record.
  */
 ret_code_t Storage::exists(cs_file_id_t fileId, uint16_t recordKey, fds_record_desc_t& record_desc, bool& result) {
+#if BUILD_FLASH_RECORD_INDEX == 1
+	cs_storage_record_index_entry_t* entry = _recordIndex.find(recordKey, fileId);
+	result                                 = (entry != nullptr);
+	if (result) {
+		record_desc = entry->recordDesc;
+	}
+	return ERR_SUCCESS;
+#else
 	initSearch();
 	result = false;
 	while (fds_record_find(fileId, recordKey, &record_desc, &_findToken) == NRF_SUCCESS) {
@@ -699,15 +751,47 @@ ret_code_t Storage::exists(cs_file_id_t fileId, uint16_t recordKey, fds_record_d
 		}
 	}
 	return ERR_SUCCESS;
+#endif
+}
+
+#if BUILD_FLASH_RECORD_INDEX == 1
+/**
+ * In case of duplicates, the last found record is indexed, like read() uses the last found record.
+ */
+void Storage::buildRecordIndex() {
+	uint32_t startCount = RTC::getCount();
+	_recordIndex.clear();
+	fds_record_desc_t recordDesc;
+	fds_flash_record_t flashRecord;
+	initSearch();
+	while (fds_record_iterate(&recordDesc, &_findToken) == NRF_SUCCESS) {
+		if (fds_record_open(&recordDesc, &flashRecord) != NRF_SUCCESS) {
+			LOGw("Skip record addr=%p", recordDesc.p_record);
+			continue;
+		}
+		uint16_t recordKey = flashRecord.p_header->record_key;
+		uint16_t fileId    = flashRecord.p_header->file_id;
+		if (fds_record_close(&recordDesc) != NRF_SUCCESS) {
+			LOGe("Error on closing record");
+		}
+		_recordIndex.append(recordKey, fileId, recordDesc);
+	}
+	_recordIndex.sort();
+	LOGStorageInit("Indexed %u records in %u ms", _recordIndex.size(), RTC::msPassedSince(startCount));
 }
+#endif
 
 void Storage::setBusy(uint16_t recordKey) {
-	_busyRecordKeys.push_back(recordKey);
+	_busyRecordKeys.push_back({recordKey, RTC::getCount()});
 }
 
+/**
+ * FDS handles operations in order, so the first busy entry of a record key belongs to the oldest operation.
+ */
 void Storage::clearBusy(uint16_t recordKey) {
 	for (auto it = _busyRecordKeys.begin(); it != _busyRecordKeys.end(); it++) {
-		if (*it == recordKey) {
+		if (it->recordKey == recordKey) {
+			_stats.onOperationDone(RTC::msPassedSince(it->startCount));
 			_busyRecordKeys.erase(it);
 			return;
 		}
@@ -723,7 +807,7 @@ bool Storage::isBusy(uint16_t recordKey) {
 		return true;
 	}
 	for (auto it = _busyRecordKeys.begin(); it != _busyRecordKeys.end(); it++) {
-		if (*it == recordKey) {
+		if (it->recordKey == recordKey) {
 			LOGw("Busy with record %u", recordKey);
 			return true;
 		}
@@ -789,6 +873,12 @@ void Storage::handleWriteEvent(fds_evt_t const* p_fds_evt) {
 	eventData.id   = getStateId(p_fds_evt->write.file_id);
 	switch (p_fds_evt->result) {
 		case NRF_SUCCESS: {
+#if BUILD_FLASH_RECORD_INDEX == 1
+			// The record has not been read yet, so FDS will look up the record by id on first read.
+			fds_record_desc_t recordDesc = {};
+			recordDesc.record_id         = p_fds_evt->write.record_id;
+			_recordIndex.add(p_fds_evt->write.record_key, p_fds_evt->write.file_id, recordDesc);
+#endif
 			LOGStorageWrite(
 					"Write done, key=%u file=%u type=%u id=%u",
 					p_fds_evt->del.record_key,
@@ -821,6 +911,9 @@ void Storage::handleRemoveRecordEvent(fds_evt_t const* p_fds_evt) {
 	eventData.id   = getStateId(p_fds_evt->del.file_id);
 	switch (p_fds_evt->result) {
 		case NRF_SUCCESS: {
+#if BUILD_FLASH_RECORD_INDEX == 1
+			_recordIndex.remove(p_fds_evt->del.record_key, p_fds_evt->del.file_id);
+#endif
 			LOGStorageInfo(
 					"Remove done, key=%u file=%u type=%u id=%u",
 					p_fds_evt->del.record_key,
@@ -855,6 +948,9 @@ void Storage::handleRemoveFileEvent(fds_evt_t const* p_fds_evt) {
 	cs_state_id_t id = getStateId(p_fds_evt->write.file_id);
 	switch (p_fds_evt->result) {
 		case NRF_SUCCESS: {
+#if BUILD_FLASH_RECORD_INDEX == 1
+			_recordIndex.removeFile(p_fds_evt->del.file_id);
+#endif
 			LOGStorageInfo("Remove file done, file=%u id=%u", p_fds_evt->del.file_id, id);
 			event_t event(CS_TYPE::EVT_STORAGE_REMOVE_ALL_TYPES_WITH_ID_DONE, &id, sizeof(id));
 			EventDispatcher::getInstance().dispatch(event);
@@ -876,7 +972,14 @@ void Storage::handleGarbageCollectionEvent(fds_evt_t const* p_fds_evt) {
 	_collectingGarbage = false;
 	switch (p_fds_evt->result) {
 		case NRF_SUCCESS: {
-			LOGStorageInfo("Garbage collection successful");
+			uint32_t durationMs     = RTC::msPassedSince(_garbageCollectionStartCount);
+			uint32_t freeableWords  = getFreeableWords();
+			uint32_t reclaimedWords = 0;
+			if (_garbageCollectionFreeableWords > freeableWords) {
+				reclaimedWords = _garbageCollectionFreeableWords - freeableWords;
+			}
+			_stats.onGarbageCollectionDone(durationMs, reclaimedWords * sizeof(uint32_t));
+			LOGStorageInfo("Garbage collection successful, took %u ms, reclaimed %u words", durationMs, reclaimedWords);
 			if (_performingFactoryReset) {
 				_performingFactoryReset = false;
 				event_t resetEvent(CS_TYPE::EVT_STORAGE_FACTORY_RESET_DONE);
@@ -920,6 +1023,9 @@ void Storage::handleFileStorageEvent(fds_evt_t const* p_fds_evt) {
 		case FDS_EVT_INIT: {
 			if (p_fds_evt->result == NRF_SUCCESS) {
 				LOGStorageInit("Storage initialized");
+#if BUILD_FLASH_RECORD_INDEX == 1
+				buildRecordIndex();
+#endif
 				_initialized = true;
 				event_t event(CS_TYPE::EVT_STORAGE_INITIALIZED);
 				EventDispatcher::getInstance().dispatch(event);
@@ -49,7 +49,7 @@ Twi& Twi::getInstance() {
 }
 
 Twi::Twi() : EventListener(), _initialized(false), _initializedBus(false) {
-	EventDispatcher::getInstance().addListener(this);
+	listen({CS_TYPE::EVT_TWI_INIT, CS_TYPE::EVT_TWI_WRITE, CS_TYPE::EVT_TWI_READ});
 
 	_eventRead  = false;
 	_eventError = false;
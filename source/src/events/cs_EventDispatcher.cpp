@@ -41,42 +41,154 @@ void EventDispatcher::dispatch(event_t& event) {
 			}
 	}
 
-	for (int i = 0; i < _listenerCount; i++) {
-			_listeners[i]->handleEvent(event);
+	event_listener_mask_t listeners = _broadcastListeners | getSubscribers(event.type);
+	while (listeners != 0) {
+		// Iterate over the set bits, from low to high, so that the listeners are called in order of registration.
+		uint8_t listenerIndex = __builtin_ctzll(listeners);
+		listeners &= listeners - 1;
+		_listeners[listenerIndex]->handleEvent(event);
 	}
 }
 
 bool EventDispatcher::addListener(EventListener* listener) {
-	if (_listenerCount >= MAX_EVENT_LISTENERS - 1) {
-		APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
-		return false;
-	}
 	if (listener == nullptr) {
 		APP_ERROR_HANDLER(NRF_ERROR_NULL);
 		return false;
 	}
 
-	// check for duplicate registration
-	for (uint8_t listenerIndex = 0; listenerIndex < _listenerCount; listenerIndex++) {
-		if (_listeners[listenerIndex] == listener) {
+	int listenerIndex = getListenerIndex(listener);
+	if (listenerIndex < 0) {
+		if (_listenerCount >= MAX_EVENT_LISTENERS - 1) {
+			APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
+			return false;
+		}
+		listenerIndex             = _listenerCount++;
+		_listeners[listenerIndex] = listener;
+	}
+	else {
+		clearSubscriptions(listenerIndex, false);
+	}
+
+	_broadcastListeners |= (event_listener_mask_t)1 << listenerIndex;
+	return true;
+}
+
+bool EventDispatcher::addListener(EventListener* listener, const CS_TYPE* types, uint8_t typeCount) {
+	if (!addListener(listener)) {
+		return false;
+	}
+	uint8_t listenerIndex = getListenerIndex(listener);
+
+	for (uint8_t i = 0; i < typeCount; ++i) {
+		if (!addSubscription(types[i], listenerIndex)) {
+			LOGEventdispatcherWarning("Subscription table full: listener %u will receive all events", listenerIndex);
+			clearSubscriptions(listenerIndex, false);
 			return true;
 		}
 	}
 
-	_listeners[_listenerCount++] = listener;
+	_broadcastListeners &= ~((event_listener_mask_t)1 << listenerIndex);
 	return true;
 }
 
 void EventDispatcher::removeListener(EventListener* listener) {
-	for (int i = 1; i < _listenerCount; i++) {
+	int listenerIndex = getListenerIndex(listener);
+	if (listenerIndex < 0) {
+		return;
+	}
+
+	clearSubscriptions(listenerIndex, true);
+
+	// Shift tail down one index.
+	for (int j = listenerIndex + 1; j < _listenerCount; j++) {
+		_listeners[j - 1] = _listeners[j];
+	}
+	// toss out duplicate
+	_listeners[_listenerCount - 1] = nullptr;
+	_listenerCount--;
+}
+
+int EventDispatcher::getListenerIndex(EventListener* listener) {
+	for (int i = 0; i < _listenerCount; i++) {
 		if (_listeners[i] == listener) {
-			// found match, shifting tail down one index
-			for( int j = i+1; j < _listenerCount; j++) {
-				_listeners[j-1] = _listeners[j];
-			}
-			// toss out duplicate
-			_listeners[_listenerCount -1] = nullptr;
-			_listenerCount--;
+			return i;
+		}
+	}
+	return -1;
+}
+
+uint8_t EventDispatcher::lowerBound(CS_TYPE type) {
+	uint8_t low  = 0;
+	uint8_t high = _subscriptionCount;
+	while (low < high) {
+		uint8_t mid = (low + high) / 2;
+		if (_subscriptionTypes[mid] < type) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+event_listener_mask_t EventDispatcher::getSubscribers(CS_TYPE type) {
+	uint8_t index = lowerBound(type);
+	if (index < _subscriptionCount && _subscriptionTypes[index] == type) {
+		return _subscriptionListeners[index];
+	}
+	return 0;
+}
+
+bool EventDispatcher::addSubscription(CS_TYPE type, uint8_t listenerIndex) {
+	event_listener_mask_t listenerBit = (event_listener_mask_t)1 << listenerIndex;
+	uint8_t index                     = lowerBound(type);
+	if (index < _subscriptionCount && _subscriptionTypes[index] == type) {
+		_subscriptionListeners[index] |= listenerBit;
+		return true;
+	}
+
+	if (_subscriptionCount >= MAX_EVENT_SUBSCRIPTIONS) {
+		return false;
+	}
+
+	// Insert a new entry, keeping the table sorted.
+	for (uint8_t i = _subscriptionCount; i > index; --i) {
+		_subscriptionTypes[i]     = _subscriptionTypes[i - 1];
+		_subscriptionListeners[i] = _subscriptionListeners[i - 1];
+	}
+	_subscriptionTypes[index]     = type;
+	_subscriptionListeners[index] = listenerBit;
+	_subscriptionCount++;
+	return true;
+}
+
+/**
+ * Removes the bit at given index from the mask.
+ * When shifting, all higher bits are moved down one position.
+ */
+static event_listener_mask_t removeBit(event_listener_mask_t mask, uint8_t index, bool shift) {
+	event_listener_mask_t bit = (event_listener_mask_t)1 << index;
+	if (!shift) {
+		return mask & ~bit;
+	}
+	event_listener_mask_t lowerBits = bit - 1;
+	return (mask & lowerBits) | ((mask >> 1) & ~lowerBits);
+}
+
+void EventDispatcher::clearSubscriptions(uint8_t listenerIndex, bool shift) {
+	_broadcastListeners = removeBit(_broadcastListeners, listenerIndex, shift);
+
+	// Remove the listener from each entry, and remove entries without subscribers.
+	uint8_t newCount = 0;
+	for (uint8_t i = 0; i < _subscriptionCount; ++i) {
+		event_listener_mask_t listeners = removeBit(_subscriptionListeners[i], listenerIndex, shift);
+		if (listeners == 0) {
+			continue;
 		}
+		_subscriptionTypes[newCount]     = _subscriptionTypes[i];
+		_subscriptionListeners[newCount] = listeners;
+		newCount++;
 	}
+	_subscriptionCount = newCount;
 }
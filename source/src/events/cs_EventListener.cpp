@@ -12,6 +12,10 @@ void EventListener::listen() {
 	EventDispatcher::getInstance().addListener(this);
 }
 
+void EventListener::listen(std::initializer_list<CS_TYPE> types) {
+	EventDispatcher::getInstance().addListener(this, types.begin(), types.size());
+}
+
 EventListener::~EventListener() {
 	EventDispatcher::getInstance().removeListener(this);
 }
@@ -150,11 +150,15 @@ AssetFilterMetadata AssetFilterData::metadata() {
 }
 
 CuckooFilter AssetFilterData::cuckooFilter() {
-	return CuckooFilter(reinterpret_cast<cuckoo_filter_data_t*>(_data + metadata().length()));
+	CuckooFilterHashVersion hashVersion = CuckooFilterHashVersion::Crc16Djb2;
+	if (metadata().flags()->flags.fnv1aHash) {
+		hashVersion = CuckooFilterHashVersion::Fnv1a;
+	}
+	return CuckooFilter(reinterpret_cast<cuckoo_filter_data_t*>(_data + metadata().length()), hashVersion);
 }
 
-ExactMatchFilter AssetFilterData::exactMatchFilter() {
-	return ExactMatchFilter(reinterpret_cast<exact_match_filter_data_t*>(_data + metadata().length()));
+ExactMatchFilter AssetFilterData::exactMatchFilter(ExactMatchFilterLayout layout) {
+	return ExactMatchFilter(reinterpret_cast<exact_match_filter_data_t*>(_data + metadata().length()), layout);
 }
 
 bool AssetFilterData::isValid() {
@@ -419,7 +419,10 @@ void AssetFilterStore::endInProgress(uint16_t newMasterVersion, uint32_t newMast
 	_modificationInProgressCountdown             = 0;
 
 	TYPIFY(STATE_ASSET_FILTERS_VERSION) stateVal = {.masterVersion = _masterVersion, .masterCrc = _masterCrc};
-	State::getInstance().set(CS_TYPE::STATE_ASSET_FILTERS_VERSION, &stateVal, sizeof(stateVal));
+	// Write back, so that the version is written to flash together with the filters.
+	cs_state_data_t stateData(
+			CS_TYPE::STATE_ASSET_FILTERS_VERSION, reinterpret_cast<uint8_t*>(&stateVal), sizeof(stateVal));
+	State::getInstance().setWriteBack(stateData);
 
 	sendInProgressStatus();
 }
@@ -478,6 +481,8 @@ cs_ret_code_t AssetFilterStore::commit(uint16_t masterVersion, uint32_t masterCr
 
 	markFiltersCommitted();
 
+	applyLookupLayouts();
+
 	endInProgress(masterVersion, masterCrc);
 	return ERR_SUCCESS;
 }
@@ -602,7 +607,7 @@ void AssetFilterStore::storeFilters() {
 				filter.filterdata()._data,
 				getStateSize(filter.filterdata().length()));
 		LOGAssetFilterDebug("store stateType=%u stateId=%u size=%u", stateData.type, stateData.id, stateData.size);
-		State::getInstance().set(stateData);
+		State::getInstance().setWriteBack(stateData);
 	}
 }
 
@@ -701,3 +706,27 @@ void AssetFilterStore::markFiltersCommitted() {
 		filter.runtimedata()->flags.flags.committed = true;
 	}
 }
+
+void AssetFilterStore::applyLookupLayouts() {
+	LOGAssetFilterDebug("applyLookupLayouts");
+	for (uint8_t* filterBuffer : _filters) {
+		if (filterBuffer == nullptr) {
+			break;
+		}
+
+		AssetFilter filter(filterBuffer);
+		if (*filter.filterdata().metadata().filterType() != AssetFilterType::ExactMatchFilter
+			|| filter.runtimedata()->flags.flags.eytzingerLayout == true) {
+			continue;
+		}
+
+		cs_ret_code_t retCode = filter.exactMatchFilter().toEytzingerLayout();
+		if (retCode != ERR_SUCCESS) {
+			// The filter still works in the sorted layout, just slower.
+			LOGAssetFilterWarn(
+					"Failed to reorder filter filterId=%u, retCode=%u", filter.runtimedata()->filterId, retCode);
+			continue;
+		}
+		filter.runtimedata()->flags.flags.eytzingerLayout = true;
+	}
+}
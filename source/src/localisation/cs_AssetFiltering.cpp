@@ -128,6 +128,11 @@ void AssetFiltering::handleEvent(event_t& evt) {
 			handleScannedDevice(*scannedDevice);
 			break;
 		}
+		case CS_TYPE::EVT_FILTERS_UPDATED:
+		case CS_TYPE::EVT_FILTER_MODIFICATION: {
+			_filterPlanOutdated = true;
+			break;
+		}
 		default: break;
 	}
 }
@@ -147,35 +152,34 @@ void AssetFiltering::handleScannedDevice(const scanned_device_t& asset) {
 			asset.address[0]);
 	_logArray(LogLevelAssetFilteringVerbose, true, asset.data, asset.dataSize);
 
-	if (isAssetRejected(asset)) {
+	if (_filterPlanOutdated) {
+		updateFilterPlan();
+	}
+
+	uint8_t acceptingFilters;
+	std::optional<uint8_t> rejectingFilterIndex = _filterPlan.evaluate(asset, acceptingFilters);
+	if (rejectingFilterIndex) {
+		LogAcceptedDevice(_filterStore->getFilter(*rejectingFilterIndex), asset, true);
 		return;
 	}
 
 	for (uint8_t filterIndex = 0; filterIndex < _filterStore->getFilterCount(); ++filterIndex) {
-		checkIfFilterAccepts(filterIndex, asset);
+		if (CsUtils::isBitSet(acceptingFilters, filterIndex)) {
+			handleAcceptingFilter(filterIndex, asset);
+		}
 	}
 
 	_assetForwarder->flush();
 }
 
-bool AssetFiltering::checkIfFilterAccepts(uint8_t filterIndex, const scanned_device_t& device) {
+void AssetFiltering::handleAcceptingFilter(uint8_t filterIndex, const scanned_device_t& device) {
 	auto filter = AssetFilter(_filterStore->getFilter(filterIndex));
 
-	if (filter.filterdata().metadata().flags()->flags.exclude) {
-		return false;
-	}
-
-	if (filter.filterAcceptsScannedDevice(device)) {
-		handleAcceptedAsset(filterIndex, filter, device);
+	handleAcceptedAsset(filterIndex, filter, device);
 
-		AssetAcceptedEvent evtData(filter, device);
-		event_t assetEvent(CS_TYPE::EVT_ASSET_ACCEPTED, &evtData, sizeof(evtData));
-		assetEvent.dispatch();
-
-		return true;
-	}
-
-	return false;
+	AssetAcceptedEvent evtData(filter, device);
+	event_t assetEvent(CS_TYPE::EVT_ASSET_ACCEPTED, &evtData, sizeof(evtData));
+	assetEvent.dispatch();
 }
 
 void AssetFiltering::handleAcceptedAsset(uint8_t filterIndex, AssetFilter filter, const scanned_device_t& asset) {
@@ -286,19 +290,13 @@ void AssetFiltering::handleAcceptedAssetOutputAssetIdNearest(
 
 // ---------------------------- utils ----------------------------
 
-bool AssetFiltering::isAssetRejected(const scanned_device_t& device) {
-	// Rejection check: looping over exclusion filters.
+void AssetFiltering::updateFilterPlan() {
+	static_assert(AssetFilterStore::MAX_FILTER_IDS <= AssetFilterPlan::MAX_FILTERS, "Filter plan is too small");
+	_filterPlan.clear();
 	for (uint8_t i = 0; i < _filterStore->getFilterCount(); ++i) {
-		auto filter = AssetFilter(_filterStore->getFilter(i));
-
-		if (filter.filterdata().metadata().flags()->flags.exclude == true) {
-			if (filter.filterAcceptsScannedDevice(device)) {
-				// Reject by early return.
-				LogAcceptedDevice(filter, device, true);
-				return true;
-			}
-		}
+		_filterPlan.add(_filterStore->getFilter(i));
 	}
-
-	return false;
+	_filterPlanOutdated = false;
+	LOGAssetFilteringDebug(
+			"Filter plan: filters=%u inputs=%u", _filterStore->getFilterCount(), _filterPlan.getInputCount());
 }
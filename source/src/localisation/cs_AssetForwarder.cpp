@@ -18,7 +18,7 @@
 cs_ret_code_t AssetForwarder::init() {
 	State::getInstance().get(CS_TYPE::CONFIG_CROWNSTONE_ID, &_myStoneId, sizeof(_myStoneId));
 	clearOutbox();
-	listen();
+	listen({CS_TYPE::EVT_RECV_MESH_MSG});
 	return ERR_SUCCESS;
 }
 
@@ -92,9 +92,11 @@ asset_record_t* AssetStore::getOrCreateRecord(const asset_id_t& id) {
 			oldestRecord->assetId.data[1],
 			oldestRecord->assetId.data[2]);
 
-	oldestRecord->empty();
-	oldestRecord->assetId = id;
-	return oldestRecord;
+	_store.remove(oldestRecord);
+	asset_record_t* rec = _store.getOrAdd(id);
+	rec->empty();
+	rec->assetId = id;
+	return rec;
 }
 
 void AssetStore::addThrottlingBump(asset_record_t& record, uint16_t timeToNextThrottleOpenMs) {
@@ -132,7 +134,7 @@ void AssetStore::incrementLastReceivedCounters() {
 					record.assetId.data[0],
 					record.assetId.data[1],
 					record.assetId.data[2]);
-			record.invalidate();
+			_store.remove(&record);
 		}
 	}
 }
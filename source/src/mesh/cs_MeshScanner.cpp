@@ -9,6 +9,7 @@
 #include <events/cs_Event.h>
 #include <mesh/cs_MeshScanner.h>
 #include <structs/cs_PacketsInternal.h>
+#include <util/cs_Utils.h>
 
 #include <cstring>
 
@@ -38,6 +39,11 @@ void MeshScanner::onScan(const nrf_mesh_adv_packet_rx_data_t* scanData) {
 			_scannedDevice.dataSize               = scanData->length;
 			_scannedDevice.data                   = const_cast<uint8_t*>(scanData->p_payload);
 
+			// Parse the AD structures once, for all handlers of the event.
+			adv_index_t advIndex;
+			CsUtils::indexAdvTypes(_scannedDevice.data, _scannedDevice.dataSize, advIndex);
+			_scannedDevice.advIndex = &advIndex;
+
 			event_t event(CS_TYPE::EVT_DEVICE_SCANNED, static_cast<void*>(&_scannedDevice), sizeof(_scannedDevice));
 			event.dispatch();
 			break;
@@ -197,12 +197,12 @@ void MicroappInterruptHandler::onDeviceScanned(scanned_device_t& dev) {
 			cs_data_t advData;
 			cs_ret_code_t retCode;
 
-			retCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME, dev.data, dev.dataSize, &advData);
+			retCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME, dev, &advData);
 			if (retCode == ERR_SUCCESS && filter.name.size == advData.len) {
 				passedFilter = (memcmp(filter.name.name, advData.data, advData.len) == 0);
 			}
 
-			retCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME, dev.data, dev.dataSize, &advData);
+			retCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME, dev, &advData);
 			if (retCode == ERR_SUCCESS && filter.name.size == advData.len) {
 				passedFilter = (memcmp(filter.name.name, advData.data, advData.len) == 0);
 			}
@@ -218,8 +218,7 @@ void MicroappInterruptHandler::onDeviceScanned(scanned_device_t& dev) {
 			cs_ret_code_t retCode;
 			uint16_t* services;
 
-			retCode = CsUtils::findAdvType(
-					BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE, dev.data, dev.dataSize, &advData);
+			retCode  = CsUtils::findAdvType(BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE, dev, &advData);
 			services = reinterpret_cast<uint16_t*>(advData.data);
 			if (retCode == ERR_SUCCESS) {
 				for (uint8_t i = 0; i < advData.len / sizeof(services[0]); ++i) {
@@ -230,8 +229,7 @@ void MicroappInterruptHandler::onDeviceScanned(scanned_device_t& dev) {
 				}
 			}
 
-			retCode =
-					CsUtils::findAdvType(BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE, dev.data, dev.dataSize, &advData);
+			retCode  = CsUtils::findAdvType(BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE, dev, &advData);
 			services = reinterpret_cast<uint16_t*>(advData.data);
 			if (retCode == ERR_SUCCESS) {
 				for (uint8_t i = 0; i < advData.len / sizeof(services[0]); ++i) {
@@ -31,17 +31,13 @@
 
 BackgroundAdvertisementHandler::BackgroundAdvertisementHandler() {
 	State::getInstance().get(CS_TYPE::CONFIG_SPHERE_ID, &_sphereId, sizeof(_sphereId));
-	EventDispatcher::getInstance().addListener(this);
+	listen({CS_TYPE::EVT_DEVICE_SCANNED, CS_TYPE::EVT_ADV_BACKGROUND});
 }
 
 void BackgroundAdvertisementHandler::parseServicesAdvertisement(scanned_device_t* scannedDevice) {
 	uint32_t errCode;
 	cs_data_t serviceUuids;
-	errCode = CsUtils::findAdvType(
-			BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE,
-			scannedDevice->data,
-			scannedDevice->dataSize,
-			&serviceUuids);
+	errCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE, *scannedDevice, &serviceUuids);
 	if (errCode != ERR_SUCCESS) {
 		return;
 	}
@@ -82,11 +78,7 @@ void BackgroundAdvertisementHandler::parseServicesAdvertisement(scanned_device_t
 void BackgroundAdvertisementHandler::parseAdvertisement(scanned_device_t* scannedDevice) {
 	uint32_t errCode;
 	cs_data_t manufacturerData;
-	errCode = CsUtils::findAdvType(
-			BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
-			scannedDevice->data,
-			scannedDevice->dataSize,
-			&manufacturerData);
+	errCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA, *scannedDevice, &manufacturerData);
 	if (errCode != ERR_SUCCESS) {
 		return;
 	}
@@ -42,8 +42,8 @@ constexpr int8_t RSSI_LOG_THRESHOLD = -40;
 CommandAdvHandler::CommandAdvHandler() {}
 
 void CommandAdvHandler::init() {
-	State::getInstance().get(CS_TYPE::CONFIG_SPHERE_ID, &_sphereId, sizeof(_sphereId));
-	EventDispatcher::getInstance().addListener(this);
+	_sphereId = State::getInstance().get<CS_TYPE::CONFIG_SPHERE_ID>();
+	listen({CS_TYPE::EVT_DEVICE_SCANNED, CS_TYPE::EVT_TICK});
 }
 
 void CommandAdvHandler::parseAdvertisement(scanned_device_t* scannedDevice) {
@@ -69,17 +69,12 @@ void CommandAdvHandler::parseAdvertisement(scanned_device_t* scannedDevice) {
 
 	uint32_t errCode;
 	cs_data_t services16bit;
-	errCode = CsUtils::findAdvType(
-			BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE, scannedDevice->data, scannedDevice->dataSize, &services16bit);
+	errCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE, *scannedDevice, &services16bit);
 	if (errCode != ERR_SUCCESS) {
 		return;
 	}
 	cs_data_t services128bit;
-	errCode = CsUtils::findAdvType(
-			BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE,
-			scannedDevice->data,
-			scannedDevice->dataSize,
-			&services128bit);
+	errCode = CsUtils::findAdvType(BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE, *scannedDevice, &services128bit);
 	if (errCode != ERR_SUCCESS) {
 		return;
 	}
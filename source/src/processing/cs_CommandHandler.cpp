@@ -222,6 +222,10 @@ void CommandHandler::_handleCommand(
 			return dispatchEventForCommand(CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS, commandData, source, result);
 		case CTRL_CMD_GET_RAM_STATS:
 			return dispatchEventForCommand(CS_TYPE::CMD_GET_RAM_STATS, commandData, source, result);
+		case CTRL_CMD_GET_STORAGE_STATS:
+			return dispatchEventForCommand(CS_TYPE::CMD_GET_STORAGE_STATS, commandData, source, result);
+		case CTRL_CMD_GET_SOFTFUSE_LATENCY:
+			return dispatchEventForCommand(CS_TYPE::CMD_GET_SOFTFUSE_LATENCY, commandData, source, result);
 		case CTRL_CMD_MICROAPP_GET_INFO:
 			return dispatchEventForCommand(CS_TYPE::CMD_MICROAPP_GET_INFO, commandData, source, result);
 		case CTRL_CMD_MICROAPP_VALIDATE:
@@ -1141,6 +1145,7 @@ EncryptionAccessLevel CommandHandler::getRequiredAccessLevel(const CommandHandle
 		case CTRL_CMD_GET_GPREGRET:
 		case CTRL_CMD_GET_ADC_CHANNEL_SWAPS:
 		case CTRL_CMD_GET_RAM_STATS:
+		case CTRL_CMD_GET_STORAGE_STATS:
 		case CTRL_CMD_MICROAPP_GET_INFO:
 		case CTRL_CMD_MICROAPP_UPLOAD:
 		case CTRL_CMD_MICROAPP_VALIDATE:
@@ -1149,6 +1154,7 @@ EncryptionAccessLevel CommandHandler::getRequiredAccessLevel(const CommandHandle
 		case CTRL_CMD_MICROAPP_DISABLE:
 		case CTRL_CMD_MICROAPP_MESSAGE:
 		case CTRL_CMD_CLEAN_FLASH:
+		case CTRL_CMD_GET_SOFTFUSE_LATENCY:
 		case CTRL_CMD_FILTER_UPLOAD:
 		case CTRL_CMD_FILTER_REMOVE:
 		case CTRL_CMD_FILTER_COMMIT:
@@ -5,71 +5,145 @@
  * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
  */
 
-// typename uint8_t median_filter_data_t;
+#include <processing/cs_MedianFilter.h>
 
-typedef struct node {
-	value_id_t index;
-	struct node* next;
-} node_t;
-
-MedianFilter::MedianFilter() {
-	// list of node_t elements
-	_nodes = calloc(sizeof(node_t), SLIDING_WINDOW_SIZE);
-	// start with a sequential order
-	for (uint8_t i = 0; i < SLIDING_WINDOW_SIZE - 1; ++i) {
-		_nodes[i].next  = _nodes[j];
-		_nodes[i].index = i;
-	}
+SlidingMedianFilter::SlidingMedianFilter(uint16_t halfWindowSize)
+		: _halfWindowSize(halfWindowSize), _windowSize(2 * halfWindowSize + 1) {
+	_heapPositions  = new int16_t[_windowSize];
+	_heapValuesBuf  = new adc_sample_value_t[_windowSize];
+	_heapIndicesBuf = new uint16_t[_windowSize];
+	_heapValues     = _heapValuesBuf + _halfWindowSize;
+	_heapIndices    = _heapIndicesBuf + _halfWindowSize;
+	reset(0);
 }
 
-MedianFilter::~MedianFilter() {}
+SlidingMedianFilter::~SlidingMedianFilter() {
+	delete[] _heapPositions;
+	delete[] _heapValuesBuf;
+	delete[] _heapIndicesBuf;
+}
 
-void MedianFilter::init(uint8_t sliding_window_size) {
-	// create linked list
-	for (uint8_t i = 0; i < sliding_window_size - 1; ++i) {
+/**
+ * The first output sample needs the first sample as padding, followed by the first halfWindowSize samples. After that,
+ * each new input sample gives an output sample. By then, the output index lags the input index by halfWindowSize.
+ */
+void SlidingMedianFilter::filter(
+		const adc_sample_value_t* input, adc_sample_value_t* output, uint16_t stride, uint16_t numSamples) {
+	if (numSamples == 0) {
+		return;
+	}
+	reset(input[0]);
+	uint16_t lastIndex = numSamples - 1;
+	for (uint16_t i = 1; i <= _halfWindowSize; ++i) {
+		insert(input[(i < lastIndex ? i : lastIndex) * stride]);
+	}
+	for (uint16_t i = 0; i < numSamples; ++i) {
+		if (i != 0) {
+			uint32_t inputIndex = i + _halfWindowSize;
+			insert(input[(inputIndex < lastIndex ? inputIndex : lastIndex) * stride]);
+		}
+		output[i * stride] = getMedian();
 	}
 }
 
 /**
- * Use an insert operation that has some state information.
+ * When all values are equal, any order is a valid heap, so simply alternate between max heap and min heap.
  */
-void MedianFilter::sorted_insert(value_id_t value_id, value_t value, bool& start) {
-	value_t pvalue = _buffer.getValue(buffer_id, channel_id, _nodes[0].index);
-	if (value > pvalue) {
-		value_id_t pvalue_id = _nodes[0].index;
+void SlidingMedianFilter::reset(adc_sample_value_t value) {
+	for (uint16_t i = 0; i < _windowSize; ++i) {
+		int16_t position       = ((i + 1) / 2) * ((i & 1) ? -1 : 1);
+		_heapPositions[i]      = position;
+		_heapValues[position]  = value;
+		_heapIndices[position] = i;
 	}
-	// we can have a hypothesis about where to insert the next element because we expect a sine wave
-	// if the sine wave is descending the next item should be inserted in the front
-	// if it is ascending the next item should be inserted in the back
-	// if it is switching from descending to ascending the insert gradually shifts from front to back and other way
-	// around
+	_oldest = 0;
+}
+
+void SlidingMedianFilter::insert(adc_sample_value_t value) {
+	int16_t position       = _heapPositions[_oldest];
+	adc_sample_value_t old = _heapValues[position];
+	_heapValues[position]  = value;
+	if (++_oldest == _windowSize) {
+		_oldest = 0;
+	}
+
+	if (position > 0) {
+		// Value is in the min heap.
+		if (old < value) {
+			minSortDown(position * 2);
+		}
+		else if (minSortUp(position)) {
+			maxSortDown(-1);
+		}
+	}
+	else if (position < 0) {
+		// Value is in the max heap.
+		if (value < old) {
+			maxSortDown(position * 2);
+		}
+		else if (maxSortUp(position)) {
+			minSortDown(1);
+		}
+	}
+	else {
+		// Value is the median.
+		maxSortDown(-1);
+		minSortDown(1);
+	}
+}
+
+bool SlidingMedianFilter::swapIfLess(int16_t i, int16_t j) {
+	if (!isLess(i, j)) {
+		return false;
+	}
+	adc_sample_value_t value        = _heapValues[i];
+	uint16_t index                  = _heapIndices[i];
+	_heapValues[i]                  = _heapValues[j];
+	_heapIndices[i]                 = _heapIndices[j];
+	_heapValues[j]                  = value;
+	_heapIndices[j]                 = index;
+	_heapPositions[_heapIndices[i]] = i;
+	_heapPositions[index]           = j;
+	return true;
 }
 
 /**
- * Set buffer. We're assuming several things about this buffer:
- *   - Values before and after the buffer can be accessed as well and used as padding for the median filter.
- *   - The buffer is assumed
+ * Position i is a child, compared with its parent at i / 2. Position 1 is compared with the median.
  */
-void MedianFilter::setBuffer(InterleavedBuffer* buffer) {
-	_buffer = buffer;
+void SlidingMedianFilter::minSortDown(int16_t i) {
+	int16_t size = _halfWindowSize;
+	for (; i <= size; i *= 2) {
+		if (i > 1 && i < size && isLess(i + 1, i)) {
+			++i;
+		}
+		if (!swapIfLess(i, i / 2)) {
+			break;
+		}
+	}
 }
 
-void MedianFilter::setPadding(value_id_t padding) {
-	assert(padding > 0, "Padding should be larger than 0");
-	_padding = padding;
+void SlidingMedianFilter::maxSortDown(int16_t i) {
+	int16_t size = _halfWindowSize;
+	for (; i >= -size; i *= 2) {
+		if (i < -1 && i > -size && isLess(i, i - 1)) {
+			--i;
+		}
+		if (!swapIfLess(i / 2, i)) {
+			break;
+		}
+	}
 }
 
-void MedianFilter::run(buffer_id_t buffer_id, channel_id_t channel_id) {
-	_buffer.getBuffer(buffer_id);
-
-	bool start = true;
-	value_t value;
-	for (value_id_t i = -_padding; i < 0; ++i) {
-		value = _buffer.getValue(buffer_id, channel_id, i);
-		sorted_insert(i, value, start)
+bool SlidingMedianFilter::minSortUp(int16_t i) {
+	while (i > 0 && swapIfLess(i, i / 2)) {
+		i /= 2;
 	}
+	return i == 0;
+}
 
-	for (value_id_t i = -_padding; i < _buffer.getBufferLength() - 1 + _padding; ++i) {
-		_buffer.getValue(buffer_id, channel_id, i);
+bool SlidingMedianFilter::maxSortUp(int16_t i) {
+	while (i < 0 && swapIfLess(i / 2, i)) {
+		i /= 2;
 	}
+	return i == 0;
 }
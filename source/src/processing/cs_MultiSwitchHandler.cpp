@@ -14,7 +14,7 @@ MultiSwitchHandler::MultiSwitchHandler() {}
 
 void MultiSwitchHandler::init() {
 	State::getInstance().get(CS_TYPE::CONFIG_CROWNSTONE_ID, &_ownId, sizeof(_ownId));
-	EventDispatcher::getInstance().addListener(this);
+	listen({CS_TYPE::CMD_MULTI_SWITCH});
 }
 
 void MultiSwitchHandler::handleMultiSwitch(internal_multi_switch_item_t* item, cmd_source_with_counter_t& source) {
@@ -0,0 +1,391 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <processing/cs_PowerKernel.h>
+
+#include <cstring>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include <cmsis_compiler.h>
+#endif
+
+/**
+ * Get halfword 0 of a and b, as halfword 0 and 1.
+ */
+static inline uint32_t packLow(uint32_t a, uint32_t b) {
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+	return __PKHBT(a, b, 16);
+#else
+	return (a & 0xFFFF) | (b << 16);
+#endif
+}
+
+/**
+ * Get halfword 1 of a and b, as halfword 0 and 1.
+ */
+static inline uint32_t packHigh(uint32_t a, uint32_t b) {
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+	return __PKHTB(b, a, 16);
+#else
+	return (a >> 16) | (b & 0xFFFF0000);
+#endif
+}
+
+/**
+ * Add the products of the signed halfwords 0 and of the signed halfwords 1 of x and y to sum.
+ */
+static inline int64_t dualMultiplyAccumulate(uint32_t x, uint32_t y, int64_t sum) {
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+	return static_cast<int64_t>(__SMLALD(x, y, static_cast<uint64_t>(sum)));
+#else
+	return sum + static_cast<int64_t>(static_cast<int16_t>(x)) * static_cast<int16_t>(y)
+		   + static_cast<int64_t>(static_cast<int16_t>(x >> 16)) * static_cast<int16_t>(y >> 16);
+#endif
+}
+
+/**
+ * Subtract the signed halfwords of y from those of x.
+ */
+static inline uint32_t dualSubtract(uint32_t x, uint32_t y) {
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+	return __SSUB16(x, y);
+#else
+	uint32_t low  = static_cast<uint16_t>(static_cast<int16_t>(x) - static_cast<int16_t>(y));
+	uint32_t high = static_cast<uint16_t>(static_cast<int16_t>(x >> 16) - static_cast<int16_t>(y >> 16));
+	return low | (high << 16);
+#endif
+}
+
+/**
+ * Add the products of the signed halfwords 0 and of the signed halfwords 1 of x and y to a 32 bit sum.
+ */
+static inline int32_t dualMultiplyAccumulate32(uint32_t x, uint32_t y, int32_t sum) {
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+	return static_cast<int32_t>(__SMLAD(x, y, static_cast<uint32_t>(sum)));
+#else
+	return sum + static_cast<int16_t>(x) * static_cast<int16_t>(y)
+		   + static_cast<int16_t>(x >> 16) * static_cast<int16_t>(y >> 16);
+#endif
+}
+
+/**
+ * Reads the samples of a buffer with interleaved channels.
+ *
+ * Loads a sample of both channels as one word, so channel 0 ends up in halfword 0 (this is little endian). Then packs
+ * two of those words, to get 2 consecutive samples of a channel in one word.
+ */
+class InterleavedSamples {
+public:
+	explicit InterleavedSamples(const adc_sample_value_t* samples) : _samples(samples) {}
+
+	/**
+	 * Get samples i and i + 1 of both channels, as halfword 0 and 1.
+	 */
+	inline void loadPairs(adc_sample_value_id_t i, uint32_t& channel0, uint32_t& channel1) const {
+		uint32_t pairs[2];
+		memcpy(pairs, _samples + 2 * i, sizeof(pairs));
+		channel0 = packLow(pairs[0], pairs[1]);
+		channel1 = packHigh(pairs[0], pairs[1]);
+	}
+
+	inline int32_t get(adc_channel_id_t channel, adc_sample_value_id_t i) const { return _samples[2 * i + channel]; }
+
+private:
+	const adc_sample_value_t* _samples;
+};
+
+/**
+ * Reads the samples of a buffer with a separate plane per channel: 2 consecutive samples of a channel are loaded as
+ * one word, without packing.
+ */
+class PlanarSamples {
+public:
+	PlanarSamples(const adc_sample_value_t* samples0, const adc_sample_value_t* samples1)
+			: _samples{samples0, samples1} {}
+
+	inline void loadPairs(adc_sample_value_id_t i, uint32_t& channel0, uint32_t& channel1) const {
+		memcpy(&channel0, _samples[0] + i, sizeof(channel0));
+		memcpy(&channel1, _samples[1] + i, sizeof(channel1));
+	}
+
+	inline int32_t get(adc_channel_id_t channel, adc_sample_value_id_t i) const { return _samples[channel][i]; }
+
+private:
+	const adc_sample_value_t* _samples[2];
+};
+
+template <class Samples>
+static inline void accumulate(const Samples& samples, adc_sample_value_id_t numSamples, power_kernel_sums_t& sums) {
+	int32_t sum0       = 0;
+	int32_t sum1       = 0;
+	int64_t squareSum0 = 0;
+	int64_t squareSum1 = 0;
+	int64_t productSum = 0;
+
+	adc_sample_value_id_t i = 0;
+	for (; i + 1 < numSamples; i += 2) {
+		uint32_t channel0;
+		uint32_t channel1;
+		samples.loadPairs(i, channel0, channel1);
+		squareSum0 = dualMultiplyAccumulate(channel0, channel0, squareSum0);
+		squareSum1 = dualMultiplyAccumulate(channel1, channel1, squareSum1);
+		productSum = dualMultiplyAccumulate(channel0, channel1, productSum);
+		sum0 += static_cast<int16_t>(channel0) + static_cast<int16_t>(channel0 >> 16);
+		sum1 += static_cast<int16_t>(channel1) + static_cast<int16_t>(channel1 >> 16);
+	}
+	if (i < numSamples) {
+		int32_t sample0 = samples.get(0, i);
+		int32_t sample1 = samples.get(1, i);
+		sum0 += sample0;
+		sum1 += sample1;
+		squareSum0 += sample0 * sample0;
+		squareSum1 += sample1 * sample1;
+		productSum += sample0 * sample1;
+	}
+
+	sums.numSamples   = numSamples;
+	sums.sum[0]       = sum0;
+	sums.sum[1]       = sum1;
+	sums.squareSum[0] = squareSum0;
+	sums.squareSum[1] = squareSum1;
+	sums.productSum   = productSum;
+}
+
+void powerKernelAccumulate(
+		const adc_sample_value_t* samples, adc_sample_value_id_t numSamples, power_kernel_sums_t& sums) {
+	accumulate(InterleavedSamples(samples), numSamples, sums);
+}
+
+void powerKernelAccumulatePlanar(
+		const adc_sample_value_t* samples0,
+		const adc_sample_value_t* samples1,
+		adc_sample_value_id_t numSamples,
+		power_kernel_sums_t& sums) {
+	accumulate(PlanarSamples(samples0, samples1), numSamples, sums);
+}
+
+void powerKernelAccumulateReference(
+		const adc_sample_value_t* samples, adc_sample_value_id_t numSamples, power_kernel_sums_t& sums) {
+	sums = power_kernel_sums_t();
+	for (adc_sample_value_id_t i = 0; i < numSamples; ++i) {
+		int32_t sample0 = samples[2 * i];
+		int32_t sample1 = samples[2 * i + 1];
+		sums.sum[0] += sample0;
+		sums.sum[1] += sample1;
+		sums.squareSum[0] += sample0 * sample0;
+		sums.squareSum[1] += sample1 * sample1;
+		sums.productSum += sample0 * sample1;
+	}
+	sums.numSamples = numSamples;
+}
+
+static_assert(POWER_KERNEL_PERIOD_LENGTH % 2 == 0, "Harmonic tables need an even number of samples per period");
+
+/**
+ * Cosine and sine of a harmonic over one period, scaled by 32767.
+ */
+struct power_kernel_harmonic_table_t {
+	int16_t cos[POWER_KERNEL_PERIOD_LENGTH] = {0};
+	int16_t sin[POWER_KERNEL_PERIOD_LENGTH] = {0};
+};
+
+struct power_kernel_harmonic_tables_t {
+	power_kernel_harmonic_table_t harmonics[POWER_QUALITY_NUM_HARMONICS];
+};
+
+static constexpr double POWER_KERNEL_PI = 3.14159265358979323846;
+
+/**
+ * Taylor series of the sine, accurate to double precision for angles between -pi and pi.
+ */
+static constexpr double constexprSin(double angle) {
+	double term = angle;
+	double sum  = angle;
+	for (int i = 1; i < 16; ++i) {
+		term *= -angle * angle / ((2 * i) * (2 * i + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Taylor series of the cosine, accurate to double precision for angles between -pi and pi.
+ */
+static constexpr double constexprCos(double angle) {
+	double term = 1.0;
+	double sum  = 1.0;
+	for (int i = 1; i < 16; ++i) {
+		term *= -angle * angle / ((2 * i - 1) * (2 * i));
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Scale to 32767 and round half away from zero, so that opposite values stay opposite.
+ */
+static constexpr int16_t toQ15(double value) {
+	return (value < 0) ? -static_cast<int16_t>(-value * 32767 + 0.5) : static_cast<int16_t>(value * 32767 + 0.5);
+}
+
+/**
+ * Only the first half of the period is calculated: for odd harmonics, the second half is the negated first half.
+ * This makes the tables sum to exactly 0.
+ */
+static constexpr power_kernel_harmonic_tables_t generateHarmonicTables() {
+	power_kernel_harmonic_tables_t tables;
+	constexpr adc_sample_value_id_t halfPeriod = POWER_KERNEL_PERIOD_LENGTH / 2;
+	for (uint8_t h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+		uint32_t harmonic                    = 2 * h + 1;
+		power_kernel_harmonic_table_t& table = tables.harmonics[h];
+		for (adc_sample_value_id_t i = 0; i < halfPeriod; ++i) {
+			// Reduce the angle to [-pi, pi].
+			double angle = 2 * POWER_KERNEL_PI * ((harmonic * i) % POWER_KERNEL_PERIOD_LENGTH)
+						   / POWER_KERNEL_PERIOD_LENGTH;
+			if (angle > POWER_KERNEL_PI) {
+				angle -= 2 * POWER_KERNEL_PI;
+			}
+			table.cos[i]              = toQ15(constexprCos(angle));
+			table.sin[i]              = toQ15(constexprSin(angle));
+			table.cos[i + halfPeriod] = -table.cos[i];
+			table.sin[i + halfPeriod] = -table.sin[i];
+		}
+	}
+	return tables;
+}
+
+static constexpr power_kernel_harmonic_tables_t harmonicTables = generateHarmonicTables();
+
+static_assert(harmonicTables.harmonics[0].cos[0] == 32767, "Harmonic tables not generated correctly");
+
+/**
+ * Like accumulate(), and loads 2 consecutive table values as one word, to match the samples of a channel.
+ */
+template <class Samples>
+static inline void accumulateHarmonics(
+		const Samples& samples, power_kernel_sums_t& sums, power_kernel_harmonic_sums_t& harmonicSums) {
+	int32_t sum0       = 0;
+	int32_t sum1       = 0;
+	int64_t squareSum0 = 0;
+	int64_t squareSum1 = 0;
+	int64_t productSum = 0;
+	harmonicSums       = power_kernel_harmonic_sums_t();
+
+	for (adc_sample_value_id_t i = 0; i < POWER_KERNEL_PERIOD_LENGTH; i += 2) {
+		uint32_t channel0;
+		uint32_t channel1;
+		samples.loadPairs(i, channel0, channel1);
+		squareSum0 = dualMultiplyAccumulate(channel0, channel0, squareSum0);
+		squareSum1 = dualMultiplyAccumulate(channel1, channel1, squareSum1);
+		productSum = dualMultiplyAccumulate(channel0, channel1, productSum);
+		sum0 += static_cast<int16_t>(channel0) + static_cast<int16_t>(channel0 >> 16);
+		sum1 += static_cast<int16_t>(channel1) + static_cast<int16_t>(channel1 >> 16);
+
+		for (uint8_t h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+			uint32_t cosPair;
+			uint32_t sinPair;
+			memcpy(&cosPair, harmonicTables.harmonics[h].cos + i, sizeof(cosPair));
+			memcpy(&sinPair, harmonicTables.harmonics[h].sin + i, sizeof(sinPair));
+			power_kernel_phasor_t& phasor0 = harmonicSums.harmonics[0][h];
+			power_kernel_phasor_t& phasor1 = harmonicSums.harmonics[1][h];
+			phasor0.cos                    = dualMultiplyAccumulate(channel0, cosPair, phasor0.cos);
+			phasor0.sin                    = dualMultiplyAccumulate(channel0, sinPair, phasor0.sin);
+			phasor1.cos                    = dualMultiplyAccumulate(channel1, cosPair, phasor1.cos);
+			phasor1.sin                    = dualMultiplyAccumulate(channel1, sinPair, phasor1.sin);
+		}
+	}
+
+	sums.numSamples   = POWER_KERNEL_PERIOD_LENGTH;
+	sums.sum[0]       = sum0;
+	sums.sum[1]       = sum1;
+	sums.squareSum[0] = squareSum0;
+	sums.squareSum[1] = squareSum1;
+	sums.productSum   = productSum;
+}
+
+void powerKernelAccumulateHarmonics(
+		const adc_sample_value_t* samples, power_kernel_sums_t& sums, power_kernel_harmonic_sums_t& harmonicSums) {
+	accumulateHarmonics(InterleavedSamples(samples), sums, harmonicSums);
+}
+
+void powerKernelAccumulateHarmonicsPlanar(
+		const adc_sample_value_t* samples0,
+		const adc_sample_value_t* samples1,
+		power_kernel_sums_t& sums,
+		power_kernel_harmonic_sums_t& harmonicSums) {
+	accumulateHarmonics(PlanarSamples(samples0, samples1), sums, harmonicSums);
+}
+
+void powerKernelAccumulateHarmonicsReference(
+		const adc_sample_value_t* samples, power_kernel_sums_t& sums, power_kernel_harmonic_sums_t& harmonicSums) {
+	powerKernelAccumulateReference(samples, POWER_KERNEL_PERIOD_LENGTH, sums);
+	harmonicSums = power_kernel_harmonic_sums_t();
+	for (adc_sample_value_id_t i = 0; i < POWER_KERNEL_PERIOD_LENGTH; ++i) {
+		for (uint8_t channel = 0; channel < 2; ++channel) {
+			int32_t sample = samples[2 * i + channel];
+			for (uint8_t h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+				harmonicSums.harmonics[channel][h].cos += sample * harmonicTables.harmonics[h].cos[i];
+				harmonicSums.harmonics[channel][h].sin += sample * harmonicTables.harmonics[h].sin[i];
+			}
+		}
+	}
+}
+
+/**
+ * Expands sum((a * 1024 - zeroA) * (b * 1024 - zeroB)) into:
+ *   1024 * 1024 * sum(a * b) - 1024 * (zeroB * sum(a) + zeroA * sum(b)) + n * zeroA * zeroB
+ */
+int64_t powerKernelCenteredProductSum(
+		const power_kernel_sums_t& sums,
+		adc_channel_id_t channelA,
+		int32_t zeroA,
+		adc_channel_id_t channelB,
+		int32_t zeroB) {
+	int64_t productSum  = (channelA == channelB) ? sums.squareSum[channelA] : sums.productSum;
+	int64_t centeredSum = productSum * 1024 * 1024
+						  - 1024 * ((int64_t)zeroB * sums.sum[channelA] + (int64_t)zeroA * sums.sum[channelB])
+						  + (int64_t)sums.numSamples * zeroA * zeroB;
+	return centeredSum / (1024 * 1024);
+}
+
+/**
+ * Loads 2 samples of each buffer as one word. The limit is checked every 8 samples, so the check costs little.
+ */
+uint32_t powerKernelSquaredDiffSum(
+		const adc_sample_value_t* samplesA,
+		const adc_sample_value_t* samplesB,
+		adc_sample_value_id_t numSamples,
+		uint32_t limit) {
+	int32_t sum             = 0;
+	adc_sample_value_id_t i = 0;
+	for (; i + 1 < numSamples; i += 2) {
+		uint32_t a;
+		uint32_t b;
+		memcpy(&a, samplesA + i, sizeof(a));
+		memcpy(&b, samplesB + i, sizeof(b));
+		uint32_t diff = dualSubtract(a, b);
+		sum           = dualMultiplyAccumulate32(diff, diff, sum);
+		if ((i % 8) == 6 && static_cast<uint32_t>(sum) >= limit) {
+			return sum;
+		}
+	}
+	if (i < numSamples) {
+		int32_t diff = samplesA[i] - samplesB[i];
+		sum += diff * diff;
+	}
+	return sum;
+}
+
+uint32_t powerKernelSquaredDiffSumReference(
+		const adc_sample_value_t* samplesA, const adc_sample_value_t* samplesB, adc_sample_value_id_t numSamples) {
+	uint32_t sum = 0;
+	for (adc_sample_value_id_t i = 0; i < numSamples; ++i) {
+		int32_t diff = samplesA[i] - samplesB[i];
+		sum += diff * diff;
+	}
+	return sum;
+}
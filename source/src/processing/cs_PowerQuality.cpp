@@ -0,0 +1,103 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <processing/cs_PowerQuality.h>
+
+#include <cmath>
+
+/**
+ * Get a ratio in 1/1000, limited to [-1000, 1000], since the measured powers don't match exactly.
+ */
+static int16_t toPermille(float ratio) {
+	float permille = roundf(ratio * 1000);
+	if (permille > 1000) {
+		return 1000;
+	}
+	if (permille < -1000) {
+		return -1000;
+	}
+	return static_cast<int16_t>(permille);
+}
+
+/**
+ * The fundamentals are multiplied as floats: their magnitudes can be up to 2^32, so the product may overflow an int64.
+ */
+bool PowerQuality::add(
+		const power_kernel_phasor_t voltageHarmonics[POWER_QUALITY_NUM_HARMONICS],
+		const power_kernel_phasor_t currentHarmonics[POWER_QUALITY_NUM_HARMONICS],
+		int32_t powerMilliWatt,
+		int32_t currentRmsMA,
+		int32_t voltageRmsMilliVolt) {
+	_realPowerSumMilliWatt += powerMilliWatt;
+	_apparentPowerSumMilliWatt += static_cast<int64_t>(currentRmsMA) * voltageRmsMilliVolt / 1000;
+
+	float voltageCos = voltageHarmonics[0].cos;
+	float voltageSin = voltageHarmonics[0].sin;
+	float currentCos = currentHarmonics[0].cos;
+	float currentSin = currentHarmonics[0].sin;
+	_fundamentalProductSum += voltageCos * currentCos + voltageSin * currentSin;
+	_fundamentalMagnitudeSum += sqrtf(voltageCos * voltageCos + voltageSin * voltageSin)
+								* sqrtf(currentCos * currentCos + currentSin * currentSin);
+
+	for (uint8_t h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+		float cos = voltageHarmonics[h].cos;
+		float sin = voltageHarmonics[h].sin;
+		_voltageHarmonicSquareSums[h] += cos * cos + sin * sin;
+		cos = currentHarmonics[h].cos;
+		sin = currentHarmonics[h].sin;
+		_currentHarmonicSquareSums[h] += cos * cos + sin * sin;
+	}
+
+	_numPeriods++;
+	return _numPeriods >= POWER_QUALITY_INTERVAL_PERIODS;
+}
+
+void PowerQuality::calculate(float voltageMultiplier, float currentMultiplier, cs_power_quality_t& powerQuality) {
+	powerQuality = cs_power_quality_t();
+	if (_numPeriods == 0) {
+		return;
+	}
+
+	if (_apparentPowerSumMilliWatt > 0) {
+		powerQuality.powerFactor = toPermille(static_cast<float>(_realPowerSumMilliWatt) / _apparentPowerSumMilliWatt);
+	}
+
+	// A negative multiplier flips the phase of that channel, like it flips the sign of the real power.
+	if (_fundamentalMagnitudeSum > 0) {
+		float sign                           = (voltageMultiplier * currentMultiplier < 0) ? -1.0f : 1.0f;
+		powerQuality.displacementPowerFactor = toPermille(sign * _fundamentalProductSum / _fundamentalMagnitudeSum);
+	}
+
+	for (uint8_t h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+		powerQuality.voltageHarmonicsRmsMilliVolt[h] =
+				getHarmonicRms(_voltageHarmonicSquareSums[h], voltageMultiplier) * 1000;
+		powerQuality.currentHarmonicsRmsMA[h] = getHarmonicRms(_currentHarmonicSquareSums[h], currentMultiplier) * 1000;
+	}
+
+	reset();
+}
+
+/**
+ * The magnitude of the correlation is amplitude * 32767 * POWER_KERNEL_PERIOD_LENGTH / 2, and the RMS of a sine is
+ * the amplitude / sqrt(2).
+ */
+float PowerQuality::getHarmonicRms(float squareSum, float multiplier) {
+	float magnitude = sqrtf(squareSum / _numPeriods);
+	return magnitude * sqrtf(2.0f) / (32767.0f * POWER_KERNEL_PERIOD_LENGTH) * fabsf(multiplier);
+}
+
+void PowerQuality::reset() {
+	_numPeriods                = 0;
+	_realPowerSumMilliWatt     = 0;
+	_apparentPowerSumMilliWatt = 0;
+	_fundamentalProductSum     = 0;
+	_fundamentalMagnitudeSum   = 0;
+	for (uint8_t h = 0; h < POWER_QUALITY_NUM_HARMONICS; ++h) {
+		_voltageHarmonicSquareSums[h] = 0;
+		_currentHarmonicSquareSums[h] = 0;
+	}
+}
@@ -9,20 +9,22 @@
 
 #include <logging/cs_Logger.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 
 #include "common/cs_Types.h"
 #include "drivers/cs_RTC.h"
 #include "events/cs_EventDispatcher.h"
 #include "ipc/cs_IpcRamDataContents.h"
+#include "processing/cs_PowerKernel.h"
 #include "processing/cs_RecognizeSwitch.h"
+#include "processing/cs_SoftfuseLatency.h"
 #include "protocol/cs_Packets.h"
 #include "protocol/cs_UartMsgTypes.h"
 #include "storage/cs_IpcRamBluenet.h"
 #include "storage/cs_State.h"
 #include "structs/buffer/cs_AdcBuffer.h"
-#include "third/SortMedian.h"
-#include "third/optmed.h"
 #include "time/cs_SystemTime.h"
 #include "uart/cs_UartHandler.h"
 
@@ -54,22 +56,12 @@
 #endif
 
 PowerSampling::PowerSampling() : _bufferQueue(CS_ADC_NUM_BUFFERS), _switchHist(switchHistSize) {
-	_adc                      = &(ADC::getInstance());
-	_powerMilliWattHist       = new CircularBuffer<int32_t>(POWER_SAMPLING_RMS_WINDOW_SIZE);
-	_currentRmsMilliAmpHist   = new CircularBuffer<int32_t>(POWER_SAMPLING_RMS_WINDOW_SIZE);
-	_voltageRmsMilliVoltHist  = new CircularBuffer<int32_t>(POWER_SAMPLING_RMS_WINDOW_SIZE);
-	_filteredCurrentRmsHistMA = new CircularBuffer<int32_t>(POWER_SAMPLING_RMS_WINDOW_SIZE);
-	_logsEnabled.asInt        = 0;
+	_adc                     = &(ADC::getInstance());
+	_powerMilliWattHist      = new CircularBuffer<int32_t>(POWER_SAMPLING_RMS_WINDOW_SIZE);
+	_logsEnabled.asInt       = 0;
+	_steadySwitchState.asInt = 0;
 }
 
-#if POWER_SAMPLING_RMS_WINDOW_SIZE == 7
-#define opt_med(arr) opt_med7(arr)
-#elif POWER_SAMPLING_RMS_WINDOW_SIZE == 9
-#define opt_med(arr) opt_med9(arr)
-#elif POWER_SAMPLING_RMS_WINDOW_SIZE == 25
-#define opt_med(arr) opt_med25(arr)
-#endif
-
 #ifdef PRINT_POWER_SAMPLES
 static int printPower = 0;
 #endif
@@ -132,24 +124,13 @@ void PowerSampling::init(const boards_config_t* boardConfig) {
 	_boardPowerZero         = boardConfig->powerOffsetMilliWatt;
 
 	LOGi(FMT_INIT "buffers");
-	_powerMilliWattHist->init();        // Allocates buffer
-	_currentRmsMilliAmpHist->init();    // Allocates buffer
-	_voltageRmsMilliVoltHist->init();   // Allocates buffer
-	_filteredCurrentRmsHistMA->init();  // Allocates buffer
-	_switchHist.init();                 // Allocates buffer
+	_powerMilliWattHist->init();  // Allocates buffer
+	_switchHist.init();           // Allocates buffer
 
 	// Init moving median filter
-	unsigned halfWindowSize = POWER_SAMPLING_CURVE_HALF_WINDOW_SIZE;
-	//	unsigned halfWindowSize = 5;  // Takes 0.74ms
-	//	unsigned halfWindowSize = 16; // Takes 0.93ms
-	unsigned windowSize     = halfWindowSize * 2 + 1;
-	uint16_t bufSize        = AdcBuffer::getInstance().getChannelLength();
-	unsigned blockCount     = (bufSize + halfWindowSize * 2) / windowSize;  // Shouldn't have a remainder!
-	_filterParams           = new MedianFilter(halfWindowSize, blockCount);
-	_inputSamples           = new PowerVector(bufSize + halfWindowSize * 2);
-	_outputSamples          = new PowerVector(bufSize);
-
-	_boardConfig            = boardConfig;
+	_medianFilter = new SlidingMedianFilter(POWER_SAMPLING_CURVE_HALF_WINDOW_SIZE);
+
+	_boardConfig  = boardConfig;
 
 	LOGd(FMT_INIT "ADC");
 	adc_config_t adcConfig;
@@ -261,6 +242,10 @@ void PowerSampling::handleEvent(event_t& event) {
 		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
 			_logsEnabled.flags.filteredCurrent = *(TYPIFY(CMD_ENABLE_LOG_FILTERED_CURRENT)*)event.data;
 			break;
+		case CS_TYPE::CMD_SET_LOG_SAMPLES_STREAM:
+			_logSamplesStreamMode =
+					static_cast<UartSamplesStreamMode>(*(TYPIFY(CMD_SET_LOG_SAMPLES_STREAM)*)event.data);
+			break;
 		case CS_TYPE::CMD_TOGGLE_ADC_VOLTAGE_VDD_REFERENCE_PIN: selectNextPin(VOLTAGE_CHANNEL_IDX); break;
 		case CS_TYPE::CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT:
 			enableDifferentialModeCurrent(*(TYPIFY(CMD_ENABLE_ADC_DIFFERENTIAL_CURRENT)*)event.data);
@@ -300,10 +285,22 @@ void PowerSampling::handleEvent(event_t& event) {
 			event.result.returnCode = ERR_SUCCESS;
 			break;
 		}
+		case CS_TYPE::CMD_GET_SOFTFUSE_LATENCY: {
+			const cs_softfuse_latency_stats_t& stats = SoftfuseLatency::getInstance().getStats();
+			if (event.result.buf.len < sizeof(stats)) {
+				event.result.returnCode = ERR_BUFFER_TOO_SMALL;
+				return;
+			}
+			memcpy(event.result.buf.data, &stats, sizeof(stats));
+			event.result.dataSize   = sizeof(stats);
+			event.result.returnCode = ERR_SUCCESS;
+			break;
+		}
 		case CS_TYPE::EVT_ADC_RESTARTED: {
 			_adcRestarts.count++;
 			_adcRestarts.lastTimestamp = SystemTime::posix();
 			_bufferQueue.clear();
+			stopSteady();
 			UartHandler::getInstance().writeMsg(UART_OPCODE_TX_ADC_RESTART, NULL, 0);
 			//		RecognizeSwitch::getInstance().skip(2);
 			break;
@@ -351,6 +348,7 @@ void PowerSampling::handleEvent(event_t& event) {
  * @param[in] bufIndex                           The buffer index, can be used in InterleavedBuffer.
  */
 void PowerSampling::powerSampleAdcDone(adc_buffer_id_t bufIndex) {
+	uint32_t startRtcCount    = RTC::getCount();
 	adc_buffer_seq_nr_t seqNr = AdcBuffer::getInstance().getBuffer(bufIndex)->seqNr;
 	LOGPowerSamplingVerbose("bufId=%u seqNr=%u", bufIndex, seqNr);
 	PS_TEST_PIN_TOGGLE
@@ -375,6 +373,10 @@ void PowerSampling::powerSampleAdcDone(adc_buffer_id_t bufIndex) {
 		return;
 	}
 
+	if (skipSteadyBuf(bufIndex)) {
+		return;
+	}
+
 	adc_buffer_id_t filteredBufIndex;
 	if (_bufferQueue.empty()) {
 		// Filter current buffer to current buffer.
@@ -445,7 +447,7 @@ void PowerSampling::powerSampleAdcDone(adc_buffer_id_t bufIndex) {
 
 	PS_TEST_PIN_TOGGLE
 
-	if (!calculatePower(filteredBufIndex)) {
+	if (!calculatePower(filteredBufIndex, bufIndex)) {
 		LOGw("Failed to calculate power");
 	}
 
@@ -506,6 +508,9 @@ void PowerSampling::powerSampleAdcDone(adc_buffer_id_t bufIndex) {
 			}
 		}
 	}
+
+	_processedBufCount++;
+	_processedRtcTicks += RTC::difference(RTC::getCount(), startRtcCount);
 }
 
 void PowerSampling::initAverages() {
@@ -550,6 +555,163 @@ uint32_t PowerSampling::getSkippedBufCount() {
 	return _bufSkipCount;
 }
 
+void PowerSampling::enableSteadyMode(bool enable) {
+	_steadyModeEnabled = enable;
+	if (!enable) {
+		stopSteady();
+	}
+}
+
+uint32_t PowerSampling::getSteadySkippedBufCount() {
+	return _steadySkippedBufCount;
+}
+
+uint32_t PowerSampling::getSteadySavedMs() {
+	if (_processedBufCount == 0) {
+		return 0;
+	}
+	// Each unprocessed buffer would have taken the average processing time, minus the time spent on the steady check.
+	int64_t savedTicks = _processedRtcTicks * _steadySkippedBufCount / _processedBufCount;
+	savedTicks -= _steadySkippedRtcTicks;
+	if (savedTicks <= 0) {
+		return 0;
+	}
+	return savedTicks * 1000 / RTC_CLOCK_FREQ;
+}
+
+/**
+ * Whether a value is within the band around the steady value.
+ */
+static bool isWithinSteadyBand(int32_t value, int32_t steadyValue, int32_t minBand) {
+	int32_t band = std::max(static_cast<int32_t>(std::abs(steadyValue) * POWER_SAMPLING_STEADY_BAND_PART), minBand);
+	return std::abs(value - steadyValue) <= band;
+}
+
+bool PowerSampling::skipSteadyBuf(adc_buffer_id_t bufIndex) {
+	if (!_steadyModeEnabled) {
+		return false;
+	}
+	uint32_t startRtcCount = RTC::getCount();
+
+	// Unfiltered samples, so that the check is cheap.
+	int32_t currentRmsMA;
+	int32_t voltageRmsMilliVolt;
+	int32_t powerMilliWatt;
+	calculateRms(bufIndex, currentRmsMA, voltageRmsMilliVolt, powerMilliWatt);
+
+	if (!isValidBuf(bufIndex)) {
+		LOGPowerSamplingWarn("buf %u invalid", bufIndex);
+		_bufSkipCount++;
+		_bufferQueue.clear();
+		return true;
+	}
+
+	TYPIFY(STATE_SWITCH_STATE) switchState;
+	State::getInstance().get(CS_TYPE::STATE_SWITCH_STATE, &switchState, sizeof(switchState));
+
+	bool sameSwitchState = switchState.asInt == _steadySwitchState.asInt;
+	bool currentSteady   = isWithinSteadyBand(currentRmsMA, _steadyCurrentRmsMA, POWER_SAMPLING_STEADY_BAND_MIN_MA);
+	bool voltageSteady   = isWithinSteadyBand(
+			voltageRmsMilliVolt, _steadyVoltageRmsMilliVolt, POWER_SAMPLING_STEADY_BAND_MIN_MV);
+	bool powerSteady     = isWithinSteadyBand(powerMilliWatt, _steadyPowerMilliWatt, POWER_SAMPLING_STEADY_BAND_MIN_MW);
+	bool withinBand      = sameSwitchState && currentSteady && voltageSteady && powerSteady;
+
+	if (_steady) {
+		if (withinBand && !_adc->isLimitGuardTriggered()) {
+			// The power didn't change, so the energy can still be calculated.
+			calculateEnergy();
+			storeEnergyUsed();
+			State::getInstance().set(
+					CS_TYPE::STATE_ACCUMULATED_ENERGY, &_energyUsedmicroJoule, sizeof(_energyUsedmicroJoule));
+
+			// Buffers in the queue are no longer consecutive with the next processed buffer.
+			// The switch history is kept, as the switch state can't change while steady.
+			_bufferQueue.clear();
+
+			_steadySkippedBufCount++;
+			_steadyPeriodSkippedBufCount++;
+			_steadySkippedRtcTicks += RTC::difference(RTC::getCount(), startRtcCount);
+			return true;
+		}
+		// Process this buffer, and start looking for a new steady period.
+		stopSteady();
+		withinBand = false;
+	}
+
+	if (withinBand && _steadyBufCount > 0) {
+		if (_steadyBufCount < POWER_SAMPLING_STEADY_BUFFERS) {
+			_steadyBufCount++;
+		}
+	}
+	else {
+		_steadyBufCount            = 1;
+		_steadyCurrentRmsMA        = currentRmsMA;
+		_steadyVoltageRmsMilliVolt = voltageRmsMilliVolt;
+		_steadyPowerMilliWatt      = powerMilliWatt;
+		_steadySwitchState         = switchState;
+	}
+
+	if (_steadyBufCount >= POWER_SAMPLING_STEADY_BUFFERS && isSteadyAllowed(switchState)) {
+		// Process this buffer, and skip the next.
+		startSteady(switchState);
+	}
+	return false;
+}
+
+bool PowerSampling::isSteadyAllowed(switch_state_t switchState) {
+	// Switchcraft and the logs need every buffer.
+	if (_switchcraftEnabled || _logsEnabled.asInt != 0) {
+		return false;
+	}
+
+	// Wait for the zero values, the softfuse, and the power averages to settle.
+	if (_zeroVoltageCount <= 200 || _zeroCurrentCount <= 200 || !_dimmerFailureDetectionStarted
+		|| _powerZero == CONFIG_POWER_ZERO_INVALID || _slowAvgPowerCount < slowAvgPowerConvergedCount
+		|| _currentMultiplier == 0) {
+		return false;
+	}
+
+	// Stay well below the softfuse threshold, as the softfuse is not checked while buffers are skipped.
+	int32_t maxCurrentRmsMA = getSoftfuseCurrentThreshold(switchState) * POWER_SAMPLING_STEADY_MAX_CURRENT_PART;
+	return _steadyCurrentRmsMA < maxCurrentRmsMA && _avgCurrentRmsMilliAmp < maxCurrentRmsMA;
+}
+
+int32_t PowerSampling::getSoftfuseCurrentThreshold(switch_state_t switchState) {
+	// With the dimmer on, or both off, the dimmer overcurrent or dimmer failure can trigger.
+	if (switchState.state.dimmer != 0 || switchState.state.relay == 0) {
+		return _currentMilliAmpThresholdDimmer;
+	}
+	return _currentMilliAmpThreshold;
+}
+
+void PowerSampling::startSteady(switch_state_t switchState) {
+	// Guard the current samples at the peak of a sine with the RMS current of the softfuse threshold.
+	float peakCurrent     = getSoftfuseCurrentThreshold(switchState) / 1000.0f * std::sqrt(2.0f);
+	int32_t peak          = peakCurrent / std::fabs(_currentMultiplier);
+	int32_t zero          = _avgZeroCurrent / 1024;
+	cs_ret_code_t retCode = _adc->enableLimitGuard(CURRENT_CHANNEL_IDX, zero - peak, zero + peak);
+	if (retCode != ERR_SUCCESS) {
+		LOGw("Failed to guard current: retCode=%u", retCode);
+		return;
+	}
+	LOGi("Steady load: Irms=%imA Vrms=%imV P=%imW",
+		 _steadyCurrentRmsMA,
+		 _steadyVoltageRmsMilliVolt,
+		 _steadyPowerMilliWatt);
+	_steady                      = true;
+	_steadyPeriodSkippedBufCount = 0;
+}
+
+void PowerSampling::stopSteady() {
+	_steadyBufCount = 0;
+	if (!_steady) {
+		return;
+	}
+	_adc->disableLimitGuard();
+	_steady = false;
+	LOGi("Steady load ended: skipped %u bufs, saved %u ms in total", _steadyPeriodSkippedBufCount, getSteadySavedMs());
+}
+
 /*
  * Other idea:
  * - compare Vrms[t-1] with Vrms[t] and Irms[t]. If Vrms[t-1] is more similar to Irms[t] than to Vrms[t], then swapped.
@@ -630,9 +792,10 @@ void PowerSampling::calculateVoltageZero(adc_buffer_id_t bufIndex) {
 			AC_PERIOD_US / AdcBuffer::getInstance().getBuffer(bufIndex)->config[VOLTAGE_CHANNEL_IDX].samplingIntervalUs;
 	assert(numSamples <= AdcBuffer::getChannelLength(), "Not enough samples");
 
-	int64_t sum = 0;
+	int64_t sum                  = 0;
+	adc_channel_values_t voltage = AdcBuffer::getInstance().getChannel(bufIndex, VOLTAGE_CHANNEL_IDX);
 	for (adc_sample_value_id_t i = 0; i < numSamples; ++i) {
-		sum += AdcBuffer::getInstance().getValue(bufIndex, VOLTAGE_CHANNEL_IDX, i);
+		sum += voltage[i];
 	}
 
 	if (!isValidBuf(bufIndex)) {
@@ -667,9 +830,10 @@ void PowerSampling::calculateCurrentZero(adc_buffer_id_t bufIndex) {
 			AC_PERIOD_US / AdcBuffer::getInstance().getBuffer(bufIndex)->config[CURRENT_CHANNEL_IDX].samplingIntervalUs;
 	assert(numSamples <= AdcBuffer::getChannelLength(), "Not enough samples");
 
-	int64_t sum = 0;
+	int64_t sum                  = 0;
+	adc_channel_values_t current = AdcBuffer::getInstance().getChannel(bufIndex, CURRENT_CHANNEL_IDX);
 	for (adc_sample_value_id_t i = 0; i < numSamples; ++i) {
-		sum += AdcBuffer::getInstance().getValue(bufIndex, CURRENT_CHANNEL_IDX, i);
+		sum += current[i];
 	}
 
 	if (!isValidBuf(bufIndex)) {
@@ -699,102 +863,105 @@ void PowerSampling::calculateCurrentZero(adc_buffer_id_t bufIndex) {
 }
 
 /*
- * The median filter uses its own data structure to optimally filter the data. A median filter does filter outliers by
- * a particular smoothing operation. It sorts a sequence of values and picks the one in the center: the median. To
- * optimize this operation it makes sense that if we slide the sliding window with sorted values we do not sort these
- * values again and again. When moving the window we insert the new value from the right into the sorted array. For
- * that it is logical to use a linked list. This means that the MedianFilter object we use requires us copying the
- * data into it. An expensive operation.
+ * The median filter does filter outliers by a particular smoothing operation: each sample is replaced by the median
+ * of the window of samples around it. Instead of sorting each window, the filter keeps the window in a double heap,
+ * and only moves the sample that enters the window into place. See SlidingMedianFilter.
  *
- * TODO: Do not work with "half window sizes". Just work with a window size and enforce its size to be odd. That
- * to pick the median you only need to sort half of the values (plus one) is an implementation detail.
+ * The filter reads and writes the ADC buffers directly, with the channel stride, so no samples are copied. At the edges
+ * of the buffer, the window is padded with copies of the first and last sample.
  *
- * TODO: Create an in-place version of a median filter. It is possible to have a linked list (of half the window size
- * plus one) that contains a list of indices into the array with values. For example, let us assume a full window size
- * of 5 and ignore the border starting at index 2. Now let's sort the first 5 values [4 2 0 1 3]. Hence, the value at
- * index 4 is the smallest. We replace value at index 2 with the middle one (which is at index 0). Now we shift to the
- * right, hence index 0 falls out [4 2 1 3], and index 5 shifts in. Let's assume 5 is a value between 4 and 2, then we
- * have [4 5 2 1 3] and replace the value at index 3 with the value at index 2. Note that the value at index 0 is
- * copied into 2 and then into 3. If we do not want this, we need to have a separate array the size of the sliding
- * window and only copy the value when it is shifted out. We will have a copy assignment operation for each value,
- * however still our RAM use is much less because we only need place for values at the window. Note that we can
- * actually sort up to the half so the examples should be [4 2 0 ? ?], then [4 2 ? ?], then [4 5 2 ? ?]. In the
- * particular case where 5 > 2 we need an additional value [4 2 1 ?] or we do not know if it should be [4 2 5 ? ?] or
- * [4 2 1 ? ?]. So in this case we would need a min(.) operation on half (minus one) of the remaining array.
- *
- * TODO: Keep the newest buffer at t=0 "raw" and only filter the t=-1. If the operation is done in-place we have also
- * filtered buffers for t=-2 and t=-3 (assuming four buffers). We can use the buffer at t=0 and t=-2 for padding the
- * buffer at t=-1. This means we do not pad with copies of values but with real values. All operations that require
- * smoothed values will have a delay of one sine wave (20ms on 50Hz).
+ * TODO: Keep the newest buffer at t=0 "raw" and only filter the t=-1. We can use the buffer at t=0 and t=-2 for
+ * padding the buffer at t=-1. This means we do not pad with copies of values but with real values. All operations that
+ * require smoothed values will have a delay of one sine wave (20ms on 50Hz).
  */
 
 /**
  * This function performs a median filter with respect to the given channel.
  */
 void PowerSampling::filter(adc_buffer_id_t bufIndexIn, adc_buffer_id_t bufIndexOut, adc_channel_id_t channel_id) {
+	AdcBuffer& adcBuffer = AdcBuffer::getInstance();
+	_medianFilter->filter(
+			adcBuffer.getBuffer(bufIndexIn)->samples + adcBuffer.getChannelOffset(channel_id),
+			adcBuffer.getBuffer(bufIndexOut)->samples + adcBuffer.getChannelOffset(channel_id),
+			adcBuffer.getChannelStride(),
+			adcBuffer.getChannelLength());
+}
 
-	// Pad the start of the input vector with the first sample in the buffer
-	uint16_t j                      = 0;
-	adc_sample_value_t padded_value = AdcBuffer::getInstance().getValue(bufIndexIn, channel_id, 0);
-	for (uint16_t i = 0; i < _filterParams->half; ++i, ++j) {
-		_inputSamples->at(j) = padded_value;
-	}
+void PowerSampling::calculateRms(
+		adc_buffer_id_t bufIndex, int32_t& currentRmsMA, int32_t& voltageRmsMilliVolt, int32_t& powerMilliWatt) {
+	adc_sample_value_id_t numSamples =
+			AC_PERIOD_US / AdcBuffer::getInstance().getBuffer(bufIndex)->config[VOLTAGE_CHANNEL_IDX].samplingIntervalUs;
+	assert(numSamples <= AdcBuffer::getChannelLength(), "Not enough samples");
 
-	// Copy samples from buffer to input vector
-	uint8_t channel_length = AdcBuffer::getInstance().getChannelLength();
-	for (int i = 0; i < channel_length; ++i, ++j) {
-		_inputSamples->at(j) = AdcBuffer::getInstance().getValue(bufIndexIn, channel_id, i);
+	// Go over the samples once, then correct the sums for the zero offsets.
+	static_assert(AdcBuffer::getChannelCount() == 2, "Power kernel expects 2 channels");
+	AdcBuffer& adcBuffer = AdcBuffer::getInstance();
+	power_kernel_sums_t sums;
+	if (AdcBuffer::isDeinterleaved()) {
+		powerKernelAccumulatePlanar(
+				adcBuffer.getChannelValues(bufIndex, 0), adcBuffer.getChannelValues(bufIndex, 1), numSamples, sums);
 	}
+	else {
+		powerKernelAccumulate(adcBuffer.getChannelValues(bufIndex, 0), numSamples, sums);
+	}
+	int64_t pSum        = powerKernelCenteredProductSum(
+			sums, VOLTAGE_CHANNEL_IDX, _avgZeroVoltage, CURRENT_CHANNEL_IDX, _avgZeroCurrent);
+	int64_t cSquareSum  = powerKernelCenteredProductSum(
+			sums, CURRENT_CHANNEL_IDX, _avgZeroCurrent, CURRENT_CHANNEL_IDX, _avgZeroCurrent);
+	int64_t vSquareSum  = powerKernelCenteredProductSum(
+			sums, VOLTAGE_CHANNEL_IDX, _avgZeroVoltage, VOLTAGE_CHANNEL_IDX, _avgZeroVoltage);
+
+	powerMilliWatt      = pSum * _currentMultiplier * _voltageMultiplier * 1000 / numSamples;
+	currentRmsMA        = sqrt((double)cSquareSum * _currentMultiplier * _currentMultiplier / numSamples) * 1000;
+	voltageRmsMilliVolt = sqrt((double)vSquareSum * _voltageMultiplier * _voltageMultiplier / numSamples) * 1000;
+}
 
-	// Pad the end of the buffer with the last sample in the buffer
-	padded_value = AdcBuffer::getInstance().getValue(bufIndexIn, channel_id, channel_length - 1);
-	for (uint16_t i = 0; i < _filterParams->half; ++i, ++j) {
-		_inputSamples->at(j) = padded_value;
+bool PowerSampling::calculateHarmonics(adc_buffer_id_t bufIndex, power_kernel_harmonic_sums_t& harmonicSums) {
+	// The harmonic tables are made for the configured sampling interval, other intervals skip the harmonics.
+	adc_sample_value_id_t numSamples =
+			AC_PERIOD_US / AdcBuffer::getInstance().getBuffer(bufIndex)->config[VOLTAGE_CHANNEL_IDX].samplingIntervalUs;
+	if (numSamples != POWER_KERNEL_PERIOD_LENGTH) {
+		return false;
 	}
 
-	// Filter the data
-	sort_median(*_filterParams, *_inputSamples, *_outputSamples);
-
-	// Copy the result back into the buffer
-	for (int i = 0; i < AdcBuffer::getInstance().getChannelLength(); ++i) {
-		AdcBuffer::getInstance().setValue(bufIndexOut, channel_id, i, _outputSamples->at(i));
+	// The power sums of this pass are not used, as the power is calculated from the filtered samples.
+	AdcBuffer& adcBuffer               = AdcBuffer::getInstance();
+	const adc_sample_value_t* samples0 = adcBuffer.getChannelValues(bufIndex, 0);
+	const adc_sample_value_t* samples1 = adcBuffer.getChannelValues(bufIndex, 1);
+	power_kernel_sums_t sums;
+	if (AdcBuffer::isDeinterleaved()) {
+		powerKernelAccumulateHarmonicsPlanar(samples0, samples1, sums, harmonicSums);
 	}
+	else {
+		powerKernelAccumulateHarmonics(samples0, sums, harmonicSums);
+	}
+	return isValidBuf(bufIndex);
 }
 
-bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex) {
-
-	adc_sample_value_id_t numSamples =
-			AC_PERIOD_US / AdcBuffer::getInstance().getBuffer(bufIndex)->config[VOLTAGE_CHANNEL_IDX].samplingIntervalUs;
-	assert(numSamples <= AdcBuffer::getChannelLength(), "Not enough samples");
+bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex, adc_buffer_id_t unfilteredBufIndex) {
 
 	//////////////////////////////////////////////////
 	// Calculatate power, Irms, and Vrms
 	//////////////////////////////////////////////////
 
-	// The int64_t sum is large enough: 2^63 / (2^12 * 1000 * 2^12 * 1000) = 5*10^5. Many more samples than the 100 we
-	// use.
-	int64_t pSum       = 0;
-	int64_t cSquareSum = 0;
-	int64_t vSquareSum = 0;
-	int64_t current;
-	int64_t voltage;
-	for (adc_sample_value_id_t i = 0; i < numSamples; ++i) {
-		voltage = (int64_t)AdcBuffer::getInstance().getValue(bufIndex, VOLTAGE_CHANNEL_IDX, i) * 1024 - _avgZeroVoltage;
-		current = (int64_t)AdcBuffer::getInstance().getValue(bufIndex, CURRENT_CHANNEL_IDX, i) * 1024 - _avgZeroCurrent;
-		vSquareSum += (voltage * voltage) / (1024 * 1024);
-		cSquareSum += (current * current) / (1024 * 1024);
-		pSum += (current * voltage) / (1024 * 1024);
+	int32_t currentRmsMA;
+	int32_t voltageRmsMilliVolt;
+	int32_t powerMilliWattReal;
+	calculateRms(bufIndex, currentRmsMA, voltageRmsMilliVolt, powerMilliWattReal);
+
+	// The median filter flattens the peaks of the waveform, which changes the harmonics, so use the unfiltered
+	// samples. When a buffer was filtered in place, there are no unfiltered samples.
+	power_kernel_harmonic_sums_t harmonicSums;
+	bool harmonicsValid = false;
+	if (unfilteredBufIndex != bufIndex) {
+		harmonicsValid = calculateHarmonics(unfilteredBufIndex, harmonicSums);
 	}
+
 	if (!isValidBuf(bufIndex)) {
 		LOGPowerSamplingWarn("buf %u invalid", bufIndex);
 		return false;
 	}
 
-	int32_t powerMilliWattReal = pSum * _currentMultiplier * _voltageMultiplier * 1000 / numSamples;
-	int32_t currentRmsMA       = sqrt((double)cSquareSum * _currentMultiplier * _currentMultiplier / numSamples) * 1000;
-	int32_t voltageRmsMilliVolt =
-			sqrt((double)vSquareSum * _voltageMultiplier * _voltageMultiplier / numSamples) * 1000;
-
 	////////////////////////////////////////////////////////////////////////////////
 	// Calculate Irms of median filtered samples, and filter over multiple periods
 	////////////////////////////////////////////////////////////////////////////////
@@ -819,18 +986,13 @@ bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex) {
 	//	}
 
 	// Calculate median when there are enough values in history, else calculate the average.
-	_filteredCurrentRmsHistMA->push(filteredCurrentRmsMA);
+	_filteredCurrentRmsHistMA.push(filteredCurrentRmsMA);
 	int32_t filteredCurrentRmsMedianMA;
-	if (_filteredCurrentRmsHistMA->full()) {
-		memcpy(_histCopy, _filteredCurrentRmsHistMA->getBuffer(), _filteredCurrentRmsHistMA->getMaxByteSize());
-		filteredCurrentRmsMedianMA = opt_med(_histCopy);
+	if (_filteredCurrentRmsHistMA.full()) {
+		filteredCurrentRmsMedianMA = _filteredCurrentRmsHistMA.getMedian();
 	}
 	else {
-		int64_t currentRmsSumMA = 0;
-		for (uint16_t i = 0; i < _filteredCurrentRmsHistMA->size(); ++i) {
-			currentRmsSumMA += _filteredCurrentRmsHistMA->operator[](i);
-		}
-		filteredCurrentRmsMedianMA = currentRmsSumMA / _filteredCurrentRmsHistMA->size();
+		filteredCurrentRmsMedianMA = _filteredCurrentRmsHistMA.getAverage();
 	}
 
 	// Now that Irms is known: first check the soft fuse.
@@ -845,18 +1007,13 @@ bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex) {
 	/////////////////////////////////////////////////////////
 
 	// Calculate median when there are enough values in history, else calculate the average.
-	_currentRmsMilliAmpHist->push(currentRmsMA);
+	_currentRmsMilliAmpHist.push(currentRmsMA);
 	int32_t currentRmsMedianMA;
-	if (_currentRmsMilliAmpHist->full()) {
-		memcpy(_histCopy, _currentRmsMilliAmpHist->getBuffer(), _currentRmsMilliAmpHist->getMaxByteSize());
-		currentRmsMedianMA = opt_med(_histCopy);
+	if (_currentRmsMilliAmpHist.full()) {
+		currentRmsMedianMA = _currentRmsMilliAmpHist.getMedian();
 	}
 	else {
-		int64_t currentRmsMilliAmpSum = 0;
-		for (uint16_t i = 0; i < _currentRmsMilliAmpHist->size(); ++i) {
-			currentRmsMilliAmpSum += _currentRmsMilliAmpHist->operator[](i);
-		}
-		currentRmsMedianMA = currentRmsMilliAmpSum / _currentRmsMilliAmpHist->size();
+		currentRmsMedianMA = _currentRmsMilliAmpHist.getAverage();
 	}
 
 	//	// Exponential moving average of the median
@@ -868,17 +1025,12 @@ bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex) {
 	_avgCurrentRmsMilliAmp = currentRmsMedianMA;
 
 	// Calculate median when there are enough values in history, else calculate the average.
-	_voltageRmsMilliVoltHist->push(voltageRmsMilliVolt);
-	if (_voltageRmsMilliVoltHist->full()) {
-		memcpy(_histCopy, _voltageRmsMilliVoltHist->getBuffer(), _voltageRmsMilliVoltHist->getMaxByteSize());
-		_avgVoltageRmsMilliVolt = opt_med(_histCopy);
+	_voltageRmsMilliVoltHist.push(voltageRmsMilliVolt);
+	if (_voltageRmsMilliVoltHist.full()) {
+		_avgVoltageRmsMilliVolt = _voltageRmsMilliVoltHist.getMedian();
 	}
 	else {
-		int64_t voltageRmsMilliVoltSum = 0;
-		for (uint16_t i = 0; i < _voltageRmsMilliVoltHist->size(); ++i) {
-			voltageRmsMilliVoltSum += _voltageRmsMilliVoltHist->operator[](i);
-		}
-		_avgVoltageRmsMilliVolt = voltageRmsMilliVoltSum / _voltageRmsMilliVoltHist->size();
+		_avgVoltageRmsMilliVolt = _voltageRmsMilliVoltHist.getAverage();
 	}
 
 	// Calculate apparent power: current_rms * voltage_rms
@@ -892,6 +1044,16 @@ bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex) {
 		powerMilliWattReal -= _powerZero;
 	}
 
+	if (harmonicsValid
+		&& _powerQuality.add(
+				harmonicSums.harmonics[VOLTAGE_CHANNEL_IDX],
+				harmonicSums.harmonics[CURRENT_CHANNEL_IDX],
+				powerMilliWattReal,
+				currentRmsMA,
+				voltageRmsMilliVolt)) {
+		publishPowerQuality();
+	}
+
 	// Exponential moving average
 	int64_t avgPowerDiscount = _avgPowerDiscount;
 	_avgPowerMilliWatt =
@@ -947,48 +1109,77 @@ bool PowerSampling::calculatePower(adc_buffer_id_t bufIndex) {
 	}
 
 	if (_logsEnabled.flags.current) {
-		// Write uart_msg_current_t without allocating a buffer.
-		UartHandler::getInstance().writeMsgStart(UART_OPCODE_TX_POWER_LOG_CURRENT, sizeof(uart_msg_current_t));
-		UartHandler::getInstance().writeMsgPart(
-				UART_OPCODE_TX_POWER_LOG_CURRENT, (uint8_t*)&(rtcCount), sizeof(rtcCount));
-		adc_sample_value_t val;
-		for (adc_sample_value_id_t i = 0; i < AdcBuffer::getChannelLength(); ++i) {
-			val = AdcBuffer::getInstance().getValue(bufIndex, CURRENT_CHANNEL_IDX, i);
-			UartHandler::getInstance().writeMsgPart(UART_OPCODE_TX_POWER_LOG_CURRENT, (uint8_t*)&val, sizeof(val));
-		}
-		UartHandler::getInstance().writeMsgEnd(UART_OPCODE_TX_POWER_LOG_CURRENT);
+		logSamples(
+				bufIndex, CURRENT_CHANNEL_IDX, UART_OPCODE_TX_POWER_LOG_CURRENT, UART_SAMPLES_TYPE_CURRENT, rtcCount);
 	}
 
 	if (_logsEnabled.flags.filteredCurrent) {
-		// Write uart_msg_current_t without allocating a buffer.
-		UartHandler::getInstance().writeMsgStart(UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT, sizeof(uart_msg_current_t));
-		UartHandler::getInstance().writeMsgPart(
-				UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT, (uint8_t*)&(rtcCount), sizeof(rtcCount));
-		adc_sample_value_t val;
-		for (adc_sample_value_id_t i = 0; i < AdcBuffer::getChannelLength(); ++i) {
-			val = AdcBuffer::getInstance().getValue(bufIndex, CURRENT_CHANNEL_IDX, i);
-			UartHandler::getInstance().writeMsgPart(
-					UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT, (uint8_t*)&val, sizeof(val));
-		}
-		UartHandler::getInstance().writeMsgEnd(UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT);
+		logSamples(
+				bufIndex,
+				CURRENT_CHANNEL_IDX,
+				UART_OPCODE_TX_POWER_LOG_FILTERED_CURRENT,
+				UART_SAMPLES_TYPE_FILTERED_CURRENT,
+				rtcCount);
 	}
 
 	if (_logsEnabled.flags.voltage) {
-		// Write uart_msg_voltage_t without allocating a buffer.
-		UartHandler::getInstance().writeMsgStart(UART_OPCODE_TX_POWER_LOG_VOLTAGE, sizeof(uart_msg_voltage_t));
-		UartHandler::getInstance().writeMsgPart(
-				UART_OPCODE_TX_POWER_LOG_VOLTAGE, (uint8_t*)&(rtcCount), sizeof(rtcCount));
-		adc_sample_value_t val;
-		for (adc_sample_value_id_t i = 0; i < AdcBuffer::getChannelLength(); ++i) {
-			val = AdcBuffer::getInstance().getValue(bufIndex, VOLTAGE_CHANNEL_IDX, i);
-			UartHandler::getInstance().writeMsgPart(UART_OPCODE_TX_POWER_LOG_VOLTAGE, (uint8_t*)&val, sizeof(val));
-		}
-		UartHandler::getInstance().writeMsgEnd(UART_OPCODE_TX_POWER_LOG_VOLTAGE);
+		logSamples(
+				bufIndex, VOLTAGE_CHANNEL_IDX, UART_OPCODE_TX_POWER_LOG_VOLTAGE, UART_SAMPLES_TYPE_VOLTAGE, rtcCount);
 	}
 
 	return true;
 }
 
+void PowerSampling::publishPowerQuality() {
+	cs_power_quality_t powerQuality;
+	_powerQuality.calculate(_voltageMultiplier, _currentMultiplier, powerQuality);
+	State::getInstance().set(CS_TYPE::STATE_POWER_QUALITY, &powerQuality, sizeof(powerQuality));
+
+	if (_logsEnabled.flags.power) {
+		UartHandler::getInstance().writeMsg(
+				UART_OPCODE_TX_POWER_LOG_POWER_QUALITY, (uint8_t*)&powerQuality, sizeof(powerQuality));
+	}
+}
+
+void PowerSampling::logSamples(
+		adc_buffer_id_t bufIndex,
+		adc_channel_id_t channel,
+		UartOpcodeTx opCode,
+		UartSamplesType type,
+		uint32_t timestamp) {
+	const adc_sample_value_t* samples = AdcBuffer::getInstance().getChannelValues(bufIndex, channel);
+	uart_msg_samples_header_t header;
+	switch (_logSamplesStreamMode) {
+		case UART_SAMPLES_STREAM_RAW: header.encoding = UART_SAMPLES_ENCODING_RAW; break;
+		case UART_SAMPLES_STREAM_DELTA: header.encoding = UART_SAMPLES_ENCODING_DELTA; break;
+		case UART_SAMPLES_STREAM_OFF:
+		default: {
+			// Same payload as uart_msg_current_t and uart_msg_voltage_t.
+			UartHandler::getInstance().writeMsgSamples(
+					opCode,
+					cs_data_t(reinterpret_cast<uint8_t*>(&timestamp), sizeof(timestamp)),
+					samples,
+					AdcBuffer::getChannelLength(),
+					AdcBuffer::getChannelStride(),
+					UART_SAMPLES_ENCODING_RAW,
+					false);
+			return;
+		}
+	}
+	header.timestamp    = timestamp;
+	header.type         = type;
+	header.droppedCount = UartHandler::getInstance().getSamplesDroppedCount();
+	header.numSamples   = AdcBuffer::getChannelLength();
+	UartHandler::getInstance().writeMsgSamples(
+			UART_OPCODE_TX_POWER_LOG_SAMPLES,
+			cs_data_t(reinterpret_cast<uint8_t*>(&header), sizeof(header)),
+			samples,
+			AdcBuffer::getChannelLength(),
+			AdcBuffer::getChannelStride(),
+			static_cast<UartSamplesEncoding>(header.encoding),
+			true);
+}
+
 void PowerSampling::calculateSlowAveragePower(float powerMilliWatt, float fastAvgPowerMilliWatt) {
 	if (_switchHist.size() >= 2) {
 		if (_switchHist[_switchHist.size() - 2].asInt != _switchHist[_switchHist.size() - 1].asInt) {
@@ -1081,6 +1272,7 @@ void PowerSampling::checkSoftfuse(
 		int32_t currentRmsMilliAmpFiltered,
 		int32_t voltageRmsMilliVolt,
 		adc_buffer_id_t bufIndex) {
+	SoftfuseLatency::getInstance().onCheck(AdcBuffer::getInstance().getBuffer(bufIndex)->doneTicks, RTC::getCount());
 
 	// Get the current state errors
 	TYPIFY(STATE_ERRORS) stateErrors;
@@ -1172,6 +1364,7 @@ void PowerSampling::checkSoftfuse(
 		State::getInstance().set(CS_TYPE::STATE_ERRORS, &stateErrors, sizeof(stateErrors));
 
 		event_t event(CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD);
+		SoftfuseLatency::getInstance().onDispatch(RTC::getCount());
 		EventDispatcher::getInstance().dispatch(event);
 		return;
 	}
@@ -1201,6 +1394,7 @@ void PowerSampling::checkSoftfuse(
 
 			// Dispatch the event that will turn off the dimmer
 			event_t event(CS_TYPE::EVT_CURRENT_USAGE_ABOVE_THRESHOLD_DIMMER);
+			SoftfuseLatency::getInstance().onDispatch(RTC::getCount());
 			EventDispatcher::getInstance().dispatch(event);
 		}
 		else if (switchState.state.relay == 0 && !recentlySwitchedOff && _dimmerFailureDetectionStarted) {
@@ -1218,6 +1412,7 @@ void PowerSampling::checkSoftfuse(
 			State::getInstance().set(CS_TYPE::STATE_ERRORS, &stateErrors, sizeof(stateErrors));
 
 			event_t event(CS_TYPE::EVT_DIMMER_ON_FAILURE_DETECTED);
+			SoftfuseLatency::getInstance().onDispatch(RTC::getCount());
 			EventDispatcher::getInstance().dispatch(event);
 		}
 	}
@@ -1444,6 +1639,7 @@ void PowerSampling::applyAdcConfig(adc_channel_id_t channelIndex) {
 }
 
 void PowerSampling::enableSwitchcraft(bool enable) {
+	_switchcraftEnabled = enable;
 	if (enable) {
 		RecognizeSwitch::getInstance().start();
 	}
@@ -6,11 +6,16 @@
  */
 
 #include <cfg/cs_Config.h>
+#include <processing/cs_PowerKernel.h>
 #include <processing/cs_RecognizeSwitch.h>
 #include <protocol/cs_Packets.h>
 #include <structs/cs_PacketsInternal.h>
 #include <time/cs_SystemTime.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #define LOGSwitchcraftWarn LOGw
 #define LOGSwitchcraftDebug LOGnone
 #define LOGSwitchcraftVerbose LOGnone
@@ -55,9 +60,13 @@ bool RecognizeSwitch::detect(const CircularBuffer<adc_buffer_id_t>& bufQueue, ad
 		return false;
 	}
 
+	if (!loadBuffers(bufQueue, voltageChannelId)) {
+		return false;
+	}
+
 	FoundSwitch found = FoundSwitch::False;
 	for (uint8_t i = 0; i < (_numBuffersRequired - 2); ++i) {
-		FoundSwitch tempFound = detect(bufQueue, voltageChannelId, i);
+		FoundSwitch tempFound = detect(i);
 		if (tempFound == FoundSwitch::True) {
 			found = tempFound;
 			break;
@@ -67,15 +76,20 @@ bool RecognizeSwitch::detect(const CircularBuffer<adc_buffer_id_t>& bufQueue, ad
 		}
 	}
 
+	// Check buffer validity after the calculations, as the buffers may have been overwritten meanwhile.
+	if (!buffersValid()) {
+		return false;
+	}
+
 	switch (found) {
 		case FoundSwitch::True: {
-			setLastDetection(true, bufQueue, voltageChannelId);
+			setLastDetection(true);
 			_skipSwitchDetectionTriggers = 5;
 			return true;
 		}
 		case FoundSwitch::Almost: {
 			LOGSwitchcraftDebug("Almost found switch");
-			setLastDetection(false, bufQueue, voltageChannelId);
+			setLastDetection(false);
 			return false;
 		}
 		case FoundSwitch::False: {
@@ -83,233 +97,109 @@ bool RecognizeSwitch::detect(const CircularBuffer<adc_buffer_id_t>& bufQueue, ad
 			return false;
 		}
 	}
-
-	//	FoundSwitch found = detectSwitch(bufQueue, voltageChannelId);
-	//
-	//	switch (found) {
-	//		case FoundSwitch::True: {
-	//			setLastDetection(true, bufQueue, voltageChannelId);
-	//			_skipSwitchDetectionTriggers = 5;
-	//			return true;
-	//		}
-	//		case FoundSwitch::Almost: {
-	//			setLastDetection(false, bufQueue, voltageChannelId);
-	//			return false;
-	//		}
-	//		case FoundSwitch::False: {
-	//			return false;
-	//		}
-	//	}
-
 	return false;
 }
 
-RecognizeSwitch::FoundSwitch RecognizeSwitch::detectSwitch(
-		const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId) {
-	// Buffer index (size - 1) is unfiltered buffer.
-	adc_buffer_id_t bufIndexFirst      = bufQueue[bufQueue.size() - (1 + _numBuffersRequired)];
-	adc_buffer_id_t bufIndexLast       = bufQueue[bufQueue.size() - (1 + 1)];
-
-	bool foundAlmost                   = false;
-
-	// Check only part of the buffer length (half buffer length).
-	// Then repeat that at different parts of the buffer (start, mid, end).
-	// Example: if channel length = 100, then check 0-49, 25-74, and 50-99.
-	adc_sample_value_id_t bufferLength = AdcBuffer::getInstance().getChannelLength();
-	adc_sample_value_id_t checkLength  = bufferLength / 2;
-	adc_sample_value_id_t shift        = checkLength / 2;
-	adc_sample_value_id_t startIndex;
+bool RecognizeSwitch::loadBuffers(const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId) {
+	AdcBuffer& ib = AdcBuffer::getInstance();
 
-	float diffFirstLast, diffCenterFirst, diffCenterLast;
-	float minDiff;
-	float lowerTheshold = 0.1 * _thresholdDifferent;
-
-	AdcBuffer& ib       = AdcBuffer::getInstance();
-
-	for (startIndex = 0; startIndex < (bufferLength - shift); startIndex += shift) {
-
-		// Difference between first and last buffer.
-		diffFirstLast = calcDiff(bufQueue, voltageChannelId, bufIndexFirst, bufIndexLast, startIndex, checkLength);
-
-		// Loop over the center buffers.
-		for (uint8_t i = 0; i < (_numBuffersRequired - 2); ++i) {
-			adc_buffer_id_t bufIndexCenter = bufQueue[bufQueue.size() - (1 + _numBuffersRequired - i - 1)];
-
-			// Check buffer validity before doing the calculations.
-			if (!ib.getBuffer(bufIndexFirst)->valid || !ib.getBuffer(bufIndexCenter)->valid
-				|| !ib.getBuffer(bufIndexLast)->valid) {
-				LOGSwitchcraftWarn("Buffer not valid");
-				return RecognizeSwitch::FoundSwitch::False;
-			}
-
-			// Difference between center and first buffer. And between center and last buffer.
-			diffCenterFirst =
-					calcDiff(bufQueue, voltageChannelId, bufIndexFirst, bufIndexCenter, startIndex, checkLength);
-			diffCenterLast =
-					calcDiff(bufQueue, voltageChannelId, bufIndexLast, bufIndexCenter, startIndex, checkLength);
-
-			// Check buffer validity after doing the calculations.
-			if (!ib.getBuffer(bufIndexFirst)->valid || !ib.getBuffer(bufIndexCenter)->valid
-				|| !ib.getBuffer(bufIndexLast)->valid) {
-				LOGSwitchcraftWarn("Buffer not valid");
-				return RecognizeSwitch::FoundSwitch::False;
-			}
-
-			LOGnone("buffer ind: first=%u center=%u last=%u", bufIndexFirst, bufIndexCenter, bufIndexLast);
-			LOGSwitchcraftVerbose(
-					"center iter=%u sample start=%u %d %d %d",
-					i,
-					startIndex,
-					(int32_t)diffCenterFirst,
-					(int32_t)diffCenterLast,
-					(int32_t)diffFirstLast);
-			if (diffCenterFirst > _thresholdDifferent && diffCenterLast > _thresholdDifferent) {
-				minDiff = diffCenterFirst < diffCenterLast ? diffCenterFirst : diffCenterLast;
-				if (diffFirstLast < _thresholdSimilar || minDiff / diffFirstLast > _thresholdRatio) {
-					LOGSwitchcraftDebug(
-							"Found switch: %i %i %i %i",
-							(int)diffCenterFirst,
-							(int)diffCenterLast,
-							(int)diffFirstLast,
-							(int)(minDiff / diffFirstLast));
-					return FoundSwitch::True;
-				}
-			}
-
-			// Check if it was almost recognized as switch.
-			if (diffCenterFirst > lowerTheshold && diffCenterLast > lowerTheshold
-				&& diffFirstLast < _thresholdSimilar) {
-				LOGSwitchcraftDebug(
-						"Almost found switch: %i %i %i", (int)diffCenterFirst, (int)diffCenterLast, (int)diffFirstLast);
-				foundAlmost = true;
-			}
-		}
+	// Buffer index (size - 1) is unfiltered buffer.
+	for (uint8_t i = 0; i < _numBuffersRequired; ++i) {
+		_bufIndices[i] = bufQueue[bufQueue.size() - (1 + _numBuffersRequired) + i];
 	}
-
-	if (foundAlmost) {
-		return RecognizeSwitch::FoundSwitch::Almost;
+	if (!buffersValid()) {
+		return false;
 	}
-	return RecognizeSwitch::FoundSwitch::False;
-}
 
-float RecognizeSwitch::calcDiff(
-		const CircularBuffer<adc_buffer_id_t>& bufQueue,
-		const adc_channel_id_t voltageChannelId,
-		const adc_buffer_id_t bufIndex1,
-		const adc_buffer_id_t bufIndex2,
-		const adc_sample_value_id_t startIndex,
-		const adc_sample_value_id_t numSamples) {
-	AdcBuffer& ib                  = AdcBuffer::getInstance();
-	adc_sample_value_id_t endIndex = startIndex + numSamples;
-	float diffSum                  = 0;
-	float value1, value2, diff;
-	LOGnone("start=%i end=%i", startIndex, endIndex);
-	for (int i = startIndex; i < endIndex; ++i) {
-		value1 = ib.getValue(bufIndex1, voltageChannelId, i);
-		value2 = ib.getValue(bufIndex2, voltageChannelId, i);
-		if (ignoreSample(value1, value2)) {
-			diff = 0;
+	_hasIgnoredSamples = false;
+	for (uint8_t i = 0; i < _numBuffersRequired; ++i) {
+#if BUILD_ADC_DEINTERLEAVED == 0
+		adc_channel_values_t values = ib.getChannel(_bufIndices[i], voltageChannelId);
+		for (adc_sample_value_id_t j = 0; j < values.length; ++j) {
+			_voltageCopy[i][j] = values[j];
 		}
-		else {
-			diff = (value1 - value2) * (value1 - value2);
+		_voltage[i] = _voltageCopy[i];
+#else
+		_voltage[i] = ib.getChannelValues(_bufIndices[i], voltageChannelId);
+#endif
+		for (adc_sample_value_id_t j = 0; j < AdcBuffer::getChannelLength(); ++j) {
+			_hasIgnoredSamples |= ignoreSample(_voltage[i][j], 0);
 		}
-		diffSum += diff;
 	}
-	return diffSum;
+	return true;
 }
 
-RecognizeSwitch::FoundSwitch RecognizeSwitch::detect(
-		const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId, uint8_t iteration) {
-	AdcBuffer& ib                     = AdcBuffer::getInstance();
-
-	// Check only part of the buffer length (half buffer length).
-	// Then repeat that at different parts of the buffer (start, mid, end).
-	// Example: if channel length = 100, then check 0-49, 25-74, and 50-99.
-	adc_sample_value_id_t checkLength = ib.getChannelLength() / 2;
-	adc_sample_value_id_t shift       = checkLength / 2;
-	adc_sample_value_id_t startInd;
-	adc_sample_value_id_t endInd;
+bool RecognizeSwitch::buffersValid() {
+	AdcBuffer& ib = AdcBuffer::getInstance();
+	for (uint8_t i = 0; i < _numBuffersRequired; ++i) {
+		if (!ib.getBuffer(_bufIndices[i])->valid) {
+			LOGSwitchcraftWarn("Buffer not valid");
+			return false;
+		}
+	}
+	return true;
+}
 
-	// Buffer index (size - 1) is unfiltered buffer.
-	adc_buffer_id_t bufIndexFirst  = bufQueue[bufQueue.size() - (1 + _numBuffersRequired)];
-	adc_buffer_id_t bufIndexCenter = bufQueue[bufQueue.size() - (1 + _numBuffersRequired - iteration - 1)];
-	adc_buffer_id_t bufIndexLast   = bufQueue[bufQueue.size() - (1 + 1)];
-	LOGnone("buffer ind: first=%u center=%u last=%u", bufIndexFirst, bufIndexCenter, bufIndexLast);
-
-	// Check buffer validity before doing the calculations.
-	if (!ib.getBuffer(bufIndexFirst)->valid || !ib.getBuffer(bufIndexCenter)->valid
-		|| !ib.getBuffer(bufIndexLast)->valid) {
-		LOGSwitchcraftWarn("Buffer not valid");
-		return RecognizeSwitch::FoundSwitch::False;
+RecognizeSwitch::FoundSwitch RecognizeSwitch::detect(uint8_t iteration) {
+	uint8_t first  = 0;
+	uint8_t center = iteration + 1;
+	uint8_t last   = _numBuffersRequired - 1;
+
+	// Summed diff between all values of 2 buffers, per segment.
+	uint32_t diffSumCenterFirst[_numSegments];
+	uint32_t diffSumCenterLast[_numSegments];
+	for (uint8_t i = 0; i < _numSegments; ++i) {
+		diffSumCenterFirst[i] = calcDiff(first, center, last, i * _segmentLength, _segmentLength, UINT32_MAX);
+		diffSumCenterLast[i]  = calcDiff(center, last, first, i * _segmentLength, _segmentLength, UINT32_MAX);
 	}
 
-	float valueFirst, valueCenter, valueLast;
-	float diffCenterFirst, diffCenterLast, diffFirstLast;           // Diff between 2 values of 2 buffers.
-	float diffSumCenterFirst, diffSumCenterLast, diffSumFirstLast;  // Summed diff between all values of 2 buffers.
-	float minDiffSum;
 	float lowerTheshold = 0.1 * _thresholdDifferent;
 	bool foundAlmost    = false;
 
-	for (startInd = 0; startInd < (ib.getChannelLength() - shift); startInd += shift) {
-		diffSumCenterFirst = 0;
-		diffSumCenterLast  = 0;
-		diffSumFirstLast   = 0;
-		endInd             = startInd + checkLength;
-		LOGnone("start=%i end=%i", startInd, endInd);
-		for (int i = startInd; i < endInd; ++i) {
-			valueFirst  = ib.getValue(bufIndexFirst, voltageChannelId, i);
-			valueCenter = ib.getValue(bufIndexCenter, voltageChannelId, i);
-			valueLast   = ib.getValue(bufIndexLast, voltageChannelId, i);
-			if (ignoreSample(valueFirst, valueCenter, valueLast)) {
-				diffCenterFirst = 0;
-				diffCenterLast  = 0;
-				diffFirstLast   = 0;
-			}
-			else {
-				diffCenterFirst = (valueFirst - valueCenter) * (valueFirst - valueCenter);
-				diffCenterLast  = (valueCenter - valueLast) * (valueCenter - valueLast);
-				diffFirstLast   = (valueFirst - valueLast) * (valueFirst - valueLast);
-			}
-			diffSumCenterFirst += diffCenterFirst;
-			diffSumCenterLast += diffCenterLast;
-			diffSumFirstLast += diffFirstLast;
+	// Check only part of the buffer length (half buffer length).
+	// Then repeat that at different parts of the buffer (start, mid, end).
+	// Example: if channel length = 100, then check 0-49, 25-74, and 50-99.
+	for (uint8_t window = 0; window < _numWindows; ++window) {
+		uint32_t windowCenterFirst = diffSumCenterFirst[window] + diffSumCenterFirst[window + 1];
+		uint32_t windowCenterLast  = diffSumCenterLast[window] + diffSumCenterLast[window + 1];
+		bool different = windowCenterFirst > _thresholdDifferent && windowCenterLast > _thresholdDifferent;
+		bool almostDifferent = windowCenterFirst > lowerTheshold && windowCenterLast > lowerTheshold;
+		if (!different && !almostDifferent) {
+			continue;
 		}
+
+		// The first and last buffer only matter when they're similar: below the similar threshold, or below the
+		// ratio threshold (minDiffSum / diffSumFirstLast > _thresholdRatio). So stop summing above that.
+		float maxDiffSumFirstLast = _thresholdSimilar;
+		uint32_t minDiffSum       = std::min(windowCenterFirst, windowCenterLast);
+		if (different) {
+			maxDiffSumFirstLast = std::max(maxDiffSumFirstLast, minDiffSum / _thresholdRatio);
+		}
+		uint32_t limit = UINT32_MAX;
+		if (maxDiffSumFirstLast < UINT32_MAX) {
+			limit = static_cast<uint32_t>(std::ceil(maxDiffSumFirstLast));
+		}
+		uint32_t diffSumFirstLast =
+				calcDiff(first, last, center, window * _segmentLength, 2 * _segmentLength, limit);
+
 		LOGSwitchcraftVerbose(
-				"center iter=%u sample start=%u %d %d %d",
+				"center iter=%u sample start=%u %u %u %u",
 				iteration,
-				startInd,
-				(int32_t)diffSumCenterFirst,
-				(int32_t)diffSumCenterLast,
-				(int32_t)diffSumFirstLast);
-
-		// Check buffer validity after doing the calculations.
-		if (!ib.getBuffer(bufIndexFirst)->valid || !ib.getBuffer(bufIndexCenter)->valid
-			|| !ib.getBuffer(bufIndexLast)->valid) {
-			LOGSwitchcraftWarn("Buffer not valid");
-			return RecognizeSwitch::FoundSwitch::False;
-		}
+				window * _segmentLength,
+				windowCenterFirst,
+				windowCenterLast,
+				diffSumFirstLast);
 
-		if (diffSumCenterFirst > _thresholdDifferent && diffSumCenterLast > _thresholdDifferent) {
-			minDiffSum = diffSumCenterFirst < diffSumCenterLast ? diffSumCenterFirst : diffSumCenterLast;
-			if (diffSumFirstLast < _thresholdSimilar || minDiffSum / diffSumFirstLast > _thresholdRatio) {
-				LOGSwitchcraftDebug(
-						"Found switch: %i %i %i %i",
-						(int)diffSumCenterFirst,
-						(int)diffSumCenterLast,
-						(int)diffSumFirstLast,
-						(int)(minDiffSum / diffSumFirstLast));
-				return RecognizeSwitch::FoundSwitch::True;
-			}
+		if (different && diffSumFirstLast < maxDiffSumFirstLast) {
+			LOGSwitchcraftDebug(
+					"Found switch: %u %u %u", windowCenterFirst, windowCenterLast, diffSumFirstLast);
+			return RecognizeSwitch::FoundSwitch::True;
 		}
 
 		// Check if it was almost recognized as switch.
-		if (diffSumCenterFirst > lowerTheshold && diffSumCenterLast > lowerTheshold
-			&& diffSumFirstLast < _thresholdSimilar) {
+		if (almostDifferent && diffSumFirstLast < _thresholdSimilar) {
 			LOGSwitchcraftDebug(
-					"Almost found switch: %i %i %i",
-					(int)diffSumCenterFirst,
-					(int)diffSumCenterLast,
-					(int)diffSumFirstLast);
+					"Almost found switch: %u %u %u", windowCenterFirst, windowCenterLast, diffSumFirstLast);
 			foundAlmost = true;
 		}
 	}
@@ -320,6 +210,31 @@ RecognizeSwitch::FoundSwitch RecognizeSwitch::detect(
 	return RecognizeSwitch::FoundSwitch::False;
 }
 
+uint32_t RecognizeSwitch::calcDiff(
+		uint8_t buffer1,
+		uint8_t buffer2,
+		uint8_t buffer3,
+		adc_sample_value_id_t startIndex,
+		adc_sample_value_id_t numSamples,
+		uint32_t limit) {
+	const adc_sample_value_t* values1 = _voltage[buffer1] + startIndex;
+	const adc_sample_value_t* values2 = _voltage[buffer2] + startIndex;
+	const adc_sample_value_t* values3 = _voltage[buffer3] + startIndex;
+	if (!_hasIgnoredSamples) {
+		return powerKernelSquaredDiffSum(values1, values2, numSamples, limit);
+	}
+
+	uint32_t diffSum = 0;
+	for (adc_sample_value_id_t i = 0; i < numSamples && diffSum < limit; ++i) {
+		if (ignoreSample(values1[i], values2[i], values3[i])) {
+			continue;
+		}
+		int32_t diff = values1[i] - values2[i];
+		diffSum += diff * diff;
+	}
+	return diffSum;
+}
+
 bool RecognizeSwitch::ignoreSample(const adc_sample_value_t value1, const adc_sample_value_t value2) {
 	return ignoreSample(value1, value2, 0);
 }
@@ -334,8 +249,7 @@ bool RecognizeSwitch::ignoreSample(
 	return false;
 }
 
-void RecognizeSwitch::setLastDetection(
-		bool aboveThreshold, const CircularBuffer<adc_buffer_id_t>& bufQueue, adc_channel_id_t voltageChannelId) {
+void RecognizeSwitch::setLastDetection(bool aboveThreshold) {
 	cs_power_samples_header_t* header;
 	int16_t* buf;
 	if (aboveThreshold) {
@@ -355,19 +269,11 @@ void RecognizeSwitch::setLastDetection(
 	//	header->offset =
 	//	header->multiplier =
 
-	// Copy the samples.
-	AdcBuffer& ib            = AdcBuffer::getInstance();
-	adc_buffer_id_t bufIndices[_numStoredBuffers];
+	// Copy the samples, they are the loaded buffers, without the unfiltered buffer.
+	static_assert(_numStoredBuffers == _numBuffersRequired, "Stored buffers should be the loaded buffers");
+	uint16_t numSamples = AdcBuffer::getChannelLength();
 	for (uint8_t i = 0; i < _numStoredBuffers; ++i) {
-		bufIndices[i] =
-				bufQueue[bufQueue.size() - (1 + _numBuffersRequired) + i];  // Last buffer is the unfiltered version.
-	}
-
-	uint16_t numSamples = ib.getChannelLength();
-	for (uint8_t i = 0; i < _numStoredBuffers; ++i) {
-		for (adc_sample_value_id_t j = 0; j < numSamples; ++j) {
-			buf[i * numSamples + j] = ib.getValue(bufIndices[i], voltageChannelId, j);
-		}
+		memcpy(buf + i * numSamples, _voltage[i], numSamples * sizeof(adc_sample_value_t));
 	}
 }
 
@@ -0,0 +1,60 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <drivers/cs_RTC.h>
+#include <processing/cs_SoftfuseLatency.h>
+
+void SoftfuseLatency::onCheck(uint32_t bufferDoneTicks, uint32_t checkTicks) {
+	// A dispatched softfuse that didn't lead to a switch off is not measured.
+	_dispatched      = false;
+	_bufferDoneTicks = bufferDoneTicks;
+	_checkTicks      = checkTicks;
+	add(_stats.bufferToCheck, _bufferToCheckTotalUs, ticksToUs(checkTicks, bufferDoneTicks));
+}
+
+void SoftfuseLatency::onDispatch(uint32_t dispatchTicks) {
+	_dispatched    = true;
+	_dispatchTicks = dispatchTicks;
+	add(_stats.checkToDispatch, _checkToDispatchTotalUs, ticksToUs(dispatchTicks, _checkTicks));
+}
+
+void SoftfuseLatency::onSwitchOff(uint32_t switchOffTicks) {
+	if (!_dispatched) {
+		return;
+	}
+	_dispatched        = false;
+	uint32_t latencyUs = ticksToUs(switchOffTicks, _bufferDoneTicks);
+	add(_stats.dispatchToSwitchOff, _dispatchToSwitchOffTotalUs, ticksToUs(switchOffTicks, _dispatchTicks));
+	add(_stats.bufferToSwitchOff, _bufferToSwitchOffTotalUs, latencyUs);
+	_stats.histogram[getHistogramBin(latencyUs)]++;
+}
+
+uint8_t SoftfuseLatency::getHistogramBin(uint32_t latencyUs) {
+	uint32_t latencyMs = latencyUs / 1000;
+	uint8_t bin        = 0;
+	while (latencyMs != 0 && bin < SOFTFUSE_LATENCY_BINS - 1) {
+		latencyMs >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+uint32_t SoftfuseLatency::ticksToUs(uint32_t ticksTo, uint32_t ticksFrom) {
+	return static_cast<uint64_t>(RTC::difference(ticksTo, ticksFrom)) * 1000 * 1000 / RTC_CLOCK_FREQ;
+}
+
+void SoftfuseLatency::add(cs_latency_stats_t& stats, uint64_t& totalUs, uint32_t latencyUs) {
+	if (stats.count == 0 || latencyUs < stats.minUs) {
+		stats.minUs = latencyUs;
+	}
+	if (latencyUs > stats.maxUs) {
+		stats.maxUs = latencyUs;
+	}
+	stats.count++;
+	totalUs += latencyUs;
+	stats.avgUs = totalUs / stats.count;
+}
@@ -28,7 +28,10 @@ void TapToToggle::init(int8_t defaultRssiThreshold) {
 			CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET, &thresholdOffset, sizeof(thresholdOffset));
 	rssiThreshold = defaultRssiThreshold + thresholdOffset;
 	LOGd("RSSI threshold = %i", rssiThreshold);
-	EventDispatcher::getInstance().addListener(this);
+	listen({CS_TYPE::EVT_TICK,
+			CS_TYPE::EVT_ADV_BACKGROUND_PARSED,
+			CS_TYPE::CONFIG_TAP_TO_TOGGLE_ENABLED,
+			CS_TYPE::CONFIG_TAP_TO_TOGGLE_RSSI_THRESHOLD_OFFSET});
 }
 
 void TapToToggle::handleBackgroundAdvertisement(adv_background_parsed_t* adv) {
@@ -24,6 +24,10 @@
 #error "TICK_INTERVAL_MS must not be larger than STATE_RETRY_STORE_DELAY_MS"
 #endif
 
+#if TICK_INTERVAL_MS > STATE_WRITE_BACK_DELAY_MS
+#error "TICK_INTERVAL_MS must not be larger than STATE_WRITE_BACK_DELAY_MS"
+#endif
+
 // Define to get more debug logs.
 #if !defined(CS_STATE_DEBUG_LOGS)
 #define CS_STATE_DEBUG_LOGS 0
@@ -35,12 +39,15 @@ void storageErrorCallback(cs_storage_operation_t operation, CS_TYPE type, cs_sta
 	State::getInstance().handleStorageError(operation, type, id);
 }
 
-State::State() : _storage(NULL), _boardsConfig(NULL) {}
+State::State() : _storage(NULL), _boardsConfig(NULL) {
+	for (size16_t i = 0; i < STATE_RAM_INDEX_BUCKETS; ++i) {
+		_ramIndexBuckets[i] = CS_STATE_RAM_INDEX_NONE;
+	}
+}
 
 State::~State() {
 	for (auto it = _ram_data_register.begin(); it < _ram_data_register.end(); it++) {
-		cs_state_data_t* ram_data = &(*it);
-		free(ram_data->value);
+		deallocate(*it);
 	}
 	for (auto it = _idsCache.begin(); it < _idsCache.end(); it++) {
 		delete it->ids;
@@ -61,6 +68,8 @@ void State::init(boards_config_t* boardsConfig) {
 		return;
 	}
 	_storage->setErrorCallback(storageErrorCallback);
+	_ram_data_register.reserve(STATE_RAM_REGISTER_RESERVED_SIZE);
+	_ramIndexNext.reserve(STATE_RAM_REGISTER_RESERVED_SIZE);
 	EventDispatcher::getInstance().addListener(this);
 	setInitialized();
 }
@@ -144,49 +153,14 @@ cs_ret_code_t State::get(cs_state_data_t& data, const PersistenceMode mode) {
 		case PersistenceMode::RAM: return loadFromRam(data);
 		case PersistenceMode::FLASH: data.size = typeSize; return _storage->read(data);
 		case PersistenceMode::STRATEGY1: {
-			// First check if it's already in ram.
-			ret_code = loadFromRam(data);
-			if (ret_code == ERR_SUCCESS) {
-				//				LOGStateDebug("Loaded from RAM: $typeName(%u)", data.type);
-				return ERR_SUCCESS;
-			}
-			// Else we're going to add a new type to the ram data.
-			cs_state_data_t& ram_data = addToRam(type, id, typeSize);
-
-			// See if we need to check flash.
-			if (DefaultLocation(type) == PersistenceMode::RAM) {
-				LOGd("Load default: $typeName(%u)", ram_data.type);
-				ret_code = getDefaultValue(ram_data);
-				if (ret_code != ERR_SUCCESS) {
-					return ret_code;
-				}
-			}
-			else {
-				ret_code = _storage->read(ram_data);
-
-				// Temp code, to retain old reset counter.
-				if (ram_data.type == CS_TYPE::STATE_RESET_COUNTER && ret_code == ERR_NOT_FOUND) {
-					LOGi("Load old reset counter");
-					ret_code = _storage->readV3ResetCounter(ram_data);
-				}
-
-				switch (ret_code) {
-					case ERR_SUCCESS: {
-						break;
-					}
-					case ERR_NOT_FOUND:
-					default: {
-						LOGd("Load default: $typeName(%u)", ram_data.type);
-						ret_code = getDefaultValue(ram_data);
-						if (ret_code != ERR_SUCCESS) {
-							return ret_code;
-						}
-						break;
-					}
-				}
+			size16_t index_in_ram;
+			ret_code = loadIntoRam(type, id, index_in_ram);
+			if (ret_code != ERR_SUCCESS) {
+				return ret_code;
 			}
-			// Finally, copy data from ram to user data.
-			data.size = ram_data.size;
+			// Copy data from ram to user data.
+			cs_state_data_t& ram_data = _ram_data_register[index_in_ram];
+			data.size                 = ram_data.size;
 			memcpy(data.value, ram_data.value, ram_data.size);
 			break;
 		}
@@ -194,6 +168,63 @@ cs_ret_code_t State::get(cs_state_data_t& data, const PersistenceMode mode) {
 	return ret_code;
 }
 
+/**
+ * When the value is not found in flash, or fails to load, the default value is used.
+ * When there's no default value either, the entry is removed from ram again.
+ */
+cs_ret_code_t State::loadIntoRam(const CS_TYPE& type, cs_state_id_t id, size16_t& index_in_ram) {
+	// First check if it's already in ram.
+	cs_ret_code_t ret_code = findInRam(type, id, index_in_ram);
+	if (ret_code == ERR_SUCCESS) {
+		return ERR_SUCCESS;
+	}
+	// Else we're going to add a new type to the ram data.
+	ret_code = addToRam(type, id, TypeSize(type), index_in_ram);
+	if (ret_code != ERR_SUCCESS) {
+		return ret_code;
+	}
+	cs_state_data_t& ram_data = _ram_data_register[index_in_ram];
+
+	// See if we need to check flash.
+	if (DefaultLocation(type) == PersistenceMode::RAM) {
+		ret_code = ERR_NOT_FOUND;
+	}
+	else {
+		ret_code = _storage->read(ram_data);
+
+		// Temp code, to retain old reset counter.
+		if (ram_data.type == CS_TYPE::STATE_RESET_COUNTER && ret_code == ERR_NOT_FOUND) {
+			LOGi("Load old reset counter");
+			ret_code = _storage->readV3ResetCounter(ram_data);
+		}
+	}
+	if (ret_code != ERR_SUCCESS) {
+		LOGd("Load default: $typeName(%u)", ram_data.type);
+		ret_code = getDefaultValue(ram_data);
+		if (ret_code != ERR_SUCCESS) {
+			removeFromRam(type, id);
+			return ret_code;
+		}
+	}
+	return ERR_SUCCESS;
+}
+
+const uint8_t* State::getValueInRam(const CS_TYPE& type, size16_t size) {
+	if (!isInitialized()) {
+		LOGe(STR_ERR_NOT_INITIALIZED);
+		return nullptr;
+	}
+	if (DefaultLocation(type) == PersistenceMode::NEITHER_RAM_NOR_FLASH || TypeSize(type) != size) {
+		LOGe("Can't get type=%u size=%u", to_underlying_type(type), size);
+		return nullptr;
+	}
+	size16_t index_in_ram;
+	if (loadIntoRam(type, 0, index_in_ram) != ERR_SUCCESS) {
+		return nullptr;
+	}
+	return _ram_data_register[index_in_ram].value;
+}
+
 /**
  * There are three modes:
  *   RAM: store item in volatile memory
@@ -370,12 +401,18 @@ cs_ret_code_t State::getDefaultValue(cs_state_data_t& data) {
 	return retCode;
 }
 
+size16_t State::getRamIndexBucket(const CS_TYPE& type, cs_state_id_t id) {
+	return (to_underlying_type(type) * 31 + id) & (STATE_RAM_INDEX_BUCKETS - 1);
+}
+
 cs_ret_code_t State::findInRam(const CS_TYPE& type, cs_state_id_t id, size16_t& index_in_ram) {
-	for (size16_t i = 0; i < _ram_data_register.size(); ++i) {
+	size16_t i = _ramIndexBuckets[getRamIndexBucket(type, id)];
+	while (i != CS_STATE_RAM_INDEX_NONE) {
 		if (_ram_data_register[i].type == type && _ram_data_register[i].id == id) {
 			index_in_ram = i;
 			return ERR_SUCCESS;
 		}
+		i = _ramIndexNext[i];
 	}
 	return ERR_NOT_FOUND;
 }
@@ -399,9 +436,12 @@ cs_ret_code_t State::storeInRam(const cs_state_data_t& data, size16_t& index_in_
 			LOGe("Should not happen: ram_data.size=%u data.size=%u", ram_data.size, data.size);
 			assert(false, "See last error message");
 
-			free(ram_data.value);
+			deallocate(ram_data);
 			ram_data.size = data.size;
-			allocate(ram_data);
+			if (allocate(ram_data) != ERR_SUCCESS) {
+				removeFromRam(data.type, data.id);
+				return ERR_NO_SPACE;
+			}
 		}
 		if (memcmp(ram_data.value, data.value, data.size) == 0) {
 			LOGStateDebug("No change");
@@ -411,32 +451,71 @@ cs_ret_code_t State::storeInRam(const cs_state_data_t& data, size16_t& index_in_
 	}
 	else {
 		LOGStateDebug("Store in RAM type=%u", data.type);
-		cs_state_data_t& ram_data = addToRam(data.type, data.id, data.size);
-		memcpy(ram_data.value, data.value, data.size);
-		index_in_ram = _ram_data_register.size() - 1;
+		cs_ret_code_t retCode = addToRam(data.type, data.id, data.size, index_in_ram);
+		if (retCode != ERR_SUCCESS) {
+			return retCode;
+		}
+		memcpy(_ram_data_register[index_in_ram].value, data.value, data.size);
 	}
 
 	return ERR_SUCCESS;
 }
 
-cs_state_data_t& State::addToRam(const CS_TYPE& type, cs_state_id_t id, size16_t size) {
+/**
+ * Reuse an unused entry if there is one, and add it to the front of the chain of its bucket.
+ */
+cs_ret_code_t State::addToRam(const CS_TYPE& type, cs_state_id_t id, size16_t size, size16_t& index_in_ram) {
 	cs_state_data_t data(type, id, nullptr, size);
-	allocate(data);
-	_ram_data_register.push_back(data);
+	if (allocate(data) != ERR_SUCCESS) {
+		LOGe("No space in RAM for type=%u id=%u size=%u", to_underlying_type(type), id, size);
+		return ERR_NO_SPACE;
+	}
+	if (_ramFreeIndices.empty()) {
+		index_in_ram = _ram_data_register.size();
+		_ram_data_register.push_back(data);
+		_ramIndexNext.push_back(CS_STATE_RAM_INDEX_NONE);
+		if (_ramDirtyBitmap.size() * 32 < _ram_data_register.size()) {
+			_ramDirtyBitmap.push_back(0);
+		}
+	}
+	else {
+		index_in_ram = _ramFreeIndices.back();
+		_ramFreeIndices.pop_back();
+		_ram_data_register[index_in_ram] = data;
+	}
+	size16_t bucket             = getRamIndexBucket(type, id);
+	_ramIndexNext[index_in_ram] = _ramIndexBuckets[bucket];
+	_ramIndexBuckets[bucket]    = index_in_ram;
 	LOGStateDebug("Added type=%u id=%u size=%u val=%p", data.type, data.id, data.size, data.value);
 	LOGStateDebug("RAM index now of size %i", _ram_data_register.size());
 	addId(type, id);
-	return _ram_data_register.back();
+	return ERR_SUCCESS;
 }
 
 cs_ret_code_t State::removeFromRam(const CS_TYPE& type, cs_state_id_t id) {
 	LOGStateDebug("removeFromRam type=%u id=%u", to_underlying_type(type), id);
-	size16_t index_in_ram;
-	cs_ret_code_t ret_code = findInRam(type, id, index_in_ram);
-	if (ret_code == ERR_SUCCESS) {
-		cs_state_data_t* ram_data = &(_ram_data_register[index_in_ram]);
-		free(ram_data->value);
-		_ram_data_register.erase(_ram_data_register.begin() + index_in_ram);
+	size16_t bucket = getRamIndexBucket(type, id);
+	size16_t prev   = CS_STATE_RAM_INDEX_NONE;
+	size16_t i      = _ramIndexBuckets[bucket];
+	while (i != CS_STATE_RAM_INDEX_NONE) {
+		cs_state_data_t& ram_data = _ram_data_register[i];
+		if (ram_data.type == type && ram_data.id == id) {
+			// Unlink from the bucket, and mark the entry as unused.
+			if (prev == CS_STATE_RAM_INDEX_NONE) {
+				_ramIndexBuckets[bucket] = _ramIndexNext[i];
+			}
+			else {
+				_ramIndexNext[prev] = _ramIndexNext[i];
+			}
+			_ramIndexNext[i] = CS_STATE_RAM_INDEX_NONE;
+			setDirty(i, false);
+			deallocate(ram_data);
+			ram_data = cs_state_data_t();
+			_ramFreeIndices.push_back(i);
+			break;
+		}
+		prev = i;
+		i    = _ramIndexNext[i];
 	}
 	remId(type, id);
 
@@ -444,16 +523,22 @@ cs_ret_code_t State::removeFromRam(const CS_TYPE& type, cs_state_id_t id) {
 }
 
 /**
- * Let storage do the allocation, so that it's of the correct size and alignment.
+ * The pool pads the value to a multiple of 4 bytes, so that it can be written to flash.
  */
 cs_ret_code_t State::allocate(cs_state_data_t& data) {
 	LOGStateDebug("Allocate value array of size %u", data.size);
-	size16_t tempSize = data.size;
-	data.value        = _storage->allocate(tempSize);
-	LOGStateDebug("Actually allocated %u", tempSize);
+	data.value = _valuePool.allocate(data.size);
+	if (data.value == nullptr) {
+		return ERR_NO_SPACE;
+	}
 	return ERR_SUCCESS;
 }
 
+void State::deallocate(cs_state_data_t& data) {
+	_valuePool.free(data.value, data.size);
+	data.value = nullptr;
+}
+
 cs_ret_code_t State::loadFromRam(cs_state_data_t& data) {
 	size16_t index_in_ram;
 	cs_ret_code_t ret_code = findInRam(data.type, data.id, index_in_ram);
@@ -477,7 +562,8 @@ cs_ret_code_t State::storeInFlash(size16_t& index_in_ram) {
 	if (_performingFactoryReset) {
 		return ERR_WRONG_STATE;
 	}
-	if (index_in_ram >= _ram_data_register.size()) {
+	if (index_in_ram >= _ram_data_register.size()
+		|| _ram_data_register[index_in_ram].type == CS_TYPE::CONFIG_DO_NOT_USE) {
 		LOGe("Invalid index");
 		return ERR_WRITE_NOT_ALLOWED;
 	}
@@ -489,7 +575,12 @@ cs_ret_code_t State::storeInFlash(size16_t& index_in_ram) {
 			ram_data.value,
 			ram_data.value[0]);
 
-	return _storage->write(ram_data);
+	cs_ret_code_t retCode = _storage->write(ram_data);
+	if (retCode != ERR_BUSY) {
+		// Either the write started, or it will never succeed.
+		setDirty(index_in_ram, false);
+	}
+	return retCode;
 }
 
 cs_ret_code_t State::removeFromFlash(const CS_TYPE& type, const cs_state_id_t id) {
@@ -714,6 +805,75 @@ cs_ret_code_t State::setDelayed(const cs_state_data_t& data, uint8_t delaySecond
 	return addToQueue(CS_STATE_QUEUE_OP_WRITE, data.type, data.id, delayMs, StateQueueMode::DELAY);
 }
 
+/**
+ * Always first store to ram, use set() for this so that data struct is already validated.
+ * Pending operations in the queue for the same type and id are removed: the value will be written when flushing.
+ * Otherwise, a queued remove would remove the new value again.
+ */
+cs_ret_code_t State::setWriteBack(const cs_state_data_t& data) {
+	cs_ret_code_t ret_code = set(data, PersistenceMode::RAM);
+	if (ret_code != ERR_SUCCESS) {
+		return ret_code;
+	}
+	if (DefaultLocation(data.type) != PersistenceMode::FLASH) {
+		return ERR_SUCCESS;
+	}
+	size16_t index_in_ram;
+	ret_code = findInRam(data.type, data.id, index_in_ram);
+	if (ret_code != ERR_SUCCESS) {
+		return ret_code;
+	}
+	cs_state_store_queue_t* queuedItem = _storeQueue.find(CS_STATE_QUEUE_OP_WRITE, data.type, data.id);
+	if (queuedItem != nullptr) {
+		_storeQueue.remove(queuedItem);
+	}
+	if (_ramDirtyBitmap[index_in_ram / 32] & (1UL << (index_in_ram % 32))) {
+		_writeBackStats.numCoalesced++;
+	}
+	setDirty(index_in_ram, true);
+	_writeBackDelayTicks = STATE_WRITE_BACK_DELAY_MS / TICK_INTERVAL_MS;
+	return ERR_SUCCESS;
+}
+
+void State::setDirty(size16_t index_in_ram, bool dirty) {
+	uint32_t& word = _ramDirtyBitmap[index_in_ram / 32];
+	uint32_t mask  = 1UL << (index_in_ram % 32);
+	if (dirty && !(word & mask)) {
+		word |= mask;
+		_numDirty++;
+	}
+	else if (!dirty && (word & mask)) {
+		word &= ~mask;
+		_numDirty--;
+	}
+}
+
+/**
+ * Values for which storage is busy stay dirty, and will be retried next flush.
+ */
+void State::flushWriteBack(uint16_t maxWrites) {
+	uint16_t numAttempts = 0;
+	for (size16_t wordIndex = 0; wordIndex < _ramDirtyBitmap.size(); ++wordIndex) {
+		uint32_t word = _ramDirtyBitmap[wordIndex];
+		while (word != 0) {
+			if (numAttempts >= maxWrites) {
+				return;
+			}
+			uint8_t bit = __builtin_ctz(word);
+			word &= ~(1UL << bit);
+			size16_t index_in_ram = wordIndex * 32 + bit;
+			numAttempts++;
+			cs_ret_code_t ret_code = storeInFlash(index_in_ram);
+			if (ret_code == ERR_SUCCESS) {
+				_writeBackStats.numWrites++;
+			}
+		}
+	}
+	if (_numDirty == 0) {
+		LOGd("Write-back done: writes=%u coalesced=%u", _writeBackStats.numWrites, _writeBackStats.numCoalesced);
+	}
+}
+
 /**
  * Add a type to the queue to be written to flash.
  */
@@ -727,143 +887,115 @@ cs_ret_code_t State::addToQueue(
 			id,
 			delayMs,
 			delayTicks);
-	bool found = false;
-	switch (operation) {
-		case CS_STATE_QUEUE_OP_WRITE:
-		case CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE: {
-			for (size_t i = 0; i < _store_queue.size(); ++i) {
-				// A write operation replaces a remove operation, and vice versa.
-				if ((_store_queue[i].type == type && _store_queue[i].id == id)
-					&& ((_store_queue[i].operation == CS_STATE_QUEUE_OP_WRITE)
-						|| (_store_queue[i].operation == CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE))) {
-					// n-th time, now execute becomes true and for throttle init_counter will be set as well
-					if (mode == StateQueueMode::THROTTLE) {
-						_store_queue[i].init_counter = delayTicks;
-					}
-					else {
-						_store_queue[i].counter = delayTicks;
-					}
-					_store_queue[i].execute = true;
-					found                   = true;
-					break;
-				}
-			}
-			break;
+	cs_state_store_queue_t* queuedItem = _storeQueue.find(operation, type, id);
+	if (queuedItem != nullptr) {
+		// n-th time, now execute becomes true and for throttle init_counter will be set as well
+		if (mode == StateQueueMode::THROTTLE) {
+			queuedItem->init_counter = delayTicks;
 		}
-		case CS_STATE_QUEUE_OP_FACTORY_RESET: {
-			break;
+		else {
+			_storeQueue.setDeadline(queuedItem, getDeadline(delayTicks));
 		}
-		case CS_STATE_QUEUE_OP_GC: break;
+		queuedItem->execute = true;
+		return ERR_SUCCESS;
 	}
-	if (!found) {
-		if (mode == StateQueueMode::THROTTLE) {
-			// write to flash (again check if it still exists in ram)
-			size16_t index_in_ram;
-			ret_code_t ret_code = findInRam(type, id, index_in_ram);
-			if (ret_code == ERR_SUCCESS) {
-				ret_code = storeInFlash(index_in_ram);
-			}
-			else {
-				return ret_code;
-			}
-			if (ret_code != ERR_SUCCESS) {
-				return ret_code;
-			}
-			else {
-				// also add to the queue (drop through)
-			}
+
+	if (mode == StateQueueMode::THROTTLE) {
+		// write to flash (again check if it still exists in ram)
+		size16_t index_in_ram;
+		ret_code_t ret_code = findInRam(type, id, index_in_ram);
+		if (ret_code == ERR_SUCCESS) {
+			ret_code = storeInFlash(index_in_ram);
+		}
+		if (ret_code != ERR_SUCCESS) {
+			return ret_code;
 		}
+		// also add to the queue
+	}
 
-		// add new item to the queue
-		cs_state_store_queue_t item;
-		item.operation    = operation;
-		item.type         = type;
-		item.id           = id;
-		item.counter      = delayTicks;
-		item.init_counter = 0;
-		item.execute      = (mode == StateQueueMode::DELAY);
-		_store_queue.push_back(item);
+	// add new item to the queue
+	cs_state_store_queue_t item;
+	item.operation         = operation;
+	item.type              = type;
+	item.id                = id;
+	item.deadline          = getDeadline(delayTicks);
+	item.init_counter      = 0;
+	item.execute           = (mode == StateQueueMode::DELAY);
+	cs_ret_code_t ret_code = _storeQueue.add(item);
+	if (ret_code != ERR_SUCCESS) {
+		LOGe("Queue full: failed to add op=%u type=%u id=%u", operation, to_underlying_type(type), id);
+		return ret_code;
 	}
-	LOGStateDebug("queue is now of size %u", _store_queue.size());
+	LOGStateDebug("queue is now of size %u", _storeQueue.size());
 	return ERR_SUCCESS;
 }
 
 /**
- * Each tick, decrease the counter of all items.
- * If a counter is 0, store that item, and remove it from the list.
- * But if storage is busy, retry later by not removing item from queue, and setting counter again.
+ * Each tick, execute the items of which the deadline has been reached, in order of deadline.
+ * Executed items are removed from the queue.
+ * But if storage is busy, retry later by not removing item from queue, and setting the deadline again.
  */
 void State::delayedStoreTick() {
-	if (!_store_queue.empty()) {
-		LOGStateDebug("delayedStoreTick");
+	if (_numDirty != 0) {
+		if (_writeBackDelayTicks != 0) {
+			_writeBackDelayTicks--;
+		}
+		else {
+			flushWriteBack(STATE_WRITE_BACK_FLUSH_BUDGET);
+		}
 	}
-	cs_ret_code_t ret_code;
-	size16_t index_in_ram;
-	for (auto it = _store_queue.begin(); it != _store_queue.end(); /*it++*/) {
-		if (it->counter == 0) {
-			bool keepItem = false;
-			if (it->execute) {
-				switch (it->operation) {
-					case CS_STATE_QUEUE_OP_WRITE: {
-						if (it->execute == false) {
-							// fall through with removeItem is true, don't execute
-							break;
-						}
-						ret_code = findInRam(it->type, it->id, index_in_ram);
-						if (ret_code == ERR_SUCCESS) {
-							ret_code = storeInFlash(index_in_ram);
-							if (ret_code == ERR_BUSY) {
-								keepItem = true;
-							}
-						}
-						break;
-					}
-					case CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE: {
-						ret_code = removeFromFlash(it->type, it->id);
-						if (ret_code == ERR_BUSY) {
-							keepItem = true;
-						}
-						break;
-					}
-					case CS_STATE_QUEUE_OP_FACTORY_RESET: {
-						ret_code = _storage->factoryReset();
-						if (!handleFactoryResetResult(ret_code)) {
-							keepItem = true;
-						}
-						break;
-					}
-					case CS_STATE_QUEUE_OP_GC: {
-						ret_code = _storage->garbageCollect();
-						if (ret_code == ERR_BUSY) {
-							keepItem = true;
-						}
-						break;
-					}
-				}
-			}
-			if (it->execute && it->init_counter != 0) {
-				// When init_counter is set, add the item again, but don't execute.
-				keepItem    = true;
-				it->execute = false;
-				it->counter = it->init_counter;
-			}
-			else {
-				// Add to queue again with fixed retry delay.
-				it->counter = STATE_RETRY_STORE_DELAY_MS / TICK_INTERVAL_MS;
-			}
+	_tickCount++;
+	cs_state_store_queue_t* item = _storeQueue.front();
+	while (item != nullptr && static_cast<int32_t>(_tickCount - item->deadline) >= 0) {
+		LOGStateDebug("delayedStoreTick op=%u type=%u id=%u", item->operation, item->type, item->id);
+		bool keepItem = false;
+		if (item->execute) {
+			keepItem = executeQueueItem(*item);
+		}
+		if (item->execute && item->init_counter != 0 && !keepItem) {
+			// When init_counter is set, add the item again, but don't execute.
+			keepItem      = true;
+			item->execute = false;
+			_storeQueue.setDeadline(item, getDeadline(item->init_counter));
+		}
+		else if (keepItem) {
+			// Add to queue again with fixed retry delay.
+			_storeQueue.setDeadline(item, getDeadline(STATE_RETRY_STORE_DELAY_MS / TICK_INTERVAL_MS));
+		}
 
-			if (!keepItem) {
-				it = _store_queue.erase(it);
-			}
-			else {
-				it++;
+		if (!keepItem) {
+			_storeQueue.remove(item);
+		}
+		item = _storeQueue.front();
+	}
+}
+
+bool State::executeQueueItem(cs_state_store_queue_t& item) {
+	cs_ret_code_t ret_code;
+	switch (item.operation) {
+		case CS_STATE_QUEUE_OP_WRITE: {
+			size16_t index_in_ram;
+			ret_code = findInRam(item.type, item.id, index_in_ram);
+			if (ret_code == ERR_SUCCESS) {
+				ret_code = storeInFlash(index_in_ram);
+				return ret_code == ERR_BUSY;
 			}
+			return false;
 		}
-		else {
-			it->counter--;
-			it++;
+		case CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE: {
+			ret_code = removeFromFlash(item.type, item.id);
+			return ret_code == ERR_BUSY;
+		}
+		case CS_STATE_QUEUE_OP_FACTORY_RESET: {
+			ret_code = _storage->factoryReset();
+			return !handleFactoryResetResult(ret_code);
+		}
+		case CS_STATE_QUEUE_OP_GC: {
+			ret_code = _storage->garbageCollect();
+			return ret_code == ERR_BUSY;
 		}
 	}
+	return false;
 }
 
 void State::startWritesToFlash() {
@@ -875,8 +1007,12 @@ void State::factoryReset() {
 	LOGw("Perform factory reset!");
 	_performingFactoryReset = true;
 
-	// Clear queue, to remove any pending writes.
-	_store_queue.clear();
+	// Clear queue and dirty values, to remove any pending writes.
+	_storeQueue.clear();
+	for (auto& word : _ramDirtyBitmap) {
+		word = 0;
+	}
+	_numDirty = 0;
 
 	cs_ret_code_t retCode = ERR_BUSY;
 	if (_startedWritingToFlash) {
@@ -952,6 +1088,13 @@ void State::handleStorageError(cs_storage_operation_t operation, CS_TYPE type, c
 void State::handleEvent(event_t& event) {
 	switch (event.type) {
 		case CS_TYPE::EVT_TICK: delayedStoreTick(); break;
+		case CS_TYPE::EVT_BROWNOUT_IMPENDING: {
+			if (_numDirty != 0) {
+				LOGw("Brownout: write %u dirty values", _numDirty);
+				flushWriteBack(_numDirty);
+			}
+			break;
+		}
 		case CS_TYPE::CMD_FACTORY_RESET: {
 			factoryReset();
 			break;
@@ -164,6 +164,9 @@ cs_ret_code_t getDefault(cs_state_data_t& data, const boards_config_t& boardsCon
 		case CS_TYPE::STATE_POWER_USAGE:
 			*(TYPIFY(STATE_POWER_USAGE)*)data.value = STATE_POWER_USAGE_DEFAULT;
 			return ERR_SUCCESS;
+		case CS_TYPE::STATE_POWER_QUALITY:
+			*(TYPIFY(STATE_POWER_QUALITY)*)data.value = cs_power_quality_t();
+			return ERR_SUCCESS;
 		case CS_TYPE::STATE_OPERATION_MODE:
 			*(TYPIFY(STATE_OPERATION_MODE)*)data.value = STATE_OPERATION_MODE_DEFAULT;
 			return ERR_SUCCESS;
@@ -241,6 +244,7 @@ cs_ret_code_t getDefault(cs_state_data_t& data, const boards_config_t& boardsCon
 		case CS_TYPE::CMD_SEND_MESH_MSG_MULTI_SWITCH:
 		case CS_TYPE::CMD_SEND_MESH_MSG_PROFILE_LOCATION:
 		case CS_TYPE::CMD_SEND_MESH_MSG_SET_BEHAVIOUR_SETTINGS:
+		case CS_TYPE::CMD_SET_LOG_SAMPLES_STREAM:
 		case CS_TYPE::CMD_SET_TIME:
 		case CS_TYPE::CMD_SWITCH_OFF:
 		case CS_TYPE::CMD_SWITCH_ON:
@@ -364,6 +368,8 @@ cs_ret_code_t getDefault(cs_state_data_t& data, const boards_config_t& boardsCon
 		case CS_TYPE::CMD_GET_GPREGRET:
 		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
 		case CS_TYPE::CMD_GET_RAM_STATS:
+		case CS_TYPE::CMD_GET_STORAGE_STATS:
+		case CS_TYPE::CMD_GET_SOFTFUSE_LATENCY:
 		case CS_TYPE::EVT_GENERIC_TEST:
 		case CS_TYPE::CMD_TEST_SET_TIME:
 		case CS_TYPE::CMD_MICROAPP_GET_INFO:
@@ -470,6 +476,7 @@ PersistenceMode DefaultLocation(CS_TYPE const& type) {
 		case CS_TYPE::STATE_ASSET_FILTER_512: return PersistenceMode::FLASH;
 		case CS_TYPE::STATE_ACCUMULATED_ENERGY:
 		case CS_TYPE::STATE_POWER_USAGE:
+		case CS_TYPE::STATE_POWER_QUALITY:
 		case CS_TYPE::STATE_TEMPERATURE:
 		case CS_TYPE::STATE_FACTORY_RESET:
 		case CS_TYPE::STATE_ERRORS:
@@ -553,6 +560,7 @@ PersistenceMode DefaultLocation(CS_TYPE const& type) {
 		case CS_TYPE::CMD_ENABLE_LOG_CURRENT:
 		case CS_TYPE::CMD_ENABLE_LOG_VOLTAGE:
 		case CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT:
+		case CS_TYPE::CMD_SET_LOG_SAMPLES_STREAM:
 		case CS_TYPE::CMD_RESET_DELAYED:
 		case CS_TYPE::CMD_ENABLE_ADVERTISEMENT:
 		case CS_TYPE::CMD_ENABLE_MESH:
@@ -617,6 +625,8 @@ PersistenceMode DefaultLocation(CS_TYPE const& type) {
 		case CS_TYPE::CMD_GET_GPREGRET:
 		case CS_TYPE::CMD_GET_ADC_CHANNEL_SWAPS:
 		case CS_TYPE::CMD_GET_RAM_STATS:
+		case CS_TYPE::CMD_GET_STORAGE_STATS:
+		case CS_TYPE::CMD_GET_SOFTFUSE_LATENCY:
 		case CS_TYPE::EVT_GENERIC_TEST:
 		case CS_TYPE::CMD_TEST_SET_TIME:
 		case CS_TYPE::CMD_MICROAPP_GET_INFO:
@@ -0,0 +1,160 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <storage/cs_StateStoreQueue.h>
+
+StateStoreQueue::StateStoreQueue() {
+	clear();
+}
+
+void StateStoreQueue::clear() {
+	_heapSize = 0;
+	for (uint8_t i = 0; i < STATE_STORE_QUEUE_BUCKETS; ++i) {
+		_buckets[i] = CS_STATE_STORE_QUEUE_INDEX_NONE;
+	}
+	for (uint8_t i = 0; i < STATE_STORE_QUEUE_SIZE; ++i) {
+		_next[i] = (i + 1 < STATE_STORE_QUEUE_SIZE) ? i + 1 : CS_STATE_STORE_QUEUE_INDEX_NONE;
+	}
+	_firstFree = 0;
+}
+
+uint8_t StateStoreQueue::getBucket(const CS_TYPE& type, cs_state_id_t id) {
+	return (to_underlying_type(type) * 31 + id) & (STATE_STORE_QUEUE_BUCKETS - 1);
+}
+
+bool StateStoreQueue::isSameItem(
+		const cs_state_store_queue_t& item, StateQueueOp operation, const CS_TYPE& type, cs_state_id_t id) {
+	if (item.type != type || item.id != id) {
+		return false;
+	}
+	switch (operation) {
+		case CS_STATE_QUEUE_OP_WRITE:
+		case CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE:
+			// A write operation replaces a remove operation, and vice versa.
+			return item.operation == CS_STATE_QUEUE_OP_WRITE || item.operation == CS_STATE_QUEUE_OP_REM_ONE_ID_OF_TYPE;
+		default: return item.operation == operation;
+	}
+}
+
+cs_state_store_queue_t* StateStoreQueue::find(StateQueueOp operation, const CS_TYPE& type, cs_state_id_t id) {
+	uint8_t slot = _buckets[getBucket(type, id)];
+	while (slot != CS_STATE_STORE_QUEUE_INDEX_NONE) {
+		if (isSameItem(_items[slot], operation, type, id)) {
+			return &_items[slot];
+		}
+		slot = _next[slot];
+	}
+	return nullptr;
+}
+
+/**
+ * Take the first free slot, add it to the front of the chain of its bucket, and to the end of the heap.
+ */
+cs_ret_code_t StateStoreQueue::add(const cs_state_store_queue_t& item) {
+	if (_firstFree == CS_STATE_STORE_QUEUE_INDEX_NONE) {
+		return ERR_NO_SPACE;
+	}
+	uint8_t slot     = _firstFree;
+	_firstFree       = _next[slot];
+	_items[slot]     = item;
+
+	uint8_t bucket   = getBucket(item.type, item.id);
+	_next[slot]      = _buckets[bucket];
+	_buckets[bucket] = slot;
+
+	_heap[_heapSize] = slot;
+	_heapPos[slot]   = _heapSize;
+	_heapSize++;
+	siftUp(_heapSize - 1);
+	return ERR_SUCCESS;
+}
+
+cs_state_store_queue_t* StateStoreQueue::front() {
+	if (_heapSize == 0) {
+		return nullptr;
+	}
+	return &_items[_heap[0]];
+}
+
+void StateStoreQueue::setDeadline(cs_state_store_queue_t* item, uint32_t deadline) {
+	uint8_t slot   = getSlot(item);
+	item->deadline = deadline;
+	siftUp(_heapPos[slot]);
+	siftDown(_heapPos[slot]);
+}
+
+/**
+ * Unlink the slot from its bucket, replace it in the heap by the last item, and add it to the free slots.
+ */
+void StateStoreQueue::remove(cs_state_store_queue_t* item) {
+	uint8_t slot   = getSlot(item);
+	uint8_t bucket = getBucket(item->type, item->id);
+	if (_buckets[bucket] == slot) {
+		_buckets[bucket] = _next[slot];
+	}
+	else {
+		uint8_t prev = _buckets[bucket];
+		while (_next[prev] != slot) {
+			prev = _next[prev];
+		}
+		_next[prev] = _next[slot];
+	}
+
+	uint8_t heapPos = _heapPos[slot];
+	_heapSize--;
+	if (heapPos != _heapSize) {
+		swap(heapPos, _heapSize);
+		siftUp(heapPos);
+		siftDown(heapPos);
+	}
+
+	_next[slot] = _firstFree;
+	_firstFree  = slot;
+}
+
+bool StateStoreQueue::isEarlier(uint8_t a, uint8_t b) {
+	return static_cast<int32_t>(_items[a].deadline - _items[b].deadline) < 0;
+}
+
+void StateStoreQueue::swap(uint8_t heapPosA, uint8_t heapPosB) {
+	uint8_t slotA   = _heap[heapPosA];
+	uint8_t slotB   = _heap[heapPosB];
+	_heap[heapPosA] = slotB;
+	_heap[heapPosB] = slotA;
+	_heapPos[slotA] = heapPosB;
+	_heapPos[slotB] = heapPosA;
+}
+
+void StateStoreQueue::siftUp(uint8_t heapPos) {
+	while (heapPos > 0) {
+		uint8_t parent = (heapPos - 1) / 2;
+		if (!isEarlier(_heap[heapPos], _heap[parent])) {
+			return;
+		}
+		swap(heapPos, parent);
+		heapPos = parent;
+	}
+}
+
+void StateStoreQueue::siftDown(uint8_t heapPos) {
+	while (true) {
+		uint8_t earliest = heapPos;
+		uint16_t left    = 2 * heapPos + 1;
+		uint16_t right   = 2 * heapPos + 2;
+		if (left < _heapSize && isEarlier(_heap[left], _heap[earliest])) {
+			earliest = left;
+		}
+		if (right < _heapSize && isEarlier(_heap[right], _heap[earliest])) {
+			earliest = right;
+		}
+		if (earliest == heapPos) {
+			return;
+		}
+		swap(heapPos, earliest);
+		heapPos = earliest;
+	}
+}
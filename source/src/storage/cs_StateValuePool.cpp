@@ -0,0 +1,164 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <cfg/cs_Config.h>
+#include <logging/cs_Logger.h>
+#include <storage/cs_StateValuePool.h>
+#include <util/cs_Utils.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#define LOGStateValuePoolDebug LOGvv
+
+static_assert(
+		(CS_STATE_VALUE_POOL_MIN_SLOT_SIZE << (CS_STATE_VALUE_POOL_NUM_SIZE_CLASSES - 1)) <= STATE_VALUE_POOL_SLAB_SIZE,
+		"Slab must fit at least one slot of the largest size class");
+
+StateValuePool::~StateValuePool() {
+	for (uint8_t sizeClass = 0; sizeClass < CS_STATE_VALUE_POOL_NUM_SIZE_CLASSES; ++sizeClass) {
+		slab_t* slab = _slabs[sizeClass];
+		while (slab != nullptr) {
+			slab_t* next = slab->next;
+			::free(slab);
+			slab = next;
+		}
+	}
+}
+
+int8_t StateValuePool::getSizeClass(size16_t paddedSize) {
+	for (uint8_t sizeClass = 0; sizeClass < CS_STATE_VALUE_POOL_NUM_SIZE_CLASSES; ++sizeClass) {
+		if (paddedSize <= getSlotSize(sizeClass)) {
+			return sizeClass;
+		}
+	}
+	return -1;
+}
+
+size16_t StateValuePool::getSlotSize(uint8_t sizeClass) {
+	return CS_STATE_VALUE_POOL_MIN_SLOT_SIZE << sizeClass;
+}
+
+uint8_t StateValuePool::getNumSlots(uint8_t sizeClass) {
+	size16_t numSlots = STATE_VALUE_POOL_SLAB_SIZE / getSlotSize(sizeClass);
+	if (numSlots > CS_STATE_VALUE_POOL_MAX_SLOTS) {
+		numSlots = CS_STATE_VALUE_POOL_MAX_SLOTS;
+	}
+	return numSlots;
+}
+
+uint32_t StateValuePool::getAllFreeSlots(uint8_t sizeClass) {
+	uint8_t numSlots = getNumSlots(sizeClass);
+	return (numSlots == 32) ? 0xFFFFFFFF : ((1UL << numSlots) - 1);
+}
+
+/**
+ * The slots are placed directly after the slab header.
+ */
+uint8_t* StateValuePool::getSlot(slab_t* slab, uint8_t sizeClass, uint8_t slotIndex) {
+	return reinterpret_cast<uint8_t*>(slab + 1) + slotIndex * getSlotSize(sizeClass);
+}
+
+void StateValuePool::useBytes(size16_t size) {
+	_stats.usedBytes += size;
+	if (_stats.usedBytes > _stats.peakUsedBytes) {
+		_stats.peakUsedBytes = _stats.usedBytes;
+	}
+}
+
+/**
+ * - Large values are allocated on the heap.
+ * - Else, take the first free slot of the first slab of the size class that has one.
+ * - If there is none, add a new slab in front of the list.
+ */
+uint8_t* StateValuePool::allocate(size16_t size) {
+	size16_t paddedSize = CS_ROUND_UP_TO_MULTIPLE_OF_POWER_OF_2(size, CS_STATE_VALUE_POOL_MIN_SLOT_SIZE);
+	int8_t sizeClass    = getSizeClass(paddedSize);
+	uint8_t* ptr        = nullptr;
+	if (sizeClass < 0) {
+		ptr = static_cast<uint8_t*>(malloc(paddedSize));
+		if (ptr == nullptr) {
+			LOGe("No space for value of size %u", size);
+			return nullptr;
+		}
+		_stats.reservedBytes += paddedSize;
+		_stats.numHeapAllocations++;
+	}
+	else {
+		slab_t* slab = _slabs[sizeClass];
+		while (slab != nullptr && slab->freeSlots == 0) {
+			slab = slab->next;
+		}
+		if (slab == nullptr) {
+			uint8_t numSlots  = getNumSlots(sizeClass);
+			size16_t slabSize = sizeof(slab_t) + numSlots * getSlotSize(sizeClass);
+			slab              = static_cast<slab_t*>(malloc(slabSize));
+			if (slab == nullptr) {
+				LOGe("No space for slab of size %u", slabSize);
+				return nullptr;
+			}
+			slab->freeSlots   = getAllFreeSlots(sizeClass);
+			slab->next        = _slabs[sizeClass];
+			_slabs[sizeClass] = slab;
+			_stats.reservedBytes += slabSize;
+			_stats.numHeapAllocations++;
+			LOGStateValuePoolDebug("Added slab size=%u for size class %u", slabSize, sizeClass);
+		}
+		uint8_t slotIndex = __builtin_ctz(slab->freeSlots);
+		slab->freeSlots &= ~(1UL << slotIndex);
+		ptr = getSlot(slab, sizeClass, slotIndex);
+	}
+	useBytes(size);
+	memset(ptr + size, 0xFF, paddedSize - size);
+	return ptr;
+}
+
+/**
+ * - Large values are freed to the heap.
+ * - Else, find the slab of the size class that holds the pointer, and mark the slot as free.
+ * - If all slots of that slab are free, and it's not the only slab of this size class, free the slab.
+ */
+void StateValuePool::free(uint8_t* ptr, size16_t size) {
+	if (ptr == nullptr) {
+		return;
+	}
+	size16_t paddedSize = CS_ROUND_UP_TO_MULTIPLE_OF_POWER_OF_2(size, CS_STATE_VALUE_POOL_MIN_SLOT_SIZE);
+	int8_t sizeClass    = getSizeClass(paddedSize);
+	_stats.usedBytes -= size;
+	if (sizeClass < 0) {
+		::free(ptr);
+		_stats.reservedBytes -= paddedSize;
+		return;
+	}
+
+	uint8_t numSlots  = getNumSlots(sizeClass);
+	size16_t slotSize = getSlotSize(sizeClass);
+	slab_t* prev      = nullptr;
+	slab_t* slab      = _slabs[sizeClass];
+	while (slab != nullptr) {
+		uint8_t* firstSlot = getSlot(slab, sizeClass, 0);
+		if (ptr >= firstSlot && ptr < firstSlot + numSlots * slotSize) {
+			uint8_t slotIndex = (ptr - firstSlot) / slotSize;
+			slab->freeSlots |= (1UL << slotIndex);
+			if (slab->freeSlots == getAllFreeSlots(sizeClass) && (prev != nullptr || slab->next != nullptr)) {
+				if (prev == nullptr) {
+					_slabs[sizeClass] = slab->next;
+				}
+				else {
+					prev->next = slab->next;
+				}
+				_stats.reservedBytes -= sizeof(slab_t) + numSlots * slotSize;
+				::free(slab);
+				LOGStateValuePoolDebug("Removed slab for size class %u", sizeClass);
+			}
+			return;
+		}
+		prev = slab;
+		slab = slab->next;
+	}
+	LOGe("Pointer %p of size %u is not in pool", ptr, size);
+}
@@ -0,0 +1,122 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <logging/cs_Logger.h>
+#include <storage/cs_StorageRecordIndex.h>
+
+#include <algorithm>
+
+void StorageRecordIndex::clear() {
+	_entries.clear();
+	_searchPos = 0;
+}
+
+void StorageRecordIndex::append(uint16_t recordKey, uint16_t fileId, const fds_record_desc_t& recordDesc) {
+	_entries.push_back({recordKey, fileId, recordDesc});
+}
+
+/**
+ * Records are appended in the order they are found, and sorted afterwards, so that building the index doesn't need
+ * a lookup per record.
+ */
+uint16_t StorageRecordIndex::sort() {
+	// A stable sort keeps duplicates in the order they were appended, so the last one of each is the one to keep.
+	std::stable_sort(
+			_entries.begin(),
+			_entries.end(),
+			[](const cs_storage_record_index_entry_t& a, const cs_storage_record_index_entry_t& b) {
+				return a.recordKey < b.recordKey || (a.recordKey == b.recordKey && a.fileId < b.fileId);
+			});
+	uint16_t count         = 0;
+	uint16_t numDuplicates = 0;
+	for (uint16_t i = 0; i < _entries.size(); ++i) {
+		cs_storage_record_index_entry_t& entry = _entries[i];
+		if (count > 0 && _entries[count - 1].recordKey == entry.recordKey && _entries[count - 1].fileId == entry.fileId) {
+			LOGe("Duplicate record key=%u file=%u addr=%p", entry.recordKey, entry.fileId, entry.recordDesc.p_record);
+			_entries[count - 1] = entry;
+			numDuplicates++;
+			continue;
+		}
+		_entries[count++] = entry;
+	}
+	_entries.resize(count);
+	return numDuplicates;
+}
+
+uint16_t StorageRecordIndex::lowerBound(uint16_t recordKey, uint16_t fileId) {
+	uint16_t low  = 0;
+	uint16_t high = _entries.size();
+	while (low < high) {
+		uint16_t mid                           = (low + high) / 2;
+		cs_storage_record_index_entry_t& entry = _entries[mid];
+		if (entry.recordKey < recordKey || (entry.recordKey == recordKey && entry.fileId < fileId)) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+cs_storage_record_index_entry_t* StorageRecordIndex::find(uint16_t recordKey, uint16_t fileId) {
+	uint16_t pos = lowerBound(recordKey, fileId);
+	if (pos < _entries.size() && _entries[pos].recordKey == recordKey && _entries[pos].fileId == fileId) {
+		return &_entries[pos];
+	}
+	return nullptr;
+}
+
+void StorageRecordIndex::initSearch() {
+	_searchPos = 0;
+}
+
+/**
+ * The entries of a record key are next to each other, so the search can skip ahead to the first of them.
+ */
+cs_storage_record_index_entry_t* StorageRecordIndex::findNext(uint16_t recordKey) {
+	uint16_t firstPos = lowerBound(recordKey, 0);
+	if (_searchPos < firstPos) {
+		_searchPos = firstPos;
+	}
+	if (_searchPos < _entries.size() && _entries[_searchPos].recordKey == recordKey) {
+		return &_entries[_searchPos++];
+	}
+	return nullptr;
+}
+
+void StorageRecordIndex::add(uint16_t recordKey, uint16_t fileId, const fds_record_desc_t& recordDesc) {
+	uint16_t pos = lowerBound(recordKey, fileId);
+	if (pos < _entries.size() && _entries[pos].recordKey == recordKey && _entries[pos].fileId == fileId) {
+		_entries[pos].recordDesc = recordDesc;
+		return;
+	}
+	_entries.insert(_entries.begin() + pos, {recordKey, fileId, recordDesc});
+}
+
+void StorageRecordIndex::remove(uint16_t recordKey, uint16_t fileId) {
+	cs_storage_record_index_entry_t* entry = find(recordKey, fileId);
+	if (entry != nullptr) {
+		_entries.erase(_entries.begin() + (entry - _entries.data()));
+	}
+}
+
+/**
+ * Removing a file is rare, so just check every entry.
+ */
+void StorageRecordIndex::removeFile(uint16_t fileId) {
+	_entries.erase(
+			std::remove_if(
+					_entries.begin(),
+					_entries.end(),
+					[fileId](const cs_storage_record_index_entry_t& entry) { return entry.fileId == fileId; }),
+			_entries.end());
+}
+
+uint16_t StorageRecordIndex::size() const {
+	return _entries.size();
+}
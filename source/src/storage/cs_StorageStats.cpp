@@ -0,0 +1,56 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <storage/cs_StorageStats.h>
+
+void StorageStats::onWrite(const CS_TYPE& type) {
+	_stats.numWrites++;
+	getTypeStats(type).numWrites++;
+}
+
+void StorageStats::onRemove(const CS_TYPE& type) {
+	_stats.numRemoves++;
+	getTypeStats(type).numRemoves++;
+}
+
+void StorageStats::onOperationDone(uint32_t latencyMs) {
+	_stats.latencyHistogram[getLatencyBin(latencyMs)]++;
+}
+
+void StorageStats::onGarbageCollectionDone(uint32_t durationMs, uint32_t reclaimedBytes) {
+	_stats.numGarbageCollections++;
+	_stats.garbageCollectionTotalMs += durationMs;
+	if (durationMs > _stats.garbageCollectionMaxMs) {
+		_stats.garbageCollectionMaxMs = durationMs;
+	}
+	_stats.garbageCollectionReclaimedBytes += reclaimedBytes;
+}
+
+uint8_t StorageStats::getLatencyBin(uint32_t latencyMs) {
+	uint8_t bin = 0;
+	while (latencyMs != 0 && bin < STORAGE_STATS_LATENCY_BINS - 1) {
+		latencyMs >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+cs_storage_type_stats_t& StorageStats::getTypeStats(const CS_TYPE& type) {
+	uint16_t typeValue             = to_underlying_type(type);
+	cs_storage_type_stats_t* least = &_stats.typeStats[0];
+	for (auto& typeStats : _stats.typeStats) {
+		if (typeStats.type == typeValue) {
+			return typeStats;
+		}
+		if (typeStats.numWrites + typeStats.numRemoves < least->numWrites + least->numRemoves) {
+			least = &typeStats;
+		}
+	}
+	// Unused entries have no writes and removes, so they are replaced first.
+	least->type = typeValue;
+	return *least;
+}
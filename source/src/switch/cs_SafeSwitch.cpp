@@ -5,7 +5,9 @@
  * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
  */
 
+#include <drivers/cs_RTC.h>
 #include <events/cs_EventDispatcher.h>
+#include <processing/cs_SoftfuseLatency.h>
 #include <storage/cs_State.h>
 #include <switch/cs_SafeSwitch.h>
 #include <test/cs_Test.h>
@@ -177,10 +179,8 @@ void SafeSwitch::checkDimmerPower() {
 
 	checkedDimmerPowerUsage = true;
 
-	TYPIFY(STATE_POWER_USAGE) powerUsage;
-	State::getInstance().get(CS_TYPE::STATE_POWER_USAGE, &powerUsage, sizeof(powerUsage));
-	TYPIFY(CONFIG_POWER_ZERO) powerZero;
-	State::getInstance().get(CS_TYPE::CONFIG_POWER_ZERO, &powerZero, sizeof(powerZero));
+	TYPIFY(STATE_POWER_USAGE) powerUsage = State::getInstance().get<CS_TYPE::STATE_POWER_USAGE>();
+	TYPIFY(CONFIG_POWER_ZERO) powerZero  = State::getInstance().get<CS_TYPE::CONFIG_POWER_ZERO>();
 
 	LOGd("powerUsage=%i mW powerZero=%i mW", powerUsage, powerZero);
 
@@ -222,6 +222,7 @@ void SafeSwitch::forceSwitchOff() {
 	if (isSafeToTurnRelayOff(getErrorState())) {
 		relay.set(false);
 		currentState.state.relay = 0;
+		SoftfuseLatency::getInstance().onSwitchOff(RTC::getCount());
 
 		sendUnexpectedStateUpdate();
 
@@ -229,6 +230,8 @@ void SafeSwitch::forceSwitchOff() {
 		EventDispatcher::getInstance().dispatch(event);
 	}
 	else {
+		SoftfuseLatency::getInstance().onSwitchOff(RTC::getCount());
+
 		// The dimmer should have already be turned off, so no need for event here.
 		event_t eventDimmer(CS_TYPE::EVT_DIMMER_FORCED_OFF);  // TODO: remove, as this event is not used.
 		EventDispatcher::getInstance().dispatch(eventDimmer);
@@ -244,6 +247,7 @@ void SafeSwitch::forceRelayOnAndDimmerOff() {
 
 	currentState.state.relay  = 1;
 	currentState.state.dimmer = 0;
+	SoftfuseLatency::getInstance().onSwitchOff(RTC::getCount());
 
 	sendUnexpectedStateUpdate();
 
@@ -260,9 +264,7 @@ void SafeSwitch::forceRelayOnAndDimmerOff() {
 // ======================== Error state checks ===========================
 
 state_errors_t SafeSwitch::getErrorState() {
-	TYPIFY(STATE_ERRORS) stateErrors = {};
-	State::getInstance().get(CS_TYPE::STATE_ERRORS, &stateErrors, sizeof(stateErrors));
-	return stateErrors;
+	return State::getInstance().get<CS_TYPE::STATE_ERRORS>();
 }
 
 bool SafeSwitch::isSwitchOverLoaded(state_errors_t stateErrors) {
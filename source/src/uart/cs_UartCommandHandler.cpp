@@ -5,6 +5,7 @@
  * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
  */
 
+#include <drivers/cs_Storage.h>
 #include <encryption/cs_KeysAndAccess.h>
 #include <events/cs_EventDispatcher.h>
 #include <logging/cs_Logger.h>
@@ -39,6 +40,7 @@ void UartCommandHandler::handleCommand(
 		case UART_OPCODE_RX_HEARTBEAT: handleCommandHeartBeat(commandData, wasEncrypted); break;
 		case UART_OPCODE_RX_STATUS: handleCommandStatus(commandData); break;
 		case UART_OPCODE_RX_GET_MAC: handleCommandGetMacAddress(commandData); break;
+		case UART_OPCODE_RX_GET_STORAGE_STATS: handleCommandGetStorageStats(commandData); break;
 		case UART_OPCODE_RX_CONTROL: handleCommandControl(commandData, source, accessLevel, resultBuffer); break;
 		case UART_OPCODE_RX_HUB_DATA_REPLY:
 			handleCommandHubDataReply(commandData, source, accessLevel, resultBuffer);
@@ -83,6 +85,9 @@ void UartCommandHandler::handleCommand(
 			dispatchEventForCommand(CS_TYPE::CMD_ENABLE_LOG_FILTERED_CURRENT, commandData);
 			break;
 		case UART_OPCODE_RX_POWER_LOG_POWER: dispatchEventForCommand(CS_TYPE::CMD_ENABLE_LOG_POWER, commandData); break;
+		case UART_OPCODE_RX_POWER_LOG_SAMPLES_STREAM:
+			dispatchEventForCommand(CS_TYPE::CMD_SET_LOG_SAMPLES_STREAM, commandData);
+			break;
 
 		case UART_OPCODE_RX_INJECT_EVENT: handleCommandInjectEvent(commandData); break;
 
@@ -106,6 +111,7 @@ EncryptionAccessLevel UartCommandHandler::getRequiredAccessLevel(const UartOpcod
 		case UART_OPCODE_RX_HEARTBEAT:
 		case UART_OPCODE_RX_STATUS:
 		case UART_OPCODE_RX_CONTROL: return EncryptionAccessLevel::MEMBER;
+		case UART_OPCODE_RX_GET_STORAGE_STATS: return EncryptionAccessLevel::ADMIN;
 
 		default: LOGw("Unknown opcode: %i", opCode); return EncryptionAccessLevel::NO_ONE;
 	}
@@ -244,6 +250,12 @@ void UartCommandHandler::handleCommandGetMacAddress(cs_data_t commandData) {
 	}
 }
 
+void UartCommandHandler::handleCommandGetStorageStats(cs_data_t commandData) {
+	LOGd(STR_HANDLE_COMMAND "get storage stats");
+	const cs_storage_stats_t& stats = Storage::getInstance().getStats();
+	UartHandler::getInstance().writeMsg(UART_OPCODE_TX_STORAGE_STATS, (uint8_t*)&stats, sizeof(stats));
+}
+
 void UartCommandHandler::handleCommandInjectEvent(cs_data_t commandData) {
 	LOGd(STR_HANDLE_COMMAND "inject event");
 
@@ -6,6 +6,7 @@
  */
 
 #include <drivers/cs_RNG.h>
+#include <drivers/cs_RTC.h>
 #include <drivers/cs_Serial.h>
 #include <events/cs_EventDispatcher.h>
 #include <logging/cs_Logger.h>
@@ -193,6 +194,127 @@ ret_code_t UartHandler::writeMsgEnd(UartOpcodeTx opCode, UartProtocol::Encrypt e
 	return ERR_SUCCESS;
 }
 
+cs_ret_code_t UartHandler::writeMsgSamples(
+		UartOpcodeTx opCode,
+		cs_data_t header,
+		const int16_t* samples,
+		uint16_t numSamples,
+		uint16_t stride,
+		UartSamplesEncoding encoding,
+		bool dropWhenBusy) {
+#if CS_UART_BINARY_PROTOCOL_ENABLED == 0
+	return ERR_SUCCESS;
+#else
+	// No logs, this function is called when logging
+	if (!serial_tx_ready()) {
+		return ERR_NOT_INITIALIZED;
+	}
+
+	// The size is written first, so determine the encoded size before writing anything.
+	uint16_t size = header.len;
+	if (encoding == UART_SAMPLES_ENCODING_RAW) {
+		size += numSamples * sizeof(int16_t);
+	}
+	else {
+		for (uint16_t i = 0; i < numSamples; ++i) {
+			const int16_t* previous = (i == 0) ? nullptr : &samples[(i - 1) * stride];
+			size += encodeSample(samples[i * stride], previous, encoding, nullptr);
+		}
+	}
+
+	if (dropWhenBusy) {
+		// Start byte, size header, wrapper header, msg header, and tail.
+		uint16_t overhead = 1 + sizeof(uart_msg_size_header_t) + sizeof(uart_msg_wrapper_header_t);
+		overhead += sizeof(uart_msg_header_t) + sizeof(uart_msg_tail_t);
+		if (!reserveSamplesBudget(overhead + size)) {
+			++_samplesDroppedCount;
+			return ERR_BUSY;
+		}
+	}
+
+	cs_ret_code_t retCode = writeMsgStart(opCode, size);
+	if (retCode != ERR_SUCCESS) {
+		return retCode;
+	}
+
+	retCode = writeMsgPart(opCode, header.data, header.len);
+	if (retCode != ERR_SUCCESS) {
+		return retCode;
+	}
+
+	if (encoding == UART_SAMPLES_ENCODING_RAW && stride == 1) {
+		// The samples are already laid out as they should be written.
+		retCode = writeMsgPart(opCode, reinterpret_cast<const uint8_t*>(samples), numSamples * sizeof(int16_t));
+		if (retCode != ERR_SUCCESS) {
+			return retCode;
+		}
+		return writeMsgEnd(opCode);
+	}
+
+	uint8_t chunk[UART_TX_SAMPLES_CHUNK_SIZE];
+	uint8_t chunkSize = 0;
+	for (uint16_t i = 0; i < numSamples; ++i) {
+		// Make sure an escaped delta fits.
+		if (chunkSize + 1 + sizeof(int16_t) > sizeof(chunk)) {
+			retCode = writeMsgPart(opCode, chunk, chunkSize);
+			if (retCode != ERR_SUCCESS) {
+				return retCode;
+			}
+			chunkSize = 0;
+		}
+		const int16_t* previous = (i == 0) ? nullptr : &samples[(i - 1) * stride];
+		chunkSize += encodeSample(samples[i * stride], previous, encoding, chunk + chunkSize);
+	}
+	if (chunkSize > 0) {
+		retCode = writeMsgPart(opCode, chunk, chunkSize);
+		if (retCode != ERR_SUCCESS) {
+			return retCode;
+		}
+	}
+	return writeMsgEnd(opCode);
+#endif
+}
+
+uint16_t UartHandler::getSamplesDroppedCount() {
+	return _samplesDroppedCount;
+}
+
+bool UartHandler::reserveSamplesBudget(uint16_t size) {
+	uint32_t rtcCount      = RTC::getCount();
+	uint64_t elapsedTicks  = RTC::difference(rtcCount, _samplesBudgetRtcCount);
+	uint64_t maxBudget     = static_cast<uint64_t>(UART_TX_SAMPLES_MAX_BURST_SIZE) * RTC_CLOCK_FREQ;
+	_samplesBudget         = std::min(_samplesBudget + elapsedTicks * UART_TX_SAMPLES_BYTES_PER_SECOND, maxBudget);
+	_samplesBudgetRtcCount = rtcCount;
+
+	uint32_t cost          = static_cast<uint32_t>(size) * RTC_CLOCK_FREQ;
+	if (_samplesBudget < cost) {
+		return false;
+	}
+	_samplesBudget -= cost;
+	return true;
+}
+
+uint8_t UartHandler::encodeSample(int16_t sample, const int16_t* previous, UartSamplesEncoding encoding, uint8_t* out) {
+	if (encoding == UART_SAMPLES_ENCODING_DELTA && previous != nullptr) {
+		int32_t delta = sample - *previous;
+		if (delta > UART_SAMPLES_DELTA_ESCAPE && delta <= INT8_MAX) {
+			if (out != nullptr) {
+				out[0] = static_cast<uint8_t>(static_cast<int8_t>(delta));
+			}
+			return 1;
+		}
+		if (out != nullptr) {
+			out[0] = static_cast<uint8_t>(UART_SAMPLES_DELTA_ESCAPE);
+			memcpy(out + 1, &sample, sizeof(sample));
+		}
+		return 1 + sizeof(sample);
+	}
+	if (out != nullptr) {
+		memcpy(out, &sample, sizeof(sample));
+	}
+	return sizeof(sample);
+}
+
 cs_ret_code_t UartHandler::writeStartByte() {
 	if (!serial_tx_ready()) {
 		return ERR_NOT_INITIALIZED;
@@ -20,6 +20,13 @@ AssetFilterData AssetFilter::filterdata() {
 	return AssetFilterData(_data + sizeof(asset_filter_runtime_data_t));
 }
 
+ExactMatchFilter AssetFilter::exactMatchFilter() {
+	if (runtimedata()->flags.flags.eytzingerLayout) {
+		return filterdata().exactMatchFilter(ExactMatchFilterLayout::Eytzinger);
+	}
+	return filterdata().exactMatchFilter();
+}
+
 // virtual functions
 
 size_t AssetFilter::size() {
@@ -32,7 +39,7 @@ bool AssetFilter::isValid() {
 			return filterdata().cuckooFilter().isValid();
 		}
 		case AssetFilterType::ExactMatchFilter: {
-			return filterdata().exactMatchFilter().isValid();
+			return exactMatchFilter().isValid();
 		}
 		default: {
 			return false;
@@ -50,7 +57,7 @@ bool AssetFilter::contains(const void* key, size_t keyLengthInBytes) {
 			return filterdata().cuckooFilter().contains(key, keyLengthInBytes);
 		}
 		case AssetFilterType::ExactMatchFilter: {
-			return filterdata().exactMatchFilter().contains(key, keyLengthInBytes);
+			return exactMatchFilter().contains(key, keyLengthInBytes);
 		}
 		default: {
 			return false;
@@ -82,7 +89,7 @@ ReturnType AssetFilter::prepareFilterInputAndCallDelegate(
 			break;
 		}
 		case AssetFilterType::ExactMatchFilter: {
-			exact  = filterdata().exactMatchFilter();
+			exact  = exactMatchFilter();
 			filter = &exact;
 			break;
 		}
@@ -92,65 +99,75 @@ ReturnType AssetFilter::prepareFilterInputAndCallDelegate(
 		}
 	}
 
+	uint8_t buffer[MAX_INPUT_SIZE];
+	cs_const_data_t inputData;
+	if (!getInputData(device, filterInputDescription, buffer, inputData)) {
+		return defaultValue;
+	}
+	return delegateExpression(filter, inputData.data, inputData.len);
+}
+
+bool AssetFilter::getInputData(
+		const scanned_device_t& device, AssetFilterInput input, uint8_t* buffer, cs_const_data_t& inputData) {
 	// split out input type for the filter and prepare the input
-	switch (*filterInputDescription.type()) {
+	switch (*input.type()) {
 		case AssetFilterInputType::MacAddress: {
-			return delegateExpression(filter, device.address, sizeof(device.address));
+			inputData = cs_const_data_t(device.address, sizeof(device.address));
+			return true;
 		}
 		case AssetFilterInputType::AdDataType: {
-			// selects the first found field of configured type and checks if that field's
-			// data is contained in the filter. returns defaultValue if it can't be found.
+			// selects the first found field of configured type.
 			cs_data_t result                  = {};
-			ad_data_type_selector_t* selector = filterInputDescription.AdTypeField();
+			ad_data_type_selector_t* selector = input.AdTypeField();
 
 			if (selector == nullptr) {
 				LOGe("Filter metadata type check failed");
-				return defaultValue;
+				return false;
 			}
 
-			if (CsUtils::findAdvType(selector->adDataType, device.data, device.dataSize, &result) == ERR_SUCCESS) {
-				return delegateExpression(filter, result.data, result.len);
+			if (CsUtils::findAdvType(selector->adDataType, device, &result) == ERR_SUCCESS) {
+				inputData = cs_const_data_t(result.data, result.len);
+				return true;
 			}
 
-			return defaultValue;
+			return false;
 		}
 		case AssetFilterInputType::MaskedAdDataType: {
-			// selects the first found field of configured type and checks if that field's
-			// data is contained in the filter. returns false if it can't be found.
+			// selects the first found field of configured type, and copies the bytes that are set in the mask.
 			cs_data_t result                         = {};
-			masked_ad_data_type_selector_t* selector = filterInputDescription.AdTypeMasked();
+			masked_ad_data_type_selector_t* selector = input.AdTypeMasked();
 
 			if (selector == nullptr) {
 				LOGe("Filter metadata type check failed");
-				return defaultValue;
+				return false;
 			}
 
-			if (CsUtils::findAdvType(selector->adDataType, device.data, device.dataSize, &result) == ERR_SUCCESS) {
+			if (CsUtils::findAdvType(selector->adDataType, device, &result) == ERR_SUCCESS) {
 				// A normal advertisement payload size is 31B at most.
 				// We are also limited by the 32b bitmask.
-				if (result.len > 31) {
+				if (result.len > MAX_INPUT_SIZE) {
 					LOGw("Advertisement too large");
-					return defaultValue;
+					return false;
 				}
-				uint8_t buff[31];
 
 				// apply the mask
 				uint8_t buffIndex = 0;
 				for (uint8_t bitIndex = 0; bitIndex < result.len; bitIndex++) {
 					if (CsUtils::isBitSet(selector->adDataMask, bitIndex)) {
-						buff[buffIndex] = result.data[bitIndex];
+						buffer[buffIndex] = result.data[bitIndex];
 						buffIndex++;
 					}
 				}
-				_logArray(LogLevelAssetFilteringVerbose, true, buff, buffIndex);
-				return delegateExpression(filter, buff, buffIndex);
+				_logArray(LogLevelAssetFilteringVerbose, true, buffer, buffIndex);
+				inputData = cs_const_data_t(buffer, buffIndex);
+				return true;
 			}
 
-			return defaultValue;
+			return false;
 		}
 	}
 
-	return defaultValue;
+	return false;
 }
 
 bool AssetFilter::filterAcceptsScannedDevice(const scanned_device_t& asset) {
@@ -0,0 +1,143 @@
+/*
+ * Author: Crownstone Team
+ * Copyright: Crownstone (https://crownstone.rocks)
+ * Date: Oct 16, 2026
+ * License: LGPLv3+, Apache License 2.0, and/or MIT (triple-licensed)
+ */
+
+#include <util/cs_AssetFilterPlan.h>
+#include <util/cs_Utils.h>
+
+#include <cstring>
+
+static_assert(sizeof(uint8_t) * 8 >= AssetFilterPlan::MAX_FILTERS, "Filter bitmasks are too small");
+
+/**
+ * Number of cuckoo filter hash versions, the key hashes are indexed by version.
+ */
+static constexpr uint8_t HASH_VERSION_COUNT = static_cast<uint8_t>(CuckooFilterHashVersion::Fnv1a) + 1;
+
+void AssetFilterPlan::clear() {
+	_filterCount = 0;
+	_inputCount  = 0;
+}
+
+bool AssetFilterPlan::add(AssetFilter filter) {
+	if (_filterCount == MAX_FILTERS) {
+		return false;
+	}
+	uint8_t filterIndex   = _filterCount;
+	_filters[filterIndex] = filter._data;
+	_filterCount++;
+
+	AssetFilterMetadata metadata = filter.filterdata().metadata();
+	AssetFilterInput input       = metadata.inputType();
+
+	// Look for a filter with the same input.
+	uint8_t inputIndex = 0;
+	for (; inputIndex < _inputCount; ++inputIndex) {
+		AssetFilterInput otherInput =
+				AssetFilter(_filters[_inputs[inputIndex].inputFilterIndex]).filterdata().metadata().inputType();
+		if (input.length() == otherInput.length() && memcmp(input._data, otherInput._data, input.length()) == 0) {
+			break;
+		}
+	}
+	if (inputIndex == _inputCount) {
+		_inputs[inputIndex] = asset_filter_plan_input_t{
+				.inputFilterIndex = filterIndex, .excludeFilters = 0, .otherFilters = 0, .hashVersions = 0};
+		_inputCount++;
+	}
+
+	asset_filter_plan_input_t& planInput = _inputs[inputIndex];
+	if (metadata.flags()->flags.exclude) {
+		CsUtils::setBit(planInput.excludeFilters, filterIndex);
+	}
+	else {
+		CsUtils::setBit(planInput.otherFilters, filterIndex);
+	}
+	if (*metadata.filterType() == AssetFilterType::CuckooFilter) {
+		CsUtils::setBit(planInput.hashVersions, static_cast<uint8_t>(filter.filterdata().cuckooFilter().hashVersion()));
+	}
+	return true;
+}
+
+std::optional<uint8_t> AssetFilterPlan::evaluate(const scanned_device_t& device, uint8_t& acceptingFilters) {
+	acceptingFilters = 0;
+
+	// First the inputs with exclude filters, so that the other inputs can be skipped when the device is rejected.
+	for (uint8_t i = 0; i < _inputCount; ++i) {
+		if (_inputs[i].excludeFilters != 0) {
+			std::optional<uint8_t> rejectingFilter = evaluateInput(_inputs[i], device, acceptingFilters);
+			if (rejectingFilter) {
+				return rejectingFilter;
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < _inputCount; ++i) {
+		if (_inputs[i].excludeFilters == 0) {
+			evaluateInput(_inputs[i], device, acceptingFilters);
+		}
+	}
+	return {};
+}
+
+std::optional<uint8_t> AssetFilterPlan::evaluateInput(
+		const asset_filter_plan_input_t& input, const scanned_device_t& device, uint8_t& acceptingFilters) {
+	AssetFilterInput inputDescription =
+			AssetFilter(_filters[input.inputFilterIndex]).filterdata().metadata().inputType();
+
+	uint8_t buffer[AssetFilter::MAX_INPUT_SIZE];
+	cs_const_data_t key;
+	if (!AssetFilter::getInputData(device, inputDescription, buffer, key)) {
+		return {};
+	}
+
+	cuckoo_key_hash_t keyHashes[HASH_VERSION_COUNT] = {};
+	for (uint8_t version = 0; version < HASH_VERSION_COUNT; ++version) {
+		if (CsUtils::isBitSet(input.hashVersions, version)) {
+			keyHashes[version] =
+					CuckooFilter::hashKey(key.data, key.len, static_cast<CuckooFilterHashVersion>(version));
+		}
+	}
+
+	uint8_t rejectingFilters = getContainingFilters(input.excludeFilters, key, keyHashes);
+	if (rejectingFilters != 0) {
+		// Report the exclude filter with the lowest index.
+		return __builtin_ctz(rejectingFilters);
+	}
+
+	acceptingFilters |= getContainingFilters(input.otherFilters, key, keyHashes);
+	return {};
+}
+
+uint8_t AssetFilterPlan::getContainingFilters(
+		uint8_t filterMask, const cs_const_data_t& key, const cuckoo_key_hash_t* keyHashes) {
+	uint8_t containingFilters = 0;
+	for (uint8_t filterIndex = 0; filterIndex < _filterCount; ++filterIndex) {
+		if (!CsUtils::isBitSet(filterMask, filterIndex)) {
+			continue;
+		}
+
+		AssetFilter filter(_filters[filterIndex]);
+		AssetFilterData filterData = filter.filterdata();
+		bool contains              = false;
+		switch (*filterData.metadata().filterType()) {
+			case AssetFilterType::CuckooFilter: {
+				CuckooFilter cuckooFilter        = filterData.cuckooFilter();
+				const cuckoo_key_hash_t& keyHash = keyHashes[static_cast<uint8_t>(cuckooFilter.hashVersion())];
+				contains                         = cuckooFilter.contains(keyHash);
+				break;
+			}
+			case AssetFilterType::ExactMatchFilter: {
+				contains = filter.exactMatchFilter().contains(key.data, key.len);
+				break;
+			}
+			default: break;
+		}
+		if (contains) {
+			CsUtils::setBit(containingFilters, filterIndex);
+		}
+	}
+	return containingFilters;
+}
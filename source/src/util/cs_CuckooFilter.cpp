@@ -64,6 +64,22 @@ cuckoo_fingerprint_t CuckooFilter::hashToBucket(cuckoo_key_t key, size_t keyLeng
 	return static_cast<cuckoo_fingerprint_t>(Djb2(static_cast<const uint8_t*>(key), keyLengthInBytes));
 }
 
+cuckoo_key_hash_t CuckooFilter::hashKeyFnv1a(cuckoo_key_t key, size_t keyLengthInBytes) {
+	uint32_t hash = Fnv1a(static_cast<const uint8_t*>(key), keyLengthInBytes);
+
+	// Mix the bits, so that the lower half, used for the bucket index, depends on all bits of the key.
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6B;
+	hash ^= hash >> 13;
+
+	// A fingerprint of 0 marks an empty nest.
+	cuckoo_fingerprint_t fingerprint = static_cast<cuckoo_fingerprint_t>(hash >> 16);
+	if (fingerprint == 0) {
+		fingerprint = 1;
+	}
+	return cuckoo_key_hash_t{.fingerprint = fingerprint, .bucketHash = static_cast<cuckoo_fingerprint_t>(hash)};
+}
+
 /* ------------------------------------------------------------------------- */
 
 cuckoo_extended_fingerprint_t CuckooFilter::getExtendedFingerprint(
@@ -75,25 +91,34 @@ cuckoo_extended_fingerprint_t CuckooFilter::getExtendedFingerprint(
 			.bucketB     = static_cast<cuckoo_index_t>((bucketIndex ^ finger) % bucketCount())};
 }
 
-cuckoo_extended_fingerprint_t CuckooFilter::getExtendedFingerprint(cuckoo_key_t key, size_t keyLengthInBytes) {
-
-	cuckoo_fingerprint_t fingerHash = hashToFingerprint(key, keyLengthInBytes);
-	cuckoo_fingerprint_t bucketHash = hashToBucket(key, keyLengthInBytes);
+cuckoo_key_hash_t CuckooFilter::hashKey(
+		cuckoo_key_t key, size_t keyLengthInBytes, CuckooFilterHashVersion hashVersion) {
+	if (hashVersion == CuckooFilterHashVersion::Fnv1a) {
+		return hashKeyFnv1a(key, keyLengthInBytes);
+	}
+	return cuckoo_key_hash_t{
+			.fingerprint = hashToFingerprint(key, keyLengthInBytes),
+			.bucketHash  = hashToBucket(key, keyLengthInBytes)};
+}
 
+cuckoo_extended_fingerprint_t CuckooFilter::getExtendedFingerprint(const cuckoo_key_hash_t& keyHash) {
 	return cuckoo_extended_fingerprint_t{
-			.fingerprint = fingerHash,
-			.bucketA     = static_cast<cuckoo_index_t>(bucketHash % bucketCount()),
-			.bucketB     = static_cast<cuckoo_index_t>((bucketHash ^ fingerHash) % bucketCount())};
+			.fingerprint = keyHash.fingerprint,
+			.bucketA     = static_cast<cuckoo_index_t>(keyHash.bucketHash % bucketCount()),
+			.bucketB     = static_cast<cuckoo_index_t>((keyHash.bucketHash ^ keyHash.fingerprint) % bucketCount())};
+}
+
+cuckoo_extended_fingerprint_t CuckooFilter::getExtendedFingerprint(cuckoo_key_t key, size_t keyLengthInBytes) {
+	return getExtendedFingerprint(hashKey(key, keyLengthInBytes, _hashVersion));
 }
 
 cuckoo_compressed_fingerprint_t CuckooFilter::getCompressedFingerprint(cuckoo_key_t key, size_t keyLengthInBytes) {
 
-	cuckoo_fingerprint_t fingerHash = hashToFingerprint(key, keyLengthInBytes);
-	cuckoo_fingerprint_t bucketHash = hashToBucket(key, keyLengthInBytes);
+	cuckoo_key_hash_t keyHash = hashKey(key, keyLengthInBytes, _hashVersion);
 
 	return cuckoo_compressed_fingerprint_t{
-			.fingerprint = fingerHash,
-			.bucket      = static_cast<cuckoo_index_t>(bucketHash % bucketCount()),
+			.fingerprint = keyHash.fingerprint,
+			.bucket      = static_cast<cuckoo_index_t>(keyHash.bucketHash % bucketCount()),
 	};
 }
 
@@ -101,6 +126,34 @@ cuckoo_compressed_fingerprint_t CuckooFilter::getCompressedFingerprint(cuckoo_ke
 /* ---------------------------- Filter methods ----------------------------- */
 /* ------------------------------------------------------------------------- */
 
+bool CuckooFilter::bucketContains(cuckoo_fingerprint_t fingerprint, cuckoo_index_t bucketIndex) {
+	static_assert(sizeof(cuckoo_fingerprint_t) == 2, "Word compare assumes 2 fingerprints per word");
+
+	// The bucket array is not necessarily aligned, memcpy lets the compiler pick a suitable load.
+	const uint8_t* bucket = reinterpret_cast<const uint8_t*>(&lookupFingerprint(bucketIndex, 0));
+	uint32_t pattern      = fingerprint * 0x00010001u;
+
+	size_t ii = 0;
+	for (; ii + 1 < _data->nestsPerBucket; ii += 2) {
+		uint32_t nests;
+		std::memcpy(&nests, bucket + ii * sizeof(cuckoo_fingerprint_t), sizeof(nests));
+
+		// A half of the difference is 0 where the fingerprint matches.
+		uint32_t difference = nests ^ pattern;
+		if ((difference - 0x00010001u) & ~difference & 0x80008000u) {
+			return true;
+		}
+	}
+
+	// Odd number of nests.
+	if (ii < _data->nestsPerBucket) {
+		return lookupFingerprint(bucketIndex, ii) == fingerprint;
+	}
+	return false;
+}
+
+/* ------------------------------------------------------------------------- */
+
 bool CuckooFilter::addFingerprintToBucket(cuckoo_fingerprint_t fingerprint, cuckoo_index_t bucketIndex) {
 	for (size_t ii = 0; ii < _data->nestsPerBucket; ++ii) {
 		cuckoo_fingerprint_t& fingerprintInArray = lookupFingerprint(bucketIndex, ii);
@@ -214,23 +267,7 @@ bool CuckooFilter::isValid() {
 /* ------------------------------------------------------------------------- */
 
 bool CuckooFilter::contains(cuckoo_extended_fingerprint_t efp) {
-	// loops are split to improve cache hit rate.
-
-	// search bucketA
-	for (size_t ii = 0; ii < _data->nestsPerBucket; ++ii) {
-		if (efp.fingerprint == lookupFingerprint(efp.bucketA, ii)) {
-			return true;
-		}
-	}
-
-	// search bucketB
-	for (size_t ii = 0; ii < _data->nestsPerBucket; ++ii) {
-		if (efp.fingerprint == lookupFingerprint(efp.bucketB, ii)) {
-			return true;
-		}
-	}
-
-	return false;
+	return bucketContains(efp.fingerprint, efp.bucketA) || bucketContains(efp.fingerprint, efp.bucketB);
 }
 
 /* ------------------------------------------------------------------------- */
@@ -10,11 +10,13 @@
 #include <util/cs_ExactMatchFilter.h>
 
 #include <cstring>
+#include <new>
 #include <type_traits>  // for assert(std::is_same ...) in binary search.
 
 #define LogExactMatchFilterWarn LOGw
 
-ExactMatchFilter::ExactMatchFilter(exact_match_filter_data_t* data) : _data(data) {}
+ExactMatchFilter::ExactMatchFilter(exact_match_filter_data_t* data, ExactMatchFilterLayout layout)
+		: _data(data), _layout(layout) {}
 
 bool ExactMatchFilter::isValid() {
 	if (_data == nullptr) {
@@ -29,6 +31,37 @@ bool ExactMatchFilter::isValid() {
 		LogExactMatchFilterWarn("itemSize can't be 0") return false;
 	}
 
+	if (_layout == ExactMatchFilterLayout::Eytzinger) {
+		// Walk the tree in order, starting at the leftmost node: that should give the items sorted.
+		uint32_t nodeIndex = 1;
+		while (2 * nodeIndex <= _data->itemCount) {
+			nodeIndex = 2 * nodeIndex;
+		}
+		const uint8_t* previous = nullptr;
+		while (nodeIndex != 0) {
+			const uint8_t* node = getItem(nodeIndex - 1);
+			if (previous != nullptr && memcmp(previous, node, _data->itemSize) > 0) {
+				LogExactMatchFilterWarn("Exact match filter item is out of tree order (index %u)", nodeIndex - 1);
+				return false;
+			}
+			previous = node;
+
+			if (2 * nodeIndex + 1 <= _data->itemCount) {
+				// Next is the leftmost node of the right subtree.
+				nodeIndex = 2 * nodeIndex + 1;
+				while (2 * nodeIndex <= _data->itemCount) {
+					nodeIndex = 2 * nodeIndex;
+				}
+			}
+			else {
+				// Next is the first parent of which this node is in the left subtree: remove the trailing right turns,
+				// and that left turn.
+				nodeIndex >>= __builtin_ctz(~nodeIndex) + 1;
+			}
+		}
+		return true;
+	}
+
 	for (auto i = 0; i < _data->itemCount - 1; i++) {
 		auto cmp = memcmp(getItem(i), getItem(i + 1), _data->itemSize);
 		if (cmp > 0) {
@@ -41,11 +74,49 @@ bool ExactMatchFilter::isValid() {
 
 	return true;
 }
+
+cs_ret_code_t ExactMatchFilter::toEytzingerLayout() {
+	if (_layout != ExactMatchFilterLayout::Sorted) {
+		return ERR_WRONG_STATE;
+	}
+
+	uint8_t* sortedItems = new (std::nothrow) uint8_t[bufferSize()];
+	if (sortedItems == nullptr) {
+		return ERR_NO_SPACE;
+	}
+	memcpy(sortedItems, _data->itemArray, bufferSize());
+
+	size_t sortedIndex = 0;
+	fillEytzinger(sortedItems, 1, sortedIndex);
+
+	delete[] sortedItems;
+	_layout = ExactMatchFilterLayout::Eytzinger;
+	return ERR_SUCCESS;
+}
+
+void ExactMatchFilter::fillEytzinger(const uint8_t* sortedItems, size_t nodeIndex, size_t& sortedIndex) {
+	// In order traversal of the tree, at most 8 levels deep.
+	if (nodeIndex > _data->itemCount) {
+		return;
+	}
+	fillEytzinger(sortedItems, 2 * nodeIndex, sortedIndex);
+	memcpy(getItem(nodeIndex - 1), sortedItems + sortedIndex * _data->itemSize, _data->itemSize);
+	sortedIndex++;
+	fillEytzinger(sortedItems, 2 * nodeIndex + 1, sortedIndex);
+}
+
 int ExactMatchFilter::find(const void* item, size_t itemSize) {
 	if (itemSize != _data->itemSize || _data->itemCount == 0) {
 		return -1;
 	}
 
+	if (_layout == ExactMatchFilterLayout::Eytzinger) {
+		return findEytzinger(static_cast<const uint8_t*>(item));
+	}
+	return findSorted(static_cast<const uint8_t*>(item));
+}
+
+int ExactMatchFilter::findSorted(const uint8_t* item) {
 	// Binary search. [lowerIndex, upperIndex] is the inclusive candidate interval for the key index.
 	int lowerIndex = 0;
 	int upperIndex = _data->itemCount - 1;
@@ -56,7 +127,7 @@ int ExactMatchFilter::find(const void* item, size_t itemSize) {
 
 	while (lowerIndex <= upperIndex) {
 		int midpointIndex = (lowerIndex + upperIndex) / 2;
-		auto cmp          = memcmp(item, getItem(midpointIndex), itemSize);
+		auto cmp          = memcmp(item, getItem(midpointIndex), _data->itemSize);
 
 		if (cmp == 0) {  // early return when found
 			return midpointIndex;
@@ -72,6 +143,32 @@ int ExactMatchFilter::find(const void* item, size_t itemSize) {
 	return -1;
 }
 
+int ExactMatchFilter::findEytzinger(const uint8_t* item) {
+	uint32_t itemPrefix   = getPrefix(item);
+	bool prefixIsFullItem = _data->itemSize <= PREFIX_SIZE;
+
+	// Walk down the tree: the node index gets a bit for every level, 1 for going right, when the node is smaller than
+	// the item. Only when the prefixes are equal, the comparison needs the rest of the item.
+	uint32_t nodeIndex    = 1;
+	while (nodeIndex <= _data->itemCount) {
+		const uint8_t* node = getItem(nodeIndex - 1);
+		uint32_t nodePrefix = getPrefix(node);
+		bool smaller        = nodePrefix < itemPrefix;
+		if (nodePrefix == itemPrefix && !prefixIsFullItem) {
+			smaller = memcmp(node, item, _data->itemSize) < 0;
+		}
+		nodeIndex = 2 * nodeIndex + smaller;
+	}
+
+	// The smallest node that is not smaller than the item, is where the walk last went left:
+	// remove the trailing right turns, and that left turn.
+	nodeIndex >>= __builtin_ctz(~nodeIndex) + 1;
+	if (nodeIndex == 0 || memcmp(getItem(nodeIndex - 1), item, _data->itemSize) != 0) {
+		return -1;
+	}
+	return nodeIndex - 1;
+}
+
 bool ExactMatchFilter::contains(const void* key, size_t keyLengthInBytes) {
 	return find(key, keyLengthInBytes) >= 0;
 }
@@ -79,3 +176,18 @@ bool ExactMatchFilter::contains(const void* key, size_t keyLengthInBytes) {
 uint8_t* ExactMatchFilter::getItem(size_t index) {
 	return _data->itemArray + index * _data->itemSize;
 }
+
+uint32_t ExactMatchFilter::getPrefix(const uint8_t* item) {
+	if (_data->itemSize >= PREFIX_SIZE) {
+		// Big endian, so that it compares like memcmp.
+		uint32_t prefix;
+		memcpy(&prefix, item, PREFIX_SIZE);
+		return __builtin_bswap32(prefix);
+	}
+
+	uint32_t prefix = 0;
+	for (size_t i = 0; i < _data->itemSize; ++i) {
+		prefix |= static_cast<uint32_t>(item[i]) << (8 * (PREFIX_SIZE - 1 - i));
+	}
+	return prefix;
+}